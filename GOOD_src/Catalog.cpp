@@ -0,0 +1,363 @@
+/*------------------------------------------------------------------------------
+* Catalog.cpp : conditional refresh of the mutable products from the metadata of their remote copies
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    1. RFC 9110, HTTP Semantics (Last-Modified, ETag)
+*    2. RFC 3659, Extensions to FTP (MDTM, SIZE)
+*
+* notes   : some products change under a fixed name, i.e., the IGS ANTEX files, the CNES real-time products and the
+*           predicted GIMs, so a local copy being there does not mean it is up to date. The metadata (modification
+*           time, size and ETag) of the remote copy is kept in 'catalog.list' in the root/main directory when it is
+*           downloaded, and the next run probes the remote copy (HEAD, or MDTM/SIZE) and downloads it again only if
+*           the metadata changed. A local copy not in the catalog yet is compared with its own modification time,
+*           which 'wget' sets to the remote one. Without libcurl only the HTTP(S) copies are probed, by
+*           'wget --spider'; the others are kept as before.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "StringUtil.h"
+#include "JobPool.h"
+#include "Catalog.h"
+#include <sstream>
+#include <sys/stat.h>
+#ifdef _WIN32  /* for Windows */
+#include <process.h>
+#endif
+#ifdef GOOD_USE_CURL
+#include <curl/curl.h>
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+#ifdef GOOD_USE_CURL
+/**
+* @brief   : HeadStr - the callback of libcurl appending the headers to a string
+* @param[I]: ptr (header line)
+* @param[I]: size (1)
+* @param[I]: nmemb (number of bytes)
+* @param[O]: userdata (string)
+* @return  : number of bytes taken
+* @note    :
+**/
+static size_t HeadStr(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    ((string *)userdata)->append(ptr, size * nmemb);
+
+    return size * nmemb;
+} /* end of HeadStr */
+#endif
+
+/**
+* @brief   : HttpDate - the time of an HTTP date
+* @param[I]: date (i.e., 'Wed, 21 Oct 2015 07:28:00 GMT')
+* @param[O]: none
+* @return  : seconds since 1970-01-01 UTC, 0: error
+* @note    :
+**/
+long long Catalog::HttpDate(const string &date)
+{
+    char wday[8], mon[8];
+    int dd = 0, yyyy = 0, hh = 0, mm = 0, ss = 0;
+    if (sscanf(date.c_str(), "%7[^,], %d %3s %d %d:%d:%d", wday, &dd, mon, &yyyy, &hh, &mm, &ss) != 7) return 0;
+    const char *mons = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    const char *p = strstr(mons, mon);
+    if (!p || strlen(mon) != 3 || (p - mons) % 3 != 0) return 0;
+
+    TimeUtil tu;
+    double ep[6] = { (double)yyyy, (double)((p - mons) / 3 + 1), (double)dd, (double)hh, (double)mm, (double)ss };
+    gtime_t t = tu.ymdhms2time(ep);
+
+    return (long long)(t.mjd - 40587) * 86400 + (long long)(t.sod + 0.5);  /* MJD 40587: 1970-01-01 */
+} /* end of HttpDate */
+
+/**
+* @brief   : Headers - the metadata in the headers of HTTP responses
+* @param[I]: head (headers, the ones of the last response after the redirections taken)
+* @param[O]: r (metadata)
+* @return  : status code of the last response, 0 if none
+* @note    :
+**/
+int Catalog::Headers(const string &head, remote_t &r)
+{
+    StringUtil str;
+    std::istringstream iss(head);
+    string line;
+    int code = 0;
+    while (getline(iss, line))
+    {
+        str.TrimSpace4String(line);
+        if (line.compare(0, 5, "HTTP/") == 0)
+        {
+            /* a new response */
+            std::istringstream ls(line);
+            string ver;
+            ls >> ver >> code;
+            r.mtime = 0;
+            r.size = -1;
+            r.etag = "";
+            continue;
+        }
+        size_t ipos = line.find(':');
+        if (ipos == string::npos) continue;
+        string key = line.substr(0, ipos), val = line.substr(ipos + 1);
+        str.ToLower(key);
+        str.TrimSpace4String(val);
+        if (key == "last-modified") r.mtime = HttpDate(val);
+        else if (key == "content-length") r.size = atoll(val.c_str());
+        else if (key == "etag") r.etag = val;
+    }
+
+    return code;
+} /* end of Headers */
+
+/**
+* @brief   : Probe - the metadata of a remote file, without its body
+* @param[I]: url (URL of the file)
+* @param[O]: r (metadata)
+* @return  : true: the file is there, false: not there or unknown
+* @note    : HEAD for HTTP(S), SIZE and MDTM for FTP(S) via libcurl; 'wget --spider' for HTTP(S) without libcurl
+**/
+bool Catalog::Probe(const string &url, remote_t &r) const
+{
+    r.mtime = 0;
+    r.size = -1;
+    r.etag = "";
+    bool http = url.compare(0, 7, "http://") == 0 || url.compare(0, 8, "https://") == 0;
+#ifdef GOOD_USE_CURL
+    CURL *curl = curl_easy_init();
+    if (!curl) return false;
+
+    /* 'ftps://' of 'wget' is the explicit FTPS */
+    string url0 = url;
+    bool ftps = url.compare(0, 7, "ftps://") == 0;
+    if (ftps) url0 = "ftp://" + url.substr(7);
+    string head;
+    curl_easy_setopt(curl, CURLOPT_URL, url0.c_str());
+    if (ftps) curl_easy_setopt(curl, CURLOPT_USE_SSL, (long)CURLUSESSL_ALL);
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_FILETIME, 1L);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_NETRC, (long)CURL_NETRC_OPTIONAL);  /* the logins of '.netrc', as 'wget' */
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeadStr);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &head);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    if (_connTimeout > 0) curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, _connTimeout);
+    if (_timeout > 0) curl_easy_setopt(curl, CURLOPT_TIMEOUT, _timeout);
+    CURLcode rc = curl_easy_perform(curl);
+    long code = 0;
+    curl_off_t ft = -1, len = -1;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+    curl_easy_getinfo(curl, CURLINFO_FILETIME_T, &ft);
+    curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &len);
+    curl_easy_cleanup(curl);
+    if (rc != CURLE_OK || code >= 400) return false;
+
+    if (http) Headers(head, r);
+    if (ft > 0) r.mtime = (long long)ft;
+    if (len >= 0) r.size = (long long)len;
+#else
+    if (!http) return false;
+
+    char tmpFile[MAXSTRPATH];
+#ifdef _WIN32   /* for Windows */
+    sprintf(tmpFile, ".spider_%d.log", (int)_getpid());
+#else           /* for Linux or Mac */
+    sprintf(tmpFile, ".spider_%d.log", (int)getpid());
+#endif
+    string cmd = _wget + " -o " + tmpFile + " " + url;
+    std::system(cmd.c_str());
+    std::ifstream log(tmpFile);
+    std::stringstream head;
+    head << log.rdbuf();
+    log.close();
+    remove(tmpFile);
+    int code = Headers(head.str(), r);
+    if (code == 0 || code >= 400) return false;
+#endif
+
+    return r.mtime > 0 || r.size >= 0 || !r.etag.empty();
+} /* end of Probe */
+
+/**
+* @brief   : Append - append the metadata of a local file to 'catalog.list'
+* @param[I]: path (full path of the local file)
+* @param[I]: r (metadata)
+* @param[O]: none
+* @return  : none
+* @note    : one short line, so that the concurrent jobs do not mix their lines; the last one of a file wins
+**/
+void Catalog::Append(const string &path, const remote_t &r) const
+{
+    FILE *fp = fopen(_list.c_str(), "a");
+    if (!fp)
+    {
+        cerr << "*** ERROR(Catalog::Append): failed to open " << _list << endl;
+
+        return;
+    }
+    fprintf(fp, "%lld %lld %s %s\n", r.mtime, r.size, r.etag.empty() ? "-" : r.etag.c_str(), path.c_str());
+    fclose(fp);
+} /* end of Append */
+
+/**
+* @brief   : OldCopy - the name of the old copy of a local file kept during its refresh
+* @param[I]: file (local file)
+* @param[O]: none
+* @return  : i.e., '.igs20.atx.old', hidden so that it is not moved with the new files of a concurrent job
+* @note    :
+**/
+string Catalog::OldCopy(const string &file)
+{
+    size_t ipos = file.find_last_of("/\\");
+    if (ipos == string::npos) return "." + file + ".old";
+
+    return file.substr(0, ipos + 1) + "." + file.substr(ipos + 1) + ".old";
+} /* end of OldCopy */
+
+/**
+* @brief   : Set - set the catalog and load 'catalog.list'
+* @param[I]: fopt (FTP options)
+* @param[I]: mainDir (root/main directory)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void Catalog::Set(const ftpopt_t *fopt, const char *mainDir)
+{
+    _on = fopt->refresh;
+    _list = string(mainDir) + (char)FILEPATHSEP + CATALOG_LIST;
+    _connTimeout = fopt->connTimeout;
+    _timeout = fopt->timeout;
+    char tmpLine[MAXCHARS];
+    sprintf(tmpLine, "%s --spider -S --tries=1", fopt->wgetFull);
+    if (fopt->timeout > 0) sprintf(tmpLine + strlen(tmpLine), " --timeout=%d", fopt->timeout);
+    if (fopt->connTimeout > 0) sprintf(tmpLine + strlen(tmpLine), " --connect-timeout=%d", fopt->connTimeout);
+    _wget = tmpLine;
+
+    /* the last line of each local file, as written by the jobs of the former days */
+    _files.clear();
+    if (!_on) return;
+    FILE *fp = fopen(_list.c_str(), "r");
+    if (!fp) return;
+    StringUtil str;
+    char line[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        std::istringstream iss(line);
+        remote_t r;
+        string path;
+        if (!(iss >> r.mtime >> r.size >> r.etag) || !getline(iss, path)) continue;
+        str.TrimSpace4String(path);
+        if (r.etag == "-") r.etag = "";
+        if (!path.empty()) _files[path] = r;
+    }
+    fclose(fp);
+} /* end of Set */
+
+/**
+* @brief   : Outdated - whether a local file of a mutable product is to be downloaded
+* @param[I]: file (local file in the current directory)
+* @param[I]: urls (URLs of the remote file, i.e., the '.gz' and '.Z' ones, the first one there is taken)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : true: not there, or changed remotely, false: up to date
+* @note    : an outdated copy is moved aside until "Done"; a local file is kept if its remote one cannot be probed
+**/
+bool Catalog::Outdated(const string &file, const std::vector<string> &urls, FILE *fpLog)
+{
+    bool exist = access(file.c_str(), 0) == 0;
+    if (!_on) return !exist;
+
+    remote_t r;
+    bool found = false;
+    for (int i = 0; i < urls.size() && !found; i++) found = Probe(urls[i], r);
+    _nprobe++;
+    if (!found) return !exist;
+    string path = JobPool::DataDir() + (char)FILEPATHSEP + file;
+    _pending[path] = r;
+    if (!exist) return true;
+
+    bool changed = false;
+    auto it = _files.find(path);
+    if (it != _files.end())
+    {
+        const remote_t &r0 = it->second;
+        if (!r.etag.empty() && !r0.etag.empty()) changed = r.etag != r0.etag;
+        else changed = (r.mtime > 0 && r0.mtime > 0 && r.mtime != r0.mtime) || (r.size >= 0 && r0.size >= 0 && r.size != r0.size);
+    }
+    else
+    {
+        /* not in the catalog yet: newer than the local copy, as 'If-Modified-Since' */
+        struct stat st;
+        changed = r.mtime > 0 && stat(file.c_str(), &st) == 0 && r.mtime > (long long)st.st_mtime;
+        if (!changed)
+        {
+            _files[path] = r;
+            Append(path, r);
+            _pending.erase(path);
+        }
+    }
+    if (!changed) return false;
+
+    /* the old copy is kept until the new one is there */
+    rename(file.c_str(), OldCopy(file).c_str());
+    _nfresh++;
+    if (fpLog) fprintf(fpLog, "* INFO(Catalog): %s changed remotely, downloaded again\n", path.c_str());
+
+    return true;
+} /* end of Outdated */
+
+/**
+* @brief   : Done - the end of the download of a local file asked by "Outdated"
+* @param[I]: file (local file in the current directory)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the metadata of the new copy is recorded, or the old copy is put back if the download failed
+**/
+void Catalog::Done(const string &file, FILE *fpLog)
+{
+    if (!_on) return;
+
+    string path = JobPool::DataDir() + (char)FILEPATHSEP + file, old = OldCopy(file);
+    auto it = _pending.find(path);
+    if (access(file.c_str(), 0) == 0)
+    {
+        remove(old.c_str());
+        if (it != _pending.end())
+        {
+            _files[path] = it->second;
+            Append(path, it->second);
+        }
+    }
+    else if (access(old.c_str(), 0) == 0)
+    {
+        rename(old.c_str(), file.c_str());
+        if (fpLog) fprintf(fpLog, "* WARNING(Catalog): %s not downloaded again, the old copy kept\n", path.c_str());
+    }
+    if (it != _pending.end()) _pending.erase(it);
+} /* end of Done */
+
+/**
+* @brief   : Report - report the probes and the refreshes
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the probes of the concurrent jobs are counted in their own processes and logged one by one
+**/
+void Catalog::Report(FILE *fpLog) const
+{
+    if (_nprobe == 0) return;
+
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d mutable products probed, %d changed remotely and downloaded again", _nprobe, _nfresh);
+    cout << "*** INFO(Catalog::Report): " << buff << endl;
+
+    if (fpLog) fprintf(fpLog, "* INFO(Catalog): %s\n", buff);
+} /* end of Report */
@@ -0,0 +1,126 @@
+/*------------------------------------------------------------------------------
+* Catalog.h : header file of Catalog.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+
+#define CATALOG_LIST   "catalog.list"    /* remote metadata of the local copies of the mutable products in the root/main
+                                            directory, 'mtime size etag path' */
+
+class Catalog
+{
+private:
+    struct remote_t
+    {                                     /* metadata of a remote file */
+        long long mtime;                  /* modification time (s since 1970-01-01 UTC), 0: unknown */
+        long long size;                   /* size (bytes), -1: unknown */
+        string etag;                      /* entity tag (HTTP), "": unknown */
+    };
+
+    std::map<string, remote_t> _files;    /* metadata of the remote copy of each local file, key: full path */
+    std::map<string, remote_t> _pending;  /* metadata probed before a refresh, key: full path */
+    bool _on;                             /* (0:off  1:on) */
+    string _list;                         /* path of 'catalog.list' */
+    string _wget;                         /* 'wget' command of the probes */
+    long _connTimeout;                    /* connect timeout (s), 0: default */
+    long _timeout;                        /* timeout of a probe (s), 0: default */
+    int _nprobe, _nfresh;                 /* numbers of the probes and the refreshes */
+
+    /**
+    * @brief   : HttpDate - the time of an HTTP date
+    * @param[I]: date (i.e., 'Wed, 21 Oct 2015 07:28:00 GMT')
+    * @param[O]: none
+    * @return  : seconds since 1970-01-01 UTC, 0: error
+    * @note    :
+    **/
+    static long long HttpDate(const string &date);
+
+    /**
+    * @brief   : Headers - the metadata in the headers of HTTP responses
+    * @param[I]: head (headers, the ones of the last response after the redirections taken)
+    * @param[O]: r (metadata)
+    * @return  : status code of the last response, 0 if none
+    * @note    :
+    **/
+    static int Headers(const string &head, remote_t &r);
+
+    /**
+    * @brief   : Probe - the metadata of a remote file, without its body
+    * @param[I]: url (URL of the file)
+    * @param[O]: r (metadata)
+    * @return  : true: the file is there, false: not there or unknown
+    * @note    : HEAD for HTTP(S), SIZE and MDTM for FTP(S) via libcurl; 'wget --spider' for HTTP(S) without libcurl
+    **/
+    bool Probe(const string &url, remote_t &r) const;
+
+    /**
+    * @brief   : Append - append the metadata of a local file to 'catalog.list'
+    * @param[I]: path (full path of the local file)
+    * @param[I]: r (metadata)
+    * @param[O]: none
+    * @return  : none
+    * @note    : one short line, so that the concurrent jobs do not mix their lines; the last one of a file wins
+    **/
+    void Append(const string &path, const remote_t &r) const;
+
+    /**
+    * @brief   : OldCopy - the name of the old copy of a local file kept during its refresh
+    * @param[I]: file (local file)
+    * @param[O]: none
+    * @return  : i.e., '.igs20.atx.old', hidden so that it is not moved with the new files of a concurrent job
+    * @note    :
+    **/
+    static string OldCopy(const string &file);
+
+public:
+    Catalog()
+    {
+        _on = false;
+        _connTimeout = _timeout = 0;
+        _nprobe = _nfresh = 0;
+    }
+    ~Catalog()
+    {
+
+    }
+
+    /**
+    * @brief   : Set - set the catalog and load 'catalog.list'
+    * @param[I]: fopt (FTP options)
+    * @param[I]: mainDir (root/main directory)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Set(const ftpopt_t *fopt, const char *mainDir);
+
+    /**
+    * @brief   : Outdated - whether a local file of a mutable product is to be downloaded
+    * @param[I]: file (local file in the current directory)
+    * @param[I]: urls (URLs of the remote file, i.e., the '.gz' and '.Z' ones, the first one there is taken)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : true: not there, or changed remotely, false: up to date
+    * @note    : an outdated copy is moved aside until "Done"; a local file is kept if its remote one cannot be probed
+    **/
+    bool Outdated(const string &file, const std::vector<string> &urls, FILE *fpLog);
+
+    /**
+    * @brief   : Done - the end of the download of a local file asked by "Outdated"
+    * @param[I]: file (local file in the current directory)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the metadata of the new copy is recorded, or the old copy is put back if the download failed
+    **/
+    void Done(const string &file, FILE *fpLog);
+
+    /**
+    * @brief   : Report - report the probes and the refreshes
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Report(FILE *fpLog) const;
+};
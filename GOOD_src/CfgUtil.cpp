@@ -0,0 +1,1124 @@
+/*------------------------------------------------------------------------------
+* CfgUtil.cpp : schema-driven parsing of configure files with TXT and YAML formats
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : every configure item is described once in 'cfgItems', which drives both formats. A TXT line
+*           'key = value  % comment' and a YAML item 'key: value' are set by the same setter, and an item with
+*           several fields, i.e., 'getObs', is given in YAML as a map whose sub-keys are joined in the order
+*           of the TXT fields
+*
+* history : 2026/10/18 1.0  new, replaces the 'strstr' chains of PreProcess::ReadCfgTxt and ReadCfgYaml
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "StringUtil.h"
+#include "TimeUtil.h"
+#include "CfgUtil.h"
+#include <sstream>
+#ifdef _WIN32 /* for Windows */
+#include "yaml-cpp\yaml.h"
+#else /* for Linux or Mac */
+#include <yaml-cpp/yaml.h>
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MIN(x, y) ((x) <= (y) ? (x) : (y))
+#define POPT(x)   [](prcopt_t *popt, ftpopt_t *fopt) -> void * { return &popt->x; }  /* field of processing options */
+#define FOPT(x)   [](prcopt_t *popt, ftpopt_t *fopt) -> void * { return &fopt->x; }  /* field of FTP options */
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : SetSwitch - set a switch and an optional string field
+* @param[I]: val (value text, i.e., '1  cod')
+* @param[O]: key (switch)
+* @param[O]: str (string field, nullptr: none)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetSwitch(const char *val, bool *key, char *str, string &msg)
+{
+    int j = 0;
+    int n = str ? sscanf(val, "%d %s", &j, str) : sscanf(val, "%d", &j);
+    if (n < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    *key = j == 1 ? true : false;
+
+    return true;
+} /* end of SetSwitch */
+
+/**
+* @brief   : Set3party - set the directory of third-party softwares
+* @param[I]: val (value text, i.e., '1  D:\data\thirdParty')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool Set3party(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    StringUtil str;
+    int j = 0;
+    char tmpLine[MAXCHARS] = { '\0' };
+    if (sscanf(val, "%d %[^%]", &j, tmpLine) < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    str.TrimSpace4Char(tmpLine);
+    str.CutFilePathSep(tmpLine);
+    strcpy(fopt->dir3party, tmpLine);
+    fopt->key43party = j == 1 ? true : false;
+
+    return true;
+} /* end of Set3party */
+
+/**
+* @brief   : SetLogFile - set the log file
+* @param[I]: val (value text, i.e., '1  D:\data\log\log.txt')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetLogFile(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    StringUtil str;
+    char tmpLine[MAXCHARS] = { '\0' };
+    if (sscanf(val, "%d %[^%]", &fopt->logWriteMode, tmpLine) < 1)
+    {
+        msg = "the mode (0:off  1:overwrite  2:append) is MISSING";
+
+        return false;
+    }
+    str.TrimSpace4Char(tmpLine);
+    str.CutFilePathSep(tmpLine);
+    strcpy(fopt->logFil, tmpLine);
+
+    return true;
+} /* end of SetLogFile */
+
+/**
+* @brief   : SetLease - set the distributed mode
+* @param[I]: val (value text, i.e., '1  /mnt/nfs/good/work  1800')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : the lease time is optional
+**/
+static bool SetLease(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    StringUtil str;
+    int j = 0, sec = 0;
+    char tmpLine[MAXCHARS] = { '\0' };
+    int n = sscanf(val, "%d %s %d", &j, tmpLine, &sec);
+    if (n < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->distributed = j == 1 ? true : false;
+    if (n >= 2)
+    {
+        str.CutFilePathSep(tmpLine);
+        strcpy(fopt->leaseDir, tmpLine);
+    }
+    if (n >= 3) fopt->leaseSec = sec;
+    if (fopt->distributed && strlen(fopt->leaseDir) == 0)
+    {
+        msg = "the work directory is MISSING";
+
+        return false;
+    }
+
+    return true;
+} /* end of SetLease */
+
+/**
+* @brief   : SetPriority - set the priority class of each product
+* @param[I]: val (value text, i.e., '1  0  0  0  0  0  0  0  0  0  1  0' in the order of PRODPRI_NAMES)
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetPriority(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    std::istringstream iss(val);
+    int pri[NPRODPRI], n = 0;
+    while (n < NPRODPRI && iss >> pri[n]) n++;
+    if (n < NPRODPRI)
+    {
+        msg = "the priority classes of '" PRODPRI_NAMES "' are expected";
+
+        return false;
+    }
+    for (int i = 0; i < NPRODPRI; i++)
+    {
+        if (pri[i] < 0 || pri[i] >= MAXPRICLASS)
+        {
+            msg = "a priority class is 0 to " + to_string(MAXPRICLASS - 1);
+
+            return false;
+        }
+        fopt->priority[i] = pri[i];
+    }
+
+    return true;
+} /* end of SetPriority */
+
+/**
+* @brief   : SetRetry - set the retry policy of the transient download failures
+* @param[I]: val (value text, i.e., '3  2  60  30  5  300')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : max number of retries, backoff (s), cap of the backoff (s), timeout (s), number of consecutive failures
+*            pausing a host, and seconds of the pause
+**/
+static bool SetRetry(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int maxRetry = 0, timeout = 0, hostFails = 0;
+    double backoff = 0.0, backoffMax = 0.0, hostPause = 0.0;
+    int n = sscanf(val, "%d %lf %lf %d %d %lf", &maxRetry, &backoff, &backoffMax, &timeout, &hostFails, &hostPause);
+    if (n < 6)
+    {
+        msg = "the retries, backoff, max backoff, timeout, host failures and host pause are expected";
+
+        return false;
+    }
+    if (maxRetry < 0 || backoff < 0.0 || backoffMax < backoff || timeout <= 0 || hostFails < 0 || hostPause < 0.0)
+    {
+        msg = "the retry policy is INVALID";
+
+        return false;
+    }
+    fopt->maxRetry = maxRetry;
+    fopt->backoff = backoff;
+    fopt->backoffMax = backoffMax;
+    fopt->timeout = timeout;
+    fopt->hostFails = hostFails;
+    fopt->hostPause = hostPause;
+
+    return true;
+} /* end of SetRetry */
+
+/**
+* @brief   : SetWatchdog - set the watchdog of the transfers
+* @param[I]: val (value text, i.e., '30  1024  60  3600')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : connect timeout (s), min average speed (B/s), window of the average speed (s), and total deadline (s)
+**/
+static bool SetWatchdog(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int connTimeout = 0, lowSpeedWin = 0, deadline = 0;
+    double lowSpeed = 0.0;
+    int n = sscanf(val, "%d %lf %d %d", &connTimeout, &lowSpeed, &lowSpeedWin, &deadline);
+    if (n < 4)
+    {
+        msg = "the connect timeout, min speed, speed window and deadline are expected";
+
+        return false;
+    }
+    if (connTimeout < 0 || lowSpeed < 0.0 || lowSpeedWin <= 0 || deadline < 0)
+    {
+        msg = "the watchdog is INVALID";
+
+        return false;
+    }
+    fopt->connTimeout = connTimeout;
+    fopt->lowSpeed = lowSpeed;
+    fopt->lowSpeedWin = lowSpeedWin;
+    fopt->deadline = deadline;
+
+    return true;
+} /* end of SetWatchdog */
+
+/**
+* @brief   : SetNgsS3 - set the S3 backend of the NGS/NOAA CORS archive
+* @param[I]: val (value text, i.e., '1  https://noaa-cors-pds.s3.amazonaws.com  16')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : the URL and the number of parallel transfers are optional
+**/
+static bool SetNgsS3(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0, nconn = 0;
+    char tmpLine[MAXCHARS] = { '\0' };
+    int n = sscanf(val, "%d %s %d", &j, tmpLine, &nconn);
+    if (n < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->ngsS3 = j == 1 ? true : false;
+    if (n >= 2) strcpy(fopt->ngsS3Url, tmpLine);
+    if (n >= 3)
+    {
+        if (nconn < 1)
+        {
+            msg = "the number of parallel transfers is at least 1";
+
+            return false;
+        }
+        fopt->s3Conns = nconn;
+    }
+
+    return true;
+} /* end of SetNgsS3 */
+
+/**
+* @brief   : SetManifest - set the checksum manifests of the remote directories
+* @param[I]: val (value text, i.e., '1  3600')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : the max age of a cached manifest is optional
+**/
+static bool SetManifest(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0, age = 0;
+    int n = sscanf(val, "%d %d", &j, &age);
+    if (n < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->manifest = j == 1 ? true : false;
+    if (n >= 2)
+    {
+        if (age < 0)
+        {
+            msg = "the max age of a cached manifest is at least 0";
+
+            return false;
+        }
+        fopt->manifestAge = age;
+    }
+
+    return true;
+} /* end of SetManifest */
+
+/**
+* @brief   : SetMissCache - set the negative cache of the remote files known to be missing
+* @param[I]: val (value text, i.e., '1')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : the days of an older configuration (i.e., '1  14') go to the observations and the navigation files, the
+*            other products being set by 'missDays'
+**/
+static bool SetMissCache(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0, days = 0;
+    int n = sscanf(val, "%d %d", &j, &days);
+    if (n < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->missCache = j == 1 ? true : false;
+    if (n >= 2)
+    {
+        if (days < 1)
+        {
+            msg = "the days after which a missing file is missing for good are at least 1";
+
+            return false;
+        }
+        fopt->missDays[0] = fopt->missDays[1] = days;  /* obs nav */
+    }
+
+    return true;
+} /* end of SetMissCache */
+
+/**
+* @brief   : SetMissDays - set the days of each product after which a missing remote file is missing for good
+* @param[I]: val (value text, i.e., '14  14  0  0  0  0  0  0  0  0  0  0' in the order of PRODPRI_NAMES)
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : 0: the plain TTL, never missing for good
+**/
+static bool SetMissDays(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    std::istringstream iss(val);
+    int days[NPRODPRI], n = 0;
+    while (n < NPRODPRI && iss >> days[n]) n++;
+    if (n < NPRODPRI)
+    {
+        msg = "the days of '" PRODPRI_NAMES "' are expected";
+
+        return false;
+    }
+    for (int i = 0; i < NPRODPRI; i++)
+    {
+        if (days[i] < 0)
+        {
+            msg = "the days are at least 0";
+
+            return false;
+        }
+        fopt->missDays[i] = days[i];
+    }
+
+    return true;
+} /* end of SetMissDays */
+
+/**
+* @brief   : SetMissTtl - set the TTL of a missing remote file of each product
+* @param[I]: val (value text, i.e., '600  600  3600  3600  3600  21600  21600  86400  3600  3600  3600  86400' in the order
+*            of PRODPRI_NAMES)
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetMissTtl(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    std::istringstream iss(val);
+    int ttl[NPRODPRI], n = 0;
+    while (n < NPRODPRI && iss >> ttl[n]) n++;
+    if (n < NPRODPRI)
+    {
+        msg = "the TTLs (s) of '" PRODPRI_NAMES "' are expected";
+
+        return false;
+    }
+    for (int i = 0; i < NPRODPRI; i++)
+    {
+        if (ttl[i] < 0)
+        {
+            msg = "a TTL is at least 0";
+
+            return false;
+        }
+        fopt->missTtl[i] = ttl[i];
+    }
+
+    return true;
+} /* end of SetMissTtl */
+
+/**
+* @brief   : SetHttp2 - set HTTP/2 and the number of the streams multiplexed over one connection
+* @param[I]: val (value text, i.e., '1  100')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : the number of the streams is optional
+**/
+static bool SetHttp2(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0, nstream = 0;
+    int n = sscanf(val, "%d %d", &j, &nstream);
+    if (n < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->http2 = j == 1 ? true : false;
+    if (n >= 2)
+    {
+        if (nstream < 1)
+        {
+            msg = "the number of the streams is at least 1";
+
+            return false;
+        }
+        fopt->h2Streams = nstream;
+    }
+
+    return true;
+} /* end of SetHttp2 */
+
+/**
+* @brief   : SetProcTime - set the start time and number of consecutive days
+* @param[I]: val (value text, i.e., '1  year  month  day  ndays' or '2  year  doy  ndays')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetProcTime(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    TimeUtil tu;
+    int j = 0;
+    sscanf(val, "%d", &j);
+    if (j == 1)
+    {
+        double date[6] = { 0.0 };
+        if (sscanf(val, "%d %lf %lf %lf %d", &j, date + 0, date + 1, date + 2, &popt->ndays) < 5)
+        {
+            msg = "the parameter of number of consecutive days is MISSING";
+
+            return false;
+        }
+        popt->ts = tu.ymdhms2time(date);
+    }
+    else if (j == 2)
+    {
+        double year = 0.0, doy = 0.0;
+        if (sscanf(val, "%d %lf %lf %d", &j, &year, &doy, &popt->ndays) < 4)
+        {
+            msg = "the parameter of number of consecutive days is MISSING";
+
+            return false;
+        }
+        popt->ts = tu.yrdoy2time((int)year, (int)doy);
+    }
+    else
+    {
+        msg = "the time format should be 1 (year month day) or 2 (year doy)";
+
+        return false;
+    }
+
+    return true;
+} /* end of SetProcTime */
+
+/**
+* @brief   : SetFtp - set the master switch for data downloading and the FTP archive
+* @param[I]: val (value text, i.e., '1  whu')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetFtp(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    return SetSwitch(val, &fopt->ftpDownloading, fopt->ftpFrom, msg);
+} /* end of SetFtp */
+
+/**
+* @brief   : SetObs - set the GNSS observation data downloading option
+* @param[I]: val (value text, i.e., '1  daily  mgex  all  00  2')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetObs(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0, hh = 0, nh = 0;
+    if (sscanf(val, "%d %s %s %s %d %d", &j, fopt->obsTyp, fopt->obsFrom, fopt->obsLst, &hh, &nh) < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->getObs = j == 1 ? true : false;
+
+    int imax = MIN(hh + nh, 24);
+    for (int i = hh; i < imax; i++)
+        fopt->hhObs.push_back(i);
+
+    return true;
+} /* end of SetObs */
+
+/**
+* @brief   : SetNav - set the broadcast ephemeris downloading option
+* @param[I]: val (value text, i.e., '1  daily  mixed3  igs  all  01  2')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetNav(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0, hh = 0, nh = 0;
+    if (sscanf(val, "%d %s %s %s %s %d %d", &j, fopt->navTyp, fopt->navSys, fopt->navAc, fopt->navLst, &hh, &nh) < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->getNav = j == 1 ? true : false;
+
+    int imax = MIN(hh + nh, 24);
+    for (int i = hh; i < imax; i++)
+        fopt->hhNav.push_back(i);
+
+    return true;
+} /* end of SetNav */
+
+/**
+* @brief   : SetOrbClk - set the precise orbit and clock downloading option
+* @param[I]: val (value text, i.e., '1  igs_u+gfz_u  01  2')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : the start hour is moved forward to the next update of the ultra-rapid products
+**/
+static bool SetOrbClk(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    StringUtil str;
+    int j = 0, hh = 0, nh = 0, step = 1;
+    if (sscanf(val, "%d %s %d %d", &j, fopt->orbClkAc, &hh, &nh) < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->getOrbClk = j == 1 ? true : false;
+
+    /* the analysis centers of a fallback chain (i.e., "cod>igs_r>igs_u") are set as well */
+    string ocOpt = fopt->orbClkAc;
+    std::replace(ocOpt.begin(), ocOpt.end(), '>', '+');
+    std::vector<string> acs;
+    int iPos = (int)ocOpt.find_first_of('+');
+    if (iPos > 0)
+        str.GetSubStr(ocOpt, "+", acs);
+    else
+        acs.push_back(ocOpt);
+    fopt->hhOrbClk.resize(4); /* for "esa_u", "gfz_u", "igs_u", and "whu_u" */
+    for (int i = 0; i < acs.size(); i++)
+    {
+        string ac_i = acs[i];
+        if (ac_i == "igs_u" || ac_i == "esa_u")
+            step = 6;
+        else if (ac_i == "gfz_u")
+            step = 3;
+        else if (ac_i == "whu_u")
+            step = 1;
+        else
+            step = 24;
+        int imax = 24;
+        for (int i = 0; i < imax; i += step)
+        {
+            if (hh > i)
+                hh = i + step;
+            else
+                break;
+        }
+        imax = MIN(hh + nh * step, 24);
+        for (int i = hh; i < imax; i += step)
+        {
+            if (ac_i == "esa_u")
+                fopt->hhOrbClk[0].push_back(i);
+            else if (ac_i == "gfz_u")
+                fopt->hhOrbClk[1].push_back(i);
+            else if (ac_i == "igs_u")
+                fopt->hhOrbClk[2].push_back(i);
+            else if (ac_i == "whu_u")
+                fopt->hhOrbClk[3].push_back(i);
+        }
+    }
+
+    return true;
+} /* end of SetOrbClk */
+
+/**
+* @brief   : SetEop - set the earth rotation parameter downloading option
+* @param[I]: val (value text, i.e., '1  igs_u  01  4')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : the start hour is moved forward to the next update of the ultra-rapid products
+**/
+static bool SetEop(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0, hh = 0, nh = 0, step = 24;
+    if (sscanf(val, "%d %s %d %d", &j, fopt->eopAc, &hh, &nh) < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->getEop = j == 1 ? true : false;
+
+    /* for a fallback chain (i.e., "igs>igs_u"), the hours are those of its ultra-rapid analysis center */
+    string eOpt = fopt->eopAc;
+    if (eOpt.find("igs_u") != string::npos || eOpt.find("esa_u") != string::npos)
+        step = 6;
+    else if (eOpt.find("gfz_u") != string::npos)
+        step = 3;
+    int imax = 24;
+    for (int i = 0; i < imax; i += step)
+    {
+        if (hh > i)
+            hh = i + step;
+        else
+            break;
+    }
+    imax = MIN(hh + nh * step, 24);
+    for (int i = hh; i < imax; i += step)
+        fopt->hhEop.push_back(i);
+
+    return true;
+} /* end of SetEop */
+
+/**
+* @brief   : SetObx - set the ORBEX (ORBit EXchange format) downloading option
+* @param[I]: val (value text, i.e., '1  cod_m')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetObx(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    return SetSwitch(val, &fopt->getObx, fopt->obxAc, msg);
+} /* end of SetObx */
+
+/**
+* @brief   : SetDsb - set the differential code/signal bias (DCB/DSB) downloading option
+* @param[I]: val (value text, i.e., '1  cod')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetDsb(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    return SetSwitch(val, &fopt->getDsb, fopt->dsbAc, msg);
+} /* end of SetDsb */
+
+/**
+* @brief   : SetOsb - set the observable-specific signal bias (OSB) downloading option
+* @param[I]: val (value text, i.e., '1  cod_m')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetOsb(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    return SetSwitch(val, &fopt->getOsb, fopt->osbAc, msg);
+} /* end of SetOsb */
+
+/**
+* @brief   : SetIon - set the global ionosphere map (GIM) downloading option
+* @param[I]: val (value text, i.e., '1  cod')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetIon(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    return SetSwitch(val, &fopt->getIon, fopt->ionAc, msg);
+} /* end of SetIon */
+
+/**
+* @brief   : SetTrp - set the tropospheric product downloading option
+* @param[I]: val (value text, i.e., '1  igs  all')
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    :
+**/
+static bool SetTrp(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    int j = 0;
+    if (sscanf(val, "%d %s %s", &j, fopt->trpAc, fopt->trpLst) < 1)
+    {
+        msg = "the switch (0:off  1:on) is MISSING";
+
+        return false;
+    }
+    fopt->getTrp = j == 1 ? true : false;
+
+    return true;
+} /* end of SetTrp */
+
+/* configure schema ----------------------------------------------------------*/
+static const cfgitem_t cfgItems[] = {
+    /* processing directory */
+    { "mainDir",        CFG_PATH, POPT(mainDir),       nullptr,     nullptr },
+    { "obsDir",         CFG_DIR,  POPT(obsDir),        nullptr,     nullptr },
+    { "navDir",         CFG_DIR,  POPT(navDir),        nullptr,     nullptr },
+    { "orbDir",         CFG_DIR,  POPT(orbDir),        nullptr,     nullptr },
+    { "clkDir",         CFG_DIR,  POPT(clkDir),        nullptr,     nullptr },
+    { "eopDir",         CFG_DIR,  POPT(eopDir),        nullptr,     nullptr },
+    { "obxDir",         CFG_DIR,  POPT(obxDir),        nullptr,     nullptr },
+    { "biaDir",         CFG_DIR,  POPT(biaDir),        nullptr,     nullptr },
+    { "snxDir",         CFG_DIR,  POPT(snxDir),        nullptr,     nullptr },
+    { "ionDir",         CFG_DIR,  POPT(ionDir),        nullptr,     nullptr },
+    { "ztdDir",         CFG_DIR,  POPT(ztdDir),        nullptr,     nullptr },
+    { "tblDir",         CFG_DIR,  POPT(tblDir),        nullptr,     nullptr },
+    { "3partyDir",      CFG_FUNC, nullptr,             Set3party,   "key43party path43party" },
+    { "logFile",        CFG_FUNC, nullptr,             SetLogFile,  "opt4logFil path4logFil" },
+
+    /* time settings */
+    { "procTime",       CFG_FUNC, nullptr,             SetProcTime, nullptr },
+
+    /* FTP downloading settings */
+    { "minusAdd1day",   CFG_BOOL, FOPT(minusAdd1day),  nullptr,     nullptr },
+    { "printInfoWget",  CFG_BOOL, FOPT(printInfoWget), nullptr,     nullptr },
+    { "mergeNav",       CFG_INT,  FOPT(mergeNav),      nullptr,     nullptr },
+    { "obsSys",         CFG_STR,  FOPT(obsSys),        nullptr,     nullptr },
+    { "obsTypes",       CFG_STR,  FOPT(obsTypes),      nullptr,     nullptr },
+    { "obsCheck",       CFG_BOOL, FOPT(obsCheck),      nullptr,     nullptr },
+    { "obsFrame",       CFG_INT,  FOPT(obsFrame),      nullptr,     nullptr },
+    { "obsStore",       CFG_BOOL, FOPT(obsStore),      nullptr,     nullptr },
+    { "maxJobs",        CFG_INT,  FOPT(maxJobs),       nullptr,     nullptr },
+    { "maxJobsHost",    CFG_INT,  FOPT(maxJobsHost),   nullptr,     nullptr },
+    { "leaseDir",       CFG_FUNC, nullptr,             SetLease,    "key4lease dir4lease sec4lease" },
+    { "priority",       CFG_FUNC, nullptr,             SetPriority, PRODPRI_NAMES },
+    { "retryPolicy",    CFG_FUNC, nullptr,             SetRetry,    "maxRetry backoff backoffMax timeout hostFails hostPause" },
+    { "watchdog",       CFG_FUNC, nullptr,             SetWatchdog, "connTimeout lowSpeed lowSpeedWin deadline" },
+    { "ngsS3",          CFG_FUNC, nullptr,             SetNgsS3,    "key4s3 url4s3 conns4s3" },
+    { "manifest",       CFG_FUNC, nullptr,             SetManifest, "key4sums age4sums" },
+    { "refresh",        CFG_BOOL, FOPT(refresh),       nullptr,     nullptr },
+    { "missCache",      CFG_FUNC, nullptr,             SetMissCache, "key4miss" },
+    { "missDays",       CFG_FUNC, nullptr,             SetMissDays, PRODPRI_NAMES },
+    { "missTtl",        CFG_FUNC, nullptr,             SetMissTtl,  PRODPRI_NAMES },
+    { "longName",       CFG_BOOL, FOPT(longName),      nullptr,     nullptr },
+    { "http2",          CFG_FUNC, nullptr,             SetHttp2,    "key4h2 streams4h2" },
+    { "ftpSession",     CFG_BOOL, FOPT(ftpSession),    nullptr,     nullptr },
+    { "maxProcs",       CFG_INT,  FOPT(maxProcs),      nullptr,     nullptr },
+    { "journal",        CFG_BOOL, FOPT(journal),       nullptr,     nullptr },
+
+    /* handling of FTP downloading */
+    { "ftpDownloading", CFG_FUNC, nullptr,             SetFtp,      "key4ftp ftpArch" },
+    { "getObs",         CFG_FUNC, nullptr,             SetObs,      "key4obs obsType obsFrom obsList sHH4obs nHH4obs" },
+    { "getNav",         CFG_FUNC, nullptr,             SetNav,      "key4nav navType navSys navFrom navList sHH4nav nHH4nav" },
+    { "getOrbClk",      CFG_FUNC, nullptr,             SetOrbClk,   "key4oc ocFrom sHH4oc nHH4oc" },
+    { "getEop",         CFG_FUNC, nullptr,             SetEop,      "key4eop eopFrom sHH4eop nHH4eop" },
+    { "getObx",         CFG_FUNC, nullptr,             SetObx,      "key4obx obxFrom" },
+    { "getDsb",         CFG_FUNC, nullptr,             SetDsb,      "key4dsb dsbFrom" },
+    { "getOsb",         CFG_FUNC, nullptr,             SetOsb,      "key4osb osbFrom" },
+    { "getSnx",         CFG_BOOL, FOPT(getSnx),        nullptr,     nullptr },
+    { "getIon",         CFG_FUNC, nullptr,             SetIon,      "key4ion ionFrom" },
+    { "getRoti",        CFG_BOOL, FOPT(getRoti),       nullptr,     nullptr },
+    { "getTrp",         CFG_FUNC, nullptr,             SetTrp,      "key4trp trpFrom trpList" },
+    { "getAtx",         CFG_BOOL, FOPT(getAtx),        nullptr,     nullptr }
+};
+static const int nCfgItems = (int)(sizeof(cfgItems) / sizeof(cfgItems[0]));
+
+struct cfghash_t
+{                                         /* perfect hash table of the keys */
+    unsigned int seed;                    /* seed without collision */
+    short idx[CFG_HASHSIZE];              /* index in 'cfgItems', -1: empty */
+};
+
+/**
+* @brief   : Hash - hash of a key with seed
+* @param[I]: key (key)
+* @param[I]: len (length of key)
+* @param[I]: seed (seed)
+* @param[O]: none
+* @return  : hash value
+* @note    : FNV-1a
+**/
+static unsigned int Hash(const char *key, int len, unsigned int seed)
+{
+    unsigned int h = 2166136261u ^ seed;
+    for (int i = 0; i < len; i++)
+    {
+        h ^= (unsigned char)key[i];
+        h *= 16777619u;
+    }
+
+    return h ^ (h >> 15);
+} /* end of Hash */
+
+/**
+* @brief   : BuildHash - search the seed that maps every key of the schema to its own slot
+* @param[I]: none
+* @param[O]: none
+* @return  : perfect hash table
+* @note    :
+**/
+static cfghash_t BuildHash()
+{
+    cfghash_t tab;
+    for (tab.seed = 0; ; tab.seed++)
+    {
+        bool ok = true;
+        for (int i = 0; i < CFG_HASHSIZE; i++) tab.idx[i] = -1;
+        for (int i = 0; i < nCfgItems && ok; i++)
+        {
+            unsigned int h = Hash(cfgItems[i].key, (int)strlen(cfgItems[i].key), tab.seed) & (CFG_HASHSIZE - 1);
+            if (tab.idx[h] >= 0) ok = false;
+            else tab.idx[h] = (short)i;
+        }
+        if (ok) break;
+    }
+
+    return tab;
+} /* end of BuildHash */
+
+/**
+* @brief   : Find - find the configure item of a key
+* @param[I]: key (key, not necessarily null-terminated)
+* @param[I]: len (length of key)
+* @param[O]: none
+* @return  : configure item, nullptr: unknown key
+* @note    : one probe of a perfect hash table built at the first call
+**/
+const cfgitem_t *CfgUtil::Find(const char *key, int len)
+{
+    static const cfghash_t tab = BuildHash();
+
+    int i = tab.idx[Hash(key, len, tab.seed) & (CFG_HASHSIZE - 1)];
+    if (i < 0 || strncmp(cfgItems[i].key, key, len) != 0 || cfgItems[i].key[len] != '\0') return nullptr;
+
+    return cfgItems + i;
+} /* end of Find */
+
+/**
+* @brief   : SetItem - set the field of one configure item
+* @param[I]: item (configure item)
+* @param[I]: val (value text without comment)
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @param[O]: msg (reason of failure)
+* @return  : true:ok, false:error
+* @note    : for the error of a number, '_col' is moved to the wrong character
+**/
+bool CfgUtil::SetItem(const cfgitem_t *item, const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg)
+{
+    StringUtil str;
+    char tmpLine[MAXCHARS] = { '\0' };
+    if (item->type == CFG_FUNC) return item->func(val, popt, fopt, msg);
+
+    void *field = item->field(popt, fopt);
+    if (item->type == CFG_INT || item->type == CFG_BOOL)
+    {
+        char *end = nullptr;
+        long j = strtol(val, &end, 10);
+        while (*end == ' ' || *end == '\t') end++;
+        if (end == val || *end != '\0')
+        {
+            _col += (int)(end - val);
+            msg = "an integer is expected";
+
+            return false;
+        }
+        if (item->type == CFG_INT) *(int *)field = (int)j;
+        else *(bool *)field = j == 1 ? true : false;
+
+        return true;
+    }
+
+    strncpy(tmpLine, val, MAXCHARS - 1);
+    str.TrimSpace4Char(tmpLine);
+    if (item->type == CFG_STR)
+    {
+        strcpy((char *)field, tmpLine);
+
+        return true;
+    }
+    str.CutFilePathSep(tmpLine);
+    if (item->type == CFG_PATH) strcpy((char *)field, tmpLine);
+    else sprintf((char *)field, "%s%c%s", popt->mainDir, (char)FILEPATHSEP, tmpLine);
+
+    return true;
+} /* end of SetItem */
+
+/**
+* @brief   : ReadTxt - read configure file with TXT format to get processing options
+* @param[I]: cfgFile (configure file)
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool CfgUtil::ReadTxt(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt)
+{
+    /* open configure file */
+    FILE *fp = nullptr;
+    if (!(fp = fopen(cfgFile, "r")))
+    {
+        cerr << "*** ERROR(CfgUtil::ReadTxt): open configure file " << cfgFile << " FAILED!" << endl;
+
+        return false;
+    }
+
+    char sline[MAXCHARS] = { '\0' };
+    string msg;
+    _line = 0;
+    while (fgets(sline, MAXCHARS, fp))
+    {
+        _line++;
+
+        /* the comment after '%' and the line break are cut */
+        char *p = sline;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#') continue;
+        for (char *q = p; *q; q++)
+        {
+            if (*q == '%' || *q == '\r' || *q == '\n')
+            {
+                *q = '\0';
+                break;
+            }
+        }
+        char *q = p + strlen(p);
+        while (q > p && (q[-1] == ' ' || q[-1] == '\t')) *--q = '\0';
+        if (*p == '\0') continue;
+
+        /* key = value */
+        char *key = p;
+        while (*p && *p != '=' && *p != ' ' && *p != '\t') p++;
+        int len = (int)(p - key);
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p != '=')
+        {
+            _col = (int)(p - sline) + 1;
+            cerr << "*** ERROR(CfgUtil::ReadTxt): " << cfgFile << " line " << _line << ", column " << _col << ": '=' is expected" << endl;
+            fclose(fp);
+
+            return false;
+        }
+        const cfgitem_t *item = Find(key, len);
+        if (!item)
+        {
+            cerr << "*** WARNING(CfgUtil::ReadTxt): " << cfgFile << " line " << _line << ", column " << (key - sline) + 1 << ": unknown key '"
+                << string(key, len) << "' is ignored" << endl;
+            continue;
+        }
+        p++;
+        while (*p == ' ' || *p == '\t') p++;
+        _col = (int)(p - sline) + 1;
+        if (!SetItem(item, p, popt, fopt, msg))
+        {
+            cerr << "*** ERROR(CfgUtil::ReadTxt): " << cfgFile << " line " << _line << ", column " << _col << ": " << item->key << ", "
+                << msg << "!" << endl;
+            fclose(fp);
+
+            return false;
+        }
+    }
+    fclose(fp);
+
+    return true;
+} /* end of ReadTxt */
+
+/**
+* @brief   : ReadYaml - read configure file with YAML format to get processing options
+* @param[I]: cfgFile (configure file)
+* @param[O]: popt (processing options)
+* @param[O]: fopt (FTP options)
+* @return  : true:ok, false:error
+* @note    : an item with several fields can also be given as a scalar with the TXT fields
+*            the sub-directories are set after 'mainDir', so the order of the keys does not matter
+**/
+bool CfgUtil::ReadYaml(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt)
+{
+    YAML::Node cfg;
+    try
+    {
+        cfg = YAML::LoadFile(cfgFile);
+    }
+    catch (const YAML::Exception &e)
+    {
+        cerr << "*** ERROR(CfgUtil::ReadYaml): " << cfgFile << " line " << e.mark.line + 1 << ", column " << e.mark.column + 1 << ": "
+            << e.msg << "!" << endl;
+
+        return false;
+    }
+    if (!cfg.IsMap())
+    {
+        cerr << "*** ERROR(CfgUtil::ReadYaml): " << cfgFile << " is NOT a map of configure items!" << endl;
+
+        return false;
+    }
+
+    /* the sub-directories after 'mainDir', which they are joined to, wherever it is in the file */
+    string msg;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (YAML::const_iterator it = cfg.begin(); it != cfg.end(); ++it)
+        {
+            string key = it->first.Scalar();
+            const YAML::Node &node = it->second;
+            const cfgitem_t *item = Find(key.c_str(), (int)key.size());
+            if (!item)
+            {
+                if (pass > 0) continue;
+                cerr << "*** WARNING(CfgUtil::ReadYaml): " << cfgFile << " line " << it->first.Mark().line + 1 << ", column "
+                    << it->first.Mark().column + 1 << ": unknown key '" << key << "' is ignored" << endl;
+                continue;
+            }
+            if (node.IsNull() || (item->type == CFG_DIR) != (pass > 0)) continue;
+            _line = node.Mark().line + 1;
+            _col = node.Mark().column + 1;
+
+            /* the value in TXT layout */
+            string val;
+            bool stat = true;
+            if (node.IsScalar()) val = node.Scalar();
+            else if (node.IsSequence())
+            {
+                for (size_t i = 0; i < node.size() && stat; i++)
+                {
+                    if (!node[i].IsScalar()) stat = false;
+                    else val += (i > 0 ? " " : "") + node[i].Scalar();
+                }
+                if (!stat) msg = "a list of scalars is expected";
+            }
+            else if (item->subKeys)
+            {
+                std::istringstream subKeys(item->subKeys);
+                string sub;
+                while (subKeys >> sub && stat)
+                {
+                    YAML::Node subNode = node[sub];
+                    if (!subNode.IsDefined() || !subNode.IsScalar())
+                    {
+                        msg = "'" + sub + "' is MISSING";
+                        stat = false;
+                    }
+                    else val += (val.empty() ? "" : " ") + subNode.Scalar();
+                }
+            }
+            else
+            {
+                msg = "a scalar is expected";
+                stat = false;
+            }
+            if (!stat || !SetItem(item, val.c_str(), popt, fopt, msg))
+            {
+                cerr << "*** ERROR(CfgUtil::ReadYaml): " << cfgFile << " line " << _line << ", column " << _col << ": " << key << ", "
+                    << msg << "!" << endl;
+
+                return false;
+            }
+        }
+    }
+
+    return true;
+} /* end of ReadYaml */
@@ -0,0 +1,83 @@
+/*------------------------------------------------------------------------------
+* CfgUtil.h : header file of CfgUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* types of configure items */
+#define CFG_INT      1           /* integer */
+#define CFG_BOOL     2           /* (0:off  1:on) */
+#define CFG_STR      3           /* string */
+#define CFG_PATH     4           /* path, the tailing separators being cut */
+#define CFG_DIR      5           /* sub-directory of the root/main directory */
+#define CFG_FUNC     6           /* several fields parsed by a handler */
+
+#define CFG_HASHSIZE 128         /* size of the hash table of keys, power of 2 */
+
+struct cfgitem_t
+{                                                            /* one item of the configure schema */
+    const char *key;                                         /* key, i.e., "obsDir" */
+    int type;                                                /* type of item (CFG_???) */
+    void *(*field)(prcopt_t *popt, ftpopt_t *fopt);          /* address of the field (CFG_INT: int, CFG_BOOL: bool, others: char[MAXCHARS]) */
+    bool (*func)(const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg);  /* handler (CFG_FUNC) */
+    const char *subKeys;                                     /* YAML sub-keys in the order of the TXT fields, nullptr: scalar */
+};
+
+class CfgUtil
+{
+private:
+    int _line;                            /* line of the item being parsed */
+    int _col;                             /* column of the item being parsed */
+
+    /**
+    * @brief   : SetItem - set the field of one configure item
+    * @param[I]: item (configure item)
+    * @param[I]: val (value text without comment)
+    * @param[O]: popt (processing options)
+    * @param[O]: fopt (FTP options)
+    * @param[O]: msg (reason of failure)
+    * @return  : true:ok, false:error
+    * @note    : for the error of a number, '_col' is moved to the wrong character
+    **/
+    bool SetItem(const cfgitem_t *item, const char *val, prcopt_t *popt, ftpopt_t *fopt, string &msg);
+
+public:
+    CfgUtil()
+    {
+        _line = 0;
+        _col = 0;
+    }
+    ~CfgUtil()
+    {
+
+    }
+
+    /**
+    * @brief   : Find - find the configure item of a key
+    * @param[I]: key (key, not necessarily null-terminated)
+    * @param[I]: len (length of key)
+    * @param[O]: none
+    * @return  : configure item, nullptr: unknown key
+    * @note    : one probe of a perfect hash table built at the first call
+    **/
+    static const cfgitem_t *Find(const char *key, int len);
+
+    /**
+    * @brief   : ReadTxt - read configure file with TXT format to get processing options
+    * @param[I]: cfgFile (configure file)
+    * @param[O]: popt (processing options)
+    * @param[O]: fopt (FTP options)
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool ReadTxt(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt);
+
+    /**
+    * @brief   : ReadYaml - read configure file with YAML format to get processing options
+    * @param[I]: cfgFile (configure file)
+    * @param[O]: popt (processing options)
+    * @param[O]: fopt (FTP options)
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool ReadYaml(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt);
+};
@@ -0,0 +1,949 @@
+/*------------------------------------------------------------------------------
+* FtpClient.cpp : native FTP client keeping its logins alive, with MLSD listings and pipelined commands
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    1. RFC 959, File Transfer Protocol (FTP)
+*    2. RFC 2428, FTP extensions for IPv6 and NATs (EPSV)
+*    3. RFC 3659, Extensions to FTP (SIZE, MDTM and MLSD)
+*
+* notes   : the archives of plain FTP (i.e., IGN, WHU, GFZ, AIUB, GA and HK) are asked for hundreds of files in one run.
+*           Each 'wget' opens a new control connection, logs in, changes down the directories and lists them as text,
+*           which costs several round-trips before the first byte of a file. The 'wget' commands of a plain FTP URL
+*           are run here instead: a host is logged in once (USER, PASS and TYPE sent in one go) and the session is
+*           kept alive for the next commands of the run; a directory is listed once by MLSD, with the sizes and the
+*           modification times, and reused within FTP_LIST_TTL; a single file is asked for by SIZE and MDTM in one go;
+*           a data connection is passive and opened by EPSV (or PASV) sent in one go with its RETR or MLSD. As by
+*           'wget -r -nH --cut-dirs=N', the files go to the local directory of the request, the listing is written to
+*           '.listing' there (in the format of 'ls -l', for "JobPlan" and "SiteNames"), and a local file of the same
+*           size and modification time is not downloaded again. The subdirectories are not descended. A session
+*           closed by the server while idle is opened again, and the failures are classified by their reply codes
+*           (-1 or 4xx: transient, 550: absent, other 5xx: permanent) for "RetryPolicy". The jobs forked by
+*           "JobPool" open their own sessions. Any other command (i.e., of 'ftps', 'http(s)' or with '-O') is left to 'wget'.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "StringUtil.h"
+#include "JobPlan.h"
+#include "RetryPolicy.h"
+#include "FtpClient.h"
+#include <chrono>
+#include <sstream>
+#include <sys/stat.h>
+#ifdef _WIN32  /* for Windows */
+#include <ws2tcpip.h>
+#include <process.h>
+#include <sys/utime.h>
+#pragma comment(lib, "ws2_32.lib")
+#else          /* for Linux or Mac */
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <utime.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0                    /* SO_NOSIGPIPE instead on Mac */
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Now - the current time
+* @param[I]: none
+* @param[O]: none
+* @return  : seconds
+* @note    :
+**/
+static double Now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} /* end of Now */
+
+/**
+* @brief   : Pid - the current process
+* @param[I]: none
+* @param[O]: none
+* @return  : process id
+* @note    :
+**/
+static int Pid()
+{
+#ifdef _WIN32  /* for Windows */
+    return (int)_getpid();
+#else          /* for Linux or Mac */
+    return (int)getpid();
+#endif
+} /* end of Pid */
+
+/**
+* @brief   : Epoch - seconds since 1970-01-01 UTC of a calendar time
+* @param[I]: ymdhms (i.e., "20240201123456", the form of MDTM and MLSD)
+* @param[O]: none
+* @return  : seconds, 0: not a time
+* @note    :
+**/
+static long long Epoch(const string &ymdhms)
+{
+    if (ymdhms.size() < 14) return 0;
+    for (int i = 0; i < 14; i++)
+        if (!isdigit((unsigned char)ymdhms[i])) return 0;
+    int y = atoi(ymdhms.substr(0, 4).c_str()), m = atoi(ymdhms.substr(4, 2).c_str()), d = atoi(ymdhms.substr(6, 2).c_str());
+    int hh = atoi(ymdhms.substr(8, 2).c_str()), mm = atoi(ymdhms.substr(10, 2).c_str()), ss = atoi(ymdhms.substr(12, 2).c_str());
+
+    /* days from 1970-01-01 of the proleptic Gregorian calendar */
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;
+    long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    long long days = era * 146097 + doe - 719468;
+
+    return days * 86400 + hh * 3600 + mm * 60 + ss;
+} /* end of Epoch */
+
+/**
+* @brief   : CloseSock - close a socket
+* @param[I]: sock (socket)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+static void CloseSock(intptr_t sock)
+{
+    if (sock < 0) return;
+#ifdef _WIN32  /* for Windows */
+    closesocket((SOCKET)sock);
+#else          /* for Linux or Mac */
+    close((int)sock);
+#endif
+} /* end of CloseSock */
+
+/**
+* @brief   : Wait - wait for a socket
+* @param[I]: sock (socket)
+* @param[I]: write (true: for writing, false: for reading)
+* @param[I]: timeout (s)
+* @param[O]: none
+* @return  : true: ready, false: timeout or error
+* @note    :
+**/
+static bool Wait(intptr_t sock, bool write, double timeout)
+{
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(sock, &fds);
+    struct timeval tv;
+    tv.tv_sec = (long)timeout;
+    tv.tv_usec = (long)((timeout - (long)timeout) * 1e6);
+
+    return select((int)sock + 1, write ? nullptr : &fds, write ? &fds : nullptr, nullptr, &tv) > 0;
+} /* end of Wait */
+
+/**
+* @brief   : Connect - open a TCP connection
+* @param[I]: host (host)
+* @param[I]: port (port)
+* @param[I]: timeout (connect timeout, s)
+* @param[O]: none
+* @return  : socket, -1: failed
+* @note    :
+**/
+static intptr_t Connect(const string &host, int port, int timeout)
+{
+#ifdef _WIN32  /* for Windows */
+    static bool init = false;
+    if (!init)
+    {
+        WSADATA wsa;
+        WSAStartup(MAKEWORD(2, 2), &wsa);
+        init = true;
+    }
+#endif
+    struct addrinfo hints, *res = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host.c_str(), to_string(port).c_str(), &hints, &res) != 0) return -1;
+
+    intptr_t sock = -1;
+    for (struct addrinfo *ai = res; ai && sock < 0; ai = ai->ai_next)
+    {
+#ifdef _WIN32  /* for Windows */
+        SOCKET s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s == INVALID_SOCKET) continue;
+        u_long nb = 1;
+        ioctlsocket(s, FIONBIO, &nb);
+        bool ok = connect(s, ai->ai_addr, (int)ai->ai_addrlen) == 0 || WSAGetLastError() == WSAEWOULDBLOCK;
+#else          /* for Linux or Mac */
+        int s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s < 0) continue;
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        int flags = fcntl(s, F_GETFL, 0);
+        fcntl(s, F_SETFL, flags | O_NONBLOCK);
+        bool ok = connect(s, ai->ai_addr, ai->ai_addrlen) == 0 || errno == EINPROGRESS;
+#endif
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (ok) ok = Wait((intptr_t)s, true, timeout) && getsockopt(s, SOL_SOCKET, SO_ERROR, (char *)&err, &len) == 0 && err == 0;
+        if (!ok)
+        {
+            CloseSock((intptr_t)s);
+            continue;
+        }
+#ifdef _WIN32  /* for Windows */
+        nb = 0;
+        ioctlsocket(s, FIONBIO, &nb);
+#else          /* for Linux or Mac */
+        fcntl(s, F_SETFL, flags);
+#endif
+        sock = (intptr_t)s;
+    }
+    freeaddrinfo(res);
+
+    return sock;
+} /* end of Connect */
+
+/**
+* @brief   : SendAll - send a string
+* @param[I]: sock (socket)
+* @param[I]: data (string)
+* @param[O]: none
+* @return  : true: sent, false: failed
+* @note    :
+**/
+static bool SendAll(intptr_t sock, const string &data)
+{
+    size_t off = 0;
+    while (off < data.size())
+    {
+        int n = (int)send(sock, data.c_str() + off, (int)(data.size() - off), MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        off += n;
+    }
+
+    return true;
+} /* end of SendAll */
+
+/**
+* @brief   : Classify - classify an FTP reply code
+* @param[I]: code (reply code, -1: no answer)
+* @param[O]: none
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT
+* @note    : no answer or 4xx (i.e., 421, 425 or 450) is transient; 550 is an absent file; the other 5xx (i.e., 530)
+*            are permanent
+**/
+static int Classify(int code)
+{
+    if (code >= 200 && code < 300) return WGET_OK;
+    if (code == 550) return WGET_ABSENT;
+    if (code >= 500 && code < 600) return WGET_PERMANENT;
+
+    return WGET_TRANSIENT;
+} /* end of Classify */
+
+/**
+* @brief   : MkDirs - make a local directory and its parents
+* @param[I]: dir (directory, relative)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+static void MkDirs(const string &dir)
+{
+    for (size_t ipos = 0; ipos != string::npos; )
+    {
+        ipos = dir.find('/', ipos + 1);
+        string sub = dir.substr(0, ipos);
+#ifdef _WIN32  /* for Windows */
+        _mkdir(sub.c_str());
+#else          /* for Linux or Mac */
+        mkdir(sub.c_str(), 0755);
+#endif
+    }
+} /* end of MkDirs */
+
+/**
+* @brief   : Parse - the request of a 'wget' command
+* @param[I]: cmd ('wget' command)
+* @param[O]: req (request)
+* @return  : true: a request of a plain FTP URL this client takes, false: left to 'wget'
+* @note    : only the options of GOOD ('-r', '-nH', '--cut-dirs=N', '-A', the timeouts and the messages) are taken;
+*            any other, i.e., '-O', leaves the command to 'wget'
+**/
+bool FtpClient::Parse(const string &cmd, request_t &req)
+{
+    std::istringstream iss(cmd);
+    string tok, prev, url, accept;
+    int cutDirs = 0;
+    bool nH = false;
+    iss >> tok;  /* 'wget' itself */
+    while (iss >> tok)
+    {
+        if (prev == "-A") accept = tok;
+        else if (tok.compare(0, 6, "ftp://") == 0) url = tok;
+        else if (tok.compare(0, 11, "--cut-dirs=") == 0) cutDirs = atoi(tok.c_str() + 11);
+        else if (tok == "-nH") nH = true;
+        else if (tok != "-A" && tok != "-r" && tok != "-qr" && tok != "-q" && tok != "-nv" && tok != "--no-remove-listing" &&
+            tok.compare(0, 8, "--tries=") != 0 && tok.compare(0, 10, "--timeout=") != 0 &&
+            tok.compare(0, 18, "--connect-timeout=") != 0) return false;
+        prev = tok;
+    }
+    if (url.empty() || !nH) return false;
+
+    /* ftp://[user[:pass]@]host[:port]/path */
+    string rest = url.substr(6);
+    size_t ipos = rest.find('/');
+    string auth = rest.substr(0, ipos), path = ipos == string::npos ? "/" : rest.substr(ipos);
+    req.user = "anonymous";
+    req.pass = "anonymous@";
+    size_t iat = auth.rfind('@');
+    if (iat != string::npos)
+    {
+        string login = auth.substr(0, iat);
+        auth = auth.substr(iat + 1);
+        size_t icol = login.find(':');
+        req.user = login.substr(0, icol);
+        req.pass = icol == string::npos ? "" : login.substr(icol + 1);
+    }
+    req.port = 21;
+    size_t icol = auth.rfind(':');
+    if (icol != string::npos && auth.find(']') == string::npos)
+    {
+        req.port = atoi(auth.c_str() + icol + 1);
+        auth = auth.substr(0, icol);
+    }
+    req.host = auth;
+    if (req.host.empty() || req.port <= 0) return false;
+
+    req.pats.clear();
+    if (!accept.empty())
+    {
+        StringUtil str;
+        str.GetSubStr(accept, ",", req.pats);
+        while (path.size() > 1 && path.back() == '/') path.pop_back();
+        req.dir = path;
+        req.wild = true;
+    }
+    else
+    {
+        ipos = path.find_last_of('/');
+        if (ipos + 1 >= path.size()) return false;
+        req.dir = ipos == 0 ? "/" : path.substr(0, ipos);
+        req.pats.push_back(path.substr(ipos + 1));
+        req.wild = false;
+    }
+
+    /* the directories of the remote path kept after '--cut-dirs=N' */
+    req.local = "";
+    std::istringstream dss(req.dir);
+    string sub;
+    int k = 0;
+    while (std::getline(dss, sub, '/'))
+    {
+        if (sub.empty() || k++ < cutDirs) continue;
+        req.local += (req.local.empty() ? "" : "/") + sub;
+    }
+
+    return true;
+} /* end of Parse */
+
+/**
+* @brief   : Drop - close a session
+* @param[I/O]: s (session)
+* @param[I]: quit (whether QUIT is sent)
+* @return  : none
+* @note    :
+**/
+void FtpClient::Drop(session_t &s, bool quit)
+{
+    if (s.sock < 0) return;
+    if (quit) SendAll(s.sock, "QUIT\r\n");
+    CloseSock(s.sock);
+    s.sock = -1;
+    s.buff.clear();
+} /* end of Drop */
+
+/**
+* @brief   : Reply - read one (multi-line) reply
+* @param[I/O]: s (session)
+* @param[O]: text (text of the reply)
+* @return  : reply code, -1: no answer
+* @note    :
+**/
+int FtpClient::Reply(session_t &s, string &text)
+{
+    text = "";
+    while (true)
+    {
+        /* 'ddd text' or 'ddd-text' ... 'ddd text' */
+        size_t eol = s.buff.find('\n');
+        if (eol != string::npos)
+        {
+            if (eol < 3 || !isdigit((unsigned char)s.buff[0]) || !isdigit((unsigned char)s.buff[1]) ||
+                !isdigit((unsigned char)s.buff[2])) return -1;
+            string last = s.buff.substr(0, 3) + " ";
+            size_t end = eol;
+            if (s.buff[3] == '-')
+            {
+                end = string::npos;
+                for (size_t p = eol + 1; p < s.buff.size(); )
+                {
+                    size_t e = s.buff.find('\n', p);
+                    if (e == string::npos) break;
+                    if (s.buff.compare(p, 4, last) == 0)
+                    {
+                        end = e;
+                        break;
+                    }
+                    p = e + 1;
+                }
+            }
+            if (end != string::npos)
+            {
+                text = s.buff.substr(0, end + 1);
+                s.buff.erase(0, end + 1);
+
+                return atoi(text.substr(0, 3).c_str());
+            }
+        }
+
+        char buf[4096];
+        if (!Wait(s.sock, false, _timeout)) return -1;
+        int n = (int)recv(s.sock, buf, sizeof(buf), 0);
+        if (n <= 0) return -1;
+        s.buff.append(buf, n);
+    }
+} /* end of Reply */
+
+/**
+* @brief   : Open - the session of a request, logged in once and kept alive
+* @param[I]: req (request)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: fresh (true: a new session, false: a kept one)
+* @param[O]: code (the FTP reply code of a failure, -1: no answer)
+* @return  : the session, nullptr: failed
+* @note    : USER, PASS and TYPE are sent in one go
+**/
+FtpClient::session_t *FtpClient::Open(const request_t &req, bool &fresh, int &code, FILE *fpLog)
+{
+    string key = req.user + "@" + req.host + ":" + to_string(req.port);
+    auto it = _sessions.find(key);
+    if (it == _sessions.end())
+    {
+        session_t s0;
+        s0.sock = -1;
+        s0.pid = Pid();
+        it = _sessions.insert(std::make_pair(key, s0)).first;
+    }
+    session_t &s = it->second;
+    if (s.pid != Pid()) Drop(s, false);  /* the session of the parent process, left to it */
+    fresh = s.sock < 0;
+    if (!fresh)
+    {
+        _nreuse++;
+
+        return &s;
+    }
+
+    s.pid = Pid();
+    s.host = req.host;
+    s.epsv = s.mlsd = true;
+    s.buff.clear();
+    s.sock = Connect(req.host, req.port, _connTimeout);
+    code = -1;
+    if (s.sock < 0)
+    {
+        if (fpLog) fprintf(fpLog, "* WARNING(FtpClient): unable to connect to %s:%d\n", req.host.c_str(), req.port);
+
+        return nullptr;
+    }
+    string text;
+    code = Reply(s, text);
+    if (code != 220)
+    {
+        Drop(s, false);
+
+        return nullptr;
+    }
+
+    /* USER answered by 230 needs no PASS, the latter being refused by 503 */
+    if (!SendAll(s.sock, "USER " + req.user + "\r\nPASS " + req.pass + "\r\nTYPE I\r\n"))
+    {
+        code = -1;
+        Drop(s, false);
+
+        return nullptr;
+    }
+    int cuser = Reply(s, text), cpass = Reply(s, text), ctype = Reply(s, text);
+    code = cuser == 230 ? ctype : (cuser == 331 && (cpass == 230 || cpass == 202) ? ctype : (cuser == 331 ? cpass : cuser));
+    if (code != 200)
+    {
+        if (fpLog) fprintf(fpLog, "* WARNING(FtpClient): login to %s as %s failed (reply %d)\n", req.host.c_str(),
+            req.user.c_str(), code);
+        Drop(s, code >= 0);
+
+        return nullptr;
+    }
+    _nlogin++;
+
+    return &s;
+} /* end of Open */
+
+/**
+* @brief   : Transfer - run a command over a passive data connection
+* @param[I/O]: s (session)
+* @param[I]: cmd (command, i.e., 'RETR /pub/a.gz' or 'MLSD /pub')
+* @param[O]: fp (file of the data, nullptr: to 'text')
+* @param[O]: text (the data, if 'fp' is nullptr)
+* @param[O]: nbyte (bytes received)
+* @return  : the final reply code, i.e., 226, -1: no answer or a broken transfer
+* @note    : EPSV (or PASV) and the command are sent in one go
+**/
+int FtpClient::Transfer(session_t &s, const string &cmd, FILE *fp, string *text, long long &nbyte)
+{
+    nbyte = 0;
+    if (text) *text = "";
+    if (!SendAll(s.sock, string(s.epsv ? "EPSV" : "PASV") + "\r\n" + cmd + "\r\n")) return -1;
+    string reply;
+    int code = Reply(s, reply), port = -1;
+    if (code < 0) return -1;
+    if (s.epsv && code == 229)
+    {
+        /* '229 Entering Extended Passive Mode (|||port|)' */
+        size_t ipos = reply.find("|||");
+        if (ipos != string::npos) port = atoi(reply.c_str() + ipos + 3);
+    }
+    else if (!s.epsv && code == 227)
+    {
+        /* '227 Entering Passive Mode (h1,h2,h3,h4,p1,p2)', the address being that of the control connection */
+        int h[6];
+        size_t ipos = reply.find_first_of("0123456789", 4);
+        if (ipos != string::npos && sscanf(reply.c_str() + ipos, "%d,%d,%d,%d,%d,%d", h, h + 1, h + 2, h + 3, h + 4, h + 5) == 6)
+            port = h[4] * 256 + h[5];
+    }
+    if (port <= 0)
+    {
+        /* the command sent with it is refused without a data connection, i.e., by 425 */
+        if (Reply(s, reply) < 0) return -1;
+        if (s.epsv && code >= 500)
+        {
+            s.epsv = false;
+
+            return Transfer(s, cmd, fp, text, nbyte);
+        }
+
+        return code >= 400 ? code : -1;
+    }
+
+    intptr_t data = Connect(s.host, port, _connTimeout);
+    if (data < 0) return -1;
+    code = Reply(s, reply);
+    if (code != 150 && code != 125)
+    {
+        CloseSock(data);
+
+        return code;
+    }
+
+    double t0 = Now(), tw = t0;
+    long long bw = 0;
+    char buf[65536];
+    bool broken = false;
+    while (true)
+    {
+        if (!Wait(data, false, _timeout))
+        {
+            broken = true;
+            break;
+        }
+        int n = (int)recv(data, buf, sizeof(buf), 0);
+        if (n == 0) break;
+        if (n < 0 || (fp && fwrite(buf, 1, n, fp) != (size_t)n))
+        {
+            broken = true;
+            break;
+        }
+        if (text) text->append(buf, n);
+        nbyte += n;
+
+        /* the deadline and the average speed over the window */
+        double t = Now();
+        if (_deadline > 0 && t - t0 > _deadline)
+        {
+            broken = true;
+            break;
+        }
+        if (t - tw >= _lowSpeedWin)
+        {
+            if (_lowSpeed > 0.0 && (nbyte - bw) / (t - tw) < _lowSpeed)
+            {
+                broken = true;
+                break;
+            }
+            tw = t;
+            bw = nbyte;
+        }
+    }
+    CloseSock(data);
+    if (broken) return -1;
+
+    return Reply(s, reply);
+} /* end of Transfer */
+
+/**
+* @brief   : List - list a remote directory
+* @param[I/O]: s (session)
+* @param[I]: dir (remote directory)
+* @param[O]: ents (entries)
+* @return  : the final reply code, i.e., 226, -1: no answer
+* @note    : MLSD, or LIST (without the modification times) if MLSD is not answered
+**/
+int FtpClient::List(session_t &s, const string &dir, std::vector<ftpent_t> &ents)
+{
+    ents.clear();
+    string text, line;
+    long long nbyte = 0;
+    int code;
+    if (s.mlsd)
+    {
+        code = Transfer(s, "MLSD " + dir, nullptr, &text, nbyte);
+        if (code == 500 || code == 502 || code == 504) s.mlsd = false;  /* not implemented */
+        else
+        {
+            if (code < 200 || code >= 300) return code;
+
+            /* 'type=file;size=1234;modify=20240201123456; name' */
+            std::istringstream iss(text);
+            while (std::getline(iss, line))
+            {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                size_t ipos = line.find(' ');
+                if (ipos == string::npos) continue;
+                ftpent_t e;
+                e.name = line.substr(ipos + 1);
+                e.size = -1;
+                e.mtime = 0;
+                e.dir = false;
+                string facts = line.substr(0, ipos), fact;
+                std::istringstream fss(facts);
+                bool skip = false;
+                while (std::getline(fss, fact, ';'))
+                {
+                    size_t ieq = fact.find('=');
+                    if (ieq == string::npos) continue;
+                    string k = fact.substr(0, ieq), v = fact.substr(ieq + 1);
+                    std::transform(k.begin(), k.end(), k.begin(), ::tolower);
+                    std::transform(v.begin(), v.end(), v.begin(), ::tolower);
+                    if (k == "type")
+                    {
+                        e.dir = v == "dir";
+                        skip = v == "cdir" || v == "pdir";
+                    }
+                    else if (k == "size") e.size = atoll(v.c_str());
+                    else if (k == "modify") e.mtime = Epoch(v);
+                }
+                if (!skip && !e.name.empty()) ents.push_back(e);
+            }
+
+            return code;
+        }
+    }
+
+    /* '-rw-r--r-- 1 ftp ftp 1234 Feb 01 12:34 name' */
+    code = Transfer(s, "LIST " + dir, nullptr, &text, nbyte);
+    if (code < 200 || code >= 300) return code;
+    std::istringstream iss(text);
+    while (std::getline(iss, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || (line[0] != '-' && line[0] != 'd')) continue;
+        std::istringstream lss(line);
+        string tok;
+        int k = 0;
+        ftpent_t e;
+        e.size = -1;
+        e.mtime = 0;
+        e.dir = line[0] == 'd';
+        while (k < 8 && lss >> tok)
+        {
+            if (k++ == 4) e.size = atoll(tok.c_str());
+        }
+        std::streamoff ipos = lss.tellg();
+        if (k < 8 || ipos < 0 || (size_t)ipos + 1 >= line.size()) continue;
+        e.name = line.substr(ipos + 1);
+        if (e.name != "." && e.name != "..") ents.push_back(e);
+    }
+
+    return code;
+} /* end of List */
+
+/**
+* @brief   : Get - download one file
+* @param[I/O]: s (session)
+* @param[I]: path (remote path)
+* @param[I]: file (local file)
+* @param[I]: size (remote size, -1: unknown)
+* @param[I]: mtime (remote modification time, 0: unknown)
+* @return  : the final reply code, i.e., 226, -1: no answer or a broken transfer
+* @note    : a local file of the same size and modification time is up to date and not downloaded; the file is
+*            written to 'file.part' and renamed when complete, with the remote modification time
+**/
+int FtpClient::Get(session_t &s, const string &path, const string &file, long long size, long long mtime)
+{
+    struct stat st;
+    if (size >= 0 && mtime > 0 && stat(file.c_str(), &st) == 0 && (long long)st.st_size == size &&
+        (long long)st.st_mtime == mtime)
+    {
+        _nskip++;
+
+        return 226;
+    }
+
+    string part = file + FTP_PART_SUFFIX;
+    FILE *fp = fopen(part.c_str(), "wb");
+    if (!fp)
+    {
+        cerr << "*** ERROR(FtpClient::Get): open the file " << part << " FAILED!" << endl;
+
+        return 553;
+    }
+    long long nbyte = 0;
+    int code = Transfer(s, "RETR " + path, fp, nullptr, nbyte);
+    fclose(fp);
+    if (code >= 200 && code < 300 && size >= 0 && nbyte != size) code = -1;  /* truncated */
+    if (code < 200 || code >= 300)
+    {
+        remove(part.c_str());
+
+        return code;
+    }
+    remove(file.c_str());
+    rename(part.c_str(), file.c_str());
+    if (mtime > 0)
+    {
+        struct utimbuf ut;
+        ut.actime = ut.modtime = (time_t)mtime;
+        utime(file.c_str(), &ut);
+    }
+    _nfile++;
+    _bytes += nbyte;
+
+    return code;
+} /* end of Get */
+
+/**
+* @brief   : Do - one try of a request on a session
+* @param[I/O]: s (session)
+* @param[I]: req (request)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: rc (the FTP reply code, -1: no answer)
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT
+* @note    : as 'wget -r -nH --cut-dirs=N', the files go to the local directory of the request, and the listing
+*            is written to '.listing' there in the format of 'ls -l'
+**/
+int FtpClient::Do(session_t &s, const request_t &req, int &rc, FILE *fpLog)
+{
+    string local = req.local.empty() ? "." : req.local;
+    if (!req.local.empty()) MkDirs(req.local);
+    string base = req.dir == "/" ? "" : req.dir;
+
+    if (!req.wild)
+    {
+        /* the size and the modification time of the file asked for in one go */
+        string path = base + "/" + req.pats[0], text;
+        if (!SendAll(s.sock, "SIZE " + path + "\r\nMDTM " + path + "\r\n"))
+        {
+            rc = -1;
+
+            return WGET_TRANSIENT;
+        }
+        int csize = Reply(s, text);
+        long long size = csize == 213 ? atoll(text.c_str() + 4) : -1;
+        int cmdtm = Reply(s, text);
+        long long mtime = cmdtm == 213 ? Epoch(text.substr(4)) : 0;
+        if (csize < 0 || cmdtm < 0)
+        {
+            rc = -1;
+
+            return WGET_TRANSIENT;
+        }
+        if (csize == 550 || csize == 421)
+        {
+            rc = csize;
+
+            return Classify(rc);
+        }
+        rc = Get(s, path, local + "/" + req.pats[0], size, mtime);
+
+        return Classify(rc);
+    }
+
+    /* the listing of the directory, kept for the next requests */
+    string key = req.host + ":" + to_string(req.port) + req.dir;
+    auto it = _listings.find(key);
+    if (it == _listings.end() || Now() - it->second.t > FTP_LIST_TTL)
+    {
+        listing_t l;
+        rc = List(s, req.dir, l.ents);
+        if (rc < 200 || rc >= 300) return Classify(rc);
+        l.t = Now();
+        _listings[key] = l;
+        it = _listings.find(key);
+        _nlist++;
+    }
+    const std::vector<ftpent_t> &ents = it->second.ents;
+
+    /* the listing in the format of 'ls -l', as kept by 'wget --no-remove-listing' */
+    string listFile = local + "/" + LISTING_FILE;
+    FILE *fp = fopen(listFile.c_str(), "w");
+    if (fp)
+    {
+        static const char *mons[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        time_t now = time(nullptr);
+        for (int i = 0; i < ents.size(); i++)
+        {
+            time_t t = (time_t)ents[i].mtime;
+            struct tm *tm = gmtime(&t);
+            char stamp[32] = "Jan 01  1970";
+            if (tm)
+            {
+                if (now - t < 180 * 86400L && t <= now)
+                    sprintf(stamp, "%s %02d %02d:%02d", mons[tm->tm_mon], tm->tm_mday, tm->tm_hour, tm->tm_min);
+                else sprintf(stamp, "%s %02d  %04d", mons[tm->tm_mon], tm->tm_mday, tm->tm_year + 1900);
+            }
+            fprintf(fp, "%s 1 ftp ftp %lld %s %s\r\n", ents[i].dir ? "drwxr-xr-x" : "-rw-r--r--",
+                ents[i].size >= 0 ? ents[i].size : 0LL, stamp, ents[i].name.c_str());
+        }
+        fclose(fp);
+    }
+
+    /* the files matching the accept patterns, as by 'wget -A' a pattern without wildcards being a suffix */
+    StringUtil str;
+    rc = 226;
+    for (int i = 0; i < ents.size(); i++)
+    {
+        const ftpent_t &e = ents[i];
+        if (e.dir) continue;
+        bool match = false;
+        for (int j = 0; j < req.pats.size() && !match; j++)
+        {
+            const string &pat = req.pats[j];
+            bool wild = pat.find_first_of("*?[") != string::npos;
+            match = wild ? str.WildMatch(pat.c_str(), e.name.c_str()) :
+                (e.name.size() >= pat.size() && e.name.compare(e.name.size() - pat.size(), pat.size(), pat) == 0);
+        }
+        if (!match) continue;
+        rc = Get(s, base + "/" + e.name, local + "/" + e.name, e.size, e.mtime);
+        if (rc < 200 || rc >= 300)
+        {
+            if (fpLog) fprintf(fpLog, "* WARNING(FtpClient): %s%s/%s failed (reply %d)\n", req.host.c_str(), base.c_str(),
+                e.name.c_str(), rc);
+
+            return Classify(rc);
+        }
+    }
+
+    return WGET_OK;
+} /* end of Do */
+
+/**
+* @brief   : Once - one try of a request
+* @param[I]: req (request)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: rc (the FTP reply code, -1: no answer)
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT
+* @note    : a kept session closed by the server while idle is opened again
+**/
+int FtpClient::Once(const request_t &req, int &rc, FILE *fpLog)
+{
+    for (int k = 0; k < 2; k++)
+    {
+        bool fresh = false;
+        session_t *s = Open(req, fresh, rc, fpLog);
+        if (!s) return Classify(rc);
+        int stat = Do(*s, req, rc, fpLog);
+        if (rc >= 0 && rc != 421) return stat;
+
+        /* the connection is lost, or closed by the server (421) */
+        Drop(*s, false);
+        if (fresh) return stat;
+    }
+
+    return WGET_TRANSIENT;
+} /* end of Once */
+
+/**
+* @brief   : Set - set the client
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : the sessions are kept
+**/
+void FtpClient::Set(const ftpopt_t *fopt)
+{
+    _on = fopt->ftpSession;
+    _timeout = fopt->timeout > 0 ? fopt->timeout : 900;  /* the read timeout of 'wget' */
+    _connTimeout = fopt->connTimeout > 0 ? fopt->connTimeout : _timeout;
+    _deadline = fopt->deadline > 0 ? fopt->deadline : 0;
+    _lowSpeed = fopt->lowSpeed > 0.0 ? fopt->lowSpeed : 0.0;
+    _lowSpeedWin = fopt->lowSpeedWin > 0 ? fopt->lowSpeedWin : 60;
+} /* end of Set */
+
+/**
+* @brief   : Run - run a 'wget' command of a plain FTP URL natively, with the retries of transient failures
+* @param[I]: cmd ('wget' command)
+* @param[I]: retry (retry policy of the 'wget' commands)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED, -1: not taken, left to 'wget'
+* @note    :
+**/
+int FtpClient::Run(const string &cmd, RetryPolicy &retry, FILE *fpLog)
+{
+    request_t req;
+    if (!_on || !Parse(cmd, req)) return -1;
+
+    return retry.Run(req.host, [&](int &rc) { return Once(req, rc, fpLog); }, fpLog);
+} /* end of Run */
+
+/**
+* @brief   : Close - log out of all the sessions of this process
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpClient::Close()
+{
+    for (auto it = _sessions.begin(); it != _sessions.end(); ++it)
+        Drop(it->second, it->second.pid == Pid());
+} /* end of Close */
+
+/**
+* @brief   : Report - report the logins, the listings and the files
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the requests of the concurrent jobs are counted in their own processes
+**/
+void FtpClient::Report(FILE *fpLog) const
+{
+    if (_nlogin == 0) return;
+
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d FTP logins serving %d more requests, %d listings, %d files downloaded (%.1f MB), %d up to date",
+        _nlogin, _nreuse, _nlist, _nfile, _bytes / 1048576.0, _nskip);
+    cout << "*** INFO(FtpClient::Report): " << buff << endl;
+
+    if (fpLog) fprintf(fpLog, "* INFO(FtpClient): %s\n", buff);
+} /* end of Report */
\ No newline at end of file
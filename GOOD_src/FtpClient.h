@@ -0,0 +1,210 @@
+/*------------------------------------------------------------------------------
+* FtpClient.h : header file of FtpClient.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+#include <cstdint>
+
+#define FTP_PART_SUFFIX ".part"          /* suffix of a file being downloaded */
+#define FTP_LIST_TTL    300              /* max age of a remote listing reused within a run (s) */
+
+struct ftpent_t
+{                                         /* one entry of a remote directory */
+    string name;                          /* name */
+    long long size;                       /* size (bytes), -1: unknown */
+    long long mtime;                      /* modification time (s since 1970-01-01 UTC), 0: unknown */
+    bool dir;                             /* whether a directory */
+};
+
+class RetryPolicy;
+
+class FtpClient
+{
+private:
+    struct session_t
+    {                                     /* one control connection, logged in */
+        intptr_t sock;                    /* socket, -1: closed */
+        int pid;                          /* process that opened it, so that the jobs forked by the job pool open their own */
+        string host;                      /* host, for the data connections */
+        bool epsv;                        /* whether EPSV is answered, else PASV */
+        bool mlsd;                        /* whether MLSD is answered, else LIST */
+        string buff;                      /* the replies received and not read yet */
+    };
+
+    struct listing_t
+    {                                     /* one remote listing */
+        double t;                         /* time of the listing (s) */
+        std::vector<ftpent_t> ents;       /* the entries */
+    };
+
+    struct request_t
+    {                                     /* one 'wget' command */
+        string host;                      /* host */
+        int port;                         /* port */
+        string user, pass;                /* login, 'anonymous' if not in the URL */
+        string dir;                       /* remote directory, i.e., '/pub/igs/data/2024/032' */
+        std::vector<string> pats;         /* accept patterns of '-A', or the name of the file */
+        bool wild;                        /* true: the files of the listing matching 'pats', false: one file */
+        string local;                     /* local directory as by '-nH --cut-dirs=N', "": the current one */
+    };
+
+    std::map<string, session_t> _sessions;  /* sessions kept alive, key: 'user@host:port' */
+    std::map<string, listing_t> _listings;  /* remote listings, key: 'host:port/dir' */
+    bool _on;                             /* (0:off  1:on) */
+    int _timeout;                         /* network timeout (s) */
+    int _connTimeout;                     /* connect timeout (s) */
+    int _deadline;                        /* total deadline of one transfer (s), 0: off */
+    double _lowSpeed;                     /* min average speed (B/s) over '_lowSpeedWin', 0: off */
+    int _lowSpeedWin;                     /* window of the average speed (s) */
+    int _nlogin, _nreuse, _nlist, _nfile, _nskip;  /* numbers of the logins, of the requests on a kept session, of
+                                             the listings, of the files downloaded and of those up to date */
+    long long _bytes;                     /* bytes downloaded */
+
+    /**
+    * @brief   : Parse - the request of a 'wget' command
+    * @param[I]: cmd ('wget' command)
+    * @param[O]: req (request)
+    * @return  : true: a request of a plain FTP URL this client takes, false: left to 'wget'
+    * @note    : only the options of GOOD ('-r', '-nH', '--cut-dirs=N', '-A', the timeouts and the messages) are taken;
+    *            any other, i.e., '-O', leaves the command to 'wget'
+    **/
+    static bool Parse(const string &cmd, request_t &req);
+
+    /**
+    * @brief   : Open - the session of a request, logged in once and kept alive
+    * @param[I]: req (request)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: fresh (true: a new session, false: a kept one)
+    * @param[O]: code (the FTP reply code of a failure, -1: no answer)
+    * @return  : the session, nullptr: failed
+    * @note    : USER, PASS and TYPE are sent in one go
+    **/
+    session_t *Open(const request_t &req, bool &fresh, int &code, FILE *fpLog);
+
+    /**
+    * @brief   : Drop - close a session
+    * @param[I/O]: s (session)
+    * @param[I]: quit (whether QUIT is sent)
+    * @return  : none
+    * @note    :
+    **/
+    static void Drop(session_t &s, bool quit);
+
+    /**
+    * @brief   : Reply - read one (multi-line) reply
+    * @param[I/O]: s (session)
+    * @param[O]: text (text of the reply)
+    * @return  : reply code, -1: no answer
+    * @note    :
+    **/
+    int Reply(session_t &s, string &text);
+
+    /**
+    * @brief   : Transfer - run a command over a passive data connection
+    * @param[I/O]: s (session)
+    * @param[I]: cmd (command, i.e., 'RETR /pub/a.gz' or 'MLSD /pub')
+    * @param[O]: fp (file of the data, nullptr: to 'text')
+    * @param[O]: text (the data, if 'fp' is nullptr)
+    * @param[O]: nbyte (bytes received)
+    * @return  : the final reply code, i.e., 226, -1: no answer or a broken transfer
+    * @note    : EPSV (or PASV) and the command are sent in one go
+    **/
+    int Transfer(session_t &s, const string &cmd, FILE *fp, string *text, long long &nbyte);
+
+    /**
+    * @brief   : List - list a remote directory
+    * @param[I/O]: s (session)
+    * @param[I]: dir (remote directory)
+    * @param[O]: ents (entries)
+    * @return  : the final reply code, i.e., 226, -1: no answer
+    * @note    : MLSD, or LIST (without the modification times) if MLSD is not answered
+    **/
+    int List(session_t &s, const string &dir, std::vector<ftpent_t> &ents);
+
+    /**
+    * @brief   : Get - download one file
+    * @param[I/O]: s (session)
+    * @param[I]: path (remote path)
+    * @param[I]: file (local file)
+    * @param[I]: size (remote size, -1: unknown)
+    * @param[I]: mtime (remote modification time, 0: unknown)
+    * @return  : the final reply code, i.e., 226, -1: no answer or a broken transfer
+    * @note    : a local file of the same size and modification time is up to date and not downloaded; the file is
+    *            written to 'file.part' and renamed when complete, with the remote modification time
+    **/
+    int Get(session_t &s, const string &path, const string &file, long long size, long long mtime);
+
+    /**
+    * @brief   : Once - one try of a request
+    * @param[I]: req (request)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: rc (the FTP reply code, -1: no answer)
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT
+    * @note    : a kept session closed by the server while idle is opened again
+    **/
+    int Once(const request_t &req, int &rc, FILE *fpLog);
+
+    /**
+    * @brief   : Do - one try of a request on a session
+    * @param[I/O]: s (session)
+    * @param[I]: req (request)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: rc (the FTP reply code, -1: no answer)
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT
+    * @note    : as 'wget -r -nH --cut-dirs=N', the files go to the local directory of the request, and the listing
+    *            is written to '.listing' there in the format of 'ls -l'
+    **/
+    int Do(session_t &s, const request_t &req, int &rc, FILE *fpLog);
+
+public:
+    FtpClient()
+    {
+        _on = false;
+        _timeout = _connTimeout = _deadline = _lowSpeedWin = 0;
+        _lowSpeed = 0.0;
+        _nlogin = _nreuse = _nlist = _nfile = _nskip = 0;
+        _bytes = 0;
+    }
+    ~FtpClient()
+    {
+        Close();
+    }
+
+    /**
+    * @brief   : Set - set the client
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the sessions are kept
+    **/
+    void Set(const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Run - run a 'wget' command of a plain FTP URL natively, with the retries of transient failures
+    * @param[I]: cmd ('wget' command)
+    * @param[I]: retry (retry policy of the 'wget' commands)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED, -1: not taken, left to 'wget'
+    * @note    :
+    **/
+    int Run(const string &cmd, RetryPolicy &retry, FILE *fpLog);
+
+    /**
+    * @brief   : Close - log out of all the sessions of this process
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Close();
+
+    /**
+    * @brief   : Report - report the logins, the listings and the files
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the requests of the concurrent jobs are counted in their own processes
+    **/
+    void Report(FILE *fpLog) const;
+};
@@ -80,11 +80,48 @@
 *           2022/08/01      modify the main function "run_GOOD.cpp" for better adaptation to Windows and Linux, as well as debug and release modes (by Feng Zhou @ SDUST)
 *           2022/09/03      delete the options for selecting sub-directory in relative or absolute path (by Feng Zhou @ SDUST)
 *           2022/10/09      the addition of downloading MGEX prodcuts from Russia Information and Analysis Center (IAC), Japan Aerospace Exploration Agency (JAXA), and Shanghai Observatory (SHAO) (by Feng Zhou @ SDUST)
+*           2026/10/18      gather all the 'crx2rnx' conversions into "Crx2Rnx" and add the option "obsStore" for the columnar binary store
+*                             of decoded observations
+*           2026/10/18      add the option "mergeNav" for merging the site-specific hourly broadcast ephemeris files
+*           2026/10/18      add the options "obsSys" and "obsTypes" for filtering systems and observation types in "Crx2Rnx"
+*           2026/10/18      add the option "obsFrame" for keeping observations compressed at rest with a frame index
+*           2026/10/18      add the option "obsCheck" for checking the converted observation files
+*           2026/10/18      record the throughput of each product and keep the remote listings for the estimate of "JobPlan"
+*           2026/10/18      add the options "maxJobs" and "maxJobsHost" for downloading the analysis centers concurrently
+*           2026/10/18      add the fallback chains of analysis centers (i.e., "cod>gfz_m>igs_r>igs_u") for the precise products
+*           2026/10/18      add the option "leaseDir" for distributing the (day, product, site) jobs over several nodes
+*           2026/10/18      add the option "priority" for downloading the latency-critical products before the bulk ones
+*           2026/10/18      add the option "retryPolicy" for retrying the transient failures with backoff and pausing the failing hosts
+*           2026/10/18      add the option "watchdog" for aborting the stalled transfers
+*           2026/10/18      the union of "igm" and "pbo5" for 'all' is planned from the remote listing, each site being downloaded once
+*           2026/10/18      add the option "ngsS3" for listing and downloading the NGS/NOAA CORS observations via the S3 API
+*           2026/10/18      add the option "manifest" for verifying the downloads against the checksum manifests of the archives
+*           2026/10/18      add the option "refresh" for downloading the mutable products again only when their remote copies change
+*           2026/10/18      add the options "missCache", "missDays" and "missTtl" for not asking for the remote files known to be missing
+*           2026/10/18      add the option "longName" for asking for the RINEX 3 files of the sites by their long names without a listing
+*           2026/10/18      add the option "http2" for fetching the hourly and high-rate observations of the HTTPS archives over HTTP/2
+*           2026/10/18      add the option "ftpSession" for fetching the files of the plain FTP archives over native sessions kept alive
+*           2026/10/18      add the option "maxProcs" for running the external tools without a shell, several at once
+*           2026/10/18      add the option "journal" for resuming a run where it stopped, the jobs done being skipped
 *-----------------------------------------------------------------------------*/
 #include "GOOD.h"
 #include "TimeUtil.h"
 #include "StringUtil.h"
 #include "FtpUtil.h"
+#include "RnxUtil.h"
+#include "NavUtil.h"
+#include "ObsStore.h"
+#include "ObsArchive.h"
+#include "ObsCheck.h"
+#include "JobPlan.h"
+#include "JobPool.h"
+#include "WorkLease.h"
+#include "HttpPool.h"
+#include "S3Client.h"
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
 
 
 /* constants/macros ----------------------------------------------------------*/
@@ -190,6 +227,469 @@ void FtpUtil::init()
     _ftpArchive.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/troposphere/new");                 /* IGS final tropospheric product files */
 } /* end of init */
 
+/**
+* @brief   : AcHost - the host of the precise orbit and clock products of an analysis center
+* @param[I]: ac (analysis center, i.e., 'igs', 'cod_r', 'esa_u', et al.)
+* @param[I]: archive (FTP archive, i.e., "CDDIS", "IGN" or "WHU")
+* @param[O]: none
+* @return  : host
+* @note    : the products not on their own servers are on the FTP archive
+**/
+string FtpUtil::AcHost(const string &ac, const string &archive)
+{
+    if (ac == "cnt") return "CNES";                         /* www.ppp-wizard.net */
+    else if (ac == "cod_r") return "AIUB";                  /* ftp.aiub.unibe.ch */
+    else if (ac == "emr_r") return "NRCAN";                 /* rtopsdata1.geod.nrcan.gc.ca */
+    else if (ac == "esa_r" || ac == "esa_u") return "ESA";  /* navigation-office.esa.int */
+    else if (ac == "gfz_r" || ac == "gfz_u") return "GFZ";  /* ftp.gfz-potsdam.de */
+
+    return archive;
+} /* end of AcHost */
+
+/**
+* @brief   : OrbClkType - the product type of the precise orbit and clock products of an analysis center
+* @param[I]: ac (analysis center, i.e., 'igs', 'cod_r', 'esa_u', et al.)
+* @param[O]: none
+* @return  : product type (PROD_REALTIME, ..., PROD_FINAL_MGEX), 0: unknown analysis center
+* @note    :
+**/
+int FtpUtil::OrbClkType(const string &ac)
+{
+    /* cnt: CNES real-time orbit and clock products from CNES offline files */
+    if (ac == "cnt") return PROD_REALTIME;
+
+    /* esa_u: ESA ultra-rapid orbit and clock products
+       gfz_u: GFZ ultra-rapid orbit and clock products
+       igs_u: IGS ultra-rapid orbit and clock products
+       whu_u: WHU ultra-rapid orbit and clock products
+    */
+    std::vector<string> ultraAc = { "esa_u", "gfz_u", "igs_u", "whu_u" };
+    if (find(ultraAc.begin(), ultraAc.end(), ac) != ultraAc.end()) return PROD_ULTRA_RAPID;
+
+    /* cod_r: CODE rapid orbit and clock products
+       emr_r: NRCan rapid orbit and clock products
+       esa_r: ESA rapid orbit and clock products
+       gfz_r: GFZ rapid orbit and clock products
+       igs_r: IGS rapid orbit and clock products
+    */
+    std::vector<string> rapidAc = { "cod_r", "emr_r", "esa_r", "gfz_r", "igs_r" };
+    if (find(rapidAc.begin(), rapidAc.end(), ac) != rapidAc.end()) return PROD_RAPID;
+
+    /* cod: CODE final orbit and clock products
+       emr: NRCan final orbit and clock products
+       esa: ESA final orbit and clock products
+       gfz: GFZ final orbit and clock products
+       grg: CNES final orbit and clock products
+       igs: IGS final orbit and clock products
+       jpl: JPL final orbit and clock products
+       mit: MIT final orbit and clock products
+    */
+    std::vector<string> finalAcIGS = { "cod", "emr", "esa", "gfz", "grg", "igs", "jpl", "mit" };
+    if (find(finalAcIGS.begin(), finalAcIGS.end(), ac) != finalAcIGS.end()) return PROD_FINAL_IGS;
+
+    /* cod_m: CODE multi-GNSS final orbit and clock products
+       gfz_m: GFZ multi-GNSS final orbit and clock products
+       grg_m: CNES multi-GNSS final orbit and clock products
+       iac_m: Russia Information and Analysis Center (IAC) multi-GNSS final orbit and clock products
+       jax_m: Japan Aerospace Exploration Agency (JAXA) multi-GNSS final orbit and clock products
+       sha_m: Shanghai Observatory (SHAO) multi-GNSS final orbit and clock products
+       whu_m: Wuhan University (WHU) multi-GNSS final orbit and clock products
+    */
+    std::vector<string> acMGEX = { "cod_m", "gfz_m", "grg_m", "iac_m", "jax_m", "sha_m", "whu_m" };
+    if (find(acMGEX.begin(), acMGEX.end(), ac) != acMGEX.end()) return PROD_FINAL_MGEX;
+
+    return 0;
+} /* end of OrbClkType */
+
+/**
+* @brief   : TryChain - try the analysis centers of a fallback chain in order and stop at the first available one
+* @param[I]: chain (analysis centers separated by '>', i.e., "cod>gfz_m>igs_r>igs_u", or only one)
+* @param[I]: prod (product, for the log)
+* @param[I]: get (the downloading routine of one analysis center)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : the analysis center used, "": none of them is available
+* @note    : an analysis center is available when all of its files exist or are downloaded, i.e., no file failed;
+*            each unavailable one costs only the remote listing of its 'wget -A' pattern, nothing is transferred,
+*            and its misses are forgiven once another one is available
+**/
+string FtpUtil::TryChain(const string &chain, const string &prod, std::function<void(const string &ac)> get, FILE *fpLog)
+{
+    StringUtil str;
+    std::vector<string> acs;
+    if ((int)chain.find_first_of('>') > 0) str.GetSubStr(chain, ">", acs);
+    else acs.push_back(chain);
+    int nmiss0 = _nmiss;
+    for (int i = 0; i < acs.size(); i++)
+    {
+        string ac = acs[i];
+        str.TrimSpace4String(ac);
+        int nmiss = _nmiss;
+        get(ac);
+        if (_nmiss > nmiss) continue;
+
+        if (acs.size() > 1 && fpLog) fprintf(fpLog, "* INFO(TryChain): %s of %s taken from '%s'\n", prod.c_str(), chain.c_str(), ac.c_str());
+        _nmiss = nmiss0;
+
+        return ac;
+    }
+    if (acs.size() > 1)
+    {
+        cout << "*** WARNING(FtpUtil::TryChain): none of the analysis centers " << chain << " is available for " << prod << endl;
+
+        if (fpLog) fprintf(fpLog, "* WARNING(TryChain): none of %s is available for %s\n", chain.c_str(), prod.c_str());
+    }
+
+    return "";
+} /* end of TryChain */
+
+/**
+* @brief   : Crx2RnxStages - the pipeline converting a Hatanaka-compressed file to a RINEX observation file
+* @param[I]: crxFile (Hatanaka-compressed file, i.e., 'abmf0320.24d', or compressed again, i.e., 'abmf0320.24d.gz')
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : 'crx2rnx -f -', after 'gzip -dc' for a '*.gz' or '*.Z' file, both reading 'crxFile' as the standard input
+* @note    :
+**/
+stages_t FtpUtil::Crx2RnxStages(const string &crxFile, const ftpopt_t *fopt)
+{
+    stages_t stages;
+    size_t ipos = crxFile.find_last_of('.');
+    string ext = ipos == string::npos ? "" : crxFile.substr(ipos);
+    if (ext == ".gz" || ext == ".Z") stages.push_back({ fopt->gzipFull, "-dc" });
+    stages.push_back({ fopt->crx2rnxFull, "-f", "-" });
+
+    return stages;
+} /* end of Crx2RnxStages */
+
+/**
+* @brief   : Crx2Rnx - convert a Hatanaka-compressed ('d' or 'crx') file to a RINEX observation file via 'crx2rnx'
+* @param[I]: crxFile (Hatanaka-compressed file, or compressed again by 'gzip' or 'compress')
+* @param[I]: oFile (RINEX observation file)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : if 'obsSys' or 'obsTypes' is set, only the selected systems and observation types are written while
+*            decoding; if 'obsStore' is on, the output of 'crx2rnx' is also decoded on the fly into a columnar binary
+*            store 'oFile.obc', without reading 'oFile' back; if 'obsFrame' is set, 'oFile.gz' with its frame index
+*            is written instead of 'oFile'
+**/
+void FtpUtil::Crx2Rnx(string crxFile, string oFile, const ftpopt_t *fopt)
+{
+    stages_t stages = Crx2RnxStages(crxFile, fopt);
+    RnxUtil rnx;
+    rnx.SetFilter(fopt->obsSys, fopt->obsTypes);
+    bool filter = rnx.Filtered(), frame = fopt->obsFrame > 0;
+    struct stat st;
+    long long crxBytes = stat(crxFile.c_str(), &st) == 0 ? (long long)st.st_size : 0;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    if (!fopt->obsStore && !filter && !frame)
+    {
+        _procs.Run(stages, crxFile, oFile);
+        _ndecode++;
+        _decodeBytes += crxBytes;
+        _decodeSec += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (fopt->obsCheck) CheckObs(oFile, nullptr, fopt);
+
+        return;
+    }
+
+    FILE *fpIn = _procs.Open(stages, crxFile);
+    if (!fpIn)
+    {
+        cerr << "*** ERROR(FtpUtil::Crx2Rnx): run 'crx2rnx' for " << crxFile << " FAILED!" << endl;
+
+        return;
+    }
+    FILE *fpOut = nullptr;
+    ObsArchive arc;
+    string arcFile = oFile + ARC_SUFFIX;
+    if (frame ? !arc.Open(arcFile.c_str(), fopt->obsFrame) : !(fpOut = fopen(oFile.c_str(), "w")))
+    {
+        cerr << "*** ERROR(FtpUtil::Crx2Rnx): open file " << (frame ? arcFile : oFile) << " FAILED!" << endl;
+        _procs.Close(fpIn);
+
+        return;
+    }
+
+    ObsStore store;
+    ObsCheck chk;
+    char line[MAXRNXLEN];
+    bool ok = true, wok = true;
+    string text;
+    while (fgets(line, MAXRNXLEN, fpIn))
+    {
+        int stat = ok ? rnx.InputLine(line) : RNX_NONE;
+        if (stat == RNX_ERROR)
+        {
+            ok = false;
+            if (filter || frame) break;  /* the output would be incomplete */
+        }
+
+        /* only the selected systems and observation types are written if the filter is set */
+        text.clear();
+        if (!filter) text = line;
+        else if (stat == RNX_ENDHDR) rnx.WriteHeader(text);
+        else if (stat == RNX_EPOCH) rnx.WriteEpoch(text);
+        if (frame)
+        {
+            arc.Write(text);
+            if (stat == RNX_ENDHDR) wok = arc.EndHeader() && wok;
+            else if (stat == RNX_EPOCH) wok = arc.EndEpoch(rnx.Epoch().time) && wok;
+        }
+        else fputs(text.c_str(), fpOut);
+        if (stat == RNX_EPOCH && fopt->obsStore) store.AddEpoch(rnx);
+        if (stat == RNX_ENDHDR) chk.EndHeader();
+        else if (stat == RNX_EPOCH && (rnx.Epoch().flag <= 1 || rnx.Epoch().flag == 6)) chk.InputEpoch(rnx.Epoch().time);
+    }
+    if (frame) wok = ok && arc.Close() && wok;
+    else fclose(fpOut);
+    _procs.Close(fpIn);
+
+    if (ok && fopt->obsStore) store.Write((oFile + OBC_SUFFIX).c_str());
+    if (!ok && fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Crx2Rnx): failed to decode %s, no filtering, %s or %s applied\n",
+        crxFile.c_str(), OBC_SUFFIX, ARC_SUFFIX);
+
+    /* the filtered or compressed file is incomplete, so fall back to the full conversion */
+    if ((!ok && filter) || (frame && !wok))
+    {
+        if (frame)
+        {
+            remove(arcFile.c_str());
+            remove((arcFile + IDX_SUFFIX).c_str());
+        }
+        _procs.Run(stages, crxFile, oFile);
+    }
+    _ndecode++;
+    _decodeBytes += crxBytes;
+    _decodeSec += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    /* the compressed file is checked by what has been decoded, others by scanning 'oFile' */
+    if (fopt->obsCheck) CheckObs(oFile, frame && wok ? &chk : nullptr, fopt);
+} /* end of Crx2Rnx */
+
+/**
+* @brief   : Crx2RnxAll - convert the downloaded Hatanaka-compressed files to RINEX observation files, several at once
+* @param[I]: crxFiles (Hatanaka-compressed files, or compressed again by 'gzip' or 'compress')
+* @param[I]: oFiles (RINEX observation files, one for each)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : up to 'maxProcs' files are converted at once, each by 'gzip -dc | crx2rnx -f -'; a file converted is
+*            removed; if the output of 'crx2rnx' is decoded by GOOD itself (for 'obsSys', 'obsTypes', 'obsStore'
+*            or 'obsFrame'), they are converted one after another by "Crx2Rnx"
+**/
+void FtpUtil::Crx2RnxAll(const std::vector<string> &crxFiles, const std::vector<string> &oFiles, const ftpopt_t *fopt)
+{
+    RnxUtil rnx;
+    rnx.SetFilter(fopt->obsSys, fopt->obsTypes);
+    bool inProc = fopt->obsStore || rnx.Filtered() || fopt->obsFrame > 0;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    std::vector<string> outs;  /* a file compressed by both 'gzip' and 'compress' is converted once */
+    for (int i = 0; i < crxFiles.size(); i++)
+    {
+        const string &crxFile = crxFiles[i], &oFile = oFiles[i];
+        if (access(crxFile.c_str(), 0) == -1 || std::find(outs.begin(), outs.end(), oFile) != outs.end()) continue;
+        outs.push_back(oFile);
+        if (inProc)
+        {
+            Crx2Rnx(crxFile, oFile, fopt);
+            if (ObsExists(oFile, fopt)) remove(crxFile.c_str());
+            continue;
+        }
+
+        struct stat st;
+        long long crxBytes = stat(crxFile.c_str(), &st) == 0 ? (long long)st.st_size : 0;
+        _procs.Start(Crx2RnxStages(crxFile, fopt), crxFile, oFile, [=](int rc)
+        {
+            _ndecode++;
+            _decodeBytes += crxBytes;
+            if (rc != 0 && rc != 2)  /* 2: a warning of 'gzip' or 'crx2rnx' */
+            {
+                remove(oFile.c_str());
+
+                return;
+            }
+            remove(crxFile.c_str());
+            if (fopt->obsCheck) CheckObs(oFile, nullptr, fopt);
+        });
+    }
+    _procs.Wait();
+    if (!inProc) _decodeSec += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+} /* end of Crx2RnxAll */
+
+/**
+* @brief   : BadMarker - the marker of an invalid RINEX observation file
+* @param[I]: oFile (RINEX observation file)
+* @param[O]: none
+* @return  : 'oFile.bad' in the data directory
+* @note    : not in the private working directory of a concurrent job, where it would be a hard link only
+**/
+static string BadMarker(const string &oFile)
+{
+    if (oFile.find_first_of("/\\") != string::npos) return oFile + BAD_SUFFIX;
+
+    return JobPool::DataDir() + (char)FILEPATHSEP + oFile + BAD_SUFFIX;
+} /* end of BadMarker */
+
+/**
+* @brief   : MarkedBefore - whether a RINEX observation file was marked invalid by a previous run
+* @param[I]: oFile (RINEX observation file)
+* @param[O]: none
+* @return  : true: marked before, to be downloaded again, false: not
+* @note    :
+**/
+bool FtpUtil::MarkedBefore(const string &oFile) const
+{
+    struct stat st;
+
+    return stat(BadMarker(oFile).c_str(), &st) == 0 && st.st_mtime < _trun;
+} /* end of MarkedBefore */
+
+/**
+* @brief   : ObsExists - whether a RINEX observation file exists, expanded or compressed at rest
+* @param[I]: oFile (RINEX observation file)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : true: exists, false: not
+* @note    : a file marked invalid by a previous run does not exist, so that it is downloaded again
+**/
+bool FtpUtil::ObsExists(string oFile, const ftpopt_t *fopt)
+{
+    if (MarkedBefore(oFile)) return false;
+    if (access(oFile.c_str(), 0) == 0) return true;
+
+    return fopt->obsFrame > 0 && ObsArchive::Exist((oFile + ARC_SUFFIX).c_str());
+} /* end of ObsExists */
+
+/**
+* @brief   : WgetUnion - download the lower-priority half of a union of observations, only for the sites not there yet
+* @param[I]: url (remote directory of the short-name 'd' files)
+* @param[I]: cutDirs (' --cut-dirs=N ' of 'wget')
+* @param[I]: pattern (wildcard of the files, i.e., '*0320.24d.*')
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : the remote listing is fetched first, and a file is taken only if neither its 'o' file nor its 'd' file
+*            is in the current directory; without a listing (i.e., HTTPS), the whole pattern is downloaded
+**/
+void FtpUtil::WgetUnion(const string &url, const string &cutDirs, const string &pattern, const ftpopt_t *fopt)
+{
+    string wgetFull = fopt->wgetFull, qr = fopt->qr;
+
+    /* only the listing, as no file name ends with '.none' */
+    remove(".listing");
+    string cmd = wgetFull + " " + qr + " -nH -A .none" + cutDirs + url;
+    Wget(cmd, fopt);
+
+    /* remote listings in the format of 'ls -l', the file name being the last field */
+    FILE *fp = fopen(".listing", "r");
+    if (!fp)
+    {
+        cmd = wgetFull + " " + qr + " -nH -A " + pattern + cutDirs + url;
+        Wget(cmd, fopt);
+
+        return;
+    }
+    StringUtil str;
+    std::vector<string> names;
+    int nlist = 0;
+    char line[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        std::istringstream iss(line);
+        string name, field;
+        while (iss >> field) name = field;
+        if (name.empty() || !str.WildMatch(pattern.c_str(), name.c_str())) continue;
+        nlist++;
+
+        /* i.e., 'abmf0320.24d.gz' -> 'abmf0320.24d' and 'abmf0320.24o' */
+        string dFile = name.substr(0, name.find_last_of('.'));
+        str.ToLower(dFile);
+        if (dFile.empty() || dFile.back() != 'd') continue;
+        string oFile = dFile.substr(0, dFile.size() - 1) + "o";
+        if (ObsExists(oFile, fopt) || access(dFile.c_str(), 0) == 0) continue;
+        names.push_back(name);
+    }
+    fclose(fp);
+
+    /* the accept lists in chunks, for the limit of the command line on Windows */
+    const int nchunk = 100;
+    for (int i = 0; i < names.size(); i += nchunk)
+    {
+        string accept = names[i];
+        for (int j = i + 1; j < names.size() && j < i + nchunk; j++) accept += "," + names[j];
+        cmd = wgetFull + " " + qr + " -nH -A " + accept + cutDirs + url;
+        Wget(cmd, fopt);
+    }
+
+    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(WgetUnion): %d of %d files taken from %s, the others being there already\n",
+        (int)names.size(), nlist, url.c_str());
+} /* end of WgetUnion */
+
+/**
+* @brief   : CheckObs - check a converted RINEX observation file, and mark it for downloading again if invalid
+* @param[I]: oFile (RINEX observation file)
+* @param[I]: chk (result of checking while decoding, nullptr: scan 'oFile')
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : true: valid or not converted, false: invalid
+* @note    : the last epoch should be within 1/24 of the span (1 hour for daily, 2.5 min for hourly files) before the
+*            expected end; an invalid file is kept (i.e., a station stopped early by an outage), marked by
+*            'oFile.bad' and its job kept in 'retry.list', so that it is downloaded once again; invalid once more,
+*            it is kept as it is
+**/
+bool FtpUtil::CheckObs(string oFile, const ObsCheck *chk, const ftpopt_t *fopt)
+{
+    ObsCheck scan;
+    if (!chk)
+    {
+        if (!scan.ScanFile(oFile.c_str())) return true;  /* not converted, which is reported by the caller */
+        chk = &scan;
+    }
+
+    TimeUtil tu;
+    gtime_t ts = { 0 }, te = { 0 };
+    double span = 0.0;
+    if (ObsCheck::ExpectedSpan(oFile, ts, span)) te = tu.TimeAdd(ts, span);
+    string msg;
+    string bad = BadMarker(oFile);
+    if (chk->Result(te, span / 24.0, msg))
+    {
+        remove(bad.c_str());  /* downloaded again, and valid */
+        remove((oFile + BAD_SUFFIX).c_str());  /* its hard link in the private working directory of a job */
+
+        return true;
+    }
+
+    if (MarkedBefore(oFile))
+    {
+        /* downloaded once again and still invalid, i.e., the station stopped early */
+        remove(bad.c_str());
+        remove((oFile + BAD_SUFFIX).c_str());
+        if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(CheckObs): %s  still invalid (%s) when downloaded again, kept as it is\n",
+            oFile.c_str(), msg.c_str());
+
+        return false;
+    }
+    if (access(bad.c_str(), 0) == 0) return false;  /* marked already in this run */
+
+    cout << "*** WARNING(FtpUtil::CheckObs): " << oFile << " is invalid (" << msg << "), to be downloaded again" << endl;
+    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(CheckObs): %s  invalid (%s), kept and marked by %s\n", oFile.c_str(),
+        msg.c_str(), BAD_SUFFIX);
+
+    /* kept, the marker making "ObsExists" of the next run miss it, so that the retry of the job downloads it again */
+    FILE *fp = fopen(bad.c_str(), "w");
+    if (fp)
+    {
+        fprintf(fp, "%s\n", msg.c_str());
+        fclose(fp);
+    }
+    Unfinished();
+
+    return false;
+} /* end of CheckObs */
+
 /**
 * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
 * @param[I]: ts (start time)
@@ -210,13 +710,9 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -228,58 +724,37 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         /* download all the IGS observation files */
         string url, cutDirs = " --cut-dirs=7 ";
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
         else if (ftpName == "IGN")
         {
-            url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
+            url = _ftpArchive.IGN[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy;
             cutDirs = " --cut-dirs=5 ";
         }
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+        else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
         /* it is OK for '*.Z' or '*.gz' format */
-        string dFile = "*" + sDoy + "0." + sYy + "d";
+        string dFile = string("*") + day.sDoy + "0." + day.sYy + "d";
         string dxFile = dFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
-        string suffix = "." + sYy + "d";
+        string suffix = string(".") + day.sYy + "d";
         vector<string> dFiles;
         str.GetFilesAll(dir, suffix, dFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < dFiles.size(); i++)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(dFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -302,26 +777,26 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                 {
                     string url, cutDirs = " --cut-dirs=7 ";
                     if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
+                        day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
                     else if (ftpName == "IGN")
                     {
-                        url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
+                        url = _ftpArchive.IGN[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy;
                         cutDirs = " --cut-dirs=5 ";
                     }
                     else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+                        day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+                    else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dxFile = dFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                     bool isgz = false;
@@ -329,7 +804,7 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + dgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = true;
 
                         if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
@@ -340,14 +815,14 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dzFile;
 #endif
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
                     }
                     if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + dzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -359,20 +834,16 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         cout << "*** WARNING(FtpUtil::GetDailyObsIgs): failed to download IGS daily observation file " << oFile << endl;
 
+                        _nmiss++;
                         string url0 = url + '/' + dxFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsIgs): successfully download IGS daily observation file " << oFile << endl;
 
@@ -387,7 +858,7 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsIgs): IGS daily observation file " << oFile << 
@@ -413,13 +884,9 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -444,7 +911,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -456,15 +923,15 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
 
             string url, cutDirs = " --cut-dirs=7 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -472,47 +939,26 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
             string sch;
             sch.push_back(ch);
             /* it is OK for '*.Z' or '*.gz' format */
-            string dFile = "*" + sDoy + sch + "." + sYy + "d";
+            string dFile = string("*") + day.sDoy + sch + "." + day.sYy + "d";
             string dxFile = dFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* get the file list */
-            string suffix = "." + sYy + "d";
+            string suffix = string(".") + day.sYy + "d";
             vector<string> dFiles;
             str.GetFilesAll(sHhDir, suffix, dFiles);
             char sitName[MAXCHARS];
+            std::vector<string> oFiles;
             for (int i = 0; i < dFiles.size(); i++)
             {
-                if (access(dFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + dFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    dFile = site + sDoy + sch + "." + sYy + "d";
-                    if (access(dFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-                }
+                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
+                oFiles.push_back(site + day.sDoy + sch + "." + day.sYy + "o");
             }
+            /* decompress and convert from 'd' files to 'o' files, several at once */
+            Crx2RnxAll(dFiles, oFiles, fopt);
         }
     }
     else  /* the option of full path of site list file is selected */
@@ -550,7 +996,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -566,26 +1012,26 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     string sch;
                     sch.push_back(ch);
                     str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    string oFile = sitName + day.sDoy + sch + "." + day.sYy + "o";
+                    string dFile = sitName + day.sDoy + sch + "." + day.sYy + "d";
+                    if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                     {
                         string url, cutDirs = " --cut-dirs=7 ";
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
                         else if (ftpName == "IGN")
                         {
-                            url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
+                            url = _ftpArchive.IGN[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy;
                             cutDirs = " --cut-dirs=6 ";
                         }
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
+                        else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
                         /* it is OK for '*.Z' or '*.gz' format */
                         string dxFile = dFile + ".*";
                         string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
 
                         string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                         bool isgz = false;
@@ -593,7 +1039,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         {
                             /* extract '*.gz' */
                             cmd = gzipFull + " -d -f " + dgzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = true;
 
                             if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
@@ -604,14 +1050,14 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dzFile;
 #endif
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                             }
                         }
                         if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
                             cmd = gzipFull + " -d -f " + dzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = false;
                         }
 
@@ -623,20 +1069,16 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         {
                             cout << "*** WARNING(FtpUtil::GetHourlyObsIgs): failed to download IGS Hourly observation file " << oFile << endl;
 
+                            _nmiss++;
                             string url0 = url + '/' + dxFile;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                             continue;
                         }
 
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                        Crx2Rnx(dFile, oFile, fopt);
 
-                        if (access(oFile.c_str(), 0) == 0)
+                        if (ObsExists(oFile, fopt))
                         {
                             cout << "*** INFO(FtpUtil::GetHourlyObsIgs): successfully download IGS hourly observation file " << oFile << endl;
 
@@ -651,7 +1093,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dFile;
 #endif
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsIgs): IGS hourly observation file " <<
@@ -678,13 +1120,9 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -709,7 +1147,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -721,18 +1159,18 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             string url, cutDirs = " --cut-dirs=8 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU")
             {
-                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                 cutDirs = " --cut-dirs=6 ";
             }
-            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -740,50 +1178,29 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             string sch;
             sch.push_back(ch);
             /* it is OK for '*.Z' or '*.gz' format */
-            string dFile = "*" + sDoy + sch + "*." + sYy + "d";
+            string dFile = string("*") + day.sDoy + sch + "*." + day.sYy + "d";
             string dxFile = dFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             std::vector<string> minuStr = { "00", "15", "30", "45" };
             for (int i = 0; i < minuStr.size(); i++)
             {
                 /* get the file list */
-                string suffix = minuStr[i] + "." + sYy + "d";
+                string suffix = minuStr[i] + "." + day.sYy + "d";
                 vector<string> dFiles;
                 str.GetFilesAll(sHhDir, suffix, dFiles);
                 char sitName[MAXCHARS];
+                std::vector<string> oFiles;
                 for (int j = 0; j < dFiles.size(); j++)
                 {
-                    if (access(dFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + dFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, dFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        dFile = site + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(dFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
+                    str.StrMid(sitName, dFiles[j].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    oFiles.push_back(site + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o");
                 }
+                /* decompress and convert from 'd' files to 'o' files, several at once */
+                Crx2RnxAll(dFiles, oFiles, fopt);
             }
         }
     }
@@ -822,7 +1239,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -842,29 +1259,29 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     for (int i = 0; i < minuStr.size(); i++)
                     {
                         str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        string oFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o";
+                        string dFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "d";
+                        if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                         {
                             string url, cutDirs = " --cut-dirs=8 ";
                             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                             else if (ftpName == "IGN")
                             {
-                                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
+                                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy;
                                 cutDirs = " --cut-dirs=6 ";
                             }
                             else if (ftpName == "WHU")
                             {
-                                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                                 cutDirs = " --cut-dirs=6 ";
                             }
-                            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
 
                             /* it is OK for '*.Z' or '*.gz' format */
                             string dxFile = dFile + ".*";
                             string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            Wget(cmd, fopt);
 
                             string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                             bool isgz = false;
@@ -872,7 +1289,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             {
                                 /* extract '*.gz' */
                                 cmd = gzipFull + " -d -f " + dgzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                                 isgz = true;
 
                                 if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
@@ -883,14 +1300,14 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                                     cmd = "rm -rf " + dzFile;
 #endif
-                                    std::system(cmd.c_str());
+                                    _procs.System(cmd);
                                 }
                             }
                             if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
                             {
                                 /* extract '*.Z' */
                                 cmd = gzipFull + " -d -f " + dzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                                 isgz = false;
                             }
 
@@ -902,20 +1319,16 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             {
                                 cout << "*** WARNING(FtpUtil::GetHrObsIgs): failed to download IGS high-rate observation file " << oFile << endl;
 
+                                _nmiss++;
                                 string url0 = url + '/' + dxFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                                 continue;
                             }
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                            Crx2Rnx(dFile, oFile, fopt);
 
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (ObsExists(oFile, fopt))
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsIgs): successfully download IGS high-rate observation file " << oFile << endl;
 
@@ -930,7 +1343,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dFile;
 #endif
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsIgs): IGS high-rate observation file " <<
@@ -965,13 +1378,9 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -983,59 +1392,37 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
         /* download all the MGEX observation files */
         string url, cutDirs = " --cut-dirs=7 ";
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + 
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
         else if (ftpName == "IGN")
         {
-            url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
+            url = _ftpArchive.IGN[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy;
             cutDirs = " --cut-dirs=5 ";
         }
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" + 
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+        else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
         /* it is OK for '*.Z' or '*.gz' format */
-        string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+        string crxFile = string("*") + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
         string crxxFile = crxFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(dir, suffix, crxFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < crxFiles.size(); i++)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(crxFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -1057,33 +1444,33 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                 {
                     string url, cutDirs = " --cut-dirs=7 ";
                     if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + 
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
+                        day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
                     else if (ftpName == "IGN")
                     {
-                        url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
+                        url = _ftpArchive.IGN[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy;
                         cutDirs = " --cut-dirs=5 ";
                     }
                     else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" + 
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+                        day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+                    else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                    string crxFile = sitName + "*" + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
                     string crxxFile = crxFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                     /* extract '*.gz' */
                     string crxgzFile = crxFile + ".gz";
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
                     changeFileName = "rename";
@@ -1091,7 +1478,7 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     changeFileName = "mv";
 #endif
                     cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     bool isgz = true;
                     string crxzFile;
                     char tmpFile[MAXSTRPATH] = { '\0' };
@@ -1103,15 +1490,16 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         /* extract '*.Z' */
                         crxzFile = crxFile + ".Z";
                         cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
 
                         cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                         if (access(dFile.c_str(), 0) == -1)
                         {
                             cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
 
+                            _nmiss++;
                             string url0 = url + '/' + crxxFile;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
@@ -1119,14 +1507,9 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         }
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsMgex): successfully download MGEX daily observation file " << oFile << endl;
 
@@ -1141,7 +1524,7 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsMgex): MGEX daily observation file " << oFile << 
@@ -1167,13 +1550,9 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -1198,7 +1577,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -1210,21 +1589,21 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
 
             string url, cutDirs = " --cut-dirs=7 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
             /* it is OK for '*.Z' or '*.gz' format */
-            string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+            string crxFile = string("*") + day.sYyyy + day.sDoy + sHh + "00_01H_30S_MO.crx";
             string crxxFile = crxFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -1237,42 +1616,38 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
             vector<string> crxFiles;
             str.GetFilesAll(sHhDir, suffix, crxFiles);
             char sitName[MAXCHARS];
+            std::vector<string> oFiles;
             for (int i = 0; i < crxFiles.size(); i++)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
-                }
+                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
+                oFiles.push_back(site + day.sDoy + sch + "." + day.sYy + "o");
             }
+            /* decompress and convert from 'd' files to 'o' files, several at once */
+            Crx2RnxAll(crxFiles, oFiles, fopt);
         }
     }
     else  /* the option of full path of site list file is selected */
     {
+        /* the files of the sites of known long names in parallel over HTTP/2 first */
+        std::vector<string> urls, dirs, tails, stems;
+        for (int i = 0; i < fopt->hhObs.size(); i++)
+        {
+            string sHh = str.hh2str(fopt->hhObs[i]);
+            char tmpDir[MAXSTRPATH] = { '\0' };
+            sprintf(tmpDir, "%s%c%s", dir, (char)FILEPATHSEP, sHh.c_str());
+            string url;
+            if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
+            urls.push_back(url);
+            dirs.push_back(tmpDir);
+            tails.push_back(string(day.sYyyy) + day.sDoy + sHh + "00_01H_30S_MO.crx");
+            stems.push_back(string(day.sDoy) + (char)(fopt->hhObs[i] + 97) + "." + day.sYy);
+        }
+        if (access(fopt->obsLst, 0) == 0) PrefetchCrx(fopt->obsLst, urls, dirs, tails, stems, fopt);
+
         /* download the MGEX observation file site-by-site */
         if (access(fopt->obsLst, 0) == 0)
         {
@@ -1305,7 +1680,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -1321,33 +1696,33 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                     string sch;
                     sch.push_back(ch);
                     str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    string oFile = sitName + day.sDoy + sch + "." + day.sYy + "o";
+                    string dFile = sitName + day.sDoy + sch + "." + day.sYy + "d";
+                    if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                     {
                         string url, cutDirs = " --cut-dirs=7 ";
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
                         else if (ftpName == "IGN")
                         {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
+                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy;
                             cutDirs = " --cut-dirs=6 ";
                         }
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
+                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
                         /* it is OK for '*.Z' or '*.gz' format */
                         str.ToUpper(sitName);
-                        string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+                        string crxFile = sitName + "*" + day.sYyyy + day.sDoy + sHh + "00_01H_30S_MO.crx";
                         string crxxFile = crxFile + ".*";
                         string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                         /* extract '*.gz' */
                         string crxgzFile = crxFile + ".gz";
                         cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         string changeFileName;
 #ifdef _WIN32  /* for Windows */
                         changeFileName = "rename";
@@ -1355,7 +1730,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                         changeFileName = "mv";
 #endif
                         cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         bool isgz = true;
                         string crxzFile;
                         char tmpFile[MAXSTRPATH] = { '\0' };
@@ -1367,14 +1742,15 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                             /* extract '*.Z' */
                             crxzFile = crxFile + ".Z";
                             cmd = gzipFull + " -d -f " + crxzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
 
                             cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             if (access(dFile.c_str(), 0) == -1)
                             {
                                 cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
 
+                                _nmiss++;
                                 string url0 = url + '/' + crxxFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
@@ -1382,14 +1758,9 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                             }
                         }
 
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                        Crx2Rnx(dFile, oFile, fopt);
 
-                        if (access(oFile.c_str(), 0) == 0)
+                        if (ObsExists(oFile, fopt))
                         {
                             cout << "*** INFO(FtpUtil::GetHourlyObsMgex): successfully download MGEX hourly observation file " << oFile << endl;
 
@@ -1404,7 +1775,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dFile;
 #endif
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsMgex): MGEX hourly observation file " <<
@@ -1431,13 +1802,9 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -1462,7 +1829,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -1474,24 +1841,24 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             string url, cutDirs = " --cut-dirs=8 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU")
             {
-                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                 cutDirs = " --cut-dirs=6 ";
             }
-            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
 
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*_15M_01S_MO.crx";
             string crxxFile = crxFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -1507,43 +1874,43 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 vector<string> crxFiles;
                 str.GetFilesAll(sHhDir, suffix, crxFiles);
                 char sitName[MAXCHARS];
+                std::vector<string> oFiles;
                 for (int j = 0; j < crxFiles.size(); j++)
                 {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] +  "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
+                    str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    oFiles.push_back(site + day.sDoy + sch + minuStr[i] +  "." + day.sYy + "o");
                 }
+                /* decompress and convert from 'd' files to 'o' files, several at once */
+                Crx2RnxAll(crxFiles, oFiles, fopt);
             }
         }
     }
     else  /* the option of full path of site list file is selected */
     {
+        /* the files of the sites of known long names in parallel over HTTP/2 first */
+        std::vector<string> urls, dirs, tails, stems;
+        std::vector<string> minuStr = { "00", "15", "30", "45" };
+        for (int i = 0; i < fopt->hhObs.size(); i++)
+        {
+            string sHh = str.hh2str(fopt->hhObs[i]);
+            char tmpDir[MAXSTRPATH] = { '\0' };
+            sprintf(tmpDir, "%s%c%s", dir, (char)FILEPATHSEP, sHh.c_str());
+            string url;
+            if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
+            for (int j = 0; j < minuStr.size(); j++)
+            {
+                urls.push_back(url);
+                dirs.push_back(tmpDir);
+                tails.push_back(string(day.sYyyy) + day.sDoy + sHh + minuStr[j] + "_15M_01S_MO.crx");
+                stems.push_back(string(day.sDoy) + (char)(fopt->hhObs[i] + 97) + minuStr[j] + "." + day.sYy);
+            }
+        }
+        if (access(fopt->obsLst, 0) == 0) PrefetchCrx(fopt->obsLst, urls, dirs, tails, stems, fopt);
+
         /* download the MGEX observation file site-by-site */
         if (access(fopt->obsLst, 0) == 0)
         {
@@ -1576,7 +1943,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -1596,37 +1963,37 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     for (int i = 0; i < minuStr.size(); i++)
                     {
                         str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        string oFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o";
+                        string dFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "d";
+                        if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                         {
                             string url, cutDirs = " --cut-dirs=8 ";
                             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                             else if (ftpName == "IGN")
                             {
-                                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
+                                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy;
                                 cutDirs = " --cut-dirs=6 ";
                             }
                             else if (ftpName == "WHU")
                             {
-                                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                                 cutDirs = " --cut-dirs=6 ";
                             }
-                            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + 
-                                sYy + "d" + "/" + sHh;
+                            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + 
+                                day.sYy + "d" + "/" + sHh;
 
                             /* it is OK for '*.Z' or '*.gz' format */
                             str.ToUpper(sitName);
-                            string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
+                            string crxFile = sitName + "*" + day.sYyyy + day.sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
                             string crxxFile = crxFile + ".*";
                             string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                             /* extract '*.gz' */
                             string crxgzFile = crxFile + ".gz";
                             cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             string changeFileName;
 #ifdef _WIN32  /* for Windows */
                             changeFileName = "rename";
@@ -1634,7 +2001,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             changeFileName = "mv";
 #endif
                             cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             bool isgz = true;
                             string crxzFile;
                             char tmpFile[MAXSTRPATH] = { '\0' };
@@ -1646,15 +2013,16 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                                 /* extract '*.Z' */
                                 crxzFile = crxFile + ".Z";
                                 cmd = gzipFull + " -d -f " + crxzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
 
                                 cmd = changeFileName + " " + crxFile + " " + dFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                                 isgz = false;
                                 if (access(dFile.c_str(), 0) == -1)
                                 {
                                     cout << "*** WARNING(FtpUtil::GetHrObsMgex): failed to download MGEX high-rate observation file " << oFile << endl;
 
+                                    _nmiss++;
                                     string url0 = url + '/' + crxxFile;
                                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsMgex): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
@@ -1662,14 +2030,9 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                                 }
                             }
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                            Crx2Rnx(dFile, oFile, fopt);
 
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (ObsExists(oFile, fopt))
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsMgex): successfully download MGEX high-rate observation file " << oFile << endl;
 
@@ -1684,7 +2047,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dFile;
 #endif
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsMgex): MGEX high-rate observation file " << 
@@ -1720,13 +2083,9 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -1738,125 +2097,71 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         /* download all the MGEX observation files */
         string url, cutDirs = " --cut-dirs=7 ";
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
         else if (ftpName == "IGN")
         {
-            url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
+            url = _ftpArchive.IGN[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy;
             cutDirs = " --cut-dirs=5 ";
         }
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+        else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
         /* it is OK for '*.Z' or '*.gz' format */
-        string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+        string crxFile = string("*") + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
         string crxxFile = crxFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(dir, suffix, crxFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < crxFiles.size(); i++)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(crxFiles, oFiles, fopt);
 
         /* download all the IGS observation files */
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
         else if (ftpName == "IGN")
         {
-            url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
+            url = _ftpArchive.IGN[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy;
             cutDirs = " --cut-dirs=5 ";
         }
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-            sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+            day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+        else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
         /* it is OK for '*.Z' or '*.gz' format */
-        string dFile = "*" + sDoy + "0." + sYy + "d";
+        string dFile = string("*") + day.sDoy + "0." + day.sYy + "d";
         string dxFile = dFile + ".*";
-        cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        WgetUnion(url, cutDirs, dxFile, fopt);  /* only the sites not taken from the higher-priority set */
 
         /* get the file list */
-        suffix = "." + sYy + "d";
+        suffix = string(".") + day.sYy + "d";
         vector<string> dFiles;
         str.GetFilesAll(dir, suffix, dFiles);
+        oFiles.clear();
         for (int i = 0; i < dFiles.size(); i++)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                if (access(oFile.c_str(), 0) == 0)
-                {
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    continue;
-                }
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            string oFile = site + day.sDoy + "0." + day.sYy + "o";
+            if (ObsExists(oFile, fopt)) remove(dFiles[i].c_str());  /* taken from the higher-priority set */
+            oFiles.push_back(oFile);
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(dFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -1877,34 +2182,34 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                 {
                     /* download the MGEX observation file site-by-site */
                     string url, cutDirs = " --cut-dirs=7 ";
                     if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
+                        day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
                     else if (ftpName == "IGN")
                     {
-                        url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
+                        url = _ftpArchive.IGN[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy;
                         cutDirs = " --cut-dirs=5 ";
                     }
                     else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" +
-                        sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+                        day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+                    else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                    string crxFile = sitName + "*" + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
                     string crxxFile = crxFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                     /* extract '*.gz' */
                     string crxgzFile = crxFile + ".gz";
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
                     changeFileName = "rename";
@@ -1912,7 +2217,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     changeFileName = "mv";
 #endif
                     cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     bool isgz = true;
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
@@ -1924,36 +2229,36 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         /* extract '*.Z' */
                         string crxzFile = crxFile + ".Z";
                         cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
 
                         cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                         if (access(dFile.c_str(), 0) == -1)
                         {
                             /* download the IGS observation file site-by-site */
                             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d";
+                                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
                             else if (ftpName == "IGN")
                             {
-                                url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
+                                url = _ftpArchive.IGN[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy;
                                 cutDirs = " --cut-dirs=5 ";
                             }
                             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d";
-                            else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
+                                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
+                            else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d";
 
                             /* it is OK for '*.Z' or '*.gz' format */
                             string dxFile = dFile + ".*";
                             string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            Wget(cmd, fopt);
 
                             string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                             if (access(dgzFile.c_str(), 0) == 0)
                             {
                                 /* extract '*.gz' */
                                 cmd = gzipFull + " -d -f " + dgzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                                 isgz = true;
 
                                 if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
@@ -1964,20 +2269,21 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                                     cmd = "rm -rf " + dzFile;
 #endif
-                                    std::system(cmd.c_str());
+                                    _procs.System(cmd);
                                 }
                             }
                             if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
                             {
                                 /* extract '*.Z' */
                                 cmd = gzipFull + " -d -f " + dzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                                 isgz = false;
                             }
                             if (access(dFile.c_str(), 0) == -1)
                             {
                                 cout << "*** WARNING(FtpUtil::GetDailyObsIgm): failed to download IGM daily observation file " << oFile << endl;
 
+                                _nmiss++;
                                 string url0 = url + '/' + crxxFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                                 url0 = url + '/' + dxFile;
@@ -1988,14 +2294,9 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         }
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsIgm): successfully download IGM daily observation file " << oFile << endl;
 
@@ -2007,7 +2308,7 @@ void FtpUtil::GetDailyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsIgm): IGM daily observation file " << oFile <<
@@ -2034,13 +2335,9 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -2064,7 +2361,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -2077,21 +2374,21 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
             /* download all the MGEX observation files */
             string url, cutDirs = " --cut-dirs=7 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
             /* it is OK for '*.Z' or '*.gz' format */
-            string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+            string crxFile = string("*") + day.sYyyy + day.sDoy + sHh + "00_01H_30S_MO.crx";
             string crxxFile = crxFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -2104,104 +2401,50 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
             vector<string> crxFiles;
             str.GetFilesAll(sHhDir, suffix, crxFiles);
             char sitName[MAXCHARS];
+            std::vector<string> oFiles;
             for (int i = 0; i < crxFiles.size(); i++)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
-                }
+                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
+                oFiles.push_back(site + day.sDoy + sch + "." + day.sYy + "o");
             }
+            /* decompress and convert from 'd' files to 'o' files, several at once */
+            Crx2RnxAll(crxFiles, oFiles, fopt);
 
             /* download all the IGS observation files */
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                sYyyy + "/" + sDoy + "/" + sHh;
-            else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
-            /* it is OK for '*.Z' or '*.gz' format */
-            string dFile = "*" + sDoy + sch + "." + sYy + "d";
-            string dxFile = dFile + ".*";
-            cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
-
-            /* get the file list */
-            suffix = "." + sYy + "d";
-            vector<string> dFiles;
-            str.GetFilesAll(sHhDir, suffix, dFiles);
-            for (int i = 0; i < dFiles.size(); i++)
-            {
-                if (access(dFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + dFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    dFile = site + sDoy + sch + "." + sYy + "d";
-                    if (access(dFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    if (access(oFile.c_str(), 0) == 0)
-                    {
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        continue;
-                    }
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+            /* it is OK for '*.Z' or '*.gz' format */
+            string dFile = string("*") + day.sDoy + sch + "." + day.sYy + "d";
+            string dxFile = dFile + ".*";
+            WgetUnion(url, cutDirs, dxFile, fopt);  /* only the sites not taken from the higher-priority set */
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-                }
+            /* get the file list */
+            suffix = string(".") + day.sYy + "d";
+            vector<string> dFiles;
+            str.GetFilesAll(sHhDir, suffix, dFiles);
+            oFiles.clear();
+            for (int i = 0; i < dFiles.size(); i++)
+            {
+                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
+                string oFile = site + day.sDoy + sch + "." + day.sYy + "o";
+                if (ObsExists(oFile, fopt)) remove(dFiles[i].c_str());  /* taken from the higher-priority set */
+                oFiles.push_back(oFile);
             }
+            /* decompress and convert from 'd' files to 'o' files, several at once */
+            Crx2RnxAll(dFiles, oFiles, fopt);
         }
     }
     else  /* the option of full path of site list file is selected */
@@ -2237,7 +2480,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -2253,34 +2496,34 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     string sch;
                     sch.push_back(ch);
                     str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    string oFile = sitName + day.sDoy + sch + "." + day.sYy + "o";
+                    string dFile = sitName + day.sDoy + sch + "." + day.sYy + "d";
+                    if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                     {
                         /* download the MGEX observation file site-by-site */
                         string url, cutDirs = " --cut-dirs=7 ";
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
                         else if (ftpName == "IGN")
                         {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
+                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy;
                             cutDirs = " --cut-dirs=6 ";
                         }
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
+                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
                         /* it is OK for '*.Z' or '*.gz' format */
                         str.ToUpper(sitName);
-                        string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+                        string crxFile = sitName + "*" + day.sYyyy + day.sDoy + sHh + "00_01H_30S_MO.crx";
                         string crxxFile = crxFile + ".*";
                         string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                         /* extract '*.gz' */
                         string crxgzFile = crxFile + ".gz";
                         cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         string changeFileName;
 #ifdef _WIN32  /* for Windows */
                         changeFileName = "rename";
@@ -2288,7 +2531,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         changeFileName = "mv";
 #endif
                         cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         bool isgz = true;
 
                         char tmpFile[MAXSTRPATH] = { '\0' };
@@ -2300,36 +2543,36 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
                             /* extract '*.Z' */
                             string crxzFile = crxFile + ".Z";
                             cmd = gzipFull + " -d -f " + crxzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
 
                             cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = false;
                             if (access(dFile.c_str(), 0) == -1)
                             {
                                 /* download the IGS observation file site-by-site */
                                 if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
-                                    sYyyy + "/" + sDoy + "/" + sHh;
+                                    day.sYyyy + "/" + day.sDoy + "/" + sHh;
                                 else if (ftpName == "IGN")
                                 {
-                                    url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
+                                    url = _ftpArchive.IGN[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy;
                                     cutDirs = " --cut-dirs=6 ";
                                 }
                                 else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
-                                    sYyyy + "/" + sDoy + "/" + sHh;
-                                else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                                    day.sYyyy + "/" + day.sDoy + "/" + sHh;
+                                else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
                                 /* it is OK for '*.Z' or '*.gz' format */
                                 string dxFile = dFile + ".*";
                                 string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                                std::system(cmd.c_str());
+                                Wget(cmd, fopt);
 
                                 string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                                 if (access(dgzFile.c_str(), 0) == 0)
                                 {
                                     /* extract '*.gz' */
                                     cmd = gzipFull + " -d -f " + dgzFile;
-                                    std::system(cmd.c_str());
+                                    _procs.System(cmd);
                                     isgz = true;
 
                                     if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
@@ -2340,20 +2583,21 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                                         cmd = "rm -rf " + dzFile;
 #endif
-                                        std::system(cmd.c_str());
+                                        _procs.System(cmd);
                                     }
                                 }
                                 if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
                                 {
                                     /* extract '*.Z' */
                                     cmd = gzipFull + " -d -f " + dzFile;
-                                    std::system(cmd.c_str());
+                                    _procs.System(cmd);
                                     isgz = false;
                                 }
                                 if (access(dFile.c_str(), 0) == -1)
                                 {
                                     cout << "*** WARNING(FtpUtil::GetHourlyObsIgm): failed to download IGM Hourly observation file " << oFile << endl;
 
+                                    _nmiss++;
                                     string url0 = url + '/' + crxxFile;
                                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                                     url0 = url + '/' + dxFile;
@@ -2364,14 +2608,9 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
                             }
                         }
 
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                        Crx2Rnx(dFile, oFile, fopt);
 
-                        if (access(oFile.c_str(), 0) == 0)
+                        if (ObsExists(oFile, fopt))
                         {
                             cout << "*** INFO(FtpUtil::GetHourlyObsIgm ): successfully download IGM hourly observation file " << oFile << endl;
 
@@ -2383,7 +2622,7 @@ void FtpUtil::GetHourlyObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dFile;
 #endif
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsIgm ): IGM hourly observation file " <<
@@ -2411,13 +2650,9 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
     string ftpName = fopt->ftpFrom;
@@ -2441,7 +2676,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -2454,24 +2689,24 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             /* download all the MGEX observation files */
             string url, cutDirs = " --cut-dirs=8 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU")
             {
-                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                 cutDirs = " --cut-dirs=6 ";
             }
-            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
 
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*_15M_01S_MO.crx";
             string crxxFile = crxFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -2487,99 +2722,55 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 vector<string> crxFiles;
                 str.GetFilesAll(sHhDir, suffix, crxFiles);
                 char sitName[MAXCHARS];
+                std::vector<string> oFiles;
                 for (int j = 0; j < crxFiles.size(); j++)
                 {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
+                    str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    oFiles.push_back(site + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o");
                 }
+                /* decompress and convert from 'd' files to 'o' files, several at once */
+                Crx2RnxAll(crxFiles, oFiles, fopt);
             }
 
             /* download all the IGS observation files */
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU")
             {
-                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                url = _ftpArchive.WHU[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                 cutDirs = " --cut-dirs=6 ";
             }
-            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+            else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
 
             /* it is OK for '*.Z' or '*.gz' format */
-            string dFile = "*" + sDoy + sch + "*." + sYy + "d";
+            string dFile = string("*") + day.sDoy + sch + "*." + day.sYy + "d";
             string dxFile = dFile + ".*";
-            cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            WgetUnion(url, cutDirs, dxFile, fopt);  /* only the sites not taken from the higher-priority set */
 
             for (int i = 0; i < minuStr.size(); i++)
             {
                 /* get the file list */
-                string suffix = minuStr[i] + "." + sYy + "d";
+                string suffix = minuStr[i] + "." + day.sYy + "d";
                 vector<string> dFiles;
                 str.GetFilesAll(sHhDir, suffix, dFiles);
                 char sitName[MAXCHARS];
+                std::vector<string> oFiles;
                 for (int j = 0; j < dFiles.size(); j++)
                 {
-                    if (access(dFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + dFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, dFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        dFile = site + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(dFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
+                    str.StrMid(sitName, dFiles[j].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    oFiles.push_back(site + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o");
                 }
+                /* decompress and convert from 'd' files to 'o' files, several at once */
+                Crx2RnxAll(dFiles, oFiles, fopt);
             }
         }
     }
@@ -2617,7 +2808,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -2637,37 +2828,37 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     for (int i = 0; i < minuStr.size(); i++)
                     {
                         str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        string oFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o";
+                        string dFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "d";
+                        if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                         {
                             string url, cutDirs = " --cut-dirs=8 ";
                             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
-                                sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                             else if (ftpName == "IGN")
                             {
-                                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
+                                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy;
                                 cutDirs = " --cut-dirs=6 ";
                             }
                             else if (ftpName == "WHU")
                             {
-                                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                url = _ftpArchive.WHU[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                                 cutDirs = " --cut-dirs=6 ";
                             }
-                            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" +
-                                sYy + "d" + "/" + sHh;
+                            else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" +
+                                day.sYy + "d" + "/" + sHh;
 
                             /* it is OK for '*.Z' or '*.gz' format */
                             str.ToUpper(sitName);
-                            string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
+                            string crxFile = sitName + "*" + day.sYyyy + day.sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
                             string crxxFile = crxFile + ".*";
                             string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                             /* extract '*.gz' */
                             string crxgzFile = crxFile + ".gz";
                             cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             string changeFileName;
 #ifdef _WIN32  /* for Windows */
                             changeFileName = "rename";
@@ -2675,7 +2866,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             changeFileName = "mv";
 #endif
                             cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             bool isgz = true;
 
                             char tmpFile[MAXSTRPATH] = { '\0' };
@@ -2687,38 +2878,38 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                                 /* extract '*.Z' */
                                 string crxzFile = crxFile + ".Z";
                                 cmd = gzipFull + " -d -f " + crxzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
 
                                 cmd = changeFileName + " " + crxFile + " " + dFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                                 isgz = false;
                                 if (access(dFile.c_str(), 0) == -1)
                                 {
                                     if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
-                                        sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                        day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                                     else if (ftpName == "IGN")
                                     {
-                                        url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
+                                        url = _ftpArchive.IGN[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy;
                                         cutDirs = " --cut-dirs=6 ";
                                     }
                                     else if (ftpName == "WHU")
                                     {
-                                        url = _ftpArchive.WHU[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                        url = _ftpArchive.WHU[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
                                         cutDirs = " --cut-dirs=6 ";
                                     }
-                                    else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
+                                    else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "d" + "/" + sHh;
 
                                     /* it is OK for '*.Z' or '*.gz' format */
                                     string dxFile = dFile + ".*";
                                     cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                                    std::system(cmd.c_str());
+                                    Wget(cmd, fopt);
 
                                     string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                                     if (access(dgzFile.c_str(), 0) == 0)
                                     {
                                         /* extract '*.gz' */
                                         cmd = gzipFull + " -d -f " + dgzFile;
-                                        std::system(cmd.c_str());
+                                        _procs.System(cmd);
                                         isgz = true;
 
                                         if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
@@ -2729,20 +2920,21 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                                             cmd = "rm -rf " + dzFile;
 #endif
-                                            std::system(cmd.c_str());
+                                            _procs.System(cmd);
                                         }
                                     }
                                     if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
                                     {
                                         /* extract '*.Z' */
                                         cmd = gzipFull + " -d -f " + dzFile;
-                                        std::system(cmd.c_str());
+                                        _procs.System(cmd);
                                         isgz = false;
                                     }
                                     if (access(dFile.c_str(), 0) == -1)
                                     {
                                         cout << "*** WARNING(FtpUtil::GetHrObsIgm): failed to download IGM high-rate observation file " << oFile << endl;
 
+                                        _nmiss++;
                                         string url0 = url + '/' + crxxFile;
                                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsIgm): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                                         url0 = url + '/' + dxFile;
@@ -2753,14 +2945,9 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                                 }
                             }
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                            Crx2Rnx(dFile, oFile, fopt);
 
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (ObsExists(oFile, fopt))
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsIgm): successfully download IGM high-rate observation file " << oFile << endl;
 
@@ -2772,7 +2959,7 @@ void FtpUtil::GetHrObsIgm(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dFile;
 #endif
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsIgm): IGM high-rate observation file " <<
@@ -2808,16 +2995,12 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url = "http://saegnss2.curtin.edu/ldc/rinex3/daily/" + sYyyy + "/" + sDoy;
+    string url = string("http://saegnss2.curtin.edu/ldc/rinex3/daily/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=5 ";
     /* download the Curtin University of Technology (CUT) observation file site-by-site */
     if (access(fopt->obsLst, 0) == 0)
@@ -2837,19 +3020,19 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             str.TrimSpace4String(sitName);
             if (sitName.size() != 4) continue;
             str.ToLower(sitName);
-            string oFile = sitName + sDoy + "0." + sYy + "o";
-            if (access(oFile.c_str(), 0) == -1)
+            string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+            if (!ObsExists(oFile, fopt))
             {
                 /* it is OK for '*.gz' format */
                 str.ToUpper(sitName);
-                string crxFile = sitName + "00AUS_R_" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                string crxFile = sitName + "00AUS_R_" + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
                 string crxgzFile = crxFile + ".gz";
                 string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipFull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
@@ -2859,20 +3042,16 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     cout << "*** WARNING(FtpUtil::GetDailyObsCut): failed to download CUT daily observation file " << oFile << endl;
 
+                    _nmiss++;
                     string url0 = url + '/' + crxgzFile;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsCut): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                     continue;
                 }
 
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                Crx2Rnx(crxFile, oFile, fopt);
 
-                if (access(oFile.c_str(), 0) == 0)
+                if (ObsExists(oFile, fopt))
                 {
                     cout << "*** INFO(FtpUtil::GetDailyObsCut): successfully download CUT daily observation file " << oFile << endl;
 
@@ -2885,7 +3064,7 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + crxFile;
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
             else cout << "*** INFO(FtpUtil::GetDailyObsCut): CUT daily observation file " << oFile <<
@@ -2918,62 +3097,36 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url = "ftp://ftp.data.gnss.ga.gov.au/daily/" + sYyyy + "/" + sDoy;
+    string url = string("ftp://ftp.data.gnss.ga.gov.au/daily/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=3 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.gz' format */
-        string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+        string crxFile = string("*") + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
         string crxgzFile = crxFile + ".gz";
         string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(dir, suffix, crxFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < crxFiles.size(); i++)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete crxFile */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(crxFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -2995,20 +3148,20 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt))
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                    string crxFile = sitName + "*" + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
                     string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                     /* extract '*.gz' */
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
                     changeFileName = "rename";
@@ -3016,7 +3169,7 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     changeFileName = "mv";
 #endif
                     cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -3026,20 +3179,16 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
 
+                        _nmiss++;
                         string url0 = url + '/' + crxgzFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsGa): successfully download GA daily observation file " << oFile << endl;
 
@@ -3052,7 +3201,7 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsGa): GA daily observation file " << oFile <<
@@ -3079,16 +3228,12 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url0 = "ftp://ftp.data.gnss.ga.gov.au/hourly/" + sYyyy + "/" + sDoy;
+    string url0 = string("ftp://ftp.data.gnss.ga.gov.au/hourly/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
@@ -3108,7 +3253,7 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -3120,10 +3265,10 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             string url = url0 + "/" + sHh;
             /* it is OK for '*.gz' format */
-            string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+            string crxFile = string("*") + day.sYyyy + day.sDoy + sHh + "00_01H_30S_MO.crx";
             string crxgzFile = crxFile + ".gz";
             string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -3136,38 +3281,16 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             vector<string> crxFiles;
             str.GetFilesAll(sHhDir, suffix, crxFiles);
             char sitName[MAXCHARS];
+            std::vector<string> oFiles;
             for (int i = 0; i < crxFiles.size(); i++)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
-                {
-                    /* extract it */
-                    cmd = gzipFull + "  -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
-
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
-                }
+                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+                string site = sitName;
+                str.ToLower(site);
+                oFiles.push_back(site + day.sDoy + sch + "." + day.sYy + "o");
             }
+            /* decompress and convert from 'd' files to 'o' files, several at once */
+            Crx2RnxAll(crxFiles, oFiles, fopt);
         }
     }
     else  /* the option of full path of site list file is selected */
@@ -3204,7 +3327,7 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -3220,21 +3343,21 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     string sch;
                     sch.push_back(ch);
                     str.ToLower(sitName);
-                    string oFile = sitName + sDoy + sch + "." + sYy + "o";
-                    string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    string oFile = sitName + day.sDoy + sch + "." + day.sYy + "o";
+                    string dFile = sitName + day.sDoy + sch + "." + day.sYy + "d";
+                    if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                     {
                         string url = url0 + "/" + sHh;
                         /* it is OK for '*.gz' format */
                         str.ToUpper(sitName);
-                        string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
+                        string crxFile = sitName + "*" + day.sYyyy + day.sDoy + sHh + "00_01H_30S_MO.crx";
                         string crxgzFile = crxFile + ".gz";
                         string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         string changeFileName;
 #ifdef _WIN32  /* for Windows */
                         changeFileName = "rename";
@@ -3242,7 +3365,7 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         changeFileName = "mv";
 #endif
                         cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
 
                         char tmpFile[MAXSTRPATH] = { '\0' };
                         char sep = (char)FILEPATHSEP;
@@ -3252,20 +3375,16 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         {
                             cout << "*** WARNING(FtpUtil::GetHourlyObsGa): failed to download GA hourly observation file " << oFile << endl;
 
+                            _nmiss++;
                             string url0 = url + '/' + crxgzFile;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHourlyObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                             continue;
                         }
 
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                        Crx2Rnx(dFile, oFile, fopt);
 
-                        if (access(oFile.c_str(), 0) == 0)
+                        if (ObsExists(oFile, fopt))
                         {
                             cout << "*** INFO(FtpUtil::GetHourlyObsGa): successfully download GA hourly observation file " << oFile << endl;
 
@@ -3278,7 +3397,7 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dFile;
 #endif
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
                     }
                     else cout << "*** INFO(FtpUtil::GetHourlyObsGa): GA hourly observation file " <<
@@ -3306,16 +3425,12 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url0 = "ftp://ftp.data.gnss.ga.gov.au/highrate/" + sYyyy + "/" + sDoy;
+    string url0 = string("ftp://ftp.data.gnss.ga.gov.au/highrate/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
@@ -3335,7 +3450,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                 string cmd = "mkdir -p " + sHhDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
 
             /* change directory */
@@ -3350,7 +3465,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             string crxFile = "*_15M_01S_MO.crx";
             string crxgzFile = crxFile + ".gz";
             string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObs[i] + 97;
@@ -3366,38 +3481,16 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 vector<string> crxFiles;
                 str.GetFilesAll(sHhDir, suffix, crxFiles);
                 char sitName[MAXCHARS];
+                std::vector<string> oFiles;
                 for (int j = 0; j < crxFiles.size(); j++)
                 {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
-                    {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
-                    }
+                    str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    oFiles.push_back(site + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o");
                 }
+                /* decompress and convert from 'd' files to 'o' files, several at once */
+                Crx2RnxAll(crxFiles, oFiles, fopt);
             }
         }
     }
@@ -3435,7 +3528,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -3456,20 +3549,20 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     for (int i = 0; i < minuStr.size(); i++)
                     {
                         str.ToLower(sitName);
-                        string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        string oFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "o";
+                        string dFile = sitName + day.sDoy + sch + minuStr[i] + "." + day.sYy + "d";
+                        if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                         {
                             /* it is OK for '*.gz' format */
                             str.ToUpper(sitName);
-                            string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
+                            string crxFile = sitName + "*" + day.sYyyy + day.sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
                             string crxgzFile = crxFile + ".gz";
                             string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                             /* extract '*.gz' */
                             cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             string changeFileName;
 #ifdef _WIN32  /* for Windows */
                             changeFileName = "rename";
@@ -3477,7 +3570,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             changeFileName = "mv";
 #endif
                             cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
 
                             char tmpFile[MAXSTRPATH] = { '\0' };
                             char sep = (char)FILEPATHSEP;
@@ -3487,20 +3580,16 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             {
                                 cout << "*** WARNING(FtpUtil::GetHrObsGa): failed to download GA high-rate observation file " << oFile << endl;
 
+                                _nmiss++;
                                 string url0 = url + '/' + crxgzFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetHrObsGa): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                                 continue;
                             }
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                            Crx2Rnx(dFile, oFile, fopt);
 
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (ObsExists(oFile, fopt))
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsGa): successfully download GA high-rate observation file " << oFile << endl;
 
@@ -3513,7 +3602,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                                 cmd = "rm -rf " + dFile;
 #endif
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                             }
                         }
                         else cout << "*** INFO(FtpUtil::GetHrObsGa): GA high-rate observation file " <<
@@ -3549,16 +3638,12 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
+    string url0 = string("ftp://ftp.geodetic.gov.hk/rinex3/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
     if (access(fopt->obsLst, 0) == 0)
@@ -3578,20 +3663,20 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             str.TrimSpace4String(sitName);
             if (sitName.size() != 4) continue;
             str.ToLower(sitName);
-            string oFile = sitName + sDoy + "0." + sYy + "o";
+            string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
             string url = url0 + "/" + sitName + "/30s";
-            if (access(oFile.c_str(), 0) == -1)
+            if (!ObsExists(oFile, fopt))
             {
                 /* it is OK for '*.gz' format */
                 str.ToUpper(sitName);
-                string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                string crxFile = sitName + "00HKG_R_" + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
                 string crxgzFile = crxFile + ".gz";
                 string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipFull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
@@ -3601,20 +3686,16 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     cout << "*** WARNING(FtpUtil::Get30sObsHk): failed to download HK CORS 30s observation file " << oFile << endl;
 
+                    _nmiss++;
                     string url0 = url + '/' + crxgzFile;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get30sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                     continue;
                 }
 
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                Crx2Rnx(crxFile, oFile, fopt);
 
-                if (access(oFile.c_str(), 0) == 0)
+                if (ObsExists(oFile, fopt))
                 {
                     cout << "*** INFO(FtpUtil::Get30sObsHk): successfully download HK CORS 30s observation file " << oFile << endl;
 
@@ -3627,7 +3708,7 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                     cmd = "rm -rf " + crxFile;
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
             else cout << "*** INFO(FtpUtil::Get30sObsHk): HK CORS 30s observation file " << oFile <<
@@ -3660,16 +3741,12 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
+    string url0 = string("ftp://ftp.geodetic.gov.hk/rinex3/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
     if (access(fopt->obsLst, 0) == 0)
@@ -3703,7 +3780,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                     string cmd = "mkdir -p " + sHhDir;
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
 
                 /* change directory */
@@ -3719,20 +3796,20 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string sch;
                 sch.push_back(ch);
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + sch + "." + sYy + "o";
+                string oFile = sitName + day.sDoy + sch + "." + day.sYy + "o";
                 string url = url0 + "/" + sitName + "/5s";
-                if (access(oFile.c_str(), 0) == -1)
+                if (!ObsExists(oFile, fopt))
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + sHh + "00_01H_05S_MO.crx";
+                    string crxFile = sitName + "00HKG_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_05S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
                     string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     /* extract '*.gz' */
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -3742,20 +3819,16 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         cout << "*** WARNING(FtpUtil::Get5sObsHk): failed to download HK CORS 5s observation file " << oFile << endl;
 
+                        _nmiss++;
                         string url0 = url + '/' + crxgzFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get5sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(crxFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::Get5sObsHk): successfully download HK CORS 5s observation file " << oFile << endl;
 
@@ -3768,7 +3841,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + crxFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::Get5sObsHk): HK CORS 5s observation file " << oFile <<
@@ -3802,16 +3875,12 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
+    string url0 = string("ftp://ftp.geodetic.gov.hk/rinex3/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
     if (access(fopt->obsLst, 0) == 0)
@@ -3845,7 +3914,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                     string cmd = "mkdir -p " + sHhDir;
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
 
                 /* change directory */
@@ -3861,20 +3930,20 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string sch;
                 sch.push_back(ch);
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + sch + "." + sYy + "o";
+                string oFile = sitName + day.sDoy + sch + "." + day.sYy + "o";
                 string url = url0 + "/" + sitName + "/1s";
-                if (access(oFile.c_str(), 0) == -1)
+                if (!ObsExists(oFile, fopt))
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + sHh + "00_01H_01S_MO.crx";
+                    string crxFile = sitName + "00HKG_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_01S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
                     string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     /* extract '*.gz' */
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -3884,20 +3953,16 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         cout << "*** WARNING(FtpUtil::Get1sObsHk): failed to download HK CORS 1s observation file " << oFile << endl;
 
+                        _nmiss++;
                         string url0 = url + '/' + crxgzFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(Get1sObsHk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(crxFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::Get1sObsHk): successfully download HK CORS 1s observation file " << oFile << endl;
 
@@ -3910,7 +3975,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + crxFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::Get1sObsHk): HK CORS 1s observation file " << oFile <<
@@ -3944,20 +4009,20 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url = "https://noaa-cors-pds.s3.amazonaws.com/rinex/" + sYyyy + "/" + sDoy;
+    string url = string("https://noaa-cors-pds.s3.amazonaws.com/rinex/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=4 ";
-    /* download the NGS/NOAA CORS observation file site-by-site */
-    if (access(fopt->obsLst, 0) == 0)
+
+    /* the sites of the day */
+    std::vector<string> sites;
+    bool all = strlen(fopt->obsLst) < 9;  /* the option of 'all' is selected; the length of "site.list" is nine */
+    if (!all)
     {
+        if (access(fopt->obsLst, 0) == -1) return;
         ifstream sitLst(fopt->obsLst);
         if (!sitLst.is_open())
         {
@@ -3973,62 +4038,111 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             str.TrimSpace4String(sitName);
             if (sitName.size() != 4) continue;
             str.ToLower(sitName);
-            string oFile = sitName + sDoy + "0." + sYy + "o";
-            if (access(oFile.c_str(), 0) == -1)
+            sites.push_back(sitName);
+        }
+
+        /* close 'site.list' */
+        sitLst.close();
+    }
+
+    /* the sites available in the bucket are listed, and their files downloaded in parallel */
+    bool listed = false;
+    if (fopt->ngsS3 && S3Client::Available())
+    {
+        S3Client s3(fopt->ngsS3Url, fopt);
+        string prefix = string("rinex/") + day.sYyyy + "/" + day.sDoy + "/";
+        std::vector<s3obj_t> objs;
+        if (s3.List(prefix, objs, fopt->fpLog))
+        {
+            listed = true;
+            url = string(fopt->ngsS3Url) + "/rinex/" + day.sYyyy + "/" + day.sDoy;
+            std::vector<string> avail;
+            for (int i = 0; i < objs.size(); i++)
             {
-                /* it is OK for '*.gz' format */
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                string dgzFile = dFile + ".gz";
-                string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + sitName + "/" + dgzFile;
-                std::system(cmd.c_str());
+                /* i.e., 'rinex/2024/032/algo/algo0320.24d.gz' */
+                string rest = objs[i].key.substr(prefix.size());
+                string site = rest.substr(0, rest.find('/'));
+                if (site.size() == 4 && rest == site + "/" + site + day.sDoy + "0." + day.sYy + "d.gz") avail.push_back(site);
+            }
+            sort(avail.begin(), avail.end());
+            if (all) sites = avail;
 
-                /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + dgzFile;
-                std::system(cmd.c_str());
+            std::vector<string> keys, files;
+            for (int i = 0; i < sites.size(); i++)
+            {
+                string oFile = sites[i] + day.sDoy + "0." + day.sYy + "o", dFile = sites[i] + day.sDoy + "0." + day.sYy + "d";
+                if (!std::binary_search(avail.begin(), avail.end(), sites[i]) || ObsExists(oFile, fopt) ||
+                    access(dFile.c_str(), 0) == 0) continue;
+                keys.push_back(prefix + sites[i] + "/" + dFile + ".gz");
+                files.push_back(dFile + ".gz");
+            }
+            GetParallel(keys, files, [&](const std::vector<string> &keys, const std::vector<string> &files,
+                std::vector<int> &stats) { return s3.GetAll(keys, files, stats, fopt->fpLog); }, fopt);
+        }
+    }
+    if (all && !listed)
+    {
+        cerr << "*** ERROR(FtpUtil::GetDailyObsNgs): the option of 'all' needs the S3 listing, please check 'ngsS3'" << endl;
 
-                char tmpFile[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(tmpFile, "%s%c%s", dir, sep, oFile.c_str());
-                string localFile = tmpFile;
-                if (access(dFile.c_str(), 0) == -1)
-                {
-                    cout << "*** WARNING(FtpUtil::GetDailyObsNgs): failed to download NGS/NOAA CORS daily observation file " << oFile << endl;
+        return;
+    }
+
+    /* the NGS/NOAA CORS observation file site-by-site */
+    for (int i = 0; i < sites.size(); i++)
+    {
+        string sitName = sites[i];
+        string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+        if (!ObsExists(oFile, fopt))
+        {
+            /* it is OK for '*.gz' format */
+            string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+            string dgzFile = dFile + ".gz";
+            string cmd;
+            if (!listed)
+            {
+                cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + sitName + "/" + dgzFile;
+                Wget(cmd, fopt);
+            }
 
-                    string url0 = url + '/' + dgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsNgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
+            /* extract '*.gz' */
+            cmd = gzipFull + " -d -f " + dgzFile;
+            _procs.System(cmd);
 
-                    continue;
-                }
+            char tmpFile[MAXSTRPATH] = { '\0' };
+            char sep = (char)FILEPATHSEP;
+            sprintf(tmpFile, "%s%c%s", dir, sep, oFile.c_str());
+            string localFile = tmpFile;
+            if (access(dFile.c_str(), 0) == -1)
+            {
+                cout << "*** WARNING(FtpUtil::GetDailyObsNgs): failed to download NGS/NOAA CORS daily observation file " << oFile << endl;
 
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                _nmiss++;
+                string url0 = url + '/' + sitName + '/' + dgzFile;
+                if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsNgs): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
-                if (access(oFile.c_str(), 0) == 0)
-                {
-                    cout << "*** INFO(FtpUtil::GetDailyObsNgs): successfully download NGS/NOAA CORS daily observation file " << oFile << endl;
+                continue;
+            }
+
+            Crx2Rnx(dFile, oFile, fopt);
+
+            if (ObsExists(oFile, fopt))
+            {
+                cout << "*** INFO(FtpUtil::GetDailyObsNgs): successfully download NGS/NOAA CORS daily observation file " << oFile << endl;
 
-                    string url0 = url + '/' + dgzFile;
-                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsNgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
+                string url0 = url + '/' + sitName + '/' + dgzFile;
+                if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetDailyObsNgs): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
 
-                    /* delete 'd' file */
+                /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
+                cmd = "del " + dFile;
 #else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
+                cmd = "rm -rf " + dFile;
 #endif
-                    std::system(cmd.c_str());
-                }
+                _procs.System(cmd);
             }
-            else cout << "*** INFO(FtpUtil::GetDailyObsNgs): NGS/NOAA CORS daily observation file " << oFile <<
-                " has existed!" << endl;
         }
-
-        /* close 'site.list' */
-        sitLst.close();
+        else cout << "*** INFO(FtpUtil::GetDailyObsNgs): NGS/NOAA CORS daily observation file " << oFile <<
+            " has existed!" << endl;
     }
 } /* end of GetDailyObsNgs */
 
@@ -4053,62 +4167,36 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url = "ftp://ftp.epncb.oma.be/pub/obs/" + sYyyy + "/" + sDoy;
+    string url = string("ftp://ftp.epncb.oma.be/pub/obs/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.gz' format */
-        string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+        string crxFile = string("*") + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
         string crxgzFile = crxFile + ".gz";
         string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(dir, suffix, crxFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < crxFiles.size(); i++)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete crxFile */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(crxFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -4130,20 +4218,20 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt))
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
+                    string crxFile = sitName + "*" + day.sYyyy + day.sDoy + "0000_01D_30S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
                     string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                     /* extract '*.gz' */
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
                     changeFileName = "rename";
@@ -4151,7 +4239,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     changeFileName = "mv";
 #endif
                     cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -4161,20 +4249,16 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         cout << "*** WARNING(FtpUtil::GetDailyObsEpn): failed to download EPN daily observation file " << oFile << endl;
 
+                        _nmiss++;
                         string url0 = url + '/' + crxgzFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsEpn): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsEpn): successfully download EPN daily observation file " << oFile << endl;
 
@@ -4187,7 +4271,7 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsEpn): EPN daily observation file " << oFile <<
@@ -4214,61 +4298,36 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url = "ftp://data-out.unavco.org/pub/rinex/obs/" + sYyyy + "/" + sDoy;
+    string url = string("ftp://data-out.unavco.org/pub/rinex/obs/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=5 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.Z' or '*.gz' format */
-        string dFile = "*" + sDoy + "0." + sYy + "d";
+        string dFile = string("*") + day.sDoy + "0." + day.sYy + "d";
         string dxFile = dFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
-        string suffix = "." + sYy + "d";
+        string suffix = string(".") + day.sYy + "d";
         vector<string> dFiles;
         str.GetFilesAll(dir, suffix, dFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < dFiles.size(); i++)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(dFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -4290,14 +4349,14 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dxFile = dFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                     bool isgz = false;
@@ -4305,7 +4364,7 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     {
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + dgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = true;
 
                         if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
@@ -4316,7 +4375,7 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + dzFile;
 #endif
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
                     }
 
@@ -4324,7 +4383,7 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + dzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -4336,20 +4395,16 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     {
                         cout << "*** WARNING(FtpUtil::GetDailyObsPbo2): failed to download PBO daily observation file " << oFile << endl;
 
+                        _nmiss++;
                         string url0 = url + '/' + dxFile;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo2): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsPbo2): successfully download PBO daily observation file " << oFile << endl;
 
@@ -4364,7 +4419,7 @@ void FtpUtil::GetDailyObsPbo2(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsPbo2): PBO daily observation file " << oFile <<
@@ -4398,62 +4453,36 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
-    string url = "ftp://data-out.unavco.org/pub/rinex3/obs/" + sYyyy + "/" + sDoy;
+    string url = string("ftp://data-out.unavco.org/pub/rinex3/obs/") + day.sYyyy + "/" + day.sDoy;
     string cutDirs = " --cut-dirs=5 ";
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.Z' or '*.gz' format */
-        string crxFile = "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
+        string crxFile = string("*") + day.sYyyy + day.sDoy + "0000_01D_15S_MO.crx";
         string crxxFile = crxFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(dir, suffix, crxFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < crxFiles.size(); i++)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(crxFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -4475,21 +4504,21 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
+                    string crxFile = sitName + "*" + day.sYyyy + day.sDoy + "0000_01D_15S_MO.crx";
                     string crxxFile = crxFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                     /* extract '*.gz' */
                     string crxgzFile = crxFile + ".gz";
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
                     changeFileName = "rename";
@@ -4497,7 +4526,7 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     changeFileName = "mv";
 #endif
                     cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     bool isgz = true;
                     string crxzFile;
 
@@ -4510,15 +4539,16 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         /* extract '*.Z' */
                         crxzFile = crxFile + ".Z";
                         cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
 
                         cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                         if (access(dFile.c_str(), 0) == -1)
                         {
                             cout << "*** WARNING(FtpUtil::GetDailyObsPbo3): failed to download PBO daily observation file " << oFile << endl;
 
+                            _nmiss++;
                             string url0 = url + '/' + crxxFile;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo3): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
 
@@ -4526,14 +4556,9 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         }
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsPbo3): successfully download PBO daily observation file " << oFile << endl;
 
@@ -4548,7 +4573,7 @@ void FtpUtil::GetDailyObsPbo3(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsPbo3): PBO daily observation file " << oFile <<
@@ -4583,118 +4608,60 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsLst) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
-        string url = "ftp://data-out.unavco.org/pub/rinex3/obs/" + sYyyy + "/" + sDoy;
+        string url = string("ftp://data-out.unavco.org/pub/rinex3/obs/") + day.sYyyy + "/" + day.sDoy;
         string cutDirs = " --cut-dirs=5 ";
         /* it is OK for '*.Z' or '*.gz' format */
-        string crxFile = "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
+        string crxFile = string("*") + day.sYyyy + day.sDoy + "0000_01D_15S_MO.crx";
         string crxxFile = crxFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(dir, suffix, crxFiles);
         char sitName[MAXCHARS];
+        std::vector<string> oFiles;
         for (int i = 0; i < crxFiles.size(); i++)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
-
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
-            }
+            str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            oFiles.push_back(site + day.sDoy + "0." + day.sYy + "o");
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(crxFiles, oFiles, fopt);
         
         /* to download the observation files with short name "d" */
-        url = "ftp://data-out.unavco.org/pub/rinex/obs/" + sYyyy + "/" + sDoy;
+        url = string("ftp://data-out.unavco.org/pub/rinex/obs/") + day.sYyyy + "/" + day.sDoy;
         /* it is OK for '*.Z' or '*.gz' format */
-        string dFile = "*" + sDoy + "0." + sYy + "d";
+        string dFile = string("*") + day.sDoy + "0." + day.sYy + "d";
         string dxFile = dFile + ".*";
-        cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
-
-        /* get the file list */
-        suffix = "." + sYy + "d";
-        vector<string> dFiles;
-        str.GetFilesAll(dir, suffix, dFiles);
-        for (int i = 0; i < dFiles.size(); i++)
-        {
-            if (access(dFiles[i].c_str(), 0) == 0)
-            {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                if (access(oFile.c_str(), 0) == 0)
-                {
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
-
-                    continue;
-                }
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+        WgetUnion(url, cutDirs, dxFile, fopt);  /* only the sites not taken from the higher-priority set */
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
-            }
+        /* get the file list */
+        suffix = string(".") + day.sYy + "d";
+        vector<string> dFiles;
+        str.GetFilesAll(dir, suffix, dFiles);
+        oFiles.clear();
+        for (int i = 0; i < dFiles.size(); i++)
+        {
+            str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
+            string site = sitName;
+            str.ToLower(site);
+            string oFile = site + day.sDoy + "0." + day.sYy + "o";
+            if (ObsExists(oFile, fopt)) remove(dFiles[i].c_str());  /* taken from the higher-priority set */
+            oFiles.push_back(oFile);
         }
+        /* decompress and convert from 'd' files to 'o' files, several at once */
+        Crx2RnxAll(dFiles, oFiles, fopt);
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -4716,23 +4683,23 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
                 str.TrimSpace4String(sitName);
                 if (sitName.size() != 4) continue;
                 str.ToLower(sitName);
-                string oFile = sitName + sDoy + "0." + sYy + "o";
-                string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                string oFile = sitName + day.sDoy + "0." + day.sYy + "o";
+                string dFile = sitName + day.sDoy + "0." + day.sYy + "d";
+                if (!ObsExists(oFile, fopt) && access(dFile.c_str(), 0) == -1)
                 {
-                    string url = "ftp://data-out.unavco.org/pub/rinex3/obs/" + sYyyy + "/" + sDoy;
+                    string url = string("ftp://data-out.unavco.org/pub/rinex3/obs/") + day.sYyyy + "/" + day.sDoy;
                     string cutDirs = " --cut-dirs=5 ";
                     /* it is OK for '*.Z' or '*.gz' format */
                     str.ToUpper(sitName);
-                    string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_15S_MO.crx";
+                    string crxFile = sitName + "*" + day.sYyyy + day.sDoy + "0000_01D_15S_MO.crx";
                     string crxxFile = crxFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    WgetCrx(sitName, url, cutDirs, cmd, crxFile, fopt);
 
                     /* extract '*.gz' */
                     string crxgzFile = crxFile + ".gz";
                     cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
                     changeFileName = "rename";
@@ -4740,7 +4707,7 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     changeFileName = "mv";
 #endif
                     cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
 
                     char tmpFile[MAXSTRPATH] = { '\0' };
                     char sep = (char)FILEPATHSEP;
@@ -4751,25 +4718,25 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         /* extract '*.Z' */
                         string crxzFile = crxFile + ".Z";
                         cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
 
                         cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         if (access(dFile.c_str(), 0) == -1)
                         {
                             /* to download the observation files with short name "d" */
-                            url = "ftp://data-out.unavco.org/pub/rinex/obs/" + sYyyy + "/" + sDoy;
+                            url = string("ftp://data-out.unavco.org/pub/rinex/obs/") + day.sYyyy + "/" + day.sDoy;
                             /* it is OK for '*.Z' or '*.gz' format */
                             string dxFile = dFile + ".*";
                             string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            Wget(cmd, fopt);
 
                             string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
                             if (access(dgzFile.c_str(), 0) == 0)
                             {
                                 /* extract '*.gz' */
                                 cmd = gzipFull + " -d -f " + dgzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
 
                                 if (access(dFile.c_str(), 0) == 0 && access(dzFile.c_str(), 0) == 0)
                                 {
@@ -4779,19 +4746,20 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                                     cmd = "rm -rf " + dzFile;
 #endif
-                                    std::system(cmd.c_str());
+                                    _procs.System(cmd);
                                 }
                             }
                             if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
                             {
                                 /* extract '*.Z' */
                                 cmd = gzipFull + " -d -f " + dzFile;
-                                std::system(cmd.c_str());
+                                _procs.System(cmd);
                             }
                             if (access(dFile.c_str(), 0) == -1)
                             {
                                 cout << "*** WARNING(FtpUtil::GetDailyObsPbo5): failed to download PBO daily observation file " << oFile << endl;
 
+                                _nmiss++;
                                 string url0 = url + '/' + crxxFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDailyObsPbo5): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                                 url0 = url + '/' + dxFile;
@@ -4802,14 +4770,9 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         }
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    Crx2Rnx(dFile, oFile, fopt);
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (ObsExists(oFile, fopt))
                     {
                         cout << "*** INFO(FtpUtil::GetDailyObsPbo5): successfully download PBO daily observation file " << oFile << endl;
 
@@ -4821,7 +4784,7 @@ void FtpUtil::GetDailyObsPbo5(gtime_t ts, const char dir[], const ftpopt_t *fopt
 #else           /* for Linux or Mac */
                         cmd = "rm -rf " + dFile;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
                 else cout << "*** INFO(FtpUtil::GetDailyObsPbo5): PBO daily observation file " << oFile <<
@@ -4847,13 +4810,9 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
@@ -4881,22 +4840,22 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         if (navSys == "gps")
         {
             /* GPS broadcast ephemeris file */
-            navFile = "brdc" + sDoy + "0." + sYy + "n";
+            navFile = string("brdc") + day.sDoy + "0." + day.sYy + "n";
         }
         else if (navSys == "glo")
         {
             /* GLONASS broadcast ephemeris file */
-            navFile = "brdc" + sDoy + "0." + sYy + "g";
+            navFile = string("brdc") + day.sDoy + "0." + day.sYy + "g";
         }
         else if (navSys == "mixed3")
         {
             /* multi-GNSS broadcast ephemeris file in RINEX 3.xx format */
-            navFile = "BRDC00" + navAc + "_R_" + sYyyy + sDoy + "0000_01D_MN.rnx";
+            navFile = "BRDC00" + navAc + "_R_" + day.sYyyy + day.sDoy + "0000_01D_MN.rnx";
         }
         else if (navSys == "mixed4")
         {
             /* multi-GNSS broadcast ephemeris file in RINEX 4.xx format */
-            navFile = "BRD400DLR_S_" + sYyyy + sDoy + "0000_01D_MN.rnx";
+            navFile = string("BRD400DLR_S_") + day.sYyyy + day.sDoy + "0000_01D_MN.rnx";
         }
 
         if (access(navFile.c_str(), 0) == -1)
@@ -4904,30 +4863,30 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
             string url, cutDirs = " --cut-dirs=6 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_NAV] + "/" +
-                sYyyy + "/brdc";
+                day.sYyyy + "/brdc";
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_NAV] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_NAV] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=5 ";
             }
             else if (ftpName == "WHU")
             {
-                if (yyyy >= 2020) url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/brdc";
+                if (day.yyyy >= 2020) url = _ftpArchive.WHU[IDX_NAV] + "/" + day.sYyyy + "/brdc";
                 else
                 {
-                    if (navSys == "gps") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "n";
-                    else if (navSys == "glo") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "g";
-                    if (navSys == "mixed3") url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "p";
+                    if (navSys == "gps") url = _ftpArchive.WHU[IDX_NAV] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "n";
+                    else if (navSys == "glo") url = _ftpArchive.WHU[IDX_NAV] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "g";
+                    if (navSys == "mixed3") url = _ftpArchive.WHU[IDX_NAV] + "/" + day.sYyyy + "/" + day.sDoy + "/" + day.sYy + "p";
                 }
                 cutDirs = " --cut-dirs=7 ";
             }
-            else url = _ftpArchive.CDDIS[IDX_NAV] + "/" + sYyyy + "/brdc";
+            else url = _ftpArchive.CDDIS[IDX_NAV] + "/" + day.sYyyy + "/brdc";
 
             if (navSys == "mixed3")
             {
                 if (navAc == "DLR")
                 {
-                    navFile = "BRDM00" + navAc + "_S_" + sYyyy + sDoy + "0000_01D_MN.rnx";
+                    navFile = "BRDM00" + navAc + "_S_" + day.sYyyy + day.sDoy + "0000_01D_MN.rnx";
                     if (ftpName != "CDDIS" && ftpName != "WHU")
                     {
                         cerr << "*** ERROR(FtpUtil::GetNav): DLR mixed broadcast ephemeris file is ONLY downloaded from CDDIS or WHU FTP!" << endl;
@@ -4946,12 +4905,12 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 }
                 else if (navAc == "GOP")
                 {
-                    url = "ftp://ftp.pecny.cz/LDC/orbits_brd/gop3/" + sYyyy;
+                    url = string("ftp://ftp.pecny.cz/LDC/orbits_brd/gop3/") + day.sYyyy;
                     cutDirs = " --cut-dirs=4 ";
                 }
                 else if (navAc == "WRD")
                 {
-                    url = "https://igs.bkg.bund.de/root_ftp/IGS/BRDC/" + sYyyy + "/" + sDoy;
+                    url = string("https://igs.bkg.bund.de/root_ftp/IGS/BRDC/") + day.sYyyy + "/" + day.sDoy;
                     cutDirs = " --cut-dirs=5 ";
                 }
             }
@@ -4970,7 +4929,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 cmd = wgetFull + " " + qr + " -nH -A " + navxFile + cutDirs + url;
                 url0 = url + "/" + navxFile;
             }
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             string navgzFile = navFile + ".gz", navzFile = navFile + ".Z";
             bool isgz = false;
@@ -4978,14 +4937,14 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             {
                 /* extract '*.gz' */
                 cmd = gzipFull + " -d -f " + navgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 isgz = true;
             }
             else if (access(navzFile.c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
                 cmd = gzipFull + " -d -f " + navzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 isgz = false;
             }
 
@@ -5011,7 +4970,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
 
@@ -5042,6 +5001,10 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 return;
             }
 
+            /* merged broadcast ephemeris of each hour (-1: the whole day) */
+            std::map<int, NavUtil> navMrgs;
+            std::map<int, string> navMrgFiles;
+
             string sitName;
             while (getline(sitLst, sitName))
             {
@@ -5063,7 +5026,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
                         string cmd = "mkdir -p " + sHhDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     /* change directory */
@@ -5073,23 +5036,36 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     chdir(sHhDir.c_str());
 #endif
 
+                    /* the merged file is built incrementally, starting from that of the last run if any */
+                    int iMrg = fopt->mergeNav == NAVMRG_HOURLY ? fopt->hhNav[i] : -1;
+                    if (fopt->mergeNav != NAVMRG_OFF && navMrgs.find(iMrg) == navMrgs.end())
+                    {
+                        char mrgFile[MAXSTRPATH] = { '\0' };
+                        if (iMrg >= 0) sprintf(mrgFile, "%s%cBRDM00GOD_R_%s%s%s00_01H_MN.rnx", sHhDir.c_str(), sep,
+                            day.sYyyy, day.sDoy, sHh.c_str());
+                        else sprintf(mrgFile, "%s%cBRDM00GOD_R_%s%s0000_01D_MN.rnx", dir, sep, day.sYyyy, day.sDoy);
+                        navMrgFiles[iMrg] = mrgFile;
+                        NavUtil &navMrg = navMrgs[iMrg];
+                        if (access(mrgFile, 0) == 0) navMrg.InputFile(mrgFile);
+                    }
+
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhNav[i] + 97;
                     char ch = ii;
                     string sch;
                     sch.push_back(ch);
                     str.ToLower(sitName);
-                    string navnsFile = sitName + sDoy + sch + "." + sYy + "n";  /* short file name */
-                    string navgsFile = sitName + sDoy + sch + "." + sYy + "g";
+                    string navnsFile = sitName + day.sDoy + sch + "." + day.sYy + "n";  /* short file name */
+                    string navgsFile = sitName + day.sDoy + sch + "." + day.sYy + "g";
                     
                     str.ToUpper(sitName);
-                    string navnlFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_GN.rnx";  /* long file name */
-                    string navglFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_RN.rnx";
-                    string navclFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_CN.rnx";
-                    string navelFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_EN.rnx";
-                    string navjlFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_JN.rnx";
-                    string navilFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_IN.rnx";
-                    string navmlFile = sitName + "*_R_" + sYyyy + sDoy + sHh + "00_01H_MN.rnx";
+                    string navnlFile = sitName + "*_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_GN.rnx";  /* long file name */
+                    string navglFile = sitName + "*_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_RN.rnx";
+                    string navclFile = sitName + "*_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_CN.rnx";
+                    string navelFile = sitName + "*_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_EN.rnx";
+                    string navjlFile = sitName + "*_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_JN.rnx";
+                    string navilFile = sitName + "*_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_IN.rnx";
+                    string navmlFile = sitName + "*_R_" + day.sYyyy + day.sDoy + sHh + "00_01H_MN.rnx";
                     std::vector<string> navFiles;
                     if (navSys == "gps")
                     {
@@ -5120,15 +5096,15 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     }
 
                     str.ToLower(sitName);
-                    string navns0File = sitName + sDoy + sch + "." + sYy + "n";
-                    string navgs0File = sitName + sDoy + sch + "." + sYy + "g";
-                    string navnl0File = sitName + sDoy + sch + "." + sYy + "gn";
-                    string navgl0File = sitName + sDoy + sch + "." + sYy + "rn";
-                    string navcl0File = sitName + sDoy + sch + "." + sYy + "cn";
-                    string navel0File = sitName + sDoy + sch + "." + sYy + "en";
-                    string navjl0File = sitName + sDoy + sch + "." + sYy + "jn";
-                    string navil0File = sitName + sDoy + sch + "." + sYy + "in";
-                    string navml0File = sitName + sDoy + sch + "." + sYy + "mn";
+                    string navns0File = sitName + day.sDoy + sch + "." + day.sYy + "n";
+                    string navgs0File = sitName + day.sDoy + sch + "." + day.sYy + "g";
+                    string navnl0File = sitName + day.sDoy + sch + "." + day.sYy + "gn";
+                    string navgl0File = sitName + day.sDoy + sch + "." + day.sYy + "rn";
+                    string navcl0File = sitName + day.sDoy + sch + "." + day.sYy + "cn";
+                    string navel0File = sitName + day.sDoy + sch + "." + day.sYy + "en";
+                    string navjl0File = sitName + day.sDoy + sch + "." + day.sYy + "jn";
+                    string navil0File = sitName + day.sDoy + sch + "." + day.sYy + "in";
+                    string navml0File = sitName + day.sDoy + sch + "." + day.sYy + "mn";
                     std::vector<string> nav0Files;
                     if (navSys == "gps")
                     {
@@ -5162,26 +5138,26 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         string url, cutDirs = " --cut-dirs=7 ";
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
-                            sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
                         else if (ftpName == "IGN")
                         {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
+                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy;
                             cutDirs = " --cut-dirs=6 ";
                         }
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" + 
-                            sYyyy + "/" + sDoy + "/" + sHh;
-                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
+                            day.sYyyy + "/" + day.sDoy + "/" + sHh;
+                        else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + day.sYyyy + "/" + day.sDoy + "/" + sHh;
 
                         /* it is OK for '*.Z' or '*.gz' format */
                         string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
                         string navxFile = navFiles[i] + ".*";
                         string cmd = wgetFull + " " + qr + " -nH -A " + navxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
 
                         /* extract '*.gz' */
                         string navgzFile = navFiles[i] + ".gz";
                         cmd = gzipFull + " -d -f " + navgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         string changeFileName;
 #ifdef _WIN32  /* for Windows */
                         changeFileName = "rename";
@@ -5189,7 +5165,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         changeFileName = "mv";
 #endif
                         cmd = changeFileName + " " + navFiles[i] + " " + nav0Files[i];
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         bool isgz = true;
                         string navzFile;
                         char tmpFile[MAXSTRPATH] = { '\0' };
@@ -5201,10 +5177,10 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             /* extract '*.Z' */
                             navzFile = navFiles[i] + ".Z";
                             cmd = gzipFull + " -d -f " + navzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
 
                             cmd = changeFileName + " " + navFiles[i] + " " + nav0Files[i];
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = false;
                             if (access(nav0Files[i].c_str(), 0) == 0)
                             {
@@ -5215,6 +5191,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                                 else navxFile = navzFile;
                                 string url0 = url + '/' + navxFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetNav): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
+                                if (fopt->mergeNav != NAVMRG_OFF) navMrgs[iMrg].InputFile(nav0Files[i].c_str());
 
                                 continue;
                             }
@@ -5223,6 +5200,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                                 cout << "*** WARNING(FtpUtil::GetNav): failed to download hourly broadcast ephemeris file " <<
                                     navFiles[i] << endl;
 
+                                _nmiss++;
                                 string url0 = url + '/' + navxFile;
                                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetNav): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                             }
@@ -5236,6 +5214,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             else navxFile = navzFile;
                             string url0 = url + '/' + navxFile;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetNav): %s  ->  %s  OK\n", url0.c_str(), localFile.c_str());
+                            if (fopt->mergeNav != NAVMRG_OFF) navMrgs[iMrg].InputFile(nav0Files[i].c_str());
 
                             continue;
                         }
@@ -5245,6 +5224,22 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             /* close 'site.list' */
             sitLst.close();
+
+            /* write the merged broadcast ephemeris files */
+            for (std::map<int, NavUtil>::iterator it = navMrgs.begin(); it != navMrgs.end(); ++it)
+            {
+                if (it->second.NumRecords() == 0) continue;
+                string mrgFile = navMrgFiles[it->first];
+                if (it->second.WriteFile(mrgFile.c_str()))
+                {
+                    cout << "*** INFO(FtpUtil::GetNav): merged broadcast ephemeris file " << mrgFile << " (" <<
+                        it->second.NumRecords() << " records, " << it->second.NumDups() << " duplicates dropped)" << endl;
+
+                    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetNav): %d files  ->  %s  merged, %d records, %d duplicates dropped\n",
+                        it->second.NumFiles(), mrgFile.c_str(), it->second.NumRecords(), it->second.NumDups());
+                }
+                else if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetNav): %s  merging failed\n", mrgFile.c_str());
+            }
         }
     }
 } /* end of GetNav */
@@ -5264,15 +5259,9 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 {
     /* compute GPS week and day of week */
     TimeUtil tu;
-    int wwww, dow;
-    dow = tu.time2gpst(ts, &wwww, nullptr);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sWwww = str.wwww2str(wwww);
-    string sDow(to_string(dow));
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    string sYyyy = str.yyyy2str(yyyy);
-    string sDoy = str.doy2str(doy);
 
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
@@ -5282,7 +5271,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
     str.ToLower(ac);
     if (prodType == PROD_REALTIME)          /* for CNES real-time orbit and clock products from CNES offline files  */
     {
-        string sp3File = ac + sWwww + sDow + ".sp3", clkFile = ac + sWwww + sDow + ".clk";
+        string sp3File = ac + day.sWwww + day.sDow + ".sp3", clkFile = ac + day.sWwww + day.sDow + ".clk";
         std::vector<string> sp3clkFiles = { sp3File, clkFile };
         string sp3gzFile = sp3File + ".gz", clkgzFile = clkFile + ".gz";
         std::vector<string> sp3clkgzFiles = { sp3gzFile, clkgzFile };
@@ -5295,15 +5284,17 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
             chdir(dirs[i].c_str());
 #endif
 
-            if (access(sp3clkFiles[i].c_str(), 0) == -1)
+            /* the offline files are updated under the same name during the day */
+            string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + sp3clkgzFiles[i];
+            if (_catalog.Outdated(sp3clkFiles[i], { url }, fopt->fpLog))
             {
-                string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + sp3clkgzFiles[i];
                 string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                std::system(cmd.c_str());
+                _procs.System(cmd);
+                _catalog.Done(sp3clkFiles[i], fopt->fpLog);
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
@@ -5326,6 +5317,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     else if (i == 1) cout << "*** WARNING(FtpUtil::GetOrbClk): failed to download CNES real-time precise clock file " <<
                         sp3clkFiles[i] << endl;
 
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOrbClk): %s  ->  %s  failed\n", url.c_str(), localFile.c_str());
                 }
 
@@ -5340,7 +5332,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpDir[i];
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
             }
@@ -5366,7 +5358,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         int idx = 0;
         if (ac == "esa_u")       /* ESA */
         {
-            url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
+            url = string("http://navigation-office.esa.int/products/gnss-products/") + day.sWwww;
             cutDirs = " --cut-dirs=3 ";
             acFile = "esu";
             acName = "ESA";
@@ -5374,7 +5366,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         }
         else if (ac == "gfz_u")  /* GFZ */
         {
-            url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w" + sWwww;
+            url = string("ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w") + day.sWwww;
             cutDirs = " --cut-dirs=5 ";
             acFile = "gfu";
             acName = "GFZ";
@@ -5382,10 +5374,10 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         }
         else if (ac == "igs_u")  /* IGS */
         {
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
+            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + day.sWwww;
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + day.sWwww;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + day.sWwww;
+            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + day.sWwww;
             cutDirs = " --cut-dirs=4 ";
             acFile = "igu";
             acName = "IGS";
@@ -5393,10 +5385,10 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         }
         else if (ac == "whu_u")  /* WHU */
         {
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
+            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + day.sWwww;
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + day.sWwww;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + day.sWwww;
+            else url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + day.sWwww;
             cutDirs = " --cut-dirs=5 ";
             acName = "WHU";
             acFile = "wuu";
@@ -5406,7 +5398,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         for (int i = 0; i < fopt->hhOrbClk[idx].size(); i++)
         {
             string sHh = str.hh2str(fopt->hhOrbClk[idx][i]);
-            string sp3File = acFile + sWwww + sDow + "_" + sHh + ".sp3";
+            string sp3File = acFile + day.sWwww + day.sDow + "_" + sHh + ".sp3";
             if (access(sp3File.c_str(), 0) == -1)
             {
                 string cmd, url0, sp3zFile, sp3gzFile, sp3xFile;
@@ -5416,13 +5408,13 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     sp3zFile = sp3File + ".Z";
                     url0 = url + "/" + sp3zFile;
                     cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     if (access(sp3zFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
                     else
@@ -5430,29 +5422,29 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                         sp3gzFile = sp3File + ".gz";
                         url0 = url + "/" + sp3gzFile;
                         cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
 
                         if (access(sp3gzFile.c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
                             cmd = gzipFull + " -d -f " + sp3gzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = true;
                         }
                     }
                 }
                 else if (ac == "whu_u")  /* WHU */
                 {
-                    string sp30File = "WUM0MGXULA_" + sYyyy + sDoy + sHh + "00_01D_*_ORB.SP3";
+                    string sp30File = string("WUM0MGXULA_") + day.sYyyy + day.sDoy + sHh + "00_01D_*_ORB.SP3";
                     /* it is OK for '*.Z' or '*.gz' format */
                     sp3xFile = sp30File + ".*";
                     cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     /* extract '*.gz' */
                     sp3gzFile = sp30File + ".gz";
                     cmd = gzipFull + " -d -f " + sp3gzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
                     changeFileName = "rename";
@@ -5460,17 +5452,17 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     changeFileName = "mv";
 #endif
                     cmd = changeFileName + " " + sp30File + " " + sp3File;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = true;
                     if (access(sp3File.c_str(), 0) == -1)
                     {
                         /* extract '*.Z' */
                         sp3zFile = sp30File + ".Z";
                         cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
 
                         cmd = changeFileName + " " + sp30File + " " + sp3File;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -5481,7 +5473,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     /* it is OK for '*.Z' or '*.gz' format */
                     sp3xFile = sp3File + ".*";
                     cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     sp3gzFile = sp3File + ".gz";
                     sp3zFile = sp3File + ".Z";
@@ -5489,14 +5481,14 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     {
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + sp3gzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = true;
                     }
                     if (access(sp3File.c_str(), 0) == -1 && access(sp3zFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -5522,6 +5514,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     cout << "*** WARNING(FtpUtil::GetOrbClk): failed to download " << acName << " ultra-rapid precise orbit file " <<
                         sp3File << endl;
 
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOrbClk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
 
@@ -5536,7 +5529,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
             }
@@ -5550,44 +5543,44 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         string sp3File, clkFile;
         if (ac == "cod_r")  /* CODE */
         {
-            sp3File = "COD" + sWwww + sDow + ".EPH_M";
-            clkFile = "COD" + sWwww + sDow + ".CLK_M";
-            url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy + "_M";
+            sp3File = string("COD") + day.sWwww + day.sDow + ".EPH_M";
+            clkFile = string("COD") + day.sWwww + day.sDow + ".CLK_M";
+            url = string("ftp://ftp.aiub.unibe.ch/CODE/") + day.sYyyy + "_M";
             cutDirs = " --cut-dirs=2 ";
             acName = "CODE";
         }
         else if (ac == "emr_r")  /* NRCan */
         {
-            sp3File = "emr" + sWwww + sDow + ".sp3";
-            clkFile = "emr" + sWwww + sDow + ".clk";
-            url = "ftp://rtopsdata1.geod.nrcan.gc.ca/gps/products/rapid/" + sWwww;
+            sp3File = string("emr") + day.sWwww + day.sDow + ".sp3";
+            clkFile = string("emr") + day.sWwww + day.sDow + ".clk";
+            url = string("ftp://rtopsdata1.geod.nrcan.gc.ca/gps/products/rapid/") + day.sWwww;
             cutDirs = " --cut-dirs=4 ";
             acName = "NRCan";
         }
         else if (ac == "esa_r")  /* ESA */
         {
-            sp3File = "esr" + sWwww + sDow + ".sp3";
-            clkFile = "esr" + sWwww + sDow + ".clk";
-            url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
+            sp3File = string("esr") + day.sWwww + day.sDow + ".sp3";
+            clkFile = string("esr") + day.sWwww + day.sDow + ".clk";
+            url = string("http://navigation-office.esa.int/products/gnss-products/") + day.sWwww;
             cutDirs = " --cut-dirs=3 ";
             acName = "ESA";
         }
         else if (ac == "gfz_r")  /* GFZ */
         {
-            sp3File = "gfz" + sWwww + sDow + ".sp3";
-            clkFile = "gfz" + sWwww + sDow + ".clk";
-            url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/rapid/w" + sWwww;
+            sp3File = string("gfz") + day.sWwww + day.sDow + ".sp3";
+            clkFile = string("gfz") + day.sWwww + day.sDow + ".clk";
+            url = string("ftp://ftp.gfz-potsdam.de/pub/GNSS/products/rapid/w") + day.sWwww;
             cutDirs = " --cut-dirs=5 ";
             acName = "GFZ";
         }
         else if (ac == "igs_r")  /* IGS */
         {
-            sp3File = "igr" + sWwww + sDow + ".sp3";
-            clkFile = "igr" + sWwww + sDow + ".clk";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
+            sp3File = string("igr") + day.sWwww + day.sDow + ".sp3";
+            clkFile = string("igr") + day.sWwww + day.sDow + ".clk";
+            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + day.sWwww;
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + day.sWwww;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + day.sWwww;
+            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + day.sWwww;
             cutDirs = " --cut-dirs=4 ";
             acName = "IGS";
         }
@@ -5616,26 +5609,26 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 {
                     url0 = url + "/" + sp3clkzFiles[i];
                     cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     if (access(sp3zFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
                     else
                     {
                         url0 = url + "/" + sp3clkgzFiles[i];
                         cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
 
                         if (access(sp3clkgzFiles[i].c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
                             cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = true;
                         }
                     }
@@ -5644,13 +5637,13 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     cmd = wgetFull + " " + qr + " -nH -A " + sp3clkxFiles[i] + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     if (access(sp3clkgzFiles[i].c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = true;
 
                         if (access(sp3clkFiles[i].c_str(), 0) == 0 && access(sp3clkzFiles[i].c_str(), 0) == 0)
@@ -5661,14 +5654,14 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 #else           /* for Linux or Mac */
                             cmd = "rm -rf " + sp3clkzFiles[i];
 #endif
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
                     }
                     if (access(sp3clkFiles[i].c_str(), 0) == -1 && access(sp3clkzFiles[i].c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -5699,6 +5692,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                     else if (i == 1) cout << "*** WARNING(FtpUtil::GetOrbClk): failed to download " << acName << " rapid precise clock file " <<
                         sp3clkFiles[i] << endl;
 
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOrbClk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
 
@@ -5715,7 +5709,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
             }
@@ -5730,19 +5724,19 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
     }
     else if (prodType == PROD_FINAL_IGS)  /* for IGS final orbit and clock products  */
     {
-        string sp3File = ac + sWwww + sDow + ".sp3";
-        string clkFile = ac + sWwww + sDow + ".clk";
+        string sp3File = ac + day.sWwww + day.sDow + ".sp3";
+        string clkFile = ac + day.sWwww + day.sDow + ".clk";
         string acName;
         if (ac == "cod")
         {
-            sp3File = ac + sWwww + sDow + ".eph";
-            clkFile = ac + sWwww + sDow + ".clk_05s";
+            sp3File = ac + day.sWwww + day.sDow + ".eph";
+            clkFile = ac + day.sWwww + day.sDow + ".clk_05s";
             acName = "CODE";
         }
         else if (ac == "igs")
         {
-            sp3File = ac + sWwww + sDow + ".sp3";
-            clkFile = ac + sWwww + sDow + ".clk_30s";
+            sp3File = ac + day.sWwww + day.sDow + ".sp3";
+            clkFile = ac + day.sWwww + day.sDow + ".clk_30s";
             acName = "IGS";
         }
         else if (ac == "emr") acName = "NRCan";
@@ -5761,10 +5755,10 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         std::vector<string> sp3clkxFiles = { sp3xFile, clkxFile };
 
         string url, cutDirs = " --cut-dirs=4 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
+        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + day.sWwww;
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + day.sWwww;
+        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + day.sWwww;
+        else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + day.sWwww;
         for (int i = 0; i < sp3clkFiles.size(); i++)
         {
             /* change directory */
@@ -5778,21 +5772,21 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string cmd = wgetFull + " " + qr + " -nH -A " + sp3clkxFiles[i] + cutDirs + url;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 bool isgz = false;
                 if (access(sp3clkgzFiles[i].c_str(), 0) == 0)
                 {
                     /* extract '*.gz' */
                     cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = true;
                 }
                 if (access(sp3clkFiles[i].c_str(), 0) == -1 && access(sp3clkzFiles[i].c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
                     cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = false;
                 }
 
@@ -5821,6 +5815,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                         sp3clkFiles[i] << endl;
 
                     string url0 = url + '/' + sp3clkxFiles[i];
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOrbClk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
 
@@ -5833,7 +5828,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
             else
@@ -5850,65 +5845,65 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         string sp3File, clkFile, subStr, acName, sp3MgexFile, clkMgexFile;
         if (ac == "cod_m")
         {
-            sp3File = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ORB.SP3";
-            clkFile = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_CLK.CLK";
-            sp3MgexFile = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._ORB.SP3";
-            clkMgexFile = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._CLK.CLK";
-            subStr = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+            sp3File = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ORB.SP3";
+            clkFile = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_CLK.CLK";
+            sp3MgexFile = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_ORB.SP3";
+            clkMgexFile = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_CLK.CLK";
+            subStr = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
             acName = "CODE";
         }
         else if (ac == "gfz_m")
         {
-            sp3File = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_ORB.SP3";
-            clkFile = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_CLK.CLK";
-            subStr = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
-            sp3MgexFile= "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "..._ORB.SP3";
-            clkMgexFile = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "..._CLK.CLK";
+            sp3File = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ORB.SP3";
+            clkFile = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_CLK.CLK";
+            subStr = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
+            sp3MgexFile= string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_ORB.SP3";
+            clkMgexFile = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_CLK.CLK";
             acName = "GFZ";
         }
         else if (ac == "grg_m")
         {
-            sp3File = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ORB.SP3";
-            clkFile = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_CLK.CLK";
-            subStr = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
-            sp3MgexFile = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._ORB.SP3";
-            clkMgexFile = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._CLK.CLK";
+            sp3File = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ORB.SP3";
+            clkFile = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_CLK.CLK";
+            subStr = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
+            sp3MgexFile = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_ORB.SP3";
+            clkMgexFile = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_CLK.CLK";
             acName = "CNES";
         }
         else if (ac == "iac_m")
         {
-            sp3File = "IAC0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ORB.SP3";
-            clkFile = "IAC0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_CLK.CLK";
-            subStr = "IAC0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
-            sp3MgexFile = "IAC0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._ORB.SP3";
-            clkMgexFile = "IAC0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._CLK.CLK";
+            sp3File = string("IAC0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ORB.SP3";
+            clkFile = string("IAC0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_CLK.CLK";
+            subStr = string("IAC0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
+            sp3MgexFile = string("IAC0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_ORB.SP3";
+            clkMgexFile = string("IAC0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_CLK.CLK";
             acName = "IAC";
         }
         else if (ac == "jax_m")
         {
-            sp3File = "JAX0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ORB.SP3";
-            clkFile = "JAX0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_CLK.CLK";
-            subStr = "JAX0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
-            sp3MgexFile = "JAX0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._ORB.SP3";
-            clkMgexFile = "JAX0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._CLK.CLK";
+            sp3File = string("JAX0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ORB.SP3";
+            clkFile = string("JAX0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_CLK.CLK";
+            subStr = string("JAX0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
+            sp3MgexFile = string("JAX0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_ORB.SP3";
+            clkMgexFile = string("JAX0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_CLK.CLK";
             acName = "JAXA";
         }
         else if (ac == "sha_m")
         {
-            sp3File = "SHA0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_ORB.SP3";
-            clkFile = "SHA0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_CLK.CLK";
-            subStr = "SHA0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
-            sp3MgexFile = "SHA0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "..._ORB.SP3";
-            clkMgexFile = "SHA0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "..._CLK.CLK";
+            sp3File = string("SHA0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ORB.SP3";
+            clkFile = string("SHA0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_CLK.CLK";
+            subStr = string("SHA0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
+            sp3MgexFile = string("SHA0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_ORB.SP3";
+            clkMgexFile = string("SHA0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_CLK.CLK";
             acName = "SHAO";
         }
         else if (ac == "whu_m")
         {
-            sp3File = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ORB.SP3";
-            clkFile = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_CLK.CLK";
-            subStr = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
-            sp3MgexFile = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._ORB.SP3";
-            clkMgexFile = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "..._CLK.CLK";
+            sp3File = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ORB.SP3";
+            clkFile = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_CLK.CLK";
+            subStr = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
+            sp3MgexFile = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_ORB.SP3";
+            clkMgexFile = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "???_CLK.CLK";
             acName = "WHU";
         }
 
@@ -5922,10 +5917,10 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
         std::vector<string> sp3clkMgexFiles = { sp3MgexFile, clkMgexFile };
 
         string url, cutDirs = " --cut-dirs=5 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
+        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + day.sWwww;
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + day.sWwww;
+        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + day.sWwww;
+        else url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + day.sWwww;
         for (int i = 0; i < sp3clkFiles.size(); i++)
         {
             /* change directory */
@@ -5940,11 +5935,11 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string cmd = wgetFull + " " + qr + " -nH -A " + sp3clkxFiles[i] + cutDirs + url;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 /* extract '*.gz' */
                 cmd = gzipFull + " -d -f " + sp3clkgzFiles[i];
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 bool isgz = true;
 
                 str.GetFile(dirs[i], sp3clkMgexFiles[i], sp3clk0File);
@@ -5956,7 +5951,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                 {
                     /* extract '*.Z' */
                     cmd = gzipFull + " -d -f " + sp3clkzFiles[i];
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
 
                     isgz = false;
 
@@ -5971,6 +5966,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, std::vector<string> dirs, int prodType, stri
                             sp3clk0File << endl;
 
                         string url0 = url + '/' + sp3clkxFiles[i];
+                        _nmiss++;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOrbClk): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
@@ -6013,11 +6009,9 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
     /* compute GPS week and day of week */
     TimeUtil tu;
-    int wwww, dow;
-    dow = tu.time2gpst(ts, &wwww, nullptr);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sWwww = str.wwww2str(wwww);
-    string sDow(to_string(dow));
 
     string ac(fopt->eopAc);
     str.TrimSpace4String(ac);
@@ -6060,6 +6054,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     if (!isUltra && !isIGS)
     {
+        _nmiss++;
         cerr << "*** ERROR(FtpUtil::GetEop): Please check the setting of the 2nd item of getEop in configure file!" << endl;
 
         return;
@@ -6088,7 +6083,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
         string cmd = "mkdir -p " + subDir;
 #endif
-        std::system(cmd.c_str());
+        _procs.System(cmd);
     }
 
     /* change directory */
@@ -6107,24 +6102,24 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         string url, cutDirs, acName, acFile;
         if (ac == "esa_u")       /* ESA */
         {
-            url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
+            url = string("http://navigation-office.esa.int/products/gnss-products/") + day.sWwww;
             cutDirs = " --cut-dirs=3 ";
             acFile = "esu";
             acName = "ESA";
         }
         else if (ac == "gfz_u")  /* GFZ */
         {
-            url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w" + sWwww;
+            url = string("ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w") + day.sWwww;
             cutDirs = " --cut-dirs=5 ";
             acFile = "gfu";
             acName = "GFZ";
         }
         else if (ac == "igs_u")  /* IGS */
         {
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
+            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_EOP] + "/" + day.sWwww;
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + day.sWwww;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + day.sWwww;
+            else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + day.sWwww;
             cutDirs = " --cut-dirs=4 ";
             acFile = "igu";
             acName = "IGS";
@@ -6133,7 +6128,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         for (int i = 0; i < fopt->hhEop.size(); i++)
         {
             string sHh = str.hh2str(fopt->hhEop[i]);
-            string eopFile = acFile + sWwww + sDow + "_" + sHh + ".erp";
+            string eopFile = acFile + day.sWwww + day.sDow + "_" + sHh + ".erp";
             if (access(eopFile.c_str(), 0) == -1)
             {
                 string cmd, url0, eopzFile, eopgzFile, eopxFile;
@@ -6143,13 +6138,13 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     eopzFile = eopFile + ".Z";
                     url0 = url + "/" + eopzFile;
                     cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     if (access(eopzFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + eopzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
                     else
@@ -6157,13 +6152,13 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         eopgzFile = eopFile + ".gz";
                         url0 = url + "/" + eopgzFile;
                         cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
 
                         if (access(eopgzFile.c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
                             cmd = gzipFull + " -d -f " + eopgzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = true;
                         }
                     }
@@ -6173,7 +6168,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     /* it is OK for '*.Z' or '*.gz' format */
                     eopxFile = eopFile + ".*";
                     cmd = wgetFull + " " + qr + " -nH -A " + eopxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     eopgzFile = eopFile + ".gz";
                     eopzFile = eopFile + ".Z";
@@ -6181,14 +6176,14 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + eopgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = true;
                     }
                     if (access(eopFile.c_str(), 0) == -1 && access(eopzFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + eopzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -6212,6 +6207,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     cout << "*** INFO(FtpUtil::GetEop): failed to download " << acName << " ultra-rapid EOP file " << eopFile << endl;
 
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetEop): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
 
@@ -6226,7 +6222,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
                         cmd = "rm -rf " + tmpDir;
 #endif
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
                 }
             }
@@ -6245,20 +6241,20 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         else if (ac == "jpl") acName = "JPL";
         else if (ac == "mit") acName = "MIT";
 
-        string eopFile = ac + sWwww + "7.erp";
+        string eopFile = ac + day.sWwww + "7.erp";
         if (access(eopFile.c_str(), 0) == -1)
         {
             /* download the EOP file */
             string url, cutDirs = " --cut-dirs=4 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_EOP] + "/" + sWwww;
+            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_EOP] + "/" + day.sWwww;
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + day.sWwww;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + day.sWwww;
+            else url = _ftpArchive.CDDIS[IDX_EOP] + "/" + day.sWwww;
 
             /* it is OK for '*.Z' or '*.gz' format */
             string eopxFile = eopFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + eopxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             string eopgzFile = eopFile + ".gz", eopzFile = eopFile + ".Z";
             bool isgz = false;
@@ -6266,14 +6262,14 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             {
                 /* extract '*.gz' */
                 cmd = gzipFull + " -d -f " + eopgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 isgz = true;
             }
             if (access(eopFile.c_str(), 0) == -1 && access(eopzFile.c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
                 cmd = gzipFull + " -d -f " + eopzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 isgz = false;
             }
 
@@ -6295,6 +6291,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 cout << "*** INFO(FtpUtil::GetEop): failed to download " << acName << " final EOP file " << eopFile << endl;
 
                 string url0 = url + '/' + eopxFile;
+                _nmiss++;
                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetEop): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
             }
 
@@ -6307,7 +6304,7 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
                 cmd = "rm -rf " + tmpDir;
 #endif
-                std::system(cmd.c_str());
+                _procs.System(cmd);
             }
         }
         else cout << "*** INFO(FtpUtil::GetEop): " << acName << " final EOP file " << eopFile << " has existed!" << endl;
@@ -6334,15 +6331,9 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute GPS week and day of week */
     TimeUtil tu;
-    int wwww, dow;
-    dow = tu.time2gpst(ts, &wwww, nullptr);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sWwww = str.wwww2str(wwww);
-    string sDow(to_string(dow));
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    string sYyyy = str.yyyy2str(yyyy);
-    string sDoy = str.doy2str(doy);
 
     string ac(fopt->obxAc);
     str.TrimSpace4String(ac);
@@ -6371,6 +6362,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     if (!isRt && !isMGEX)
     {
+        _nmiss++;
         cerr << "*** ERROR(FtpUtil::GetObx): Please check the setting of the 2nd item of getObx in configure file!" << endl;
 
         return;
@@ -6382,17 +6374,18 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (isRt)  /* for CNES real-time ORBEX from CNES offline files  */
     {
-        string obxFile = ac + sWwww + sDow + ".obx";
-        if (access(obxFile.c_str(), 0) == -1)
+        string obxFile = ac + day.sWwww + day.sDow + ".obx";
+        string obxgzFile = obxFile + ".gz";
+        string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + obxgzFile;
+        if (_catalog.Outdated(obxFile, { url }, fopt->fpLog))
         {
-            string obxgzFile = obxFile + ".gz";
-            string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + obxgzFile;
             string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* extract '*.gz' */
             cmd = gzipFull + " -d -f " + obxgzFile;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
+            _catalog.Done(obxFile, fopt->fpLog);
 
             char tmpFile[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
@@ -6408,6 +6401,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             {
                 cout << "*** INFO(FtpUtil::GetObx): failed to download CNES real-time ORBEX file " << obxFile << endl;
 
+                _nmiss++;
                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetObx): %s  ->  %s  failed\n", url.c_str(), localFile.c_str());
             }
 
@@ -6422,7 +6416,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpDir[i];
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
         }
@@ -6432,10 +6426,10 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     else if (isMGEX)  /* for MGEX final ORBEX files  */
     {
         string url, cutDirs = " --cut-dirs=5 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBXM] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBXM] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBXM] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_OBXM] + "/" + sWwww;
+        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBXM] + "/" + day.sWwww;
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBXM] + "/" + day.sWwww;
+        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBXM] + "/" + day.sWwww;
+        else url = _ftpArchive.CDDIS[IDX_OBXM] + "/" + day.sWwww;
 
         string dir0 = dir;
         if (ac == "all")
@@ -6446,26 +6440,26 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string obxFile, subStr, acName;
                 if (ac_m == "cod")
                 {
-                    obxFile = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                    subStr = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                    obxFile = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                    subStr = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "CODE";
                 }
                 else if (ac_m == "gfz")
                 {
-                    obxFile = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                    subStr = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
+                    obxFile = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                    subStr = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "GFZ";
                 }
                 else if (ac_m == "grg")
                 {
-                    obxFile = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                    subStr = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                    obxFile = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                    subStr = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "CNES";
                 }
                 else if (ac_m == "whu")
                 {
-                    obxFile = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                    subStr = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                    obxFile = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                    subStr = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "WHU";
                 }
 
@@ -6476,12 +6470,12 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     /* it is OK for '*.Z' or '*.gz' format */
                     string obxxFile = obxFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + obxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     /* extract '*.gz' */
                     string obxgzFile = obxFile + ".gz";
                     cmd = gzipFull + " -d -f " + obxgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     bool isgz = true;
                     str.GetFile(dir0, subStr, obx0File);
                     char tmpFile[MAXSTRPATH] = { '\0' };
@@ -6494,7 +6488,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         /* extract '*.Z' */
                         obxzFile = obxFile + ".Z";
                         cmd = gzipFull + " -d -f " + obxzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
 
                         str.GetFile(dir0, subStr, obx0File);
@@ -6505,6 +6499,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             cout << "*** INFO(FtpUtil::GetObx): failed to download " << acName << " MGEX ORBEX file " << obx0File << endl;
 
                             string url0 = url + '/' + obxxFile;
+                            _nmiss++;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetObx): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
                     }
@@ -6527,26 +6522,26 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             string obxFile, subStr, acName;
             if (ac == "cod")
             {
-                obxFile = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                subStr = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                obxFile = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                subStr = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "CODE";
             }
             else if (ac == "gfz")
             {
-                obxFile = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                subStr = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
+                obxFile = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                subStr = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "GFZ";
             }
             else if (ac == "grg")
             {
-                obxFile = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                subStr = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                obxFile = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                subStr = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "CNES";
             }
             else if (ac == "whu")
             {
-                obxFile = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_ATT.OBX";
-                subStr = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                obxFile = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_ATT.OBX";
+                subStr = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "WHU";
             }
 
@@ -6557,12 +6552,12 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 /* it is OK for '*.Z' or '*.gz' format */
                 string obxxFile = obxFile + ".*";
                 string cmd = wgetFull + " " + qr + " -nH -A " + obxxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 /* extract '*.gz' */
                 string obxgzFile = obxFile + ".gz";
                 cmd = gzipFull + " -d -f " + obxgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 bool isgz = true;
                 str.GetFile(dir0, subStr, obx0File);
                 char tmpFile[MAXSTRPATH] = { '\0' };
@@ -6575,7 +6570,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     /* extract '*.Z' */
                     obxzFile = obxFile + ".Z";
                     cmd = gzipFull + " -d -f " + obxzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = false;
                     
                     str.GetFile(dir0, subStr, obx0File);
@@ -6586,6 +6581,7 @@ void FtpUtil::GetObx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         cout << "*** INFO(FtpUtil::GetObx): failed to download " << acName << " MGEX ORBEX file " << obx0File << endl;
 
                         string url0 = url + '/' + obxxFile;
+                        _nmiss++;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetObx): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
@@ -6625,11 +6621,9 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sDoy = str.doy2str(doy);
 
     string ac(fopt->dsbAc);
     str.TrimSpace4String(ac);
@@ -6645,28 +6639,28 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string ftpName = fopt->ftpFrom;
                 str.TrimSpace4String(ftpName);
                 str.ToUpper(ftpName);
-                string dsbFile = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_01D_DCB.BSX";
+                string dsbFile = string("CAS0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_01D_DCB.BSX";
                 if (access(dsbFile.c_str(), 0) == -1)
                 {
                     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
                     string url, cutDirs = " --cut-dirs=5 ";
-                    if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
+                    if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + day.sYyyy;
                     else if (ftpName == "IGN")
                     {
-                        url = _ftpArchive.IGN[IDX_DSBM] + "/" + sYyyy;
+                        url = _ftpArchive.IGN[IDX_DSBM] + "/" + day.sYyyy;
                         cutDirs = " --cut-dirs=6 ";
                     }
                     else if (ftpName == "WHU")
                     {
-                        url = _ftpArchive.WHU[IDX_DSBM] + "/" + sYyyy;
+                        url = _ftpArchive.WHU[IDX_DSBM] + "/" + day.sYyyy;
                         cutDirs = " --cut-dirs=6 ";
                     }
-                    else url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
+                    else url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + day.sYyyy;
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dsbxFile = dsbFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + dsbxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     string dsbgzFile = dsbFile + ".gz", dsbzFile = dsbFile + ".Z";
                     bool isgz = false;
@@ -6674,14 +6668,14 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + dsbgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = true;
                     }
                     else if (access(dsbzFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + dsbzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -6703,6 +6697,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         cout << "*** INFO(FtpUtil::GetDsb): failed to download multi-GNSS DSB file " << dsbFile << endl;
 
                         string url0 = url + '/' + dsbxFile;
+                        _nmiss++;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDsb): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
@@ -6710,8 +6705,6 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             }
             else if (ac_m == "cod")  /* CODE DCB */
             {
-                int yy = tu.yyyy2yy(yyyy);
-                string sYy = str.yy2str(yy);
                 double date[6];
                 tu.time2ymdhms(ts, date);
                 int mm = (int)date[1];
@@ -6721,20 +6714,20 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 std::vector<string> dcbType = { "P1P2", "P1C1", "P2C2" };
                 for (int i = 0; i < dcbType.size(); i++)
                 {
-                    dcbFile = dcbType[i] + sYy + sMm + ".DCB";
-                    dcb0File = dcbType[i] + sYy + sMm + ".DCB";
-                    if (dcbType[i] == "P2C2") dcbFile = dcbType[i] + sYy + sMm + "_RINEX.DCB";
+                    dcbFile = dcbType[i] + day.sYy + sMm + ".DCB";
+                    dcb0File = dcbType[i] + day.sYy + sMm + ".DCB";
+                    if (dcbType[i] == "P2C2") dcbFile = dcbType[i] + day.sYy + sMm + "_RINEX.DCB";
 
                     if (access(dcbFile.c_str(), 0) == -1 && access(dcb0File.c_str(), 0) == -1)
                     {
                         /* download CODE DCB file */
                         string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-                        string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
+                        string url = string("ftp://ftp.aiub.unibe.ch/CODE/") + day.sYyyy;
 
                         /* it is OK for '*.Z' or '*.gz' format */
                         string dcbxFile = dcbFile + ".*";
                         string cmd = wgetFull + " " + qr + " -nH -A " + dcbxFile + " --cut-dirs=2 " + url;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
 
                         string dcbgzFile = dcbFile + ".gz", dcbzFile = dcbFile + ".Z";
                         bool isgz = false;
@@ -6742,14 +6735,14 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         {
                             /* extract '*.gz' */
                             cmd = gzipFull + " -d -f " + dcbgzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = true;
                         }
                         else if (access(dcbzFile.c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
                             cmd = gzipFull + " -d -f " + dcbzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = false;
                         }
 
@@ -6762,6 +6755,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             cout << "*** INFO(FtpUtil::GetDsb): failed to download CODE DCB file " << dcbFile << endl;
 
                             string url0 = url + '/' + dcbxFile;
+                            _nmiss++;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDsb): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
 
@@ -6774,7 +6768,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             changeFileName = "mv";
 #endif
                             cmd = changeFileName + " " + dcbFile + " " + dcb0File;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                         }
 
                         if (access(dcb0File.c_str(), 0) == 0)
@@ -6799,28 +6793,28 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             string ftpName = fopt->ftpFrom;
             str.TrimSpace4String(ftpName);
             str.ToUpper(ftpName);
-            string dsbFile = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_01D_DCB.BSX";
+            string dsbFile = string("CAS0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_01D_DCB.BSX";
             if (access(dsbFile.c_str(), 0) == -1)
             {
                 string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
                 string url, cutDirs = " --cut-dirs=5 ";
-                if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
+                if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + day.sYyyy;
                 else if (ftpName == "IGN")
                 {
-                    url = _ftpArchive.IGN[IDX_DSBM] + "/" + sYyyy;
+                    url = _ftpArchive.IGN[IDX_DSBM] + "/" + day.sYyyy;
                     cutDirs = " --cut-dirs=6 ";
                 }
                 else if (ftpName == "WHU")
                 {
-                    url = _ftpArchive.WHU[IDX_DSBM] + "/" + sYyyy;
+                    url = _ftpArchive.WHU[IDX_DSBM] + "/" + day.sYyyy;
                     cutDirs = " --cut-dirs=6 ";
                 }
-                else url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + sYyyy;
+                else url = _ftpArchive.CDDIS[IDX_DSBM] + "/" + day.sYyyy;
 
                 /* it is OK for '*.Z' or '*.gz' format */
                 string dsbxFile = dsbFile + ".*";
                 string cmd = wgetFull + " " + qr + " -nH -A " + dsbxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 string dsbgzFile = dsbFile + ".gz", dsbzFile = dsbFile + ".Z";
                 bool isgz = false;
@@ -6828,14 +6822,14 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     /* extract '*.gz' */
                     cmd = gzipFull + " -d -f " + dsbgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = true;
                 }
                 else if (access(dsbzFile.c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
                     cmd = gzipFull + " -d -f " + dsbzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = false;
                 }
 
@@ -6857,6 +6851,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     cout << "*** INFO(FtpUtil::GetDsb): failed to download multi-GNSS DSB file " << dsbFile << endl;
 
                     string url0 = url + '/' + dsbxFile;
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDsb): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
             }
@@ -6864,8 +6859,6 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         }
         else if (ac == "cod")  /* CODE DCB */
         {
-            int yy = tu.yyyy2yy(yyyy);
-            string sYy = str.yy2str(yy);
             double date[6];
             tu.time2ymdhms(ts, date);
             int mm = (int)date[1];
@@ -6875,20 +6868,20 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             std::vector<string> dcbType = { "P1P2", "P1C1", "P2C2" };
             for (int i = 0; i < dcbType.size(); i++)
             {
-                dcbFile = dcbType[i] + sYy + sMm + ".DCB";
-                dcb0File = dcbType[i] + sYy + sMm + ".DCB";
-                if (dcbType[i] == "P2C2") dcbFile = dcbType[i] + sYy + sMm + "_RINEX.DCB";
+                dcbFile = dcbType[i] + day.sYy + sMm + ".DCB";
+                dcb0File = dcbType[i] + day.sYy + sMm + ".DCB";
+                if (dcbType[i] == "P2C2") dcbFile = dcbType[i] + day.sYy + sMm + "_RINEX.DCB";
 
                 if (access(dcbFile.c_str(), 0) == -1 && access(dcb0File.c_str(), 0) == -1)
                 {
                     /* download CODE DCB file */
                     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-                    string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
+                    string url = string("ftp://ftp.aiub.unibe.ch/CODE/") + day.sYyyy;
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dcbxFile = dcbFile + ".*";
                     string cmd = wgetFull + " " + qr + " -nH -A " + dcbxFile + " --cut-dirs=2 " + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
 
                     string dcbgzFile = dcbFile + ".gz", dcbzFile = dcbFile + ".Z";
                     bool isgz = false;
@@ -6896,14 +6889,14 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     {
                         /* extract '*.gz' */
                         cmd = gzipFull + " -d -f " + dcbgzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = true;
                     }
                     else if (access(dcbzFile.c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
                         cmd = gzipFull + " -d -f " + dcbzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
                     }
 
@@ -6916,6 +6909,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         cout << "*** INFO(FtpUtil::GetDsb): failed to download CODE DCB file " << dcbFile << endl;
 
                         string url0 = url + '/' + dcbxFile;
+                        _nmiss++;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetDsb): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
 
@@ -6928,7 +6922,7 @@ void FtpUtil::GetDsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         changeFileName = "mv";
 #endif
                         cmd = changeFileName + " " + dcbFile + " " + dcb0File;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                     }
 
                     if (access(dcb0File.c_str(), 0) == 0)
@@ -6967,15 +6961,9 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute GPS week and day of week */
     TimeUtil tu;
-    int wwww, dow;
-    dow = tu.time2gpst(ts, &wwww, nullptr);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sWwww = str.wwww2str(wwww);
-    string sDow(to_string(dow));
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    string sYyyy = str.yyyy2str(yyyy);
-    string sDoy = str.doy2str(doy);
 
     string ac(fopt->osbAc);
     str.TrimSpace4String(ac);
@@ -7004,6 +6992,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     if (!isRt && !isMGEX)
     {
+        _nmiss++;
         cerr << "*** ERROR(FtpUtil::Getsb): Please check the setting of the 2nd item of getOsb in configure file!" << endl;
 
         return;
@@ -7015,17 +7004,18 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (isRt)  /* for CNES real-time OSB from CNES offline files  */
     {
-        string osbFile = ac + sWwww + sDow + ".bia";
-        if (access(osbFile.c_str(), 0) == -1)
+        string osbFile = ac + day.sWwww + day.sDow + ".bia";
+        string osbgzFile = osbFile + ".gz";
+        string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + osbgzFile;
+        if (_catalog.Outdated(osbFile, { url }, fopt->fpLog))
         {
-            string osbgzFile = osbFile + ".gz";
-            string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + osbgzFile;
             string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* extract '*.gz' */
             cmd = gzipFull + " -d -f " + osbgzFile;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
+            _catalog.Done(osbFile, fopt->fpLog);
 
             char tmpFile[MAXSTRPATH] = { '\0' };
             char sep = (char)FILEPATHSEP;
@@ -7041,6 +7031,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             {
                 cout << "*** INFO(FtpUtil::GetOsb): failed to download CNES real-time OSB file " << osbFile << endl;
 
+                _nmiss++;
                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOsb): %s  ->  %s  failed\n", url.c_str(), localFile.c_str());
             }
 
@@ -7055,7 +7046,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpDir[i];
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
         }
@@ -7065,10 +7056,10 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     else if (isMGEX)  /* for MGEX final OSB files  */
     {
         string url, cutDirs = " --cut-dirs=5 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OSBM] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OSBM] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OSBM] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_OSBM] + "/" + sWwww;
+        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OSBM] + "/" + day.sWwww;
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OSBM] + "/" + day.sWwww;
+        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OSBM] + "/" + day.sWwww;
+        else url = _ftpArchive.CDDIS[IDX_OSBM] + "/" + day.sWwww;
 
         string dir0 = dir;
         if (ac == "all")
@@ -7079,32 +7070,32 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string osbFile, subStr, acName;
                 if (ac_m == "cas")
                 {
-                    osbFile = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                    subStr = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
+                    osbFile = string("CAS0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                    subStr = string("CAS0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "CAS";
                 }
                 else if (ac_m == "cod")
                 {
-                    osbFile = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                    subStr = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                    osbFile = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                    subStr = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "CODE";
                 }
                 else if (ac_m == "gfz")
                 {
-                    osbFile = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                    subStr = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
+                    osbFile = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                    subStr = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "GFZ";
                 }
                 else if (ac_m == "grg")
                 {
-                    osbFile = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                    subStr = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                    osbFile = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                    subStr = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "CNES";
                 }
                 else if (ac_m == "whu")
                 {
-                    osbFile = "WUM0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                    subStr = "WUM0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
+                    osbFile = string("WUM0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                    subStr = string("WUM0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
                     acName = "WHU";
                 }
 
@@ -7118,21 +7109,21 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     string cmd;
                     if (ac_m == "cas")
                     {
-                        string url0 = "ftp://ftp.gipp.org.cn/product/dcb/mgex/" + sYyyy;
+                        string url0 = string("ftp://ftp.gipp.org.cn/product/dcb/mgex/") + day.sYyyy;
                         string cutDirs0 = " --cut-dirs=4 ";
                         cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs0 + url0;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
                     }
                     else
                     {
                         cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
                     }
 
                     /* extract '*.gz' */
                     string osbgzFile = osbFile + ".gz";
                     cmd = gzipFull + " -d -f " + osbgzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     bool isgz = true;
                     str.GetFile(dir0, subStr, osb0File);
                     if (ac_m == "cas") osb0File = "CAS0MGXRAP_20220320000_01D_01D_OSB.BIA";  /* The filenames of CAS OSB and DSB have a large degree of overlap */
@@ -7146,7 +7137,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         /* extract '*.Z' */
                         osbzFile = osbFile + ".Z";
                         cmd = gzipFull + " -d -f " + osbzFile;
-                        std::system(cmd.c_str());
+                        _procs.System(cmd);
                         isgz = false;
 
                         str.GetFile(dir0, subStr, osb0File);
@@ -7158,6 +7149,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             cout << "*** INFO(FtpUtil::GetOsb): failed to download " << acName << " MGEX OSB file " << osb0File << endl;
 
                             string url0 = url + '/' + osbxFile;
+                            _nmiss++;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOsb): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
                     }
@@ -7180,32 +7172,32 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             string osbFile, subStr, acName;
             if (ac == "cas")
             {
-                osbFile = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                subStr = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
+                osbFile = string("CAS0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                subStr = string("CAS0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "CAS";
             }
             else if (ac == "cod")
             {
-                osbFile = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                subStr = "COD0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                osbFile = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                subStr = string("COD0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "CODE";
             }
             else if (ac == "gfz")
             {
-                osbFile = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                subStr = "GFZ0MGXRAP_" + sYyyy + sDoy + "0000_01D_";
+                osbFile = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                subStr = string("GFZ0MGXRAP_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "GFZ";
             }
             else if (ac == "grg")
             {
-                osbFile = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                subStr = "GRG0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                osbFile = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                subStr = string("GRG0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "CNES";
             }
             else if (ac == "whu")
             {
-                osbFile = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_" + "*_OSB.BIA";
-                subStr = "WUM0MGXFIN_" + sYyyy + sDoy + "0000_01D_";
+                osbFile = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_" + "*_OSB.BIA";
+                subStr = string("WUM0MGXFIN_") + day.sYyyy + day.sDoy + "0000_01D_";
                 acName = "WHU";
             }
 
@@ -7219,21 +7211,21 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string cmd;
                 if (ac == "cas")
                 {
-                    string url0 = "ftp://ftp.gipp.org.cn/product/dcb/mgex/" + sYyyy;
+                    string url0 = string("ftp://ftp.gipp.org.cn/product/dcb/mgex/") + day.sYyyy;
                     string cutDirs0 = " --cut-dirs=4 ";
                     cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs0 + url0;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
                 }
                 else
                 {
                     cmd = wgetFull + " " + qr + " -nH -A " + osbxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    Wget(cmd, fopt);
                 }
 
                 /* extract '*.gz' */
                 string osbgzFile = osbFile + ".gz";
                 cmd = gzipFull + " -d -f " + osbgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 bool isgz = true;
                 str.GetFile(dir0, subStr, osb0File);
                 if (ac == "cas") osb0File = "CAS0MGXRAP_20220320000_01D_01D_OSB.BIA";  /* The filenames of CAS OSB and DSB have a large degree of overlap */
@@ -7247,7 +7239,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     /* extract '*.Z' */
                     osbzFile = osbFile + ".Z";
                     cmd = gzipFull + " -d -f " + osbzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = false;
 
                     str.GetFile(dir0, subStr, osb0File);
@@ -7259,6 +7251,7 @@ void FtpUtil::GetOsb(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         cout << "*** INFO(FtpUtil::GetOsb): failed to download " << acName << " MGEX OSB file " << osb0File << endl;
 
                         string url0 = url + '/' + osbxFile;
+                        _nmiss++;
                         if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetOsb): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                     }
                 }
@@ -7298,35 +7291,33 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute GPS week and day of week */
     TimeUtil tu;
-    int wwww;
-    int dow = tu.time2gpst(ts, &wwww, nullptr);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sWwww = str.wwww2str(wwww);
-    string sDow(to_string(dow));
 
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string snx0File = "igs" + sWwww + ".snx";
+    string snx0File = string("igs") + day.sWwww + ".snx";
     if (access(snx0File.c_str(), 0) == -1)
     {
         string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;        
         string url, cutDirs = " --cut-dirs=4 ";
-        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
-        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + sWwww;
-        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + sWwww;
-        else url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
+        if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + day.sWwww;
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + day.sWwww;
+        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + day.sWwww;
+        else url = _ftpArchive.CDDIS[IDX_SNX] + "/" + day.sWwww;
         
         /* it is OK for '*.Z' or '*.gz' format */
-        string snxFile = "igs*P" + sWwww + ".snx";
+        string snxFile = string("igs*P") + day.sWwww + ".snx";
         string snxxFile = snxFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + snxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         /* extract '*.Z' */
         string snxzFile = snxFile + ".Z";
         cmd = gzipFull + " -d -f " + snxzFile;
-        std::system(cmd.c_str());
+        _procs.System(cmd);
         string changeFileName;
 #ifdef _WIN32  /* for Windows */
         changeFileName = "rename";
@@ -7334,7 +7325,7 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         changeFileName = "mv";
 #endif
         cmd = changeFileName + " " + snxFile + " " + snx0File;
-        std::system(cmd.c_str());
+        _procs.System(cmd);
         bool isgz = false;
         string snxgzFile;
         char tmpFile[MAXSTRPATH] = { '\0' };
@@ -7346,16 +7337,17 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             /* extract '*.Z' */
             snxgzFile = snxFile + ".gz";
             cmd = gzipFull + " -d -f " + snxgzFile;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
 
             cmd = changeFileName + " " + snxFile + " " + snx0File;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
             isgz = true;
             if (access(snx0File.c_str(), 0) == -1)
             {
                 cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " << snx0File << endl;
 
                 string url0 = url + '/' + snxxFile;
+                _nmiss++;
                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetSnx): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
             }
         }
@@ -7364,21 +7356,21 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         if (access(snx0File.c_str(), 0) == -1)
         {
             string url, cutDirs = " --cut-dirs=4 ";
-            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
-            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + sWwww;
-            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + sWwww;
-            else url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
+            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + day.sWwww;
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + day.sWwww;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + day.sWwww;
+            else url = _ftpArchive.CDDIS[IDX_SNX] + "/" + day.sWwww;
             
             /* it is OK for '*.Z' or '*.gz' format */
-            string snxFile = "igs*P" + sWwww + sDow + ".snx";
+            string snxFile = string("igs*P") + day.sWwww + day.sDow + ".snx";
             string snxxFile = snxFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + snxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* extract '*.Z' */
             string snxzFile = snxFile + ".Z";
             cmd = gzipFull + " -d -f " + snxzFile;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
             string changeFileName;
 #ifdef _WIN32  /* for Windows */
             changeFileName = "rename";
@@ -7386,23 +7378,24 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             changeFileName = "mv";
 #endif
             cmd = changeFileName + " " + snxFile + " " + snx0File;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
             isgz = false;
             if (access(snx0File.c_str(), 0) == -1)
             {
                 /* extract '*.Z' */
                 string snxgzFile = snxFile + ".gz";
                 cmd = gzipFull + " -d -f " + snxgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
 
                 cmd = changeFileName + " " + snxFile + " " + snx0File;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 isgz = true;
                 if (access(snx0File.c_str(), 0) == -1)
                 {
                     cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " << snx0File << endl;
 
                     string url0 = url + '/' + snxxFile;
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetSnx): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
             }
@@ -7427,7 +7420,7 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
             cmd = "rm -rf " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
     }
     else cout << "*** INFO(FtpUtil::GetSnx): IGS weekly SINEX file " << snx0File << " has existed!" << endl;
@@ -7453,13 +7446,9 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
@@ -7571,23 +7560,27 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         for (int i = 0; i < acFiles.size(); i++)
         {
             string acFile = acFiles[i];
-            string ionFile = acFile + "g" + sDoy + "0." + sYy + "i";
-            if (access(ionFile.c_str(), 0) == -1)
+            string ionFile = acFile + "g" + day.sDoy + "0." + day.sYy + "i";
+            string url, cutDirs = " --cut-dirs=6 ";
+            if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ION] + "/" +
+                day.sYyyy + "/" + day.sDoy;
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ION] + "/" +
+                day.sYyyy + "/" + day.sDoy;
+            else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ION] + "/" +
+                day.sYyyy + "/" + day.sDoy;
+            else url = _ftpArchive.CDDIS[IDX_ION] + "/" + day.sYyyy + "/" + day.sDoy;
+
+            /* the predicted GIMs are updated under the same name until the final ones come */
+            bool predicted = acFile == "c1p" || acFile == "c2p";
+            if (predicted ? _catalog.Outdated(ionFile, { url + "/" + ionFile + ".gz", url + "/" + ionFile + ".Z" },
+                fopt->fpLog) : access(ionFile.c_str(), 0) == -1)
             {
                 string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-                string url, cutDirs = " --cut-dirs=6 ";
-                if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ION] + "/" +
-                    sYyyy + "/" + sDoy;
-                else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ION] + "/" +
-                    sYyyy + "/" + sDoy;
-                else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ION] + "/" +
-                    sYyyy + "/" + sDoy;
-                else url = _ftpArchive.CDDIS[IDX_ION] + "/" + sYyyy + "/" + sDoy;
 
                 /* it is OK for '*.Z' or '*.gz' format */
                 string ionxFile = ionFile + ".*";
                 string cmd = wgetFull + " " + qr + " -nH -A " + ionxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                Wget(cmd, fopt);
 
                 string iongzFile = ionFile + ".gz", ionzFile = ionFile + ".Z";
                 bool isgz = false;
@@ -7595,16 +7588,17 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     /* extract '*.gz' */
                     cmd = gzipFull + " -d -f " + iongzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = true;
                 }
                 else if (access(ionzFile.c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
                     cmd = gzipFull + " -d -f " + ionzFile;
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                     isgz = false;
                 }
+                if (predicted) _catalog.Done(ionFile, fopt->fpLog);
 
                 char tmpFile[MAXSTRPATH] = { '\0' };
                 char sep = (char)FILEPATHSEP;
@@ -7624,6 +7618,7 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     cout << "*** INFO(FtpUtil::GetIono): failed to download GIM file " << ionFile << endl;
 
                     string url0 = url + '/' + ionxFile;
+                    _nmiss++;
                     if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetIono): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                 }
 
@@ -7636,7 +7631,7 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
                     cmd = "rm -rf " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
             else cout << "*** INFO(FtpUtil::GetIono): GIM file " << ionFile << " has existed!" << endl;
@@ -7664,34 +7659,30 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
 
     string ftpName = fopt->ftpFrom;
     str.TrimSpace4String(ftpName);
     str.ToUpper(ftpName);
-    string rotFile = "roti" + sDoy + "0." + sYy + "f";
+    string rotFile = string("roti") + day.sDoy + "0." + day.sYy + "f";
     if (access(rotFile.c_str(), 0) == -1)
     {
         string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
         string url, cutDirs = " --cut-dirs=6 ";
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ROTI] + "/" +
-            sYyyy + "/" + sDoy;
+            day.sYyyy + "/" + day.sDoy;
         else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ROTI] + "/" +
-            sYyyy + "/" + sDoy;
+            day.sYyyy + "/" + day.sDoy;
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ROTI] + "/" +
-            sYyyy + "/" + sDoy;
-        else url = _ftpArchive.CDDIS[IDX_ROTI] + "/" + sYyyy + "/" + sDoy;
+            day.sYyyy + "/" + day.sDoy;
+        else url = _ftpArchive.CDDIS[IDX_ROTI] + "/" + day.sYyyy + "/" + day.sDoy;
 
         /* it is OK for '*.Z' or '*.gz' format */
         string rotxFile = rotFile + ".*";
         string cmd = wgetFull + " " + qr + " -nH -A " + rotxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
 
         string rotgzFile = rotFile + ".gz", rotzFile = rotFile + ".Z";
         bool isgz = false;
@@ -7699,14 +7690,14 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         {
             /* extract '*.gz' */
             cmd = gzipFull + " -d -f " + rotgzFile;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
             isgz = true;
         }
         else if (access(rotzFile.c_str(), 0) == 0)
         {
             /* extract '*.Z' */
             cmd = gzipFull + " -d -f " + rotzFile;
-            std::system(cmd.c_str());
+            _procs.System(cmd);
             isgz = false;
         }
 
@@ -7740,7 +7731,7 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else          /* for Linux or Mac */
             cmd = "rm -rf " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
     }
     else cout << "*** INFO(FtpUtil::GetRoti): ROTI file " << rotFile << " has existed!" << endl;
@@ -7766,17 +7757,9 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* compute day of year */
     TimeUtil tu;
-    int yyyy, doy;
-    tu.time2yrdoy(ts, &yyyy, &doy);
-    int yy = tu.yyyy2yy(yyyy);
+    daydesc_t day;
+    tu.DayDesc(ts, day);
     StringUtil str;
-    string sYyyy = str.yyyy2str(yyyy);
-    string sYy = str.yy2str(yy);
-    string sDoy = str.doy2str(doy);
-    int wwww;
-    int dow = tu.time2gpst(ts, &wwww, nullptr);
-    string sWwww = str.wwww2str(wwww);
-    string sDow(to_string(dow));
 
     string ac(fopt->trpAc);
     str.TrimSpace4String(ac);
@@ -7797,7 +7780,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + subDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
         /* change directory */
@@ -7816,24 +7799,24 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             /* download all the IGS ZPD files */
             string url, cutDirs = " --cut-dirs=7 ";
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ZTD] + "/" +
-                sYyyy + "/" + sDoy;
+                day.sYyyy + "/" + day.sDoy;
             else if (ftpName == "IGN")
             {
-                url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
+                url = _ftpArchive.IGN[IDX_ZTD] + "/" + day.sYyyy + "/" + day.sDoy;
                 cutDirs = " --cut-dirs=6 ";
             }
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ZTD] + "/" +
-                sYyyy + "/" + sDoy;
-            else url = _ftpArchive.CDDIS[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
+                day.sYyyy + "/" + day.sDoy;
+            else url = _ftpArchive.CDDIS[IDX_ZTD] + "/" + day.sYyyy + "/" + day.sDoy;
 
             /* it is OK for '*.Z' or '*.gz' format */
-            string zpdFile = "*" + sDoy + "0." + sYy + "zpd";
+            string zpdFile = string("*") + day.sDoy + "0." + day.sYy + "zpd";
             string zpdxFile = zpdFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + zpdxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             /* get the file list */
-            string suffix = "." + sYy + "zpd";
+            string suffix = string(".") + day.sYy + "zpd";
             vector<string> zpdFiles;
             str.GetFilesAll(dir, suffix, zpdFiles);
             for (int i = 0; i < zpdFiles.size(); i++)
@@ -7842,7 +7825,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     /* extract it */
                     cmd = gzipFull + " -d -f " + zpdFiles[i];
-                    std::system(cmd.c_str());
+                    _procs.System(cmd);
                 }
             }
         }
@@ -7866,24 +7849,24 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     str.TrimSpace4String(sitName);
                     if (sitName.size() != 4) continue;
                     str.ToLower(sitName);
-                    string zpdFile = sitName + sDoy + "0." + sYy + "zpd";
+                    string zpdFile = sitName + day.sDoy + "0." + day.sYy + "zpd";
                     if (access(zpdFile.c_str(), 0) == -1)
                     {
                         string url, cutDirs = " --cut-dirs=7 ";
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ZTD] + "/" +
-                            sYyyy + "/" + sDoy;
+                            day.sYyyy + "/" + day.sDoy;
                         else if (ftpName == "IGN")
                         {
-                            url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
+                            url = _ftpArchive.IGN[IDX_ZTD] + "/" + day.sYyyy + "/" + day.sDoy;
                             cutDirs = " --cut-dirs=6 ";
                         }
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ZTD] + "/" +
-                            sYyyy + "/" + sDoy;
+                            day.sYyyy + "/" + day.sDoy;
                         
                         /* it is OK for '*.Z' or '*.gz' format */
                         string zpdxFile = zpdFile + ".*";
                         string cmd = wgetFull + " " + qr + " -nH -A " + zpdxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        Wget(cmd, fopt);
 
                         string zpdgzFile = zpdFile + ".gz", zpdzFile = zpdFile + ".Z";
                         bool isgz = false;
@@ -7891,14 +7874,14 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         {
                             /* extract '*.gz' */
                             cmd = gzipFull + " -d -f " + zpdgzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = true;
                         }
                         else if (access(zpdzFile.c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
                             cmd = gzipFull + " -d -f " + zpdzFile;
-                            std::system(cmd.c_str());
+                            _procs.System(cmd);
                             isgz = false;
                         }
 
@@ -7919,6 +7902,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         {
                             cout << "*** WARNING(FtpUtil::GetTrop): failed to download IGS tropospheric product file " << zpdFile << endl;
 
+                            _nmiss++;
                             string url0 = url + '/' + zpdxFile;
                             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetTrop): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
                         }
@@ -7947,7 +7931,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + subDir;
     #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
         /* change directory */
@@ -7957,16 +7941,16 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         chdir(subDir.c_str());
     #endif
 
-        string trpFile = "COD" + sWwww + sDow + ".TRO";
+        string trpFile = string("COD") + day.sWwww + day.sDow + ".TRO";
         if (access(trpFile.c_str(), 0) == -1)
         {
-            string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
+            string url = string("ftp://ftp.aiub.unibe.ch/CODE/") + day.sYyyy;
             string cutDirs = " --cut-dirs=2 ";
 
             /* it is OK for '*.Z' or '*.gz' format */
             string trpxFile = trpFile + ".*";
             string cmd = wgetFull + " " + qr + " -nH -A " + trpxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            Wget(cmd, fopt);
 
             string trpgzFile = trpFile + ".gz", trpzFile = trpFile + ".Z";
             bool isgz = false;
@@ -7974,14 +7958,14 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             {
                 /* extract '*.gz' */
                 cmd = gzipFull + " -d -f " + trpgzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 isgz = true;
             }
             else if (access(trpzFile.c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
                 cmd = gzipFull + " -d -f " + trpzFile;
-                std::system(cmd.c_str());
+                _procs.System(cmd);
                 isgz = false;
             }
 
@@ -8002,6 +7986,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             {
                 cout << "*** WARNING(FtpUtil::GetTrop): failed to download CODE tropospheric product file " << trpFile << endl;
 
+                _nmiss++;
                 string url0 = url + '/' + trpxFile;
                 if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetTrop): %s  ->  %s  failed\n", url0.c_str(), localFile.c_str());
             }
@@ -8029,13 +8014,15 @@ void FtpUtil::GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     chdir(dir);
 #endif
 
-    string atxFile("igs14.atx");
-    if (access(atxFile.c_str(), 0) == -1)
+    /* the ANTEX files are updated under the same name */
+    string atxFile("igs14.atx"), url;
+    url = "https://files.igs.org/pub/station/general/" + atxFile;
+    if (_catalog.Outdated(atxFile, { url }, fopt->fpLog))
     {
         string wgetFull = fopt->wgetFull, qr = fopt->qr;
-        string url = "https://files.igs.org/pub/station/general/" + atxFile;
         string cmd = wgetFull + " " + qr + " -nH --cut-dirs=3 " + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
+        _catalog.Done(atxFile, fopt->fpLog);
 
         char tmpFile[MAXSTRPATH] = { '\0' };
         char sep = (char)FILEPATHSEP;
@@ -8051,6 +8038,7 @@ void FtpUtil::GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         {
             cout << "*** WARNING(FtpUtil::GetAntexIGS): failed to download IGS ANTEX file " << atxFile << endl;
 
+            _nmiss++;
             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetAntexIGS): %s  ->  %s  OK\n", url.c_str(), localFile.c_str());
         }
     }
@@ -8058,12 +8046,13 @@ void FtpUtil::GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
 
     atxFile = "igs20.atx";
-    if (access(atxFile.c_str(), 0) == -1)
+    url = "https://files.igs.org/pub/station/general/" + atxFile;
+    if (_catalog.Outdated(atxFile, { url }, fopt->fpLog))
     {
         string wgetFull = fopt->wgetFull, qr = fopt->qr;
-        string url = "https://files.igs.org/pub/station/general/" + atxFile;
         string cmd = wgetFull + " " + qr + " -nH --cut-dirs=3 " + url;
-        std::system(cmd.c_str());
+        Wget(cmd, fopt);
+        _catalog.Done(atxFile, fopt->fpLog);
 
         char tmpFile[MAXSTRPATH] = { '\0' };
         char sep = (char)FILEPATHSEP;
@@ -8079,20 +8068,422 @@ void FtpUtil::GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         {
             cout << "*** WARNING(FtpUtil::GetAntexIGS): failed to download IGS ANTEX file " << atxFile << endl;
 
+            _nmiss++;
             if (fopt->fpLog) fprintf(fopt->fpLog, "* WARNING(GetAntexIGS): %s  ->  %s  OK\n", url.c_str(), localFile.c_str());
         }
     }
     else cout << "*** INFO(FtpUtil::GetAntexIGS): IGS ANTEX file " << atxFile << " has existed!" << endl;
 } /* end of GetAntexIGS */
 
+/**
+* @brief   : GetObs - download the GNSS observation files of the configured source and type
+* @param[I]: ts (start time)
+* @param[I]: dir (data directory)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpUtil::GetObs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
+{
+    StringUtil str;
+    string obsTyp = fopt->obsTyp;
+    str.TrimSpace4String(obsTyp);
+    str.ToLower(obsTyp);
+    std::vector<string> obsFroms = { "igs", "mgex", "igm", "cut", "ga", "hk", "ngs", "epn", "pbo2", "pbo3", "pbo5" };
+    string obsFrom = fopt->obsFrom;
+    str.TrimSpace4String(obsFrom);
+    str.ToLower(obsFrom);
+    for (int i = 0; i < obsFroms.size(); i++)
+    {
+        if (obsFrom == obsFroms[i])
+        {
+            string obsuFrom = obsFrom;
+            str.ToUpper(obsuFrom);
+            if (obsFrom == "igs")       /* IGS observation (RINEX version 2.xx, short name "d") */
+            {
+                if (obsTyp == "daily") GetDailyObsIgs(ts, dir, fopt);
+                else if (obsTyp == "hourly") GetHourlyObsIgs(ts, dir, fopt);
+                else if (obsTyp == "highrate") GetHrObsIgs(ts, dir, fopt);
+            }
+            else if (obsFrom == "mgex") /* MGEX observation (RINEX version 3.xx, long name "crx") */
+            {
+                if (obsTyp == "daily") GetDailyObsMgex(ts, dir, fopt);
+                else if (obsTyp == "hourly") GetHourlyObsMgex(ts, dir, fopt);
+                else if (obsTyp == "highrate") GetHrObsMgex(ts, dir, fopt);
+            }
+            else if (obsFrom == "igm")  /* the union of IGS and MGEX observation with respect to the site name */
+            {
+                if (obsTyp == "daily") GetDailyObsIgm(ts, dir, fopt);
+                else if (obsTyp == "hourly") GetHourlyObsIgm(ts, dir, fopt);
+                else if (obsTyp == "highrate") GetHrObsIgm(ts, dir, fopt);
+            }
+            else if (obsFrom == "cut")  /* Curtin University of Technology (CUT) observation (RINEX version 3.xx, long name "crx") */
+            {
+                if (obsTyp == "daily") GetDailyObsCut(ts, dir, fopt);
+            }
+            else if (obsFrom == "ga")   /* Geoscience Australia (GA) observation (RINEX version 3.xx, long name "crx") */
+            {
+                if (obsTyp == "daily") GetDailyObsGa(ts, dir, fopt);
+                else if (obsTyp == "hourly") GetHourlyObsGa(ts, dir, fopt);
+                else if (obsTyp == "highrate") GetHrObsGa(ts, dir, fopt);
+            }
+            else if (obsFrom == "hk")   /* Hong Kong CORS observation (RINEX version 3.xx, long name "crx") */
+            {
+                if (obsTyp == "30s") Get30sObsHk(ts, dir, fopt);
+                else if (obsTyp == "5s" || obsTyp == "05s") Get5sObsHk(ts, dir, fopt);
+                else if (obsTyp == "1s" || obsTyp == "01s") Get1sObsHk(ts, dir, fopt);
+            }
+            else if (obsFrom == "ngs")  /* NGS/NOAA CORS observation (RINEX version 2.xx, short name "d") */
+            {
+                if (obsTyp == "daily") GetDailyObsNgs(ts, dir, fopt);
+            }
+            else if (obsFrom == "epn")  /* EUREF Permanent Network (EPN) observation (RINEX version 3.xx, long name "crx" and RINEX version 2.xx, short name "d") */
+            {
+                if (obsTyp == "daily") GetDailyObsEpn(ts, dir, fopt);
+            }
+            else if (obsFrom == "pbo2") /* Plate Boundary Observatory (PBO) observation (RINEX version 2.xx, short name "d") */
+            {
+                if (obsTyp == "daily") GetDailyObsPbo2(ts, dir, fopt);
+            }
+            else if (obsFrom == "pbo3") /* Plate Boundary Observatory (PBO) observation (RINEX version 3.xx, long name "crx") */
+            {
+                if (obsTyp == "daily") GetDailyObsPbo3(ts, dir, fopt);
+            }
+            else if (obsFrom == "pbo5") /* Plate Boundary Observatory (PBO) observation (taking the union of pbo2 and pbo3 (pbo2 + pbo3), while the priority of pbo3 sites is higher) */
+            {
+                if (obsTyp == "daily") GetDailyObsPbo5(ts, dir, fopt);
+            }
+        }
+    }
+} /* end of GetObs */
+
+/**
+* @brief   : Due - whether a product is downloaded in the priority class of this pass, recording its queue wait time
+* @param[I]: iprod (index of product, i.e., PRI_OBS)
+* @param[I]: pclass (priority class of this pass, -1: all)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : true: due, false: in another class, or done by a previous run
+* @note    : the previous job is ended first, and the job due is journaled as started
+**/
+bool FtpUtil::Due(int iprod, int pclass, const ftpopt_t *fopt)
+{
+    int cls = fopt->priority[iprod];
+    if (pclass >= 0 && cls != pclass) return false;
+    EndJob();
+    if (_journal && _journal->Done(_day, iprod)) return false;
+
+    double wait = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count() - _tstart;
+    _nqueue[cls]++;
+    _waitSum[cls] += wait;
+    if (wait > _waitMax[cls]) _waitMax[cls] = wait;
+    _iprod = iprod;
+    _unfinished = false;
+    _nmissJob = _nmiss;
+    if (_journal) _journal->Begin(_day, iprod);
+
+    return true;
+} /* end of Due */
+
+/**
+* @brief   : JobDone - whether the current (day, product) job is complete
+* @param[I]: none
+* @param[O]: none
+* @return  : true: complete, false: kept in 'retry.list', or missing some files
+* @note    :
+**/
+bool FtpUtil::JobDone() const
+{
+    return !_unfinished && _nmiss == _nmissJob;
+} /* end of JobDone */
+
+/**
+* @brief   : EndJob - the end of the current (day, product) job, recorded in the run journal
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : a job kept in 'retry.list' is recorded as unfinished, so that a restart runs it again
+**/
+void FtpUtil::EndJob()
+{
+    if (_journal && _iprod >= 0) _journal->End(_day, _iprod, !_unfinished);
+    _iprod = -1;
+} /* end of EndJob */
+
+/**
+* @brief   : Wget - run a 'wget' command under the retry policy
+* @param[I]: cmd ('wget' command)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+* @note    : the (day, product) job of a transient failure or a paused host is kept in 'retry.list'; with the checksum
+*            manifest of the remote directory, a file not listed is not asked for, and a corrupt one is downloaded once
+*            more; the files known to be missing are not asked for until their TTL expires, and only an absent one
+*            (WGET_ABSENT, or none of the listing matching) is recorded so; a plain FTP URL
+*            is fetched over the native session of its host
+**/
+int FtpUtil::Wget(const string &cmd, const ftpopt_t *fopt)
+{
+    string dirUrl;
+    std::vector<string> pats;
+    bool asked = (_manifest.On() || _missCache.On()) && Manifest::Request(cmd, dirUrl, pats);
+    if (asked && _missCache.Missing(dirUrl, pats)) return WGET_ABSENT;
+
+    /* the files not in the manifest of their directory are not there */
+    int listed = -1;
+    if (asked && _manifest.On()) listed = _manifest.Listed(dirUrl, pats, _retry, fopt->fpLog);
+    if (listed == 0)
+    {
+        _missCache.Record(dirUrl, pats, _iprod, _day);
+
+        return WGET_ABSENT;
+    }
+
+    /* the plain FTP URLs over the native sessions, the others by 'wget' */
+    auto run = [&]()
+    {
+        int stat = _ftp.Run(cmd, _retry, fopt->fpLog);
+        return stat >= 0 ? stat : _retry.Run(cmd, !fopt->printInfoWget, fopt->fpLog);
+    };
+    int stat = run();
+    if (stat == WGET_OK && listed == 1 && _manifest.Verify(dirUrl, pats, _day, _retry, fopt->fpLog) > 0)
+    {
+        /* once more for the corrupt files */
+        stat = run();
+        if (stat == WGET_OK && _manifest.Verify(dirUrl, pats, _day, _retry, fopt->fpLog) > 0) stat = WGET_TRANSIENT;
+    }
+    if (stat == WGET_TRANSIENT || stat == WGET_PAUSED) Unfinished();
+    else if (asked && (stat == WGET_OK || stat == WGET_ABSENT))
+    {
+        /* 404 or FTP 550, or none of the listing matching; not a refused login or a local error */
+        _missCache.Record(dirUrl, pats, _iprod, _day);
+    }
+
+    return stat;
+} /* end of Wget */
+
+/**
+* @brief   : WgetCrx - download a RINEX 3 observation file of a site, by the exact URL if its long name is known
+* @param[I]: site (4-char site name in upper case)
+* @param[I]: url (URL of the remote directory)
+* @param[I]: cutDirs (i.e., ' --cut-dirs=7 ')
+* @param[I]: cmd ('wget' command asking for the file by the wildcard, i.e., '-A ABMF*20240320000_01D_30S_MO.crx.*')
+* @param[I/O]: crxFile (the file by the wildcard, i.e., 'ABMF*20240320000_01D_30S_MO.crx', replaced by its long name
+*            if it is downloaded so)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+* @note    : 'cmd' lists the remote directory if the long name is not known or the file is not there by it, and
+*            the long names are learned from the listing; a file prefetched by "PrefetchCrx" is taken as it is
+**/
+int FtpUtil::WgetCrx(const string &site, const string &url, const string &cutDirs, const string &cmd, string &crxFile,
+    const ftpopt_t *fopt)
+{
+    /* i.e., 'ABMF00GLP_R' + '_' + '20240320000_01D_30S_MO.crx', the RINEX 3 files being compressed by 'gzip' */
+    string name = _siteNames.Find(site);
+    size_t ipos = crxFile.find('*');
+    if (!name.empty() && ipos != string::npos)
+    {
+        string file = name + "_" + crxFile.substr(ipos + 1), gzFile = file + ".gz";
+
+        /* prefetched over HTTP/2, a corrupt one being removed by the manifest */
+        if (access(gzFile.c_str(), 0) == 0 && _manifest.Verify(url, { gzFile }, _day, _retry, fopt->fpLog) == 0)
+        {
+            crxFile = file;
+
+            return WGET_OK;
+        }
+
+        string wgetFull = fopt->wgetFull, qr = fopt->qr;
+        int stat = Wget(wgetFull + " " + qr + " -nH" + cutDirs + url + "/" + gzFile, fopt);
+        if (access(gzFile.c_str(), 0) == 0)
+        {
+            crxFile = file;
+
+            return stat;
+        }
+        if (stat == WGET_TRANSIENT || stat == WGET_PAUSED) return stat;
+    }
+
+    int stat = Wget(cmd, fopt);
+    _siteNames.Learn(site);
+
+    return stat;
+} /* end of WgetCrx */
+
+/**
+* @brief   : Unfinished - keep the current (day, product) job in 'retry.list' for the next run
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : once per job
+**/
+void FtpUtil::Unfinished()
+{
+    if (_unfinished || _iprod < 0 || _mainDir.empty()) return;
+
+    std::istringstream names(PRODPRI_NAMES);
+    string prod;
+    for (int i = 0; i <= _iprod; i++) names >> prod;
+    RetryPolicy::Persist(_mainDir.c_str(), _day, prod);
+    _unfinished = true;
+} /* end of Unfinished */
+
+/**
+* @brief   : GetParallel - download files in parallel, retrying the transient failures
+* @param[I]: names (keys of the objects of an S3 bucket, or URLs)
+* @param[I]: files (local files, one for each name)
+* @param[I]: get (the parallel transfers, i.e., S3Client::GetAll or HttpPool::GetAll)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : number of files downloaded
+* @note    : the job is kept in 'retry.list' if some files still fail transiently
+**/
+int FtpUtil::GetParallel(const std::vector<string> &names, const std::vector<string> &files, std::function<int(const
+    std::vector<string> &names, const std::vector<string> &files, std::vector<int> &stats)> get, const ftpopt_t *fopt)
+{
+    std::vector<string> names1 = names, files1 = files;
+    std::vector<int> stats;
+    int nok = 0;
+    for (int k = 0; names1.size() > 0; k++)
+    {
+        nok += get(names1, files1, stats);
+
+        /* the transient failures again, after the backoff */
+        std::vector<string> names2, files2;
+        for (int i = 0; i < names1.size(); i++)
+        {
+            if (stats[i] != WGET_TRANSIENT) continue;
+            names2.push_back(names1[i]);
+            files2.push_back(files1[i]);
+        }
+        if (names2.empty()) break;
+        if (k >= _retry.MaxRetry())
+        {
+            Unfinished();
+            break;
+        }
+        double delay = _retry.Backoff(k);
+        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(GetParallel): %d files failed transiently, retry %d of %d in %.1f s\n",
+            (int)names2.size(), k + 1, _retry.MaxRetry(), delay);
+        std::this_thread::sleep_for(std::chrono::duration<double>(delay));
+        names1 = names2;
+        files1 = files2;
+    }
+
+    return nok;
+} /* end of GetParallel */
+
+/**
+* @brief   : HttpsUrl - the URL of a remote directory over HTTP(S), for the parallel transfers over HTTP/2
+* @param[I]: url (URL of the remote directory)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : the URL over HTTP(S), "" if HTTP/2 is off or the archive is not served so
+* @note    : CDDIS serves its FTPS tree '/pub' over HTTPS as '/archive'
+**/
+string FtpUtil::HttpsUrl(const string &url, const ftpopt_t *fopt)
+{
+    if (!fopt->http2 || !HttpPool::Available()) return "";
+
+    if (url.compare(0, 8, "https://") == 0) return url;
+    const string cddis = "ftps://gdc.cddis.eosdis.nasa.gov/pub/";
+    if (url.compare(0, cddis.size(), cddis) == 0) return "https://cddis.nasa.gov/archive/" + url.substr(cddis.size());
+
+    return "";
+} /* end of HttpsUrl */
+
+/**
+* @brief   : PrefetchCrx - download the RINEX 3 files of the sites of known long names in parallel over HTTP/2
+* @param[I]: sitFile (full path of 'site.list')
+* @param[I]: urls (URLs of the remote directories)
+* @param[I]: dirs (local directories, one for each URL)
+* @param[I]: tails (i.e., '20240320000_01H_30S_MO.crx', one for each URL)
+* @param[I]: stems (the short names without the type, i.e., '032a.24', one for each URL)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : number of files downloaded
+* @note    : the files are then taken by "WgetCrx" without a request; a site of an 'o' or 'd' file, of an unknown
+*            long name or of a file known to be missing is not asked for
+**/
+int FtpUtil::PrefetchCrx(const char *sitFile, const std::vector<string> &urls, const std::vector<string> &dirs,
+    const std::vector<string> &tails, const std::vector<string> &stems, const ftpopt_t *fopt)
+{
+    std::vector<string> hurls(urls.size());
+    for (int i = 0; i < urls.size(); i++)
+    {
+        hurls[i] = HttpsUrl(urls[i], fopt);
+        if (hurls[i].empty()) return 0;
+    }
+
+    /* the sites of known long names */
+    std::vector<string> sites, names;
+    StringUtil str;
+    ifstream sitLst(sitFile);
+    string sitName;
+    while (getline(sitLst, sitName))
+    {
+        if (sitName[0] == '#') continue;
+        str.TrimSpace4String(sitName);
+        if (sitName.size() != 4) continue;
+        str.ToUpper(sitName);
+        string name = _siteNames.Find(sitName, false);
+        if (name.empty()) continue;
+        sites.push_back(sitName);
+        names.push_back(name);
+    }
+    sitLst.close();
+    if (sites.empty()) return 0;
+
+    std::vector<string> gets, files;
+    char sep = (char)FILEPATHSEP;
+    for (int i = 0; i < urls.size(); i++)
+    {
+        if (access(dirs[i].c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+            string cmd = "mkdir " + dirs[i];
+#else           /* for Linux or Mac */
+            string cmd = "mkdir -p " + dirs[i];
+#endif
+            _procs.System(cmd);
+        }
+        for (int j = 0; j < sites.size(); j++)
+        {
+            string site = sites[j];
+            str.ToLower(site);
+            string oFile = dirs[i] + sep + site + stems[i] + "o", dFile = dirs[i] + sep + site + stems[i] + "d";
+            string gzFile = names[j] + "_" + tails[i] + ".gz";
+            string file = dirs[i] + sep + gzFile;
+            if (ObsExists(oFile, fopt) || access(dFile.c_str(), 0) == 0 || access(file.c_str(), 0) == 0 ||
+                _missCache.Missing(urls[i], { gzFile })) continue;
+            gets.push_back(hurls[i] + "/" + gzFile);
+            files.push_back(file);
+        }
+    }
+    if (gets.empty()) return 0;
+
+    HttpPool pool(fopt, HTTP_MAXCONN);
+    int nok = GetParallel(gets, files, [&](const std::vector<string> &names, const std::vector<string> &files,
+        std::vector<int> &stats) { return pool.GetAll(names, files, stats, fopt->fpLog); }, fopt);
+    if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(PrefetchCrx): %d of %d files of the sites of known long names "
+        "downloaded in parallel\n", nok, (int)gets.size());
+
+    return nok;
+} /* end of PrefetchCrx */
+
 /**
 * @brief     : FtpDownload - GNSS data downloading via FTP
 * @param[I]  : popt (processing options)
 * @param[I/O]: fopt (FTP options)
+* @param[I]  : pclass (only the products of this priority class, -1: all)
+* @param[I/O]: journal (journal of the jobs of the run, the jobs done in it being skipped, nullptr: none)
 * @return    : none
 * @note      :
 **/
-void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
+void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt, int pclass, RunJournal *journal)
 {
     /* Get FTP archive for CDDIS, IGN, or WHU */
     init();
@@ -8131,10 +8522,35 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 
     /* "-qr" (printInfoWget == false, not print information of 'wget') or "r" (printInfoWget == true, print information of 'wget') in 'wget' command line */
     if (fopt->printInfoWget) str.SetStr(fopt->qr, "-r", 3);
+    else if (fopt->maxRetry > 0) str.SetStr(fopt->qr, "-r -nv", 7);  /* the messages are logged for the classification of failures */
     else str.SetStr(fopt->qr, "-qr", 4);
+    strcat(fopt->qr, " --no-remove-listing");  /* the remote listings are cached for the estimate of "JobPlan" */
+    if (fopt->maxRetry > 0)  /* the transient failures are retried by "RetryPolicy" instead of 'wget' itself */
+        sprintf(fopt->qr + strlen(fopt->qr), " --tries=1 --timeout=%d", fopt->timeout);
+    if (fopt->connTimeout > 0) sprintf(fopt->qr + strlen(fopt->qr), " --connect-timeout=%d", fopt->connTimeout);
+    _ndecode = 0;
+    _decodeBytes = 0;
+    _decodeSec = 0.0;
+    if (_tstart < 0.0) _tstart = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    _retry.Set(fopt);
+    _day = popt->ts;
+    _iprod = -1;
+    _mainDir = popt->mainDir;
+    _journal = journal;
+    _manifest.Set(fopt, popt->mainDir);
+    _manifest.Refresh(popt->ts, _retry, fopt->fpLog);  /* the stale local copies removed before the downloads */
+    _catalog.Set(fopt, popt->mainDir);
+    _missCache.Set(fopt, popt->mainDir);
+    _siteNames.Set(fopt, popt->mainDir);
+    _ftp.Set(fopt);
+    _procs.Set(fopt);
+    string host = JobPlan::Host(fopt);
+    dirstat_t ds0;
+    JobPool pool(fopt->maxJobs, fopt->maxJobsHost);
+    WorkLease lease(popt->ts, fopt);  /* the jobs of the day claimed by this node in the distributed mode */
 
     /* IGS observation (short name 'd') downloaded */
-    if (fopt->getObs)
+    if (fopt->getObs && Due(PRI_OBS, pclass, fopt))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->obsDir, 0) == -1)
@@ -8145,85 +8561,61 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
         string obsTyp = fopt->obsTyp;
         str.TrimSpace4String(obsTyp);
         str.ToLower(obsTyp);
-        std::vector<string> obsFroms = { "igs", "mgex", "igm", "cut", "ga", "hk", "ngs", "epn", "pbo2", "pbo3", "pbo5" };
         string obsFrom = fopt->obsFrom;
         str.TrimSpace4String(obsFrom);
         str.ToLower(obsFrom);
-        for (int i = 0; i < obsFroms.size(); i++)
-        {
-            if (obsFrom == obsFroms[i])
+        ds0 = JobPlan::Probe(popt->obsDir);
+        string prod = "obs_" + obsFrom + "_" + obsTyp;
+        if (lease.On() && access(fopt->obsLst, 0) == 0)
+        {
+            /* the sites claimed by this node are downloaded one after another through a private 'site.list' */
+            ftpopt_t fopt_s = *fopt;
+            string sitLst = lease.SiteList();
+            strcpy(fopt_s.obsLst, sitLst.c_str());
+            ifstream lst(fopt->obsLst);
+            string sitName;
+            while (getline(lst, sitName))
             {
-                string obsuFrom = obsFrom;
-                str.ToUpper(obsuFrom);
-                /* creation of sub-directory */
-                string subObsDir = popt->obsDir;
-
-                if (obsFrom == "igs")       /* IGS observation (RINEX version 2.xx, short name "d") */
-                {
-                    if (obsTyp == "daily") GetDailyObsIgs(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsIgs(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsIgs(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "mgex") /* MGEX observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "daily") GetDailyObsMgex(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsMgex(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsMgex(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "igm")  /* the union of IGS and MGEX observation with respect to the site name */
-                {
-                    if (obsTyp == "daily") GetDailyObsIgm(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsIgm(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsIgm(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "cut")  /* Curtin University of Technology (CUT) observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "daily") GetDailyObsCut(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "ga")   /* Geoscience Australia (GA) observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "daily") GetDailyObsGa(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "hourly") GetHourlyObsGa(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "highrate") GetHrObsGa(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "hk")   /* Hong Kong CORS observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "30s") Get30sObsHk(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "5s" || obsTyp == "05s") Get5sObsHk(popt->ts, subObsDir.c_str(), fopt);
-                    else if (obsTyp == "1s" || obsTyp == "01s") Get1sObsHk(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "ngs")  /* NGS/NOAA CORS observation (RINEX version 2.xx, short name "d") */
-                {
-                    if (obsTyp == "daily") GetDailyObsNgs(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "epn")  /* EUREF Permanent Network (EPN) observation (RINEX version 3.xx, long name "crx" and RINEX version 2.xx, short name "d") */
-                {
-                    if (obsTyp == "daily") GetDailyObsEpn(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "pbo2") /* Plate Boundary Observatory (PBO) observation (RINEX version 2.xx, short name "d") */
-                {
-                    if (obsTyp == "daily") GetDailyObsPbo2(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "pbo3") /* Plate Boundary Observatory (PBO) observation (RINEX version 3.xx, long name "crx") */
-                {
-                    if (obsTyp == "daily") GetDailyObsPbo3(popt->ts, subObsDir.c_str(), fopt);
-                }
-                else if (obsFrom == "pbo5") /* Plate Boundary Observatory (PBO) observation (taking the union of pbo2 and pbo3 (pbo2 + pbo3), while the priority of pbo3 sites is higher) */
+                if (sitName[0] == '#') continue;
+                str.TrimSpace4String(sitName);
+                if (sitName.empty()) continue;
+                string site = sitName;
+                str.ToLower(site);
+                if (!lease.Claim(prod, site)) continue;
+
+                /* the lease of each site is released if that site is left unfinished */
+                int nmiss = _nmiss;
+                bool unfinished = _unfinished;
+                _unfinished = false;
+                FILE *fp = fopen(sitLst.c_str(), "w");
+                if (fp)
                 {
-                    if (obsTyp == "daily") GetDailyObsPbo5(popt->ts, subObsDir.c_str(), fopt);
+                    fprintf(fp, "%s\n", sitName.c_str());
+                    fclose(fp);
+                    GetObs(popt->ts, popt->obsDir, &fopt_s);
                 }
+                lease.Done(fp && !_unfinished && _nmiss == nmiss);
+                _unfinished = _unfinished || unfinished;
             }
+            lst.close();
+            remove(sitLst.c_str());
         }
+        else if (lease.Claim(prod, "all"))
+        {
+            GetObs(popt->ts, popt->obsDir, fopt);
+            lease.Done(JobDone());
+        }
+        JobPlan::Record(popt->mainDir, prod, host, popt->obsDir, ds0);
     }
 
     /* broadcast ephemeris downloaded */
-    if (fopt->getNav)
+    if (fopt->getNav && Due(PRI_NAV, pclass, fopt) && lease.Claim("nav", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->navDir, 0) == -1)
@@ -8234,14 +8626,20 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
+        string navTyp = fopt->navTyp;
+        str.TrimSpace4String(navTyp);
+        str.ToLower(navTyp);
+        ds0 = JobPlan::Probe(popt->navDir);
         GetNav(popt->ts, popt->navDir, fopt);
+        JobPlan::Record(popt->mainDir, "nav_" + navTyp, host, popt->navDir, ds0);
+        lease.Done(JobDone());
     }
 
     /* precise orbit and clock product downloaded */
-    if (fopt->getOrbClk)
+    if (fopt->getOrbClk && Due(PRI_ORBCLK, pclass, fopt) && lease.Claim("orbclk", "all"))
     {
         string ac(fopt->orbClkAc);
         str.TrimSpace4String(ac);
@@ -8294,108 +8692,60 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
         }
         for (int i = 0; i < acs.size(); i++)
         {
+            /* one analysis center, or a fallback chain of them (i.e., "cod>gfz_m>igs_r>igs_u") stopping at the first
+               available one */
             string ac_i = acs[i];
-            int prodType = 0;
-
-            /* cnt: CNES real-time orbit and clock products from CNES offline files */
-            if (ac_i == "cnt") prodType = PROD_REALTIME;
-
-            /* esa_u: ESA ultra-rapid orbit and clock products
-               gfz_u: GFZ ultra-rapid orbit and clock products
-               igs_u: IGS ultra-rapid orbit and clock products
-               whu_u: WHU ultra-rapid orbit and clock products
-            */
-            std::vector<string> ultraAc = { "esa_u", "gfz_u", "igs_u", "whu_u" };
-            for (int i = 0; i < ultraAc.size(); i++)
-            {
-                if (ac_i == ultraAc[i])
-                {
-                    prodType = PROD_ULTRA_RAPID;
-
-                    break;
-                }
-            }
-
-            /* cod_r: CODE rapid orbit and clock products
-               emr_r: NRCan rapid orbit and clock products
-               esa_r: ESA rapid orbit and clock products
-               gfz_r: GFZ rapid orbit and clock products
-               igs_r: IGS rapid orbit and clock products
-            */
-            std::vector<string> rapidAc = { "cod_r", "emr_r", "esa_r", "gfz_r", "igs_r" };
-            for (int i = 0; i < rapidAc.size(); i++)
-            {
-                if (ac_i == rapidAc[i])
-                {
-                    prodType = PROD_RAPID;
+            string ac0 = ac_i.substr(0, ac_i.find_first_of('>'));
 
-                    break;
-                }
-            }
-
-            /* cod: CODE final orbit and clock products
-               emr: NRCan final orbit and clock products
-               esa: ESA final orbit and clock products
-               gfz: GFZ final orbit and clock products
-               grg: CNES final orbit and clock products
-               igs: IGS final orbit and clock products
-               jpl: JPL final orbit and clock products
-               mit: MIT final orbit and clock products
-            */
-            std::vector<string> finalAcIGS = { "cod", "emr", "esa", "gfz", "grg", "igs", "jpl", "mit" };
-            for (int i = 0; i < finalAcIGS.size(); i++)
+            /* the analysis centers on different hosts are downloaded concurrently */
+            pool.Add(AcHost(ac0, host), popt->orbDir, [=](const char *wdir)
             {
-                if (ac_i == finalAcIGS[i])
+                /* creation of sub-directory */
+                string subOrbDir = wdir;
+                string subClkDir = wdir;
+
+                std::vector<string> subDirs = { subOrbDir, subClkDir };
+                dirstat_t ds = JobPlan::Probe(wdir);
+                /* the analysis center is chosen by the specified day alone, i.e., the final product of the day
+                   after is not published yet for the recent days */
+                string ac = TryChain(ac_i, "orbclk", [&](const string &ac_j)
                 {
-                    prodType = PROD_FINAL_IGS;
+                    int prodType = OrbClkType(ac_j);
+                    if (prodType == 0)
+                    {
+                        cerr << "*** ERROR(FtpUtil::FtpDownload): unknown analysis center '" << ac_j << "' of getOrbClk in configure file!" << endl;
+                        _nmiss++;
 
-                    break;
-                }
-            }
+                        return;
+                    }
+                    GetOrbClk(popt->ts, subDirs, prodType, ac_j, fopt);
+                }, fopt->fpLog);
 
-            /* cod_m: CODE multi-GNSS final orbit and clock products
-               gfz_m: GFZ multi-GNSS final orbit and clock products
-               grg_m: CNES multi-GNSS final orbit and clock products
-               iac_m: Russia Information and Analysis Center (IAC) multi-GNSS final orbit and clock products
-               jax_m: Japan Aerospace Exploration Agency (JAXA) multi-GNSS final orbit and clock products
-               sha_m: Shanghai Observatory (SHAO) multi-GNSS final orbit and clock products
-               whu_m: Wuhan University (WHU) multi-GNSS final orbit and clock products
-            */
-            std::vector<string> acMGEX = { "cod_m", "gfz_m", "grg_m", "iac_m", "jax_m", "sha_m", "whu_m" };
-            for (int i = 0; i < acMGEX.size(); i++)
-            {
-                if (ac_i == acMGEX[i])
+                int nmiss = _nmiss;
+                int prodType = ac.empty() ? 0 : OrbClkType(ac);
+                if (fopt->minusAdd1day && (prodType == PROD_FINAL_IGS || prodType == PROD_FINAL_MGEX))
                 {
-                    prodType = PROD_FINAL_MGEX;
-
-                    break;
+                    TimeUtil tu;
+                    gtime_t tt;
+                    /* precise orbit and clock product downloaded for the day before the specified day */
+                    tt = tu.TimeAdd(popt->ts, -86400.0);
+                    GetOrbClk(tt, subDirs, prodType, ac, fopt);
+
+                    /* precise orbit and clock product downloaded for the day after the specified day */
+                    tt = tu.TimeAdd(popt->ts, 86400.0);
+                    GetOrbClk(tt, subDirs, prodType, ac, fopt);
                 }
-            }
-
-            /* creation of sub-directory */
-            string subOrbDir = popt->orbDir;
-            string subClkDir = popt->orbDir;
-
-            std::vector<string> subDirs = { subOrbDir, subClkDir };
-            GetOrbClk(popt->ts, subDirs, prodType, ac_i, fopt);
-
-            if (fopt->minusAdd1day && (prodType == PROD_FINAL_IGS || prodType == PROD_FINAL_MGEX))
-            {
-                TimeUtil tu;
-                gtime_t tt;
-                /* precise orbit and clock product downloaded for the day before the specified day */
-                tt = tu.TimeAdd(popt->ts, -86400.0);
-                GetOrbClk(tt, subDirs, prodType, ac_i, fopt);
+                JobPlan::Record(popt->mainDir, "orbclk_" + (ac.empty() ? ac0 : ac), host, wdir, ds);
 
-                /* precise orbit and clock product downloaded for the day after the specified day */
-                tt = tu.TimeAdd(popt->ts, 86400.0);
-                GetOrbClk(tt, subDirs, prodType, ac_i, fopt);
-            }
+                return !ac.empty() && _nmiss == nmiss && !_unfinished;
+            });
         }
+        int nfail = pool.Run(fopt->fpLog);
+        lease.Done(nfail == 0 && JobDone());
     }
     
     /* EOP file downloaded */
-    if (fopt->getEop)
+    if (fopt->getEop && Due(PRI_EOP, pclass, fopt) && lease.Claim("eop", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->eopDir, 0) == -1)
@@ -8406,14 +8756,22 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
-        GetEop(popt->ts, popt->eopDir, fopt);
+        ds0 = JobPlan::Probe(popt->eopDir);
+        TryChain(fopt->eopAc, "eop", [&](const string &ac_j)
+        {
+            ftpopt_t fopt_j = *fopt;
+            strcpy(fopt_j.eopAc, ac_j.c_str());
+            GetEop(popt->ts, popt->eopDir, &fopt_j);
+        }, fopt->fpLog);
+        JobPlan::Record(popt->mainDir, "eop", host, popt->eopDir, ds0);
+        lease.Done(JobDone());
     }
 
     /* ORBEX (ORBit EXchange format) downloaded */
-    if (fopt->getObx)
+    if (fopt->getObx && Due(PRI_OBX, pclass, fopt) && lease.Claim("obx", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->obxDir, 0) == -1)
@@ -8424,15 +8782,18 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
+        ds0 = JobPlan::Probe(popt->obxDir);
         GetObx(popt->ts, popt->obxDir, fopt);
+        JobPlan::Record(popt->mainDir, "obx", host, popt->obxDir, ds0);
+        lease.Done(JobDone());
     }
 
 
     /* differential code/signal bias (DCB/DSB) files downloaded */
-    if (fopt->getDsb)
+    if (fopt->getDsb && Due(PRI_DSB, pclass, fopt) && lease.Claim("dsb", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->biaDir, 0) == -1)
@@ -8443,15 +8804,23 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
-        GetDsb(popt->ts, popt->biaDir, fopt);
+        ds0 = JobPlan::Probe(popt->biaDir);
+        TryChain(fopt->dsbAc, "dsb", [&](const string &ac_j)
+        {
+            ftpopt_t fopt_j = *fopt;
+            strcpy(fopt_j.dsbAc, ac_j.c_str());
+            GetDsb(popt->ts, popt->biaDir, &fopt_j);
+        }, fopt->fpLog);
+        JobPlan::Record(popt->mainDir, "dsb", host, popt->biaDir, ds0);
+        lease.Done(JobDone());
     }
 
 
     /* obsevable-specific code/phase signal bias (OSB) files downloaded */
-    if (fopt->getOsb)
+    if (fopt->getOsb && Due(PRI_OSB, pclass, fopt) && lease.Claim("osb", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->biaDir, 0) == -1)
@@ -8462,14 +8831,22 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
-        GetOsb(popt->ts, popt->biaDir, fopt);
+        ds0 = JobPlan::Probe(popt->biaDir);
+        TryChain(fopt->osbAc, "osb", [&](const string &ac_j)
+        {
+            ftpopt_t fopt_j = *fopt;
+            strcpy(fopt_j.osbAc, ac_j.c_str());
+            GetOsb(popt->ts, popt->biaDir, &fopt_j);
+        }, fopt->fpLog);
+        JobPlan::Record(popt->mainDir, "osb", host, popt->biaDir, ds0);
+        lease.Done(JobDone());
     }
 
     /* IGS SINEX file downloaded */
-    if (fopt->getSnx)
+    if (fopt->getSnx && Due(PRI_SNX, pclass, fopt) && lease.Claim("snx", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->snxDir, 0) == -1)
@@ -8480,14 +8857,17 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
+        ds0 = JobPlan::Probe(popt->snxDir);
         GetSnx(popt->ts, popt->snxDir, fopt);
+        JobPlan::Record(popt->mainDir, "snx", host, popt->snxDir, ds0);
+        lease.Done(JobDone());
     }
 
     /* global ionosphere map (GIM) downloaded */
-    if (fopt->getIon)
+    if (fopt->getIon && Due(PRI_ION, pclass, fopt) && lease.Claim("ion", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->ionDir, 0) == -1)
@@ -8498,14 +8878,38 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
-        GetIono(popt->ts, popt->ionDir, fopt);
+        /* one job for each analysis center or fallback chain, i.e., "cod+igs+jpl" or "cod_r>igs_r+upc_hr" */
+        string ac(fopt->ionAc);
+        str.TrimSpace4String(ac);
+        std::vector<string> acs;
+        if ((int)ac.find_first_of('+') > 0) str.GetSubStr(ac, "+", acs);
+        else acs.push_back(ac);
+        for (int i = 0; i < acs.size(); i++)
+        {
+            string ac_i = acs[i];
+            pool.Add(host, popt->ionDir, [=](const char *wdir)
+            {
+                dirstat_t ds = JobPlan::Probe(wdir);
+                string ac = TryChain(ac_i, "ion", [&](const string &ac_j)
+                {
+                    ftpopt_t fopt_i = *fopt;
+                    strcpy(fopt_i.ionAc, ac_j.c_str());
+                    GetIono(popt->ts, wdir, &fopt_i);
+                }, fopt->fpLog);
+                JobPlan::Record(popt->mainDir, "ion", host, wdir, ds);
+
+                return !ac.empty() && !_unfinished;
+            });
+        }
+        int nfail = pool.Run(fopt->fpLog);
+        lease.Done(nfail == 0 && JobDone());
     }
 
     /* Rate of TEC index (ROTI) file downloaded */
-    if (fopt->getRoti)
+    if (fopt->getRoti && Due(PRI_ROTI, pclass, fopt) && lease.Claim("roti", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->ionDir, 0) == -1)
@@ -8516,14 +8920,17 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
+        ds0 = JobPlan::Probe(popt->ionDir);
         GetRoti(popt->ts, popt->ionDir, fopt);
+        JobPlan::Record(popt->mainDir, "roti", host, popt->ionDir, ds0);
+        lease.Done(JobDone());
     }
 
     /* final tropospheric product downloaded */
-    if (fopt->getTrp)
+    if (fopt->getTrp && Due(PRI_TRP, pclass, fopt) && lease.Claim("trp", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->ztdDir, 0) == -1)
@@ -8534,14 +8941,17 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
+        ds0 = JobPlan::Probe(popt->ztdDir);
         GetTrop(popt->ts, popt->ztdDir, fopt);
+        JobPlan::Record(popt->mainDir, "trp", host, popt->ztdDir, ds0);
+        lease.Done(JobDone());
     }
 
     /* IGS ANTEX file downloaded */
-    if (fopt->getAtx)
+    if (fopt->getAtx && Due(PRI_ATX, pclass, fopt) && lease.Claim("atx", "all"))
     {
         /* If the directory does not exist, creat it */
         if (access(popt->tblDir, 0) == -1)
@@ -8552,9 +8962,43 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
 #else           /* for Linux or Mac */
             string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+            _procs.System(cmd);
         }
 
+        ds0 = JobPlan::Probe(popt->tblDir);
         GetAntexIGS(popt->ts, popt->tblDir, fopt);
+        JobPlan::Record(popt->mainDir, "atx", host, popt->tblDir, ds0);
+        lease.Done(JobDone());
+    }
+    EndJob();
+    JobPlan::RecordDecode(popt->mainDir, _ndecode, _decodeBytes, _decodeSec);
+} /* end of FtpDownload */
+
+/**
+* @brief   : QueueReport - report the queue wait time of each priority class
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the wait time of a job is from the start of the first "FtpDownload" to its dispatch; the transfers
+*            aborted by the watchdog are reported too
+**/
+void FtpUtil::QueueReport(FILE *fpLog) const
+{
+    for (int i = 0; i < MAXPRICLASS; i++)
+    {
+        if (_nqueue[i] == 0) continue;
+
+        double mean = _waitSum[i] / _nqueue[i];
+        char buff[MAXCHARS] = { '\0' };
+        sprintf(buff, "priority class %d, %d jobs, queue wait mean %.1f s, max %.1f s", i, _nqueue[i], mean, _waitMax[i]);
+        cout << "*** INFO(FtpUtil::QueueReport): " << buff << endl;
+
+        if (fpLog) fprintf(fpLog, "* INFO(QueueReport): %s\n", buff);
     }
-} /* end of FtpDownload */
\ No newline at end of file
+    _retry.Report(fpLog);
+    _manifest.Report(fpLog);
+    _catalog.Report(fpLog);
+    _missCache.Report(fpLog);
+    _siteNames.Report(fpLog);
+    _ftp.Report(fpLog);
+} /* end of QueueReport */
\ No newline at end of file
@@ -2,6 +2,17 @@
 * FtpUtil.h : header file of FtpUtil.cpp
 *-----------------------------------------------------------------------------*/
 #pragma once
+#include <functional>
+#include "RetryPolicy.h"
+#include "Manifest.h"
+#include "Catalog.h"
+#include "MissCache.h"
+#include "SiteNames.h"
+#include "FtpClient.h"
+#include "ProcPool.h"
+#include "RunJournal.h"
+
+class ObsCheck;
 
 class FtpUtil
 {
@@ -14,6 +25,28 @@ private:
         std::vector<string> WHU;    /* WHU FTP */
     };
     ftpArchive_t _ftpArchive;
+    int _ndecode;                 /* number of files decoded by 'crx2rnx' in one call of "FtpDownload" */
+    long long _decodeBytes;       /* total size of the decoded Hatanaka-compressed files */
+    double _decodeSec;            /* seconds spent in decoding */
+    int _nmiss;                   /* number of files failed to download, to find the first available analysis center */
+    double _tstart;               /* time when the first "FtpDownload" started (s), < 0: not yet */
+    time_t _trun;                 /* wall-clock time of the start of the run, for the markers of the invalid observations */
+    int _nqueue[MAXPRICLASS];     /* number of dispatched (day, product) jobs of each priority class */
+    double _waitSum[MAXPRICLASS]; /* total queue wait time of each priority class (s) */
+    double _waitMax[MAXPRICLASS]; /* max queue wait time of each priority class (s) */
+    RetryPolicy _retry;           /* retries of the transient failures and circuit breakers of the hosts */
+    Manifest _manifest;           /* checksum manifests of the remote directories */
+    Catalog _catalog;             /* remote metadata of the local copies of the mutable products */
+    MissCache _missCache;         /* remote files known to be missing */
+    SiteNames _siteNames;         /* long names of the sites */
+    FtpClient _ftp;               /* native FTP sessions kept alive for the plain FTP archives */
+    ProcPool _procs;              /* external tools ('gzip', 'crx2rnx', ...) run without a shell */
+    gtime_t _day;                 /* the day of the current "FtpDownload" */
+    int _iprod;                   /* index of the product being downloaded (i.e., PRI_OBS), -1: none */
+    bool _unfinished;             /* whether the current (day, product) job has been kept in 'retry.list' */
+    int _nmissJob;                /* '_nmiss' at the start of the current (day, product) job */
+    string _mainDir;              /* the root/main directory where 'retry.list' is kept */
+    RunJournal *_journal;         /* journal of the (day, product) jobs of the run, nullptr: none */
 
 private:
 
@@ -26,6 +59,121 @@ private:
     **/
     void init();
 
+    /**
+    * @brief   : AcHost - the host of the precise orbit and clock products of an analysis center
+    * @param[I]: ac (analysis center, i.e., 'igs', 'cod_r', 'esa_u', et al.)
+    * @param[I]: archive (FTP archive, i.e., "CDDIS", "IGN" or "WHU")
+    * @param[O]: none
+    * @return  : host
+    * @note    : the products not on their own servers are on the FTP archive
+    **/
+    static string AcHost(const string &ac, const string &archive);
+
+    /**
+    * @brief   : OrbClkType - the product type of the precise orbit and clock products of an analysis center
+    * @param[I]: ac (analysis center, i.e., 'igs', 'cod_r', 'esa_u', et al.)
+    * @param[O]: none
+    * @return  : product type (PROD_REALTIME, ..., PROD_FINAL_MGEX), 0: unknown analysis center
+    * @note    :
+    **/
+    static int OrbClkType(const string &ac);
+
+    /**
+    * @brief   : TryChain - try the analysis centers of a fallback chain in order and stop at the first available one
+    * @param[I]: chain (analysis centers separated by '>', i.e., "cod>gfz_m>igs_r>igs_u", or only one)
+    * @param[I]: prod (product, for the log)
+    * @param[I]: get (the downloading routine of one analysis center)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : the analysis center used, "": none of them is available
+    * @note    : an analysis center is available when all of its files exist or are downloaded, i.e., no file failed;
+    *            each unavailable one costs only the remote listing of its 'wget -A' pattern, nothing is transferred
+    **/
+    string TryChain(const string &chain, const string &prod, std::function<void(const string &ac)> get, FILE *fpLog);
+
+    /**
+    * @brief   : Crx2RnxStages - the pipeline converting a Hatanaka-compressed file to a RINEX observation file
+    * @param[I]: crxFile (Hatanaka-compressed file, i.e., 'abmf0320.24d', or compressed again, i.e., 'abmf0320.24d.gz')
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : 'crx2rnx -f -', after 'gzip -dc' for a '*.gz' or '*.Z' file, both reading 'crxFile' as the standard input
+    * @note    :
+    **/
+    static stages_t Crx2RnxStages(const string &crxFile, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Crx2Rnx - convert a Hatanaka-compressed ('d' or 'crx') file to a RINEX observation file via 'crx2rnx'
+    * @param[I]: crxFile (Hatanaka-compressed file, or compressed again by 'gzip' or 'compress')
+    * @param[I]: oFile (RINEX observation file)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : if 'obsSys' or 'obsTypes' is set, only the selected systems and observation types are written while
+    *            decoding; if 'obsStore' is on, the output of 'crx2rnx' is also decoded on the fly into a columnar binary
+    *            store 'oFile.obc', without reading 'oFile' back; if 'obsFrame' is set, 'oFile.gz' with its frame index
+    *            is written instead of 'oFile'
+    **/
+    void Crx2Rnx(string crxFile, string oFile, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Crx2RnxAll - convert the downloaded Hatanaka-compressed files to RINEX observation files, several at once
+    * @param[I]: crxFiles (Hatanaka-compressed files, or compressed again by 'gzip' or 'compress')
+    * @param[I]: oFiles (RINEX observation files, one for each)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : up to 'maxProcs' files are converted at once, each by 'gzip -dc | crx2rnx -f -'; a file converted is
+    *            removed; if the output of 'crx2rnx' is decoded by GOOD itself (for 'obsSys', 'obsTypes', 'obsStore'
+    *            or 'obsFrame'), they are converted one after another by "Crx2Rnx"
+    **/
+    void Crx2RnxAll(const std::vector<string> &crxFiles, const std::vector<string> &oFiles, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : MarkedBefore - whether a RINEX observation file was marked invalid by a previous run
+    * @param[I]: oFile (RINEX observation file)
+    * @param[O]: none
+    * @return  : true: marked before, to be downloaded again, false: not
+    * @note    :
+    **/
+    bool MarkedBefore(const string &oFile) const;
+
+    /**
+    * @brief   : ObsExists - whether a RINEX observation file exists, expanded or compressed at rest
+    * @param[I]: oFile (RINEX observation file)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : true: exists, false: not
+    * @note    : a file marked invalid by a previous run does not exist, so that it is downloaded again
+    **/
+    bool ObsExists(string oFile, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : WgetUnion - download the lower-priority half of a union of observations, only for the sites not there yet
+    * @param[I]: url (remote directory of the short-name 'd' files)
+    * @param[I]: cutDirs (' --cut-dirs=N ' of 'wget')
+    * @param[I]: pattern (wildcard of the files, i.e., '*0320.24d.*')
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the remote listing is fetched first, and a file is taken only if neither its 'o' file nor its 'd' file
+    *            is in the current directory; without a listing (i.e., HTTPS), the whole pattern is downloaded
+    **/
+    void WgetUnion(const string &url, const string &cutDirs, const string &pattern, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : CheckObs - check a converted RINEX observation file, and mark it for downloading again if invalid
+    * @param[I]: oFile (RINEX observation file)
+    * @param[I]: chk (result of checking while decoding, nullptr: scan 'oFile')
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : true: valid or not converted, false: invalid
+    * @note    : the last epoch should be within 1/24 of the span (1 hour for daily, 2.5 min for hourly files) before the
+    *            expected end; an invalid file is kept (i.e., a station stopped early by an outage), marked by
+    *            'oFile.bad' and its job kept in 'retry.list', so that it is downloaded once again; invalid once more,
+    *            it is kept as it is
+    **/
+    bool CheckObs(string oFile, const ObsCheck *chk, const ftpopt_t *fopt);
+
     /**
     * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
     * @param[I]: ts (start time)
@@ -396,10 +544,140 @@ private:
     **/
     void GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt);
 
+    /**
+    * @brief   : GetObs - download the GNSS observation files of the configured source and type
+    * @param[I]: ts (start time)
+    * @param[I]: dir (data directory)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void GetObs(gtime_t ts, const char dir[], const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Due - whether a product is downloaded in the priority class of this pass, recording its queue wait time
+    * @param[I]: iprod (index of product, i.e., PRI_OBS)
+    * @param[I]: pclass (priority class of this pass, -1: all)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : true: due, false: in another class, or done by a previous run
+    * @note    : the previous job is ended first, and the job due is journaled as started
+    **/
+    bool Due(int iprod, int pclass, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : EndJob - the end of the current (day, product) job, recorded in the run journal
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : a job kept in 'retry.list' is recorded as unfinished, so that a restart runs it again
+    **/
+    void EndJob();
+
+    /**
+    * @brief   : JobDone - whether the current (day, product) job is complete
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: complete, false: kept in 'retry.list', or missing some files
+    * @note    : the lease of an incomplete job is released instead of being marked done
+    **/
+    bool JobDone() const;
+
+    /**
+    * @brief   : Wget - run a 'wget' command under the retry policy
+    * @param[I]: cmd ('wget' command)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+    * @note    : the (day, product) job of a transient failure or a paused host is kept in 'retry.list'
+    **/
+    int Wget(const string &cmd, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : WgetCrx - download a RINEX 3 observation file of a site, by the exact URL if its long name is known
+    * @param[I]: site (4-char site name in upper case)
+    * @param[I]: url (URL of the remote directory)
+    * @param[I]: cutDirs (i.e., ' --cut-dirs=7 ')
+    * @param[I]: cmd ('wget' command asking for the file by the wildcard, i.e., '-A ABMF*20240320000_01D_30S_MO.crx.*')
+    * @param[I/O]: crxFile (the file by the wildcard, i.e., 'ABMF*20240320000_01D_30S_MO.crx', replaced by its long name
+    *            if it is downloaded so)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+    * @note    : 'cmd' lists the remote directory if the long name is not known or the file is not there by it, and
+    *            the long names are learned from the listing; a file prefetched by "PrefetchCrx" is taken as it is
+    **/
+    int WgetCrx(const string &site, const string &url, const string &cutDirs, const string &cmd, string &crxFile,
+        const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Unfinished - keep the current (day, product) job in 'retry.list' for the next run
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : once per job
+    **/
+    void Unfinished();
+
+    /**
+    * @brief   : GetParallel - download files in parallel, retrying the transient failures
+    * @param[I]: names (keys of the objects of an S3 bucket, or URLs)
+    * @param[I]: files (local files, one for each name)
+    * @param[I]: get (the parallel transfers, i.e., S3Client::GetAll or HttpPool::GetAll)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : number of files downloaded
+    * @note    : the job is kept in 'retry.list' if some files still fail transiently
+    **/
+    int GetParallel(const std::vector<string> &names, const std::vector<string> &files, std::function<int(const
+        std::vector<string> &names, const std::vector<string> &files, std::vector<int> &stats)> get, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : HttpsUrl - the URL of a remote directory over HTTP(S), for the parallel transfers over HTTP/2
+    * @param[I]: url (URL of the remote directory)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : the URL over HTTP(S), "" if HTTP/2 is off or the archive is not served so
+    * @note    : CDDIS serves its FTPS tree '/pub' over HTTPS as '/archive'
+    **/
+    string HttpsUrl(const string &url, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : PrefetchCrx - download the RINEX 3 files of the sites of known long names in parallel over HTTP/2
+    * @param[I]: sitFile (full path of 'site.list')
+    * @param[I]: urls (URLs of the remote directories)
+    * @param[I]: dirs (local directories, one for each URL)
+    * @param[I]: tails (i.e., '20240320000_01H_30S_MO.crx', one for each URL)
+    * @param[I]: stems (the short names without the type, i.e., '032a.24', one for each URL)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : number of files downloaded
+    * @note    : the files are then taken by "WgetCrx" without a request; a site of an 'o' or 'd' file, of an unknown
+    *            long name or of a file known to be missing is not asked for
+    **/
+    int PrefetchCrx(const char *sitFile, const std::vector<string> &urls, const std::vector<string> &dirs,
+        const std::vector<string> &tails, const std::vector<string> &stems, const ftpopt_t *fopt);
+
 public:
     FtpUtil()
 	{
-
+        _ndecode = 0;
+        _decodeBytes = 0;
+        _decodeSec = 0.0;
+        _nmiss = 0;
+        _tstart = -1.0;
+        _trun = time(nullptr);
+        _day = { 0 };
+        _iprod = -1;
+        _unfinished = false;
+        _nmissJob = 0;
+        _journal = nullptr;
+        for (int i = 0; i < MAXPRICLASS; i++)
+        {
+            _nqueue[i] = 0;
+            _waitSum[i] = _waitMax[i] = 0.0;
+        }
 	}
 	~FtpUtil()
 	{
@@ -410,8 +688,20 @@ public:
     * @brief     : FtpDownload - GNSS data downloading via FTP
     * @param[I]  : popt (processing options)
     * @param[I/O]: fopt (FTP options)
+    * @param[I]  : pclass (only the products of this priority class, -1: all)
+    * @param[I/O]: journal (journal of the jobs of the run, the jobs done in it being skipped, nullptr: none)
     * @return    : none
     * @note      :
     **/
-    void FtpDownload(const prcopt_t *popt, ftpopt_t *fopt);
+    void FtpDownload(const prcopt_t *popt, ftpopt_t *fopt, int pclass = -1, RunJournal *journal = nullptr);
+
+    /**
+    * @brief   : QueueReport - report the queue wait time of each priority class
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the wait time of a job is from the start of the first "FtpDownload" to its dispatch; the transfers
+    *            aborted by the watchdog are reported too
+    **/
+    void QueueReport(FILE *fpLog) const;
 };
\ No newline at end of file
@@ -37,6 +37,22 @@ using namespace std;
 #define MAXCHARS        1024      /* maximum characters in one line */
 #define MAXSTRPATH      1024      /* max length of stream path */
 
+#define NPRODPRI        12        /* number of products with a priority class */
+#define PRODPRI_NAMES   "obs nav orbclk eop obx dsb osb snx ion roti trp atx"  /* products with a priority class, in order */
+#define MAXPRICLASS     10        /* max number of priority classes (0: the highest) */
+#define PRI_OBS         0         /* index of GNSS observation in the priority classes */
+#define PRI_NAV         1         /* index of broadcast ephemeris */
+#define PRI_ORBCLK      2         /* index of precise orbit and clock */
+#define PRI_EOP         3         /* index of EOP */
+#define PRI_OBX         4         /* index of ORBEX */
+#define PRI_DSB         5         /* index of DCB/DSB */
+#define PRI_OSB         6         /* index of OSB */
+#define PRI_SNX         7         /* index of IGS weekly SINEX */
+#define PRI_ION         8         /* index of GIM */
+#define PRI_ROTI        9         /* index of ROTI */
+#define PRI_TRP         10        /* index of tropospheric product */
+#define PRI_ATX         11        /* index of ANTEX */
+
 #ifdef _WIN32  /* for Windows */
 #define FILEPATHSEP '\\'
 #define strcasecmp  _stricmp
@@ -52,6 +68,25 @@ struct gtime_t
     double sod;                   /* seconds of the day */
 };
 
+struct daydesc_t
+{                                 /* day descriptor, the calendar fields and their strings used in file names and URLs */
+    gtime_t t;                    /* time at 00:00:00 of the day */
+    int yyyy;                     /* 4-digit year */
+    int yy;                       /* 2-digit year */
+    int doy;                      /* day of year */
+    int mm;                       /* month (1-12) */
+    int dd;                       /* day within a month (1-31) */
+    int wwww;                     /* GPS week */
+    int dow;                      /* day of GPS week (0-6) */
+    char sYyyy[5];                /* "yyyy" */
+    char sYy[3];                  /* "yy" */
+    char sDoy[4];                 /* "ddd" */
+    char sMm[3];                  /* "mm" */
+    char sDd[3];                  /* "dd" */
+    char sWwww[5];                /* "wwww" */
+    char sDow[2];                 /* "d" */
+};
+
 struct ftpopt_t
 {                                 /* the type of GNSS data downloading */
     bool ftpDownloading;          /* the master switch for data downloading, 0:off  1:on, only for data downloading */
@@ -72,7 +107,8 @@ struct ftpopt_t
     char orbClkAc[MAXCHARS];      /* analysis center (i.e., final: "cod", "emr", "esa", "gfz", "grg", "igs", "jpl", "mit", "cod_m", "gfz_m", 
                                      "grg_m", "whu_m"; rapid: "cod_r", "emr_r", "esa_r", "gfz_r", "igs_r"; ultra-rapid: "esa_u", "gfz_u", 
                                      "igs_u", "whu_u"; real-time: "cnt"). NOTE: the option of "cnt" is for real-time precise orbit and 
-                                     clock products from CNES offline files */
+                                     clock products from CNES offline files; "cod>gfz_m>igs_r" is a fallback chain taking the first
+                                     available one, also for "eopAc", "dsbAc", "osbAc", and "ionAc" */
     std::vector<std::vector<int> > hhOrbClk;  /* hours array (0: 00:00, 6: 6:00, 12: 12:00, 18: 18:00 for esa_u and/or igs_u; 0: 00:00, 3: 3:00,
                                                  6: 6:00, ... for gfz_u; 0: 00:00, 1: 1:00, 2: 2:00, ... for whu_u) */
     bool getObx;                  /* (0:off  1:on) ORBEX (ORBit EXchange format) for satellite attitude information */
@@ -106,6 +142,59 @@ struct ftpopt_t
                                      clock products downloading */
     bool printInfoWget;           /* (0:off  1 : on) print the information generated by 'wget' */
     char qr[MAXCHARS];            /* "-qr" (printInfoWget == false) or "r" (printInfoWget == true) in 'wget' command line */
+    int mergeNav;                 /* (0:off  1:hourly  2:daily) merge the site-specific hourly broadcast ephemeris files (navTyp = hourly)
+                                     into one multi-GNSS file per hour or per day, the duplicated records being dropped */
+    char obsSys[MAXCHARS];        /* systems kept when decoding Hatanaka-compressed observations, i.e., "GE" ("all": all systems) */
+    char obsTypes[MAXCHARS];      /* observation types (or their prefixes) kept when decoding Hatanaka-compressed observations,
+                                     i.e., "C1C L1C C5Q L5Q" or "C1 L1 C5 L5" ("all": all types) */
+    bool obsCheck;                /* (0:off  1:on) check each converted observation file (complete header, increasing epochs, and
+                                     the last epoch near the expected end), the invalid ones being kept, marked by 'oFile.bad' and
+                                     downloaded once again by the retry of their job */
+    int obsFrame;                 /* (0:off  N:on) keep the decoded observations compressed at rest ('oFile.gz' with the index
+                                     'oFile.gz.idx') instead of 'oFile', N epochs per independently decompressible frame */
+    bool obsStore;                /* (0:off  1:on) write the decoded observations to a columnar binary store ('*.obc') next to
+                                     each converted RINEX observation file */
+    int maxJobs;                  /* max number of analysis centers downloaded concurrently (1: one after another) */
+    int maxJobsHost;              /* max number of concurrent downloads from one host */
+    bool distributed;             /* (0:off  1:on) distribute the (day, product, site) jobs over the nodes sharing 'leaseDir' */
+    char leaseDir[MAXSTRPATH];    /* work directory shared by the nodes, i.e., on NFS, where the jobs are claimed */
+    int leaseSec;                 /* seconds after which the lease of a job expires and the job is taken over by another node */
+    int priority[NPRODPRI];       /* priority class of each product (0: the highest, up to MAXPRICLASS - 1) in the order of
+                                     PRODPRI_NAMES; a class is downloaded for all the days before the next one */
+    int maxRetry;                 /* max number of retries of a transient download failure (timeout, 5xx), 0: off */
+    double backoff;               /* backoff of the first retry (s), doubled for each next one, with jitter */
+    double backoffMax;            /* cap of the backoff (s) */
+    int timeout;                  /* network timeout of 'wget' (s) */
+    int hostFails;                /* number of consecutive transient failures pausing a host (circuit breaker), 0: never */
+    double hostPause;             /* seconds of a paused host; the jobs it leaves unfinished are kept in 'retry.list' */
+    int connTimeout;              /* connect timeout of 'wget' (s), 0: the default of 'wget' */
+    double lowSpeed;              /* min average speed of a transfer over 'lowSpeedWin' (B/s), below which it is aborted, 0: off */
+    int lowSpeedWin;              /* sliding window of the average speed (s) */
+    int deadline;                 /* total deadline of one transfer (s), after which it is aborted, 0: off */
+    bool ngsS3;                   /* (0:off  1:on) list and download the NGS/NOAA CORS observations via the S3 API (built with libcurl) */
+    char ngsS3Url[MAXSTRPATH];    /* base URL of the NGS/NOAA CORS bucket, or of an S3-compatible server standing in for it */
+    int s3Conns;                  /* max number of parallel S3 transfers */
+    bool manifest;                /* (0:off  1:on) verify the downloads and check the existence of the remote files against
+                                     the checksum manifests (SHA512SUMS/MD5SUMS) of the remote directories */
+    int manifestAge;              /* max age (s) of a cached checksum manifest */
+    bool refresh;                 /* (0:off  1:on) download the mutable products (i.e., IGS ANTEX, CNES real-time, CODE predicted
+                                     GIMs) again when their remote copies change */
+    bool missCache;               /* (0:off  1:on) not ask for the remote files known to be missing until their TTL expires */
+    int missDays[NPRODPRI];       /* days of each product in the order of PRODPRI_NAMES after which a remote file of a day is
+                                     missing for good, until purged, its TTL being doubled for each day it is late before
+                                     (0: the plain TTL, i.e., for the final products published weeks after their day) */
+    int missTtl[NPRODPRI];        /* TTL (s) of a missing remote file of each product in the order of PRODPRI_NAMES */
+    bool longName;                /* (0:off  1:on) ask for the RINEX 3 files of the sites of 'site.list' by their long names
+                                     (i.e., 'ABMF00GLP_R') learned from the remote listings, without a listing */
+    bool http2;                   /* (0:off  1:on) HTTP/2 over TLS if the server offers it, fetching the files of an HTTPS archive
+                                     in parallel over one connection per host (built with libcurl) */
+    int h2Streams;                /* max number of the transfers multiplexed over one HTTP/2 connection */
+    bool ftpSession;              /* (0:off  1:on) the files of the plain FTP archives fetched natively, each host logged in once
+                                     per run and its directories listed by MLSD, instead of by 'wget' */
+    int maxProcs;                 /* max number of the external tools (i.e., 'gzip' and 'crx2rnx') run at once in one job
+                                     (1: one after another) */
+    bool journal;                 /* (0:off  1:on) the (day, product) jobs journaled next to the log file, so that a restart after
+                                     a crash or a kill skips the jobs done */
 
     char logFil[MAXSTRPATH];      /* The log file with full path that gives the indications of whether the data downloading is
                                      successful or not */
@@ -0,0 +1,232 @@
+/*------------------------------------------------------------------------------
+* HttpPool.cpp : parallel HTTP(S) transfers multiplexed over HTTP/2 via libcurl
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    1. RFC 9113, HTTP/2
+*    2. libcurl, CURLMOPT_PIPELINING, CURLOPT_PIPEWAIT and CURLMOPT_MAX_CONCURRENT_STREAMS
+*
+* notes   : thousands of small hourly or high-rate files from one HTTPS archive (i.e., CDDIS) spend most of their time
+*           in the round-trips of the TCP and TLS handshakes and of the requests when they are asked for one by one
+*           over HTTP/1.1. The transfers of a batch are run by a curl multi handle; with HTTP/2 each waits for the
+*           connection to its host and is multiplexed over it as one stream, up to 'streams4h2' at once, so one TLS
+*           connection serves all of them. A server without HTTP/2 (i.e., the S3 buckets) falls back to HTTP/1.1 on
+*           up to 'maxConn' kept-alive connections. The logins of '.netrc' are sent as by 'wget', and the cookies
+*           (i.e., of the Earthdata login of CDDIS) are shared by the transfers, so the login is done once. Without
+*           libcurl (GOOD_USE_CURL undefined), the backend is not available and the callers fall back to 'wget'.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "RetryPolicy.h"
+#include "HttpPool.h"
+#include <chrono>
+#ifdef GOOD_USE_CURL
+#include <curl/curl.h>
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+#ifdef GOOD_USE_CURL
+/**
+* @brief   : InitCurl - the global initialization of libcurl, once
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+static void InitCurl()
+{
+    static bool init = false;
+    if (init) return;
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    init = true;
+} /* end of InitCurl */
+#endif
+
+/**
+* @brief   : HttpPool - a pool of parallel HTTP(S) transfers
+* @param[I]: fopt (FTP options, for HTTP/2, the number of streams and the limits of the transfers)
+* @param[I]: maxConn (max number of connections to one host)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+HttpPool::HttpPool(const ftpopt_t *fopt, int maxConn)
+{
+    _maxConn = maxConn > 0 ? maxConn : 1;
+    _http2 = fopt->http2;
+    _streams = _http2 && fopt->h2Streams > 0 ? fopt->h2Streams : _maxConn;
+    _connTimeout = fopt->connTimeout;
+    _lowSpeed = (long)fopt->lowSpeed;
+    _lowSpeedWin = fopt->lowSpeedWin;
+    _deadline = fopt->deadline;
+} /* end of HttpPool */
+
+/**
+* @brief   : Available - whether the HTTP backend is built in
+* @param[I]: none
+* @param[O]: none
+* @return  : true: built with libcurl, false: not
+* @note    :
+**/
+bool HttpPool::Available()
+{
+#ifdef GOOD_USE_CURL
+    return true;
+#else
+    return false;
+#endif
+} /* end of Available */
+
+/**
+* @brief   : GetAll - download files in parallel
+* @param[I]: urls (URLs of the files)
+* @param[I]: files (local files, one for each URL)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: stats (WGET_OK, WGET_PERMANENT or WGET_TRANSIENT of each file)
+* @return  : number of files downloaded
+* @note    : up to '_streams' transfers run at once; with HTTP/2 they wait for and share one TLS connection per
+*            host, otherwise up to '_maxConn' kept-alive connections per host are reused; a file is written to
+*            'file.part' and renamed when complete
+**/
+int HttpPool::GetAll(const std::vector<string> &urls, const std::vector<string> &files, std::vector<int> &stats, FILE *fpLog)
+{
+    stats.assign(urls.size(), WGET_TRANSIENT);
+#ifndef GOOD_USE_CURL
+    cerr << "*** ERROR(HttpPool::GetAll): GOOD is built without libcurl, the HTTP backend is NOT available!" << endl;
+
+    return 0;
+#else
+    InitCurl();
+    CURLM *multi = curl_multi_init();
+    if (!multi) return 0;
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, _http2 ? (long)CURLPIPE_MULTIPLEX : (long)CURLPIPE_NOTHING);
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)_maxConn);
+#if LIBCURL_VERSION_NUM >= 0x074300  /* 7.67.0 */
+    curl_multi_setopt(multi, CURLMOPT_MAX_CONCURRENT_STREAMS, (long)_streams);
+#endif
+
+    /* the cookies, the DNS and the TLS sessions shared by all the transfers */
+    CURLSH *share = curl_share_init();
+    if (share)
+    {
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+
+    struct slot_t
+    {                                     /* one parallel transfer */
+        CURL *curl;                       /* easy handle */
+        FILE *fp;                         /* the part file */
+        int idx;                          /* index of the file, -1: idle */
+    };
+    std::vector<slot_t> slots(_streams);
+    for (int i = 0; i < _streams; i++)
+    {
+        slots[i].curl = curl_easy_init();
+        slots[i].fp = nullptr;
+        slots[i].idx = -1;
+    }
+
+    double t0 = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    int next = 0, nrun = 0, nok = 0, nconn = 0, nh2 = 0;
+    while (true)
+    {
+        /* fill the idle slots */
+        for (int i = 0; i < _streams && next < (int)urls.size(); i++)
+        {
+            slot_t &slot = slots[i];
+            if (slot.idx >= 0 || !slot.curl) continue;
+            string part = files[next] + HTTP_PART_SUFFIX;
+            slot.fp = fopen(part.c_str(), "wb");
+            if (!slot.fp)
+            {
+                stats[next++] = WGET_PERMANENT;
+                continue;
+            }
+            curl_easy_setopt(slot.curl, CURLOPT_URL, urls[next].c_str());
+            curl_easy_setopt(slot.curl, CURLOPT_WRITEFUNCTION, nullptr);  /* fwrite */
+            curl_easy_setopt(slot.curl, CURLOPT_WRITEDATA, slot.fp);
+            curl_easy_setopt(slot.curl, CURLOPT_HTTP_VERSION, _http2 ? (long)CURL_HTTP_VERSION_2TLS : (long)CURL_HTTP_VERSION_1_1);
+            curl_easy_setopt(slot.curl, CURLOPT_PIPEWAIT, _http2 ? 1L : 0L);
+            curl_easy_setopt(slot.curl, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(slot.curl, CURLOPT_FOLLOWLOCATION, 1L);
+            curl_easy_setopt(slot.curl, CURLOPT_NETRC, (long)CURL_NETRC_OPTIONAL);  /* the logins of '.netrc', as 'wget' */
+            curl_easy_setopt(slot.curl, CURLOPT_COOKIEFILE, "");  /* the cookie engine, without a file */
+            if (share) curl_easy_setopt(slot.curl, CURLOPT_SHARE, share);
+            curl_easy_setopt(slot.curl, CURLOPT_PRIVATE, (void *)&slot);
+            if (_connTimeout > 0) curl_easy_setopt(slot.curl, CURLOPT_CONNECTTIMEOUT, _connTimeout);
+            if (_lowSpeed > 0)
+            {
+                curl_easy_setopt(slot.curl, CURLOPT_LOW_SPEED_LIMIT, _lowSpeed);
+                curl_easy_setopt(slot.curl, CURLOPT_LOW_SPEED_TIME, _lowSpeedWin);
+            }
+            if (_deadline > 0) curl_easy_setopt(slot.curl, CURLOPT_TIMEOUT, _deadline);
+            slot.idx = next++;
+            curl_multi_add_handle(multi, slot.curl);
+            nrun++;
+        }
+        if (nrun == 0) break;
+
+        int still = 0;
+        curl_multi_perform(multi, &still);
+        curl_multi_wait(multi, nullptr, 0, 1000, nullptr);
+
+        /* the finished transfers */
+        CURLMsg *msg;
+        int nmsg = 0;
+        while ((msg = curl_multi_info_read(multi, &nmsg)) != nullptr)
+        {
+            if (msg->msg != CURLMSG_DONE) continue;
+            slot_t *slot = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char **)&slot);
+            CURLcode rc = msg->data.result;
+            long code = 0, nconnect = 0, version = 0;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &code);
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_NUM_CONNECTS, &nconnect);
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_HTTP_VERSION, &version);
+            curl_multi_remove_handle(multi, msg->easy_handle);
+            fclose(slot->fp);
+            slot->fp = nullptr;
+            nconn += (int)nconnect;
+            if (version == CURL_HTTP_VERSION_2_0) nh2++;
+
+            int idx = slot->idx;
+            string part = files[idx] + HTTP_PART_SUFFIX;
+            if (rc == CURLE_OK && code == 200 && rename(part.c_str(), files[idx].c_str()) == 0)
+            {
+                stats[idx] = WGET_OK;
+                nok++;
+            }
+            else
+            {
+                remove(part.c_str());
+                /* no answer, 5xx or 429 is transient; 403/404 is permanent */
+                stats[idx] = (rc != CURLE_OK || code >= 500 || code == 429) ? WGET_TRANSIENT : WGET_PERMANENT;
+                if (fpLog) fprintf(fpLog, "* WARNING(HttpPool): %s failed (%s, HTTP %ld)\n", urls[idx].c_str(),
+                    rc != CURLE_OK ? curl_easy_strerror(rc) : "answered", code);
+            }
+            slot->idx = -1;
+            nrun--;
+        }
+    }
+
+    for (int i = 0; i < _streams; i++)
+    {
+        if (slots[i].curl) curl_easy_cleanup(slots[i].curl);
+    }
+    curl_multi_cleanup(multi);
+    if (share) curl_share_cleanup(share);
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count() - t0;
+    if (fpLog && !urls.empty()) fprintf(fpLog, "* INFO(HttpPool): %d of %d files downloaded in %.1f s over %d connections, "
+        "%d over HTTP/2\n", nok, (int)urls.size(), sec, nconn, nh2);
+
+    return nok;
+#endif
+} /* end of GetAll */
@@ -0,0 +1,57 @@
+/*------------------------------------------------------------------------------
+* HttpPool.h : header file of HttpPool.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+#define HTTP_PART_SUFFIX ".part"         /* suffix of a file being downloaded */
+#define HTTP_MAXCONN     4               /* max number of connections to one host of an archive without HTTP/2 */
+
+class HttpPool
+{
+private:
+    int _maxConn;                         /* max number of connections to one host, for the servers of HTTP/1.1 */
+    int _streams;                         /* max number of transfers at once, multiplexed over one connection per host
+                                             with HTTP/2 */
+    bool _http2;                          /* (0:off  1:on) HTTP/2 over TLS if the server offers it */
+    long _connTimeout;                    /* connect timeout (s), 0: default */
+    long _lowSpeed;                       /* min average speed (B/s) over '_lowSpeedWin', 0: off */
+    long _lowSpeedWin;                    /* window of the average speed (s) */
+    long _deadline;                       /* total deadline of one transfer (s), 0: off */
+
+public:
+    /**
+    * @brief   : HttpPool - a pool of parallel HTTP(S) transfers
+    * @param[I]: fopt (FTP options, for HTTP/2, the number of streams and the limits of the transfers)
+    * @param[I]: maxConn (max number of connections to one host)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    HttpPool(const ftpopt_t *fopt, int maxConn);
+    ~HttpPool()
+    {
+
+    }
+
+    /**
+    * @brief   : Available - whether the HTTP backend is built in
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: built with libcurl, false: not
+    * @note    :
+    **/
+    static bool Available();
+
+    /**
+    * @brief   : GetAll - download files in parallel
+    * @param[I]: urls (URLs of the files)
+    * @param[I]: files (local files, one for each URL)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: stats (WGET_OK, WGET_PERMANENT or WGET_TRANSIENT of each file)
+    * @return  : number of files downloaded
+    * @note    : up to '_streams' transfers run at once; with HTTP/2 they wait for and share one TLS connection per
+    *            host, otherwise up to '_maxConn' kept-alive connections per host are reused; a file is written to
+    *            'file.part' and renamed when complete
+    **/
+    int GetAll(const std::vector<string> &urls, const std::vector<string> &files, std::vector<int> &stats, FILE *fpLog);
+};
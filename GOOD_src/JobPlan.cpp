@@ -0,0 +1,569 @@
+/*------------------------------------------------------------------------------
+* JobPlan.cpp : expansion of the configured downloading into jobs and the prediction of their cost
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : each download run appends the throughput of every product to 'throughput.stats' and summarizes the
+*           remote listings left by 'wget --no-remove-listing' into 'listing.cache', both in the root/main directory.
+*           The estimate uses them when available:
+*             number of files   - 'site.list', or the mean number of files per cached listing for 'all'
+*             transfer volume   - the mean file size of cached listings, otherwise the nominal size
+*             decoding time     - the 'crx2rnx' records, otherwise the nominal decoding rate
+*             wall time         - the throughput records of the same product and host, otherwise the nominal
+*                                 latency and bandwidth, divided by the parallelism
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "StringUtil.h"
+#include "TimeUtil.h"
+#include "JobPlan.h"
+#include <chrono>
+#include <sys/stat.h>
+#ifdef _WIN32  /* for Windows */
+#include <io.h>
+#else          /* for Linux or Mac */
+#include <dirent.h>
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define NOM_LATENCY    2.0      /* nominal latency per file (s) */
+#define NOM_BANDWIDTH  1.0E6    /* nominal bandwidth per connection (bytes/s) */
+#define NOM_DECODE     1.0E7    /* nominal decoding rate of 'crx2rnx' (bytes/s of Hatanaka-compressed files) */
+#define DECODE_PROD    "crx2rnx"  /* product of the decoding records */
+#define DECODE_HOST    "local"    /* host of the decoding records */
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : NominalSize - the nominal size of one remote file of a product
+* @param[I]: prod (product)
+* @param[O]: none
+* @return  : size in bytes
+* @note    :
+**/
+static double NominalSize(const string &prod)
+{
+    static const struct
+    {
+        const char *prefix;
+        double bytes;
+    } sizes[] = {
+        { "obs_", 1.0E5 }, { "nav_daily", 1.0E6 }, { "nav_", 3.0E4 }, { "orbclk_", 3.0E6 }, { "eop", 5.0E3 },
+        { "obx", 5.0E6 }, { "dsb", 3.0E5 }, { "osb", 3.0E5 }, { "snx", 3.0E6 }, { "ion", 4.0E5 }, { "roti", 3.0E5 },
+        { "trp", 3.0E4 }, { "atx", 3.0E6 }
+    };
+
+    if (prod.find("obs_") == 0)
+    {
+        string typ = prod.substr(prod.find_last_of('_') + 1);
+        if (typ == "daily") return 2.0E6;
+        else if (typ == "highrate" || typ == "1s" || typ == "01s") return 1.0E6;
+        else if (typ == "5s" || typ == "05s") return 4.0E5;
+    }
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        if (prod.find(sizes[i].prefix) == 0) return sizes[i].bytes;
+    }
+
+    return 1.0E6;
+} /* end of NominalSize */
+
+/**
+* @brief   : WallTime - the wall clock time in seconds
+* @param[I]: none
+* @param[O]: none
+* @return  : seconds
+* @note    : monotonic
+**/
+static double WallTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} /* end of WallTime */
+
+/**
+* @brief   : ScanDir - add the files of a directory and its sub-directories to a snapshot
+* @param[I]: dir (directory)
+* @param[I]: depth (levels of sub-directories)
+* @param[O]: ds (snapshot)
+* @param[O]: listings (listing files found, nullptr: not needed)
+* @return  : none
+* @note    : the hidden files (i.e., '.listing') are not counted
+**/
+static void ScanDir(const string &dir, int depth, dirstat_t &ds, std::vector<string> *listings)
+{
+    char sep = (char)FILEPATHSEP;
+#ifdef _WIN32  /* for Windows */
+    struct _finddata_t fd;
+    intptr_t h = _findfirst((dir + sep + "*").c_str(), &fd);
+    if (h == -1) return;
+    do
+    {
+        string name = fd.name, path = dir + sep + name;
+        if (name == "." || name == "..") continue;
+        if (fd.attrib & _A_SUBDIR)
+        {
+            if (depth > 0) ScanDir(path, depth - 1, ds, listings);
+        }
+        else if (name == LISTING_FILE)
+        {
+            if (listings) listings->push_back(path);
+        }
+        else if (name[0] != '.')
+        {
+            ds.nfile++;
+            ds.bytes += fd.size;
+        }
+    } while (_findnext(h, &fd) == 0);
+    _findclose(h);
+#else          /* for Linux or Mac */
+    DIR *dp = opendir(dir.c_str());
+    if (!dp) return;
+    struct dirent *ep;
+    while ((ep = readdir(dp)) != nullptr)
+    {
+        string name = ep->d_name, path = dir + sep + name;
+        struct stat st;
+        if (name == "." || name == ".." || stat(path.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode))
+        {
+            if (depth > 0) ScanDir(path, depth - 1, ds, listings);
+        }
+        else if (name == LISTING_FILE)
+        {
+            if (listings) listings->push_back(path);
+        }
+        else if (name[0] != '.')
+        {
+            ds.nfile++;
+            ds.bytes += st.st_size;
+        }
+    }
+    closedir(dp);
+#endif
+} /* end of ScanDir */
+
+/**
+* @brief   : AddJob - add the files of one product from one host
+* @param[I]: prod (product)
+* @param[I]: host (host)
+* @param[I]: nfile (number of files, -1: unknown)
+* @param[I]: decode (whether the files are decoded by 'crx2rnx')
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void JobPlan::AddJob(const string &prod, const string &host, double nfile, bool decode)
+{
+    for (int i = 0; i < _jobs.size(); i++)
+    {
+        if (_jobs[i].prod != prod || _jobs[i].host != host) continue;
+        if (_jobs[i].nfile < 0.0 || nfile < 0.0) _jobs[i].nfile = -1.0;
+        else _jobs[i].nfile += nfile;
+
+        return;
+    }
+
+    job_t job;
+    job.prod = prod;
+    job.host = host;
+    job.nfile = nfile;
+    job.decode = decode;
+    _jobs.push_back(job);
+} /* end of AddJob */
+
+/**
+* @brief   : PerListing - the mean number of files in one cached remote listing
+* @param[I]: prod (product)
+* @param[I]: host (host)
+* @param[O]: none
+* @return  : number of files, -1: no cached listing
+* @note    :
+**/
+double JobPlan::PerListing(const string &prod, const string &host) const
+{
+    std::map<string, rate_t>::const_iterator it = _listings.find(prod + " " + host);
+    if (it == _listings.end() || it->second.sec <= 0.0) return -1.0;
+
+    return it->second.nfile / it->second.sec;
+} /* end of PerListing */
+
+/**
+* @brief   : CountSites - count the sites in 'site.list'
+* @param[I]: lst (the full path of 'site.list', shorter than 9 characters: 'all')
+* @param[O]: none
+* @return  : number of sites, -1: 'all'
+* @note    :
+**/
+int JobPlan::CountSites(const char *lst)
+{
+    if (strlen(lst) < 9) return -1;  /* the option of 'all' is selected; the length of "site.list" is nine */
+
+    ifstream sitLst(lst);
+    if (!sitLst.is_open())
+    {
+        cerr << "*** ERROR(JobPlan::CountSites): open site.list = " << lst << " file failed, please check it" << endl;
+
+        return 0;
+    }
+    StringUtil str;
+    string sitName;
+    int nsite = 0;
+    while (getline(sitLst, sitName))
+    {
+        if (sitName[0] == '#') continue;
+        str.TrimSpace4String(sitName);
+        if (sitName.size() == 4 || sitName.size() == 9) nsite++;
+    }
+    sitLst.close();
+
+    return nsite;
+} /* end of CountSites */
+
+/**
+* @brief   : Load - load the accumulated records of a file
+* @param[I]: file (throughput or listing cache file)
+* @param[I]: nval (number of values after 'prod host')
+* @param[O]: recs (accumulated records)
+* @return  : number of records
+* @note    : for the listing cache, the number of listings is accumulated in 'sec'
+**/
+int JobPlan::Load(const string &file, int nval, std::map<string, rate_t> &recs)
+{
+    FILE *fp = fopen(file.c_str(), "r");
+    if (!fp) return 0;
+
+    char sline[MAXCHARS], prod[MAXCHARS], host[MAXCHARS];
+    double nfile, bytes, sec = 1.0;
+    int nrec = 0;
+    while (fgets(sline, MAXCHARS, fp))
+    {
+        int n = sscanf(sline, "%s %s %lf %lf %lf", prod, host, &nfile, &bytes, &sec);
+        if (n < 2 + nval || prod[0] == '#') continue;
+        rate_t &rec = recs[string(prod) + " " + host];
+        rec.nfile += nfile;
+        rec.bytes += bytes;
+        rec.sec += nval > 2 ? sec : 1.0;
+        nrec++;
+    }
+    fclose(fp);
+
+    return nrec;
+} /* end of Load */
+
+/**
+* @brief   : Host - the host name used in the records of a configuration
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : host, i.e., "CDDIS", "IGN" or "WHU"
+* @note    :
+**/
+string JobPlan::Host(const ftpopt_t *fopt)
+{
+    StringUtil str;
+    string host = fopt->ftpFrom;
+    str.TrimSpace4String(host);
+    str.ToUpper(host);
+    if (host != "IGN" && host != "WHU") host = "CDDIS";  /* the same as the default archive of 'Get*' */
+
+    return host;
+} /* end of Host */
+
+/**
+* @brief   : Probe - take a snapshot of a local data directory and its sub-directories
+* @param[I]: dir (data directory)
+* @param[O]: none
+* @return  : snapshot
+* @note    :
+**/
+dirstat_t JobPlan::Probe(const char *dir)
+{
+    dirstat_t ds = { 0, 0, 0.0 };
+    ScanDir(dir, 2, ds, nullptr);
+    ds.time = WallTime();
+
+    return ds;
+} /* end of Probe */
+
+/**
+* @brief   : Record - record the throughput of one product since a snapshot and cache the remote listings
+* @param[I]: mainDir (root/main directory where the records are kept)
+* @param[I]: prod (product)
+* @param[I]: host (host)
+* @param[I]: dir (data directory)
+* @param[I]: ds0 (snapshot before downloading)
+* @param[O]: none
+* @return  : none
+* @note    : the listings '.listing' left by 'wget' under 'dir' are summarized into 'listing.cache' and deleted
+**/
+void JobPlan::Record(const char *mainDir, const string &prod, const string &host, const char *dir, const dirstat_t &ds0)
+{
+    dirstat_t ds = { 0, 0, 0.0 };
+    std::vector<string> listings;
+    ScanDir(dir, 2, ds, &listings);
+    ds.time = WallTime();
+
+    char sep = (char)FILEPATHSEP;
+    string statFile = string(mainDir) + sep + STATS_FILE, cacheFile = string(mainDir) + sep + LISTING_CACHE;
+    FILE *fp;
+    if (ds.nfile > ds0.nfile && (fp = fopen(statFile.c_str(), "a")))
+    {
+        fprintf(fp, "%s %s %d %lld %.3f\n", prod.c_str(), host.c_str(), ds.nfile - ds0.nfile, ds.bytes - ds0.bytes, ds.time - ds0.time);
+        fclose(fp);
+    }
+
+    /* remote listings in the format of 'ls -l', i.e., '-rw-r--r--  1 ftp ftp  1633475 Feb 02 01:35 ABMF00GLP_R_20210320000_01D_30S_MO.crx.gz' */
+    for (int i = 0; i < listings.size(); i++)
+    {
+        FILE *fpLst = fopen(listings[i].c_str(), "r");
+        if (!fpLst) continue;
+        char sline[MAXCHARS], size[MAXCHARS];
+        int nfile = 0;
+        long long bytes = 0;
+        while (fgets(sline, MAXCHARS, fpLst))
+        {
+            if (sline[0] != '-' || sscanf(sline, "%*s %*s %*s %*s %s", size) < 1) continue;
+            nfile++;
+            bytes += atoll(size);
+        }
+        fclose(fpLst);
+        remove(listings[i].c_str());
+        if (nfile > 0 && (fp = fopen(cacheFile.c_str(), "a")))
+        {
+            fprintf(fp, "%s %s %d %lld\n", prod.c_str(), host.c_str(), nfile, bytes);
+            fclose(fp);
+        }
+    }
+} /* end of Record */
+
+/**
+* @brief   : RecordDecode - record the decoding time of 'crx2rnx'
+* @param[I]: mainDir (root/main directory where the records are kept)
+* @param[I]: nfile (number of decoded files)
+* @param[I]: bytes (total size of Hatanaka-compressed files)
+* @param[I]: sec (seconds)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void JobPlan::RecordDecode(const char *mainDir, int nfile, long long bytes, double sec)
+{
+    if (nfile <= 0) return;
+
+    string statFile = string(mainDir) + (char)FILEPATHSEP + STATS_FILE;
+    FILE *fp = fopen(statFile.c_str(), "a");
+    if (!fp) return;
+    fprintf(fp, "%s %s %d %lld %.3f\n", DECODE_PROD, DECODE_HOST, nfile, bytes, sec);
+    fclose(fp);
+} /* end of RecordDecode */
+
+/**
+* @brief   : Expand - expand the configured products, days and sites into jobs
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : nothing is downloaded, and the directories are not created
+**/
+void JobPlan::Expand(const prcopt_t *popt, const ftpopt_t *fopt)
+{
+    StringUtil str;
+    TimeUtil tu;
+    char sep = (char)FILEPATHSEP;
+    _jobs.clear();
+    _rates.clear();
+    _listings.clear();
+    Load(string(popt->mainDir) + sep + STATS_FILE, 3, _rates);
+    Load(string(popt->mainDir) + sep + LISTING_CACHE, 2, _listings);
+    _ts = popt->ts;
+    _ndays = popt->ndays;
+    double ndays = popt->ndays;
+    string host = Host(fopt);
+
+    /* observation files: sites x files per site per day */
+    if (fopt->getObs)
+    {
+        string obsTyp = fopt->obsTyp, obsFrom = fopt->obsFrom;
+        str.TrimSpace4String(obsTyp);
+        str.ToLower(obsTyp);
+        str.TrimSpace4String(obsFrom);
+        str.ToLower(obsFrom);
+        string prod = "obs_" + obsFrom + "_" + obsTyp;
+        double nh = (double)fopt->hhObs.size(), perSite = 1.0, nlst = 1.0;
+        if (obsTyp == "highrate") perSite = 4.0 * nh;  /* 15-minute files */
+        else if (obsTyp != "daily") perSite = nh;
+        if (obsTyp != "daily") nlst = nh;              /* one listing per hour */
+        int nsite = CountSites(fopt->obsLst);
+        double perListing = PerListing(prod, host);
+        if (nsite >= 0) AddJob(prod, host, nsite * perSite * ndays, true);
+        else AddJob(prod, host, perListing < 0.0 ? -1.0 : perListing * nlst * ndays, true);
+    }
+
+    /* broadcast ephemeris: one file per day, or sites x hours for the site-specific hourly files */
+    if (fopt->getNav)
+    {
+        string navTyp = fopt->navTyp;
+        str.TrimSpace4String(navTyp);
+        str.ToLower(navTyp);
+        if (navTyp == "daily") AddJob("nav_daily", host, ndays, false);
+        else
+        {
+            int nsite = CountSites(fopt->navLst);
+            double perListing = PerListing("nav_" + navTyp, host), nh = (double)fopt->hhNav.size();
+            if (nsite >= 0) AddJob("nav_" + navTyp, host, nsite * nh * ndays, false);
+            else AddJob("nav_" + navTyp, host, perListing < 0.0 ? -1.0 : perListing * nh * ndays, false);
+        }
+    }
+
+    /* precise orbit and clock: SP3 and CLK per analysis center */
+    if (fopt->getOrbClk)
+    {
+        string ac = fopt->orbClkAc;
+        str.TrimSpace4String(ac);
+        str.ToLower(ac);
+        std::vector<string> acs, acs_tmp;
+        if ((int)ac.find_first_of('+') > 0) str.GetSubStr(ac, "+", acs_tmp);
+        else acs_tmp.push_back(ac);
+        for (int i = 0; i < acs_tmp.size(); i++)
+        {
+            if (acs_tmp[i] == "all") acs.insert(acs.end(), { "cod", "emr", "esa", "gfz", "grg", "igs", "jpl", "mit" });
+            else if (acs_tmp[i] == "all_m") acs.insert(acs.end(), { "cod_m", "gfz_m", "grg_m", "iac_m", "jax_m", "sha_m", "whu_m" });
+            else acs.push_back(acs_tmp[i]);
+        }
+        sort(acs.begin(), acs.end());
+        acs.erase(unique(acs.begin(), acs.end()), acs.end());
+
+        std::vector<string> ultraAc = { "esa_u", "gfz_u", "igs_u", "whu_u" };
+        for (int i = 0; i < acs.size(); i++)
+        {
+            string ac_i = acs[i].substr(0, acs[i].find_first_of('>'));  /* the head of a fallback chain */
+            int iu = (int)(find(ultraAc.begin(), ultraAc.end(), ac_i) - ultraAc.begin());
+            bool isFinal = ac_i != "cnt" && iu == ultraAc.size() && ac_i.find("_r") == string::npos;
+            double nday = ndays;
+            if (isFinal && fopt->minusAdd1day) nday += 2.0;  /* the days before and after overlap between consecutive days */
+            if (iu < ultraAc.size()) nday *= iu < fopt->hhOrbClk.size() ? (double)fopt->hhOrbClk[iu].size() : 0.0;
+            AddJob("orbclk_" + ac_i, host, 2.0 * nday, false);
+        }
+    }
+
+    /* EOP: one file per day, or per update for the ultra-rapid products */
+    if (fopt->getEop)
+    {
+        string eopAc = fopt->eopAc;
+        str.TrimSpace4String(eopAc);
+        str.ToLower(eopAc);
+        eopAc = eopAc.substr(0, eopAc.find_first_of('>'));  /* the head of a fallback chain */
+        bool ultra = eopAc == "igs_u" || eopAc == "esa_u" || eopAc == "gfz_u";
+        AddJob("eop", host, ultra ? fopt->hhEop.size() * ndays : ndays, false);
+    }
+    if (fopt->getObx) AddJob("obx", host, ndays, false);
+    if (fopt->getDsb) AddJob("dsb", host, ndays, false);
+    if (fopt->getOsb) AddJob("osb", host, ndays, false);
+
+    /* IGS weekly SINEX: one file per GPS week */
+    if (fopt->getSnx)
+    {
+        std::vector<daydesc_t> days;
+        tu.DayDescs(popt->ts, popt->ndays, days);
+        int week0 = -1, nweek = 0;
+        for (int i = 0; i < days.size(); i++)
+        {
+            if (days[i].wwww != week0) nweek++;
+            week0 = days[i].wwww;
+        }
+        AddJob("snx", host, nweek, false);
+    }
+
+    /* global ionosphere map per analysis center */
+    if (fopt->getIon)
+    {
+        string ionAc = fopt->ionAc;
+        str.TrimSpace4String(ionAc);
+        str.ToLower(ionAc);
+        std::vector<string> acs;
+        if ((int)ionAc.find_first_of('+') > 0) str.GetSubStr(ionAc, "+", acs);
+        else acs.push_back(ionAc);
+        AddJob("ion", host, acs.size() * ndays, false);
+    }
+    if (fopt->getRoti) AddJob("roti", host, ndays, false);
+    if (fopt->getTrp)
+    {
+        int nsite = CountSites(fopt->trpLst);
+        double perListing = PerListing("trp", host);
+        if (nsite >= 0) AddJob("trp", host, nsite * ndays, false);
+        else AddJob("trp", host, perListing < 0.0 ? -1.0 : perListing * ndays, false);
+    }
+    if (fopt->getAtx) AddJob("atx", host, 1.0, false);
+} /* end of Expand */
+
+/**
+* @brief   : Report - predict and print the transfer volume, decoding time and wall time
+* @param[I]: npar (parallelism, number of concurrent downloads)
+* @param[I]: fp (output file pointer)
+* @param[O]: none
+* @return  : none
+* @note    : the records of previous runs are used if any, otherwise the nominal values
+**/
+void JobPlan::Report(int npar, FILE *fp) const
+{
+    TimeUtil tu;
+    int yyyy, doy;
+    tu.time2yrdoy(_ts, &yyyy, &doy);
+    if (npar < 1) npar = 1;
+
+    /* decoding rate of 'crx2rnx' */
+    double decodeRate = NOM_DECODE;
+    std::map<string, rate_t>::const_iterator it = _rates.find(string(DECODE_PROD) + " " + DECODE_HOST);
+    bool decodeHist = it != _rates.end() && it->second.sec > 0.0 && it->second.bytes > 0.0;
+    if (decodeHist) decodeRate = it->second.bytes / it->second.sec;
+
+    fprintf(fp, "* INFO(JobPlan::Report): estimate of %d day(s) from %04d-%03d at parallelism %d, nothing is downloaded\n",
+        _ndays, yyyy, doy, npar);
+    fprintf(fp, "  %-20s %-6s %10s %13s %10s %11s %10s  %s\n", "product", "host", "files", "transfer(MB)", "disk(MB)", "decode(s)",
+        "time(h)", "source (size/time)");
+    double nfile = 0.0, bytes = 0.0, disk = 0.0, decode = 0.0, sec = 0.0;
+    int nunknown = 0;
+    for (int i = 0; i < _jobs.size(); i++)
+    {
+        const job_t &job = _jobs[i];
+        string key = job.prod + " " + job.host;
+        if (job.nfile < 0.0)
+        {
+            fprintf(fp, "  %-20s %-6s %10s %13s %10s %11s %10s  %s\n", job.prod.c_str(), job.host.c_str(), "unknown", "-", "-", "-", "-",
+                "no site.list and no cached listing");
+            nunknown++;
+            continue;
+        }
+
+        /* size per file from the cached listings, otherwise nominal */
+        std::map<string, rate_t>::const_iterator itl = _listings.find(key), itr = _rates.find(key);
+        bool sizeHist = itl != _listings.end() && itl->second.nfile > 0.0;
+        bool timeHist = itr != _rates.end() && itr->second.nfile > 0.0;
+        double size = sizeHist ? itl->second.bytes / itl->second.nfile : NominalSize(job.prod);
+        double jobBytes = job.nfile * size;
+        double jobDisk = timeHist ? job.nfile * itr->second.bytes / itr->second.nfile : -1.0;
+        double jobDecode = job.decode ? jobBytes / decodeRate : 0.0;
+        double jobSec = timeHist ? job.nfile * itr->second.sec / itr->second.nfile :
+            job.nfile * (NOM_LATENCY + size / NOM_BANDWIDTH) + jobDecode;
+
+        char sDisk[32] = "-";
+        if (jobDisk >= 0.0) sprintf(sDisk, "%.1f", jobDisk / 1.0E6);
+        string source = string(sizeHist ? "listing" : "nominal") + "/" + (timeHist ? "history" : "nominal");
+        fprintf(fp, "  %-20s %-6s %10.0f %13.1f %10s %11.1f %10.2f  %s\n", job.prod.c_str(), job.host.c_str(), job.nfile, jobBytes / 1.0E6,
+            sDisk, jobDecode, jobSec / 3600.0, source.c_str());
+        nfile += job.nfile;
+        bytes += jobBytes;
+        disk += jobDisk > 0.0 ? jobDisk : 0.0;
+        decode += jobDecode;
+        sec += jobSec;
+    }
+    fprintf(fp, "  %-20s %-6s %10.0f %13.1f %10.1f %11.1f %10.2f  decoding: %s\n", "total", "", nfile, bytes / 1.0E6, disk / 1.0E6, decode,
+        sec / 3600.0, decodeHist ? "history" : "nominal");
+    fprintf(fp, "* INFO(JobPlan::Report): predicted wall time %.2f h with %d concurrent download(s)\n", sec / npar / 3600.0, npar);
+    if (nunknown > 0) fprintf(fp, "* WARNING(JobPlan::Report): %d product(s) with unknown number of files are not included, "
+        "please set 'site.list' or run one day first to cache the remote listings\n", nunknown);
+} /* end of Report */
@@ -0,0 +1,155 @@
+/*------------------------------------------------------------------------------
+* JobPlan.h : header file of JobPlan.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+
+#define STATS_FILE     "throughput.stats"  /* throughput of previous runs in the root/main directory, 'prod host nfile bytes seconds' */
+#define LISTING_CACHE  "listing.cache"     /* remote listings of previous runs in the root/main directory, 'prod host nfile bytes' */
+#define LISTING_FILE   ".listing"          /* listing kept by 'wget --no-remove-listing' */
+
+struct dirstat_t
+{                                         /* snapshot of a local data directory */
+    int nfile;                            /* number of files */
+    long long bytes;                      /* total size of files */
+    double time;                          /* wall clock time (s) */
+};
+
+class JobPlan
+{
+private:
+    struct job_t
+    {                                     /* files of one product from one host */
+        string prod;                      /* product, i.e., "obs_mgex_daily", "orbclk_cod" */
+        string host;                      /* host (FTP archive) */
+        double nfile;                     /* number of files, -1: unknown */
+        bool decode;                      /* whether the files are decoded by 'crx2rnx' */
+    };
+    struct rate_t
+    {                                     /* accumulated records */
+        double nfile;                     /* number of files */
+        double bytes;                     /* total size of files */
+        double sec;                       /* seconds (number of listings for the listing cache) */
+    };
+
+    std::vector<job_t> _jobs;             /* expanded jobs */
+    std::map<string, rate_t> _rates;      /* throughput of previous runs, key: "prod host" */
+    std::map<string, rate_t> _listings;   /* remote listings of previous runs, key: "prod host" */
+    int _ndays;                           /* number of days */
+    gtime_t _ts;                          /* start time */
+
+    /**
+    * @brief   : AddJob - add the files of one product from one host
+    * @param[I]: prod (product)
+    * @param[I]: host (host)
+    * @param[I]: nfile (number of files, -1: unknown)
+    * @param[I]: decode (whether the files are decoded by 'crx2rnx')
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void AddJob(const string &prod, const string &host, double nfile, bool decode);
+
+    /**
+    * @brief   : PerListing - the mean number of files in one cached remote listing
+    * @param[I]: prod (product)
+    * @param[I]: host (host)
+    * @param[O]: none
+    * @return  : number of files, -1: no cached listing
+    * @note    :
+    **/
+    double PerListing(const string &prod, const string &host) const;
+
+    /**
+    * @brief   : CountSites - count the sites in 'site.list'
+    * @param[I]: lst (the full path of 'site.list', shorter than 9 characters: 'all')
+    * @param[O]: none
+    * @return  : number of sites, -1: 'all'
+    * @note    :
+    **/
+    static int CountSites(const char *lst);
+
+    /**
+    * @brief   : Load - load the accumulated records of a file
+    * @param[I]: file (throughput or listing cache file)
+    * @param[I]: nval (number of values after 'prod host')
+    * @param[O]: recs (accumulated records)
+    * @return  : number of records
+    * @note    :
+    **/
+    static int Load(const string &file, int nval, std::map<string, rate_t> &recs);
+
+public:
+    JobPlan()
+    {
+        _ndays = 0;
+        _ts = { 0 };
+    }
+    ~JobPlan()
+    {
+
+    }
+
+    /**
+    * @brief   : Host - the host name used in the records of a configuration
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : host, i.e., "CDDIS", "IGN" or "WHU"
+    * @note    :
+    **/
+    static string Host(const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Probe - take a snapshot of a local data directory and its sub-directories
+    * @param[I]: dir (data directory)
+    * @param[O]: none
+    * @return  : snapshot
+    * @note    :
+    **/
+    static dirstat_t Probe(const char *dir);
+
+    /**
+    * @brief   : Record - record the throughput of one product since a snapshot and cache the remote listings
+    * @param[I]: mainDir (root/main directory where the records are kept)
+    * @param[I]: prod (product)
+    * @param[I]: host (host)
+    * @param[I]: dir (data directory)
+    * @param[I]: ds0 (snapshot before downloading)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the listings '.listing' left by 'wget' under 'dir' are summarized into 'listing.cache' and deleted
+    **/
+    static void Record(const char *mainDir, const string &prod, const string &host, const char *dir, const dirstat_t &ds0);
+
+    /**
+    * @brief   : RecordDecode - record the decoding time of 'crx2rnx'
+    * @param[I]: mainDir (root/main directory where the records are kept)
+    * @param[I]: nfile (number of decoded files)
+    * @param[I]: bytes (total size of Hatanaka-compressed files)
+    * @param[I]: sec (seconds)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void RecordDecode(const char *mainDir, int nfile, long long bytes, double sec);
+
+    /**
+    * @brief   : Expand - expand the configured products, days and sites into jobs
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : nothing is downloaded, and the directories are not created
+    **/
+    void Expand(const prcopt_t *popt, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Report - predict and print the transfer volume, decoding time and wall time
+    * @param[I]: npar (parallelism, number of concurrent downloads)
+    * @param[I]: fp (output file pointer)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the records of previous runs are used if any, otherwise the nominal values
+    **/
+    void Report(int npar, FILE *fp) const;
+};
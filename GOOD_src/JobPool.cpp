@@ -0,0 +1,250 @@
+/*------------------------------------------------------------------------------
+* JobPool.cpp : concurrent downloading jobs with per-host limits
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : the downloading routines change the current directory and run 'wget' there, which leaves '.listing' in
+*           it, so the concurrent jobs are run in child processes, each in a private working directory holding the
+*           hard links of the existing files. The new files are moved to the data directory when the job exits.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "JobPool.h"
+#include <map>
+#include <sys/stat.h>
+#ifndef _WIN32  /* for Linux or Mac */
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Stage - create the private working directory of a job with the hard links of existing files
+* @param[I]: dir (data directory)
+* @param[I]: stage (private working directory)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : so that the existing files are still skipped by the job
+**/
+bool JobPool::Stage(const string &dir, const string &stage)
+{
+#ifdef _WIN32  /* for Windows */
+    return false;
+#else          /* for Linux or Mac */
+    if (mkdir(stage.c_str(), 0755) != 0) return false;
+
+    DIR *dp = opendir(dir.c_str());
+    if (!dp) return true;
+    struct dirent *ep;
+    while ((ep = readdir(dp)) != nullptr)
+    {
+        if (ep->d_name[0] == '.') continue;
+        string src = dir + "/" + ep->d_name;
+        struct stat st;
+        if (stat(src.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        link(src.c_str(), (stage + "/" + ep->d_name).c_str());
+    }
+    closedir(dp);
+
+    return true;
+#endif
+} /* end of Stage */
+
+/**
+* @brief   : Unstage - move the new files of a job to the data directory and remove its working directory
+* @param[I]: stage (private working directory)
+* @param[I]: dir (data directory)
+* @param[O]: none
+* @return  : number of files moved
+* @note    : the hidden files (i.e., '.listing') are dropped
+**/
+int JobPool::Unstage(const string &stage, const string &dir)
+{
+    int nmove = 0;
+#ifndef _WIN32  /* for Linux or Mac */
+    DIR *dp = opendir(stage.c_str());
+    if (!dp) return 0;
+    struct dirent *ep;
+    while ((ep = readdir(dp)) != nullptr)
+    {
+        if (ep->d_name[0] == '.') continue;
+        string src = stage + "/" + ep->d_name, dst = dir + "/" + ep->d_name;
+        struct stat st, st0;
+        if (stat(src.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        if (stat(dst.c_str(), &st0) == 0 && st0.st_dev == st.st_dev && st0.st_ino == st.st_ino) continue;  /* existed */
+        if (rename(src.c_str(), dst.c_str()) == 0) nmove++;
+    }
+    closedir(dp);
+
+    string cmd = "rm -rf " + stage;
+    std::system(cmd.c_str());
+#endif
+
+    return nmove;
+} /* end of Unstage */
+
+/**
+* @brief   : Add - add one job
+* @param[I]: host (host the job downloads from)
+* @param[I]: dir (data directory)
+* @param[I]: func (the job, called with its working directory, returning false if left unfinished or missing some files)
+* @param[O]: none
+* @return  : none
+* @note    : the job changes into the working directory by itself
+**/
+void JobPool::Add(const string &host, const char *dir, std::function<bool(const char *wdir)> func)
+{
+    task_t task;
+    task.host = host;
+    task.dir = dir;
+    task.func = func;
+    task.pid = 0;
+    _tasks.push_back(task);
+} /* end of Add */
+
+/**
+* @brief   : Concurrent - whether the jobs will run concurrently
+* @param[I]: none
+* @param[O]: none
+* @return  : true: concurrently, false: one after another
+* @note    :
+**/
+bool JobPool::Concurrent() const
+{
+#ifdef _WIN32  /* for Windows */
+    return false;
+#else          /* for Linux or Mac */
+    return _maxJobs > 1 && _tasks.size() > 1;
+#endif
+} /* end of Concurrent */
+
+/**
+* @brief   : Run - run all the jobs and wait for them
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : number of failed or incomplete jobs
+* @note    : each concurrent job runs in a child process in its own working directory under the data directory,
+*            so the working directory and the '.listing' of 'wget' are not shared; on Windows, or when none of the
+*            jobs left may start, the jobs run one after another
+**/
+int JobPool::Run(FILE *fpLog)
+{
+    int nfail = 0;
+    if (!Concurrent())
+    {
+        for (int i = 0; i < _tasks.size(); i++)
+        {
+            if (!_tasks[i].func(_tasks[i].dir.c_str())) nfail++;
+        }
+        _tasks.clear();
+
+        return nfail;
+    }
+
+#ifndef _WIN32  /* for Linux or Mac */
+    std::map<string, int> nhost;
+    int nrun = 0, ndone = 0, ntask = (int)_tasks.size();
+    while (ndone < ntask)
+    {
+        /* start the waiting jobs as long as both the total and the per-host limits allow */
+        for (int i = 0; i < ntask && nrun < _maxJobs; i++)
+        {
+            task_t &task = _tasks[i];
+            if (task.pid != 0 || nhost[task.host] >= _maxHost) continue;
+
+            char stage[MAXSTRPATH];
+            sprintf(stage, "%s%c%s%d_%d", task.dir.c_str(), (char)FILEPATHSEP, STAGE_PREFIX, (int)getpid(), i);
+            task.stage = stage;
+            fflush(stdout);
+            if (fpLog) fflush(fpLog);
+            int pid = Stage(task.dir, task.stage) ? (int)fork() : -1;
+            if (pid == 0)  /* the child */
+            {
+                bool ok = task.func(task.stage.c_str());
+                fflush(nullptr);
+                _exit(ok ? 0 : JOB_INCOMPLETE);
+            }
+            else if (pid < 0)  /* run it here instead */
+            {
+                if (fpLog) fprintf(fpLog, "* WARNING(JobPool): failed to start the job of %s concurrently\n", task.host.c_str());
+                Unstage(task.stage, task.dir);
+                if (!task.func(task.dir.c_str())) nfail++;
+                task.pid = -1;
+                ndone++;
+                continue;
+            }
+            task.pid = pid;
+            nhost[task.host]++;
+            nrun++;
+        }
+        if (nrun == 0)
+        {
+            /* none of the waiting jobs may start: run them here one after another, never spinning */
+            if (fpLog) fprintf(fpLog, "* WARNING(JobPool): no job can start concurrently, the jobs left run one after another\n");
+            for (int i = 0; i < ntask; i++)
+            {
+                if (_tasks[i].pid != 0) continue;
+                if (!_tasks[i].func(_tasks[i].dir.c_str())) nfail++;
+                _tasks[i].pid = -1;
+                ndone++;
+            }
+            break;
+        }
+
+        /* wait for any job */
+        int status = 0;
+        int pid = (int)waitpid(-1, &status, 0);
+        if (pid < 0) break;
+        for (int i = 0; i < ntask; i++)
+        {
+            task_t &task = _tasks[i];
+            if (task.pid != pid) continue;
+            Unstage(task.stage, task.dir);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            {
+                nfail++;
+                if (fpLog && !(WIFEXITED(status) && WEXITSTATUS(status) == JOB_INCOMPLETE))
+                    fprintf(fpLog, "* WARNING(JobPool): the job of %s exited abnormally\n", task.host.c_str());
+            }
+            task.pid = -1;
+            nhost[task.host]--;
+            nrun--;
+            ndone++;
+
+            break;
+        }
+    }
+#endif
+    _tasks.clear();
+
+    return nfail;
+} /* end of Run */
+
+/**
+* @brief   : DataDir - the data directory of the current job
+* @param[I]: none
+* @param[O]: none
+* @return  : the current directory, or its parent for the private working directory of a concurrent job
+* @note    : the new files of a concurrent job are moved to the data directory when it exits
+**/
+string JobPool::DataDir()
+{
+    char buff[MAXSTRPATH] = { '\0' };
+#ifdef _WIN32   /* for Windows */
+    if (!_getcwd(buff, MAXSTRPATH)) return "";
+#else           /* for Linux or Mac */
+    if (!getcwd(buff, MAXSTRPATH)) return "";
+#endif
+    string dir = buff;
+    size_t ipos = dir.find_last_of("/\\");
+    if (ipos != string::npos && dir.compare(ipos + 1, strlen(STAGE_PREFIX), STAGE_PREFIX) == 0) dir = dir.substr(0, ipos);
+
+    return dir;
+} /* end of DataDir */
@@ -0,0 +1,97 @@
+/*------------------------------------------------------------------------------
+* JobPool.h : header file of JobPool.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <functional>
+
+#define STAGE_PREFIX   ".job_"           /* prefix of the private working directories of concurrent jobs */
+#define JOB_INCOMPLETE 3                 /* exit status of a concurrent job left unfinished or missing some files */
+
+class JobPool
+{
+private:
+    struct task_t
+    {                                     /* one downloading job */
+        string host;                      /* host the job downloads from */
+        string dir;                       /* data directory */
+        std::function<bool(const char *wdir)> func;  /* the job, called with its working directory, false: incomplete */
+        string stage;                     /* private working directory (concurrent mode) */
+        int pid;                          /* process id (concurrent mode), 0: not started, -1: finished */
+    };
+
+    std::vector<task_t> _tasks;           /* jobs */
+    int _maxJobs;                         /* max number of concurrent jobs */
+    int _maxHost;                         /* max number of concurrent jobs per host */
+
+    /**
+    * @brief   : Stage - create the private working directory of a job with the hard links of existing files
+    * @param[I]: dir (data directory)
+    * @param[I]: stage (private working directory)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : so that the existing files are still skipped by the job
+    **/
+    static bool Stage(const string &dir, const string &stage);
+
+    /**
+    * @brief   : Unstage - move the new files of a job to the data directory and remove its working directory
+    * @param[I]: stage (private working directory)
+    * @param[I]: dir (data directory)
+    * @param[O]: none
+    * @return  : number of files moved
+    * @note    : the hidden files (i.e., '.listing') are dropped
+    **/
+    static int Unstage(const string &stage, const string &dir);
+
+public:
+    JobPool(int maxJobs, int maxHost)
+    {
+        /* at least one job, as in "ProcPool::Set", or "Run" would never start any */
+        _maxJobs = maxJobs < 1 ? 1 : maxJobs;
+        _maxHost = maxHost < 1 ? 1 : maxHost;
+    }
+    ~JobPool()
+    {
+
+    }
+
+    /**
+    * @brief   : Add - add one job
+    * @param[I]: host (host the job downloads from)
+    * @param[I]: dir (data directory)
+    * @param[I]: func (the job, called with its working directory, returning false if left unfinished or missing some files)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the job changes into the working directory by itself
+    **/
+    void Add(const string &host, const char *dir, std::function<bool(const char *wdir)> func);
+
+    /**
+    * @brief   : Concurrent - whether the jobs will run concurrently
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: concurrently, false: one after another
+    * @note    :
+    **/
+    bool Concurrent() const;
+
+    /**
+    * @brief   : Run - run all the jobs and wait for them
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : number of failed or incomplete jobs
+    * @note    : each concurrent job runs in a child process in its own working directory under the data directory,
+    *            so the working directory and the '.listing' of 'wget' are not shared; on Windows, or when none of the
+    *            jobs left may start, the jobs run one after another
+    **/
+    int Run(FILE *fpLog);
+
+    /**
+    * @brief   : DataDir - the data directory of the current job
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the current directory, or its parent for the private working directory of a concurrent job
+    * @note    : the new files of a concurrent job are moved to the data directory when it exits
+    **/
+    static string DataDir();
+};
@@ -0,0 +1,708 @@
+/*------------------------------------------------------------------------------
+* Manifest.cpp : checksum manifests (SHA512SUMS/MD5SUMS) of the remote directories
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    1. RFC 1321, The MD5 Message-Digest Algorithm
+*    2. FIPS 180-4, Secure Hash Standard (SHS)
+*
+* notes   : CDDIS (and some other archives) publish 'SHA512SUMS' and/or 'MD5SUMS' in each directory. The manifest of a
+*           remote directory is fetched once per run, when a file of it is asked for the first time, and cached in
+*           '<mainDir>/.manifest' for the next runs (up to its max age). A directory without any manifest is cached
+*           as an empty file, so it is not probed again. With the manifest:
+*           1. a file not in it is not there, and 'wget' is not run for it (a cached manifest is fetched again first,
+*              for the files published since);
+*           2. a downloaded file not matching its checksum is removed, and downloaded once more;
+*           3. a verified file is written to the ledger of the day of its job, 'ledger_yyyyddd', and a later run
+*              checks the ledger against the current manifests, so that a local copy of a file the archive has
+*              republished (i.e., a corrected RINEX file) is removed and downloaded again.
+*           The remote directory of a command is its URL, i.e., the files found by 'wget -r' in its subdirectories
+*           are not covered.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "StringUtil.h"
+#include "JobPool.h"
+#include "RnxUtil.h"
+#include "ObsArchive.h"
+#include "ObsStore.h"
+#include "Manifest.h"
+#include <cstdint>
+#include <ctime>
+#include <sstream>
+#include <sys/stat.h>
+#ifdef _WIN32  /* for Windows */
+#include <process.h>
+#endif
+
+/* constants/macros ----------------------------------------------------------*/
+#define HASH_BUFF      65536             /* bytes read at once */
+
+static const uint32_t K_MD5[64] = {      /* MD5 constants */
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+static const int R_MD5[64] = {           /* MD5 shifts */
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+static const uint64_t K_SHA512[80] = {   /* SHA-512 constants */
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Md5Block - process one 64-byte block of MD5
+* @param[I/O]: h (state)
+* @param[I]: p (block)
+* @return  : none
+* @note    :
+**/
+static void Md5Block(uint32_t h[4], const unsigned char *p)
+{
+    uint32_t w[16];
+    for (int i = 0; i < 16; i++) w[i] = (uint32_t)p[4 * i] | (uint32_t)p[4 * i + 1] << 8 | (uint32_t)p[4 * i + 2] << 16 |
+        (uint32_t)p[4 * i + 3] << 24;
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+    for (int i = 0; i < 64; i++)
+    {
+        uint32_t f;
+        int g;
+        if (i < 16)
+        {
+            f = (b & c) | (~b & d);
+            g = i;
+        }
+        else if (i < 32)
+        {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) % 16;
+        }
+        else if (i < 48)
+        {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) % 16;
+        }
+        else
+        {
+            f = c ^ (b | ~d);
+            g = (7 * i) % 16;
+        }
+        uint32_t x = a + f + K_MD5[i] + w[g];
+        a = d;
+        d = c;
+        c = b;
+        b += (x << R_MD5[i]) | (x >> (32 - R_MD5[i]));
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+} /* end of Md5Block */
+
+/**
+* @brief   : Sha512Block - process one 128-byte block of SHA-512
+* @param[I/O]: h (state)
+* @param[I]: p (block)
+* @return  : none
+* @note    :
+**/
+static void Sha512Block(uint64_t h[8], const unsigned char *p)
+{
+    auto rotr = [](uint64_t x, int n) { return (x >> n) | (x << (64 - n)); };
+    uint64_t w[80];
+    for (int i = 0; i < 16; i++)
+    {
+        w[i] = 0;
+        for (int j = 0; j < 8; j++) w[i] = w[i] << 8 | p[8 * i + j];
+    }
+    for (int i = 16; i < 80; i++)
+    {
+        uint64_t s0 = rotr(w[i - 15], 1) ^ rotr(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        uint64_t s1 = rotr(w[i - 2], 19) ^ rotr(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint64_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], k = h[7];
+    for (int i = 0; i < 80; i++)
+    {
+        uint64_t t1 = k + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) + ((e & f) ^ (~e & g)) + K_SHA512[i] + w[i];
+        uint64_t t2 = (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+        k = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+    h[5] += f;
+    h[6] += g;
+    h[7] += k;
+} /* end of Sha512Block */
+
+/**
+* @brief   : Md5 - MD5 digest of a file
+* @param[I]: file (file)
+* @param[O]: none
+* @return  : lower-case hex digest, "" if the file cannot be read
+* @note    :
+**/
+string Manifest::Md5(const string &file)
+{
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return "";
+
+    uint32_t h[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+    std::vector<unsigned char> buff(HASH_BUFF + 128);
+    uint64_t len = 0;
+    size_t n;
+    while ((n = fread(buff.data(), 1, HASH_BUFF, fp)) == HASH_BUFF)
+    {
+        for (size_t i = 0; i < n; i += 64) Md5Block(h, buff.data() + i);
+        len += n;
+    }
+    fclose(fp);
+
+    /* the last blocks, padded with the length in bits (little endian) */
+    len += n;
+    size_t nb = n / 64 * 64;
+    for (size_t i = 0; i < nb; i += 64) Md5Block(h, buff.data() + i);
+    size_t rem = n - nb;
+    memmove(buff.data(), buff.data() + nb, rem);
+    buff[rem++] = 0x80;
+    while (rem % 64 != 56) buff[rem++] = 0;
+    for (int i = 0; i < 8; i++) buff[rem++] = (unsigned char)((len * 8) >> (8 * i));
+    for (size_t i = 0; i < rem; i += 64) Md5Block(h, buff.data() + i);
+
+    char hex[33];
+    for (int i = 0; i < 16; i++) sprintf(hex + 2 * i, "%02x", (unsigned)(h[i / 4] >> (8 * (i % 4))) & 0xff);
+
+    return string(hex);
+} /* end of Md5 */
+
+/**
+* @brief   : Sha512 - SHA-512 digest of a file
+* @param[I]: file (file)
+* @param[O]: none
+* @return  : lower-case hex digest, "" if the file cannot be read
+* @note    :
+**/
+string Manifest::Sha512(const string &file)
+{
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return "";
+
+    uint64_t h[8] = { 0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL };
+    std::vector<unsigned char> buff(HASH_BUFF + 256);
+    uint64_t len = 0;
+    size_t n;
+    while ((n = fread(buff.data(), 1, HASH_BUFF, fp)) == HASH_BUFF)
+    {
+        for (size_t i = 0; i < n; i += 128) Sha512Block(h, buff.data() + i);
+        len += n;
+    }
+    fclose(fp);
+
+    /* the last blocks, padded with the length in bits (128 bits, big endian) */
+    len += n;
+    size_t nb = n / 128 * 128;
+    for (size_t i = 0; i < nb; i += 128) Sha512Block(h, buff.data() + i);
+    size_t rem = n - nb;
+    memmove(buff.data(), buff.data() + nb, rem);
+    buff[rem++] = 0x80;
+    while (rem % 128 != 112) buff[rem++] = 0;
+    for (int i = 0; i < 8; i++) buff[rem++] = 0;
+    for (int i = 7; i >= 0; i--) buff[rem++] = (unsigned char)((len * 8) >> (8 * i));
+    for (size_t i = 0; i < rem; i += 128) Sha512Block(h, buff.data() + i);
+
+    char hex[129];
+    for (int i = 0; i < 8; i++) sprintf(hex + 16 * i, "%016llx", (unsigned long long)h[i]);
+
+    return string(hex);
+} /* end of Sha512 */
+
+/**
+* @brief   : Parse - parse a manifest in the format of 'sha512sum'/'md5sum'
+* @param[I]: file (manifest)
+* @param[O]: s (checksums)
+* @return  : number of the checksums
+* @note    : the algorithm is told by the length of the checksums
+**/
+int Manifest::Parse(const string &file, sums_t &s)
+{
+    s.algo = "";
+    s.sums.clear();
+    FILE *fp = fopen(file.c_str(), "r");
+    if (!fp) return 0;
+
+    StringUtil str;
+    char line[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        /* i.e., '<checksum>  abmf0320.24d.gz' or '<checksum> *./abmf0320.24d.gz' */
+        std::istringstream iss(line);
+        string hash, name;
+        if (!(iss >> hash >> name)) continue;
+        if (hash.size() != 128 && hash.size() != 32) continue;
+        if (hash.find_first_not_of("0123456789abcdefABCDEF") != string::npos) continue;
+        if (name[0] == '*') name = name.substr(1);
+        size_t ipos = name.find_last_of('/');
+        if (ipos != string::npos) name = name.substr(ipos + 1);
+        str.ToLower(hash);
+        if (s.algo.empty()) s.algo = hash.size() == 128 ? "SHA512SUMS" : "MD5SUMS";
+        if (hash.size() == (s.algo == "SHA512SUMS" ? 128 : 32)) s.sums[name] = hash;
+    }
+    fclose(fp);
+
+    return (int)s.sums.size();
+} /* end of Parse */
+
+/**
+* @brief   : Load - the manifest of a remote directory, from the cache or fetched
+* @param[I]: dirUrl (URL of the remote directory)
+* @param[I]: force (fetched again even if it is loaded or cached)
+* @param[I]: retry (retry policy of the 'wget' commands)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : the manifest, nullptr if none is published or it cannot be fetched
+* @note    : 'SHA512SUMS' is tried first, then 'MD5SUMS'; a directory without any is cached as such
+**/
+const Manifest::sums_t *Manifest::Load(const string &dirUrl, bool force, RetryPolicy &retry, FILE *fpLog)
+{
+    /* once per run */
+    auto it = _dirs.find(dirUrl);
+    if (it != _dirs.end() && (!force || it->second.fetched)) return it->second.algo.empty() ? nullptr : &it->second;
+
+    /* i.e., 'ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily/2024/032/24d' ->
+       'gdc.cddis.eosdis.nasa.gov_pub_gnss_data_daily_2024_032_24d' */
+    size_t ipos = dirUrl.find("://");
+    string name = ipos == string::npos ? dirUrl : dirUrl.substr(ipos + 3);
+    for (int i = 0; i < name.size(); i++)
+        if (!isalnum((unsigned char)name[i]) && name[i] != '.' && name[i] != '-') name[i] = '_';
+    string cache = _cacheDir + (char)FILEPATHSEP + name;
+
+    sums_t &s = _dirs[dirUrl];
+    s.fetched = false;
+    struct stat st;
+    bool cached = stat(cache.c_str(), &st) == 0;
+    if (!force && cached && difftime(time(nullptr), st.st_mtime) < _maxAge)
+    {
+        Parse(cache, s);
+
+        return s.algo.empty() ? nullptr : &s;
+    }
+
+    /* fetched to a private file and renamed, for the concurrent jobs */
+    char tmpFile[MAXSTRPATH];
+#ifdef _WIN32   /* for Windows */
+    sprintf(tmpFile, "%s.%d", cache.c_str(), (int)_getpid());
+#else           /* for Linux or Mac */
+    sprintf(tmpFile, "%s.%d", cache.c_str(), (int)getpid());
+#endif
+    const char *algos[2] = { "SHA512SUMS", "MD5SUMS" };
+    bool answered = true;  /* so that none is published */
+    for (int i = 0; i < 2; i++)
+    {
+        remove(tmpFile);
+        string cmd = _wget + " -O " + tmpFile + " " + dirUrl + "/" + algos[i];
+        int stat = retry.Run(cmd, _quiet, fpLog);
+        if (stat == WGET_TRANSIENT || stat == WGET_PAUSED)
+        {
+            answered = false;
+            break;
+        }
+        if (stat == WGET_OK && Parse(tmpFile, s) > 0) break;
+    }
+    if (!s.algo.empty())
+    {
+        rename(tmpFile, cache.c_str());
+        s.fetched = true;
+        if (fpLog) fprintf(fpLog, "* INFO(Manifest): %s/%s fetched, %d files\n", dirUrl.c_str(), s.algo.c_str(), (int)s.sums.size());
+    }
+    else if (answered)
+    {
+        remove(tmpFile);
+        FILE *fp = fopen(cache.c_str(), "w");
+        if (fp) fclose(fp);
+        s.fetched = true;
+    }
+    else
+    {
+        /* the host did not answer, the cached one however old */
+        remove(tmpFile);
+        if (cached) Parse(cache, s);
+    }
+
+    return s.algo.empty() ? nullptr : &s;
+} /* end of Load */
+
+/**
+* @brief   : Match - the names of a manifest matching the accept patterns
+* @param[I]: s (manifest)
+* @param[I]: pats (accept patterns of 'wget -A', or names)
+* @param[O]: names (the names matched)
+* @return  : none
+* @note    : as 'wget -A', a pattern without wildcards is a suffix
+**/
+void Manifest::Match(const sums_t &s, const std::vector<string> &pats, std::vector<string> &names)
+{
+    names.clear();
+    StringUtil str;
+    for (auto it = s.sums.begin(); it != s.sums.end(); ++it)
+    {
+        const string &name = it->first;
+        for (int i = 0; i < pats.size(); i++)
+        {
+            bool wild = pats[i].find_first_of("*?[") != string::npos;
+            if (wild ? str.WildMatch(pats[i].c_str(), name.c_str()) :
+                (name.size() >= pats[i].size() && name.compare(name.size() - pats[i].size(), pats[i].size(), pats[i]) == 0))
+            {
+                names.push_back(name);
+                break;
+            }
+        }
+    }
+} /* end of Match */
+
+/**
+* @brief   : Copies - the local copies of a downloaded file
+* @param[I]: path (the downloaded file)
+* @param[O]: files (the file, its decompressed copy and the RINEX observation file converted from it)
+* @return  : none
+* @note    : i.e., 'abmf0320.24d.gz', 'abmf0320.24d', 'abmf0320.24o', or 'ABMF00GLP_R_20240320000_01D_30S_MO.crx.gz',
+*            'ABMF00GLP_R_20240320000_01D_30S_MO.crx', 'abmf0320.24o', with the compressed and columnar stores of
+*            the latter
+**/
+void Manifest::Copies(const string &path, std::vector<string> &files)
+{
+    files.clear();
+    files.push_back(path);
+
+    /* decompressed */
+    string file = path;
+    size_t ipos = file.find_last_of('.');
+    if (ipos != string::npos && (file.substr(ipos) == ".gz" || file.substr(ipos) == ".Z"))
+    {
+        file = file.substr(0, ipos);
+        files.push_back(file);
+    }
+
+    /* converted, i.e., the short name of the RINEX observation file */
+    size_t isep = file.find_last_of("/\\");
+    string dir = isep == string::npos ? "" : file.substr(0, isep + 1), name = file.substr(isep + 1);
+    string oFile;
+    if (name.size() == 12 && name[8] == '.' && (name[11] == 'd' || name[11] == 'D')) oFile = name.substr(0, 11) + "o";
+    else if (name.size() > 23 && name[9] == '_' && name[11] == '_' &&
+        (name.find(".crx") != string::npos || name.find(".rnx") != string::npos))
+        oFile = name.substr(0, 4) + name.substr(16, 3) + "0." + name.substr(14, 2) + "o";
+    if (oFile.empty()) return;
+    StringUtil str;
+    str.ToLower(oFile);
+    files.push_back(dir + oFile);
+    files.push_back(dir + oFile + ARC_SUFFIX);
+    files.push_back(dir + oFile + ARC_SUFFIX + IDX_SUFFIX);
+    files.push_back(dir + oFile + OBC_SUFFIX);
+} /* end of Copies */
+
+/**
+* @brief   : Ledger - the ledger of the files verified for a day
+* @param[I]: ts (the day)
+* @param[O]: none
+* @return  : path of the ledger
+* @note    :
+**/
+string Manifest::Ledger(gtime_t ts) const
+{
+    TimeUtil tu;
+    daydesc_t day;
+    tu.DayDesc(ts, day);
+
+    return _cacheDir + (char)FILEPATHSEP + "ledger_" + day.sYyyy + day.sDoy;
+} /* end of Ledger */
+
+/**
+* @brief   : Set - set the manifests
+* @param[I]: fopt (FTP options)
+* @param[I]: mainDir (root/main directory)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void Manifest::Set(const ftpopt_t *fopt, const char *mainDir)
+{
+    _on = fopt->manifest;
+    _maxAge = fopt->manifestAge;
+    _quiet = !fopt->printInfoWget;
+    _cacheDir = string(mainDir) + (char)FILEPATHSEP + MANIFEST_DIR;
+
+    /* one file to a given name, whatever the options of the downloads */
+    char tmpLine[MAXCHARS];
+    sprintf(tmpLine, "%s -nv", fopt->wgetFull);
+    if (fopt->maxRetry > 0) sprintf(tmpLine + strlen(tmpLine), " --tries=1 --timeout=%d", fopt->timeout);
+    if (fopt->connTimeout > 0) sprintf(tmpLine + strlen(tmpLine), " --connect-timeout=%d", fopt->connTimeout);
+    _wget = tmpLine;
+
+    if (_on && access(_cacheDir.c_str(), 0) == -1)
+    {
+#ifdef _WIN32   /* for Windows */
+        string cmd = "mkdir " + _cacheDir;
+#else           /* for Linux or Mac */
+        string cmd = "mkdir -p " + _cacheDir;
+#endif
+        std::system(cmd.c_str());
+    }
+} /* end of Set */
+
+/**
+* @brief   : Request - the remote directory and the files asked by a 'wget' command
+* @param[I]: cmd ('wget' command)
+* @param[O]: dirUrl (URL of the remote directory)
+* @param[O]: pats (accept patterns of '-A', or the name of the file in the URL)
+* @return  : true: ok, false: not a request of files (i.e., a listing)
+* @note    :
+**/
+bool Manifest::Request(const string &cmd, string &dirUrl, std::vector<string> &pats)
+{
+    dirUrl = "";
+    pats.clear();
+    std::istringstream iss(cmd);
+    string tok, prev, url, accept;
+    while (iss >> tok)
+    {
+        if (prev == "-A") accept = tok;
+        else if (tok.find("://") != string::npos) url = tok;
+        prev = tok;
+    }
+    if (url.empty()) return false;
+
+    if (!accept.empty())
+    {
+        StringUtil str;
+        str.GetSubStr(accept, ",", pats);
+        while (!url.empty() && url.back() == '/') url.pop_back();
+        dirUrl = url;
+    }
+    else
+    {
+        size_t ipos = url.find_last_of('/');
+        if (ipos + 1 >= url.size() || ipos < url.find("://") + 3) return false;
+        dirUrl = url.substr(0, ipos);
+        pats.push_back(url.substr(ipos + 1));
+    }
+
+    /* i.e., '-A .none' for the remote listing only */
+    for (int i = 0; i < pats.size(); i++)
+        if (pats[i].empty() || (pats[i][0] == '.' && pats[i].find_first_of("*?[") == string::npos)) return false;
+
+    return !pats.empty();
+} /* end of Request */
+
+/**
+* @brief   : Listed - whether the files asked are in the manifest of their directory
+* @param[I]: dirUrl (URL of the remote directory)
+* @param[I]: pats (accept patterns, or names)
+* @param[I]: retry (retry policy of the 'wget' commands)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : 1: listed, 0: not listed, -1: no manifest
+* @note    : a cached manifest listing none of them is fetched again before the answer, for the files published
+*            since
+**/
+int Manifest::Listed(const string &dirUrl, const std::vector<string> &pats, RetryPolicy &retry, FILE *fpLog)
+{
+    const sums_t *s = Load(dirUrl, false, retry, fpLog);
+    if (!s) return -1;
+
+    std::vector<string> names;
+    Match(*s, pats, names);
+    if (names.empty() && !s->fetched)
+    {
+        s = Load(dirUrl, true, retry, fpLog);
+        if (!s) return -1;
+        Match(*s, pats, names);
+    }
+    if (!names.empty()) return 1;
+
+    _nskip++;
+    if (fpLog) fprintf(fpLog, "* INFO(Manifest): %s/%s not in %s, not downloaded\n", dirUrl.c_str(), pats[0].c_str(), s->algo.c_str());
+
+    return 0;
+} /* end of Listed */
+
+/**
+* @brief   : Verify - verify the files downloaded against the manifest of their directory
+* @param[I]: dirUrl (URL of the remote directory)
+* @param[I]: pats (accept patterns, or names)
+* @param[I]: ts (the day of the job, for the ledger)
+* @param[I]: retry (retry policy of the 'wget' commands)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : number of the corrupt files, which are removed
+* @note    : the files are in the current directory; the good ones are written to the ledger of the day
+**/
+int Manifest::Verify(const string &dirUrl, const std::vector<string> &pats, gtime_t ts, RetryPolicy &retry, FILE *fpLog)
+{
+    const sums_t *s = Load(dirUrl, false, retry, fpLog);
+    if (!s) return 0;
+
+    std::vector<string> names;
+    Match(*s, pats, names);
+    string dir = JobPool::DataDir();
+    int nbad = 0;
+    for (int i = 0; i < names.size(); i++)
+    {
+        if (access(names[i].c_str(), 0) == -1) continue;  /* not there */
+
+        _nverify++;
+        string hash = s->algo == "SHA512SUMS" ? Sha512(names[i]) : Md5(names[i]);
+        if (hash != s->sums.at(names[i]) && !s->fetched)
+        {
+            /* the cached manifest may be older than the file */
+            s = Load(dirUrl, true, retry, fpLog);
+            if (!s) return nbad;
+            if (s->sums.count(names[i]) == 0) continue;
+            hash = s->algo == "SHA512SUMS" ? Sha512(names[i]) : Md5(names[i]);
+        }
+        if (hash == s->sums.at(names[i]))
+        {
+            /* one short line, so that the concurrent jobs do not mix their lines */
+            FILE *fp = fopen(Ledger(ts).c_str(), "a");
+            if (fp)
+            {
+                fprintf(fp, "%s %s %s %s%c%s\n", dirUrl.c_str(), names[i].c_str(), hash.c_str(), dir.c_str(), (char)FILEPATHSEP,
+                    names[i].c_str());
+                fclose(fp);
+            }
+            continue;
+        }
+
+        remove(names[i].c_str());
+        nbad++;
+        _nbad++;
+        if (fpLog) fprintf(fpLog, "* WARNING(Manifest): %s/%s does not match %s, removed\n", dirUrl.c_str(), names[i].c_str(),
+            s->algo.c_str());
+    }
+
+    return nbad;
+} /* end of Verify */
+
+/**
+* @brief   : Refresh - remove the local copies of a day whose remote files were republished
+* @param[I]: ts (the day)
+* @param[I]: retry (retry policy of the 'wget' commands)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : number of the stale files removed
+* @note    : the files verified for the day are checked against the current manifests, and a stale copy is removed
+*            with its decompressed/converted copies, so that it is downloaded again
+**/
+int Manifest::Refresh(gtime_t ts, RetryPolicy &retry, FILE *fpLog)
+{
+    if (!_on) return 0;
+    FILE *fp = fopen(Ledger(ts).c_str(), "r");
+    if (!fp) return 0;
+
+    /* the last checksum of each local file */
+    struct entry_t
+    {
+        string dirUrl, name, hash;
+    };
+    std::map<string, entry_t> entries;
+    char line[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        std::istringstream iss(line);
+        entry_t e;
+        string path;
+        if (!(iss >> e.dirUrl >> e.name >> e.hash) || !getline(iss, path)) continue;
+        StringUtil str;
+        str.TrimSpace4String(path);
+        if (!path.empty()) entries[path] = e;
+    }
+    fclose(fp);
+
+    int nstale = 0;
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        const entry_t &e = it->second;
+        const sums_t *s = Load(e.dirUrl, false, retry, fpLog);
+        if (!s) continue;
+        auto is = s->sums.find(e.name);
+        if (is == s->sums.end() || is->second.size() != e.hash.size() || is->second == e.hash) continue;
+
+        std::vector<string> files;
+        Copies(it->first, files);
+        int nrm = 0;
+        for (int i = 0; i < files.size(); i++)
+            if (remove(files[i].c_str()) == 0) nrm++;
+        if (nrm == 0) continue;
+
+        nstale++;
+        _nstale++;
+        if (fpLog) fprintf(fpLog, "* WARNING(Manifest): %s/%s republished, the stale local copy %s removed\n", e.dirUrl.c_str(),
+            e.name.c_str(), it->first.c_str());
+    }
+
+    return nstale;
+} /* end of Refresh */
+
+/**
+* @brief   : Report - report the files verified
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the files of the concurrent jobs are counted in their own processes and logged one by one
+**/
+void Manifest::Report(FILE *fpLog) const
+{
+    if (_nverify + _nskip + _nstale == 0) return;
+
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d files verified against the checksum manifests, %d corrupt, %d not published and skipped, %d stale",
+        _nverify, _nbad, _nskip, _nstale);
+    cout << "*** INFO(Manifest::Report): " << buff << endl;
+
+    if (fpLog) fprintf(fpLog, "* INFO(Manifest): %s\n", buff);
+} /* end of Report */
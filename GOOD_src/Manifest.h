@@ -0,0 +1,189 @@
+/*------------------------------------------------------------------------------
+* Manifest.h : header file of Manifest.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+#include "RetryPolicy.h"
+
+#define MANIFEST_DIR   ".manifest"       /* cache of the checksum manifests and the ledgers of the verified files in the
+                                            root/main directory */
+
+class Manifest
+{
+private:
+    struct sums_t
+    {                                     /* checksum manifest of one remote directory */
+        string algo;                      /* "SHA512SUMS" or "MD5SUMS", "" if none is published */
+        std::map<string, string> sums;    /* checksum, key: file name */
+        bool fetched;                     /* fetched in this run, not taken from the cache */
+    };
+
+    std::map<string, sums_t> _dirs;       /* manifests loaded, key: URL of the remote directory */
+    bool _on;                             /* (0:off  1:on) */
+    int _maxAge;                          /* max age (s) of a cached manifest */
+    string _cacheDir;                     /* cache directory, '<mainDir>/.manifest' */
+    string _wget;                         /* 'wget' command for the manifests */
+    bool _quiet;                          /* not print information of 'wget' */
+    int _nverify, _nbad, _nskip, _nstale; /* numbers of the files verified, corrupt, skipped and stale */
+
+    /**
+    * @brief   : Md5 - MD5 digest of a file
+    * @param[I]: file (file)
+    * @param[O]: none
+    * @return  : lower-case hex digest, "" if the file cannot be read
+    * @note    :
+    **/
+    static string Md5(const string &file);
+
+    /**
+    * @brief   : Sha512 - SHA-512 digest of a file
+    * @param[I]: file (file)
+    * @param[O]: none
+    * @return  : lower-case hex digest, "" if the file cannot be read
+    * @note    :
+    **/
+    static string Sha512(const string &file);
+
+    /**
+    * @brief   : Parse - parse a manifest in the format of 'sha512sum'/'md5sum'
+    * @param[I]: file (manifest)
+    * @param[O]: s (checksums)
+    * @return  : number of the checksums
+    * @note    : the algorithm is told by the length of the checksums
+    **/
+    static int Parse(const string &file, sums_t &s);
+
+    /**
+    * @brief   : Load - the manifest of a remote directory, from the cache or fetched
+    * @param[I]: dirUrl (URL of the remote directory)
+    * @param[I]: force (fetched again even if it is loaded or cached)
+    * @param[I]: retry (retry policy of the 'wget' commands)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : the manifest, nullptr if none is published or it cannot be fetched
+    * @note    : 'SHA512SUMS' is tried first, then 'MD5SUMS'; a directory without any is cached as such
+    **/
+    const sums_t *Load(const string &dirUrl, bool force, RetryPolicy &retry, FILE *fpLog);
+
+    /**
+    * @brief   : Match - the names of a manifest matching the accept patterns
+    * @param[I]: s (manifest)
+    * @param[I]: pats (accept patterns of 'wget -A', or names)
+    * @param[O]: names (the names matched)
+    * @return  : none
+    * @note    :
+    **/
+    static void Match(const sums_t &s, const std::vector<string> &pats, std::vector<string> &names);
+
+    /**
+    * @brief   : Copies - the local copies of a downloaded file
+    * @param[I]: path (the downloaded file)
+    * @param[O]: files (the file, its decompressed copy and the RINEX observation file converted from it)
+    * @return  : none
+    * @note    : i.e., 'abmf0320.24d.gz', 'abmf0320.24d', 'abmf0320.24o', or 'ABMF00GLP_R_20240320000_01D_30S_MO.crx.gz',
+    *            'ABMF00GLP_R_20240320000_01D_30S_MO.crx', 'abmf0320.24o', with the compressed and columnar stores of
+    *            the latter
+    **/
+    static void Copies(const string &path, std::vector<string> &files);
+
+    /**
+    * @brief   : Ledger - the ledger of the files verified for a day
+    * @param[I]: ts (the day)
+    * @param[O]: none
+    * @return  : path of the ledger
+    * @note    :
+    **/
+    string Ledger(gtime_t ts) const;
+
+public:
+    Manifest()
+    {
+        _on = false;
+        _maxAge = 0;
+        _quiet = true;
+        _nverify = _nbad = _nskip = _nstale = 0;
+    }
+    ~Manifest()
+    {
+
+    }
+
+    /**
+    * @brief   : Set - set the manifests
+    * @param[I]: fopt (FTP options)
+    * @param[I]: mainDir (root/main directory)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Set(const ftpopt_t *fopt, const char *mainDir);
+
+    /**
+    * @brief   : On - whether the manifests are used
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    bool On() const
+    {
+        return _on;
+    }
+
+    /**
+    * @brief   : Request - the remote directory and the files asked by a 'wget' command
+    * @param[I]: cmd ('wget' command)
+    * @param[O]: dirUrl (URL of the remote directory)
+    * @param[O]: pats (accept patterns of '-A', or the name of the file in the URL)
+    * @return  : true: ok, false: not a request of files (i.e., a listing)
+    * @note    :
+    **/
+    static bool Request(const string &cmd, string &dirUrl, std::vector<string> &pats);
+
+    /**
+    * @brief   : Listed - whether the files asked are in the manifest of their directory
+    * @param[I]: dirUrl (URL of the remote directory)
+    * @param[I]: pats (accept patterns, or names)
+    * @param[I]: retry (retry policy of the 'wget' commands)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : 1: listed, 0: not listed, -1: no manifest
+    * @note    : a cached manifest listing none of them is fetched again before the answer, for the files published
+    *            since
+    **/
+    int Listed(const string &dirUrl, const std::vector<string> &pats, RetryPolicy &retry, FILE *fpLog);
+
+    /**
+    * @brief   : Verify - verify the files downloaded against the manifest of their directory
+    * @param[I]: dirUrl (URL of the remote directory)
+    * @param[I]: pats (accept patterns, or names)
+    * @param[I]: ts (the day of the job, for the ledger)
+    * @param[I]: retry (retry policy of the 'wget' commands)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : number of the corrupt files, which are removed
+    * @note    : the files are in the current directory; the good ones are written to the ledger of the day
+    **/
+    int Verify(const string &dirUrl, const std::vector<string> &pats, gtime_t ts, RetryPolicy &retry, FILE *fpLog);
+
+    /**
+    * @brief   : Refresh - remove the local copies of a day whose remote files were republished
+    * @param[I]: ts (the day)
+    * @param[I]: retry (retry policy of the 'wget' commands)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : number of the stale files removed
+    * @note    : the files verified for the day are checked against the current manifests, and a stale copy is removed
+    *            with its decompressed/converted copies, so that it is downloaded again
+    **/
+    int Refresh(gtime_t ts, RetryPolicy &retry, FILE *fpLog);
+
+    /**
+    * @brief   : Report - report the files verified
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Report(FILE *fpLog) const;
+};
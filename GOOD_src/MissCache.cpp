@@ -0,0 +1,311 @@
+/*------------------------------------------------------------------------------
+* MissCache.cpp : negative cache of the remote files known to be missing
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    1. RFC 9111, HTTP Caching (negative caching of 404)
+*
+* notes   : the sites of 'site.list' that do not publish on a day are asked for by every run, each time costing a
+*           listing of the remote directory. A file asked and not downloaded (404, or no name in the listing matching
+*           the accept pattern) is kept in 'miss.list' in the root/main directory with a TTL of its product, and is
+*           not asked for again until the TTL expires. For the observations and the navigation files, the TTL is
+*           doubled for each day the file is late, so that a recent hourly file is asked for again soon while an old
+*           daily one is asked for seldom, and a file of a day older than 'missDays' of its product is missing for good
+*           until it is purged by 'run_GOOD -misscache purge'. The final products published weeks after their day
+*           (orbits, clocks, SINEX, DSB/OSB) keep the plain TTL. Transient failures are not kept.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "StringUtil.h"
+#include "MissCache.h"
+#include <sstream>
+#include <ctime>
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Load - load 'miss.list'
+* @param[I]: list (path of 'miss.list')
+* @param[O]: miss (the files, the last line of each one wins)
+* @return  : number of the lines read
+* @note    :
+**/
+int MissCache::Load(const string &list, std::map<string, miss_t> &miss)
+{
+    miss.clear();
+    FILE *fp = fopen(list.c_str(), "r");
+    if (!fp) return 0;
+
+    int n = 0;
+    char line[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        std::istringstream iss(line);
+        miss_t m;
+        string url;
+        if (!(iss >> m.expire >> m.since >> m.prod >> url)) continue;
+        if (m.prod < 0 || m.prod >= NPRODPRI) continue;
+        miss[url] = m;
+        n++;
+    }
+    fclose(fp);
+
+    return n;
+} /* end of Load */
+
+/**
+* @brief   : Save - rewrite 'miss.list'
+* @param[I]: list (path of 'miss.list')
+* @param[I]: miss (the files)
+* @param[O]: none
+* @return  : true: ok, false: error
+* @note    : written to a temporary file and renamed, so that a job reading it never sees half of it
+**/
+bool MissCache::Save(const string &list, const std::map<string, miss_t> &miss)
+{
+    string tmp = list + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "w");
+    if (!fp)
+    {
+        cerr << "*** ERROR(MissCache::Save): failed to open " << tmp << endl;
+
+        return false;
+    }
+    for (auto it = miss.begin(); it != miss.end(); ++it)
+        fprintf(fp, "%lld %lld %d %s\n", it->second.expire, it->second.since, it->second.prod, it->first.c_str());
+    fclose(fp);
+    remove(list.c_str());  /* 'rename' does not replace a file on Windows */
+    if (rename(tmp.c_str(), list.c_str()) != 0)
+    {
+        cerr << "*** ERROR(MissCache::Save): failed to rename " << tmp << endl;
+
+        return false;
+    }
+
+    return true;
+} /* end of Save */
+
+/**
+* @brief   : Found - whether a file asked is in the current directory
+* @param[I]: pat (accept pattern of 'wget -A', or name)
+* @param[I]: names (files in the current directory)
+* @param[O]: none
+* @return  : true: found, false: not
+* @note    : a pattern without any wildcard is a suffix, as in 'wget -A'
+**/
+bool MissCache::Found(const string &pat, const std::vector<string> &names)
+{
+    StringUtil str;
+    bool wild = pat.find_first_of("*?[") != string::npos;
+    for (int i = 0; i < names.size(); i++)
+    {
+        const string &name = names[i];
+        if (wild ? str.WildMatch(pat.c_str(), name.c_str()) :
+            (name.size() >= pat.size() && name.compare(name.size() - pat.size(), pat.size(), pat) == 0)) return true;
+    }
+
+    return false;
+} /* end of Found */
+
+/**
+* @brief   : Set - set the cache and load 'miss.list'
+* @param[I]: fopt (FTP options)
+* @param[I]: mainDir (root/main directory)
+* @param[O]: none
+* @return  : none
+* @note    : the expired lines are dropped from 'miss.list'
+**/
+void MissCache::Set(const ftpopt_t *fopt, const char *mainDir)
+{
+    _on = fopt->missCache;
+    for (int i = 0; i < NPRODPRI; i++)
+    {
+        _days[i] = fopt->missDays[i];
+        _ttl[i] = fopt->missTtl[i];
+    }
+    _list = string(mainDir) + (char)FILEPATHSEP + MISS_LIST;
+    _miss.clear();
+    if (!_on) return;
+
+    int n = Load(_list, _miss);
+    long long now = (long long)time(nullptr);
+    for (auto it = _miss.begin(); it != _miss.end(); )
+    {
+        if (it->second.expire > 0 && it->second.expire <= now) it = _miss.erase(it);
+        else ++it;
+    }
+    if (n > (int)_miss.size()) Save(_list, _miss);
+} /* end of Set */
+
+/**
+* @brief   : Missing - whether all the files asked are known to be missing
+* @param[I]: dirUrl (URL of the remote directory)
+* @param[I]: pats (accept patterns, or names)
+* @param[O]: none
+* @return  : true: known missing, not to be asked for, false: to be asked for
+* @note    :
+**/
+bool MissCache::Missing(const string &dirUrl, const std::vector<string> &pats)
+{
+    if (!_on || pats.empty()) return false;
+
+    long long now = (long long)time(nullptr);
+    for (int i = 0; i < pats.size(); i++)
+    {
+        auto it = _miss.find(dirUrl + "/" + pats[i]);
+        if (it == _miss.end() || (it->second.expire > 0 && it->second.expire <= now)) return false;
+    }
+    _nskip++;
+
+    return true;
+} /* end of Missing */
+
+/**
+* @brief   : Record - record the files asked and not downloaded
+* @param[I]: dirUrl (URL of the remote directory)
+* @param[I]: pats (accept patterns, or names)
+* @param[I]: iprod (product, i.e., PRI_OBS)
+* @param[I]: ts (the day of the files)
+* @param[O]: none
+* @return  : number of the files recorded
+* @note    : only for the files the server answered to be not there (404, FTP 550 or a listing matching none),
+*            not for a refused login or a local error; the files are looked for in the current directory; with the
+*            days of the product (i.e., obs), its TTL is doubled for each day the files are late, and a file older
+*            than them is missing for good; without (i.e., the final orbits), the plain TTL is used
+**/
+int MissCache::Record(const string &dirUrl, const std::vector<string> &pats, int iprod, gtime_t ts)
+{
+    if (!_on || iprod < 0 || iprod >= NPRODPRI) return 0;
+
+    std::vector<string> names;
+    StringUtil str;
+    str.GetFilesAll(".", "", names);
+
+    /* days since the end of the day of the files */
+    long long now = (long long)time(nullptr);
+    long long tend = (long long)(ts.mjd - 40587 + 1) * 86400;
+    int late = now > tend ? (int)((now - tend) / 86400) : 0;
+    miss_t m;
+    m.since = now;
+    m.prod = iprod;
+    if (_days[iprod] <= 0) m.expire = now + _ttl[iprod];  /* i.e., a final product published weeks after its day */
+    else if (late >= _days[iprod]) m.expire = 0;
+    else m.expire = now + ((long long)_ttl[iprod] << (late < 30 ? late : 30));
+
+    int n = 0;
+    FILE *fp = nullptr;
+    for (int i = 0; i < pats.size(); i++)
+    {
+        if (Found(pats[i], names)) continue;
+
+        /* one short line, so that the concurrent jobs do not mix their lines */
+        string url = dirUrl + "/" + pats[i];
+        _miss[url] = m;
+        if (!fp && !(fp = fopen(_list.c_str(), "a")))
+        {
+            cerr << "*** ERROR(MissCache::Record): failed to open " << _list << endl;
+
+            return n;
+        }
+        fprintf(fp, "%lld %lld %d %s\n", m.expire, m.since, m.prod, url.c_str());
+        n++;
+    }
+    if (fp) fclose(fp);
+    _nmiss += n;
+
+    return n;
+} /* end of Record */
+
+/**
+* @brief   : List - print the files known to be missing
+* @param[I]: mainDir (root/main directory)
+* @param[I]: pat (wildcard of the URLs, "": all)
+* @param[O]: none
+* @return  : number of the files
+* @note    :
+**/
+int MissCache::List(const char *mainDir, const string &pat)
+{
+    std::map<string, miss_t> miss;
+    Load(string(mainDir) + (char)FILEPATHSEP + MISS_LIST, miss);
+
+    StringUtil str;
+    std::vector<string> prods;
+    str.GetSubStr(PRODPRI_NAMES, " ", prods);
+    long long now = (long long)time(nullptr);
+    int n = 0;
+    for (auto it = miss.begin(); it != miss.end(); ++it)
+    {
+        const miss_t &m = it->second;
+        if (!pat.empty() && !str.WildMatch(pat.c_str(), it->first.c_str())) continue;
+        if (m.expire > 0 && m.expire <= now) continue;
+
+        char since[32] = { '\0' }, until[32] = "for good";
+        time_t t = (time_t)m.since;
+        strftime(since, sizeof(since), "%Y/%m/%d %H:%M:%S", gmtime(&t));
+        if (m.expire > 0)
+        {
+            t = (time_t)m.expire;
+            strftime(until, sizeof(until), "%Y/%m/%d %H:%M:%S", gmtime(&t));
+        }
+        const char *prod = m.prod < prods.size() ? prods[m.prod].c_str() : "-";
+        printf("%-6s  %s  %-19s  %s\n", prod, since, until, it->first.c_str());
+        n++;
+    }
+    cout << "*** INFO(MissCache::List): " << n << " remote files known to be missing (product, since, until, URL)" << endl;
+
+    return n;
+} /* end of List */
+
+/**
+* @brief   : Purge - forget the files known to be missing, so that they are asked for again
+* @param[I]: mainDir (root/main directory)
+* @param[I]: pat (wildcard of the URLs, "": all)
+* @param[O]: none
+* @return  : number of the files forgotten, -1: error
+* @note    :
+**/
+int MissCache::Purge(const char *mainDir, const string &pat)
+{
+    string list = string(mainDir) + (char)FILEPATHSEP + MISS_LIST;
+    std::map<string, miss_t> miss;
+    Load(list, miss);
+
+    StringUtil str;
+    int n = 0;
+    for (auto it = miss.begin(); it != miss.end(); )
+    {
+        if (pat.empty() || str.WildMatch(pat.c_str(), it->first.c_str()))
+        {
+            it = miss.erase(it);
+            n++;
+        }
+        else ++it;
+    }
+    if (n > 0 && !Save(list, miss)) return -1;
+    cout << "*** INFO(MissCache::Purge): " << n << " remote files forgotten, asked for again by the next run" << endl;
+
+    return n;
+} /* end of Purge */
+
+/**
+* @brief   : Report - report the requests skipped and the files found missing
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the requests of the concurrent jobs are counted in their own processes
+**/
+void MissCache::Report(FILE *fpLog) const
+{
+    if (_nskip == 0 && _nmiss == 0) return;
+
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d requests of the files known to be missing skipped, %d files found missing", _nskip, _nmiss);
+    cout << "*** INFO(MissCache::Report): " << buff << endl;
+
+    if (fpLog) fprintf(fpLog, "* INFO(MissCache): %s\n", buff);
+} /* end of Report */
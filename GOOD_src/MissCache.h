@@ -0,0 +1,143 @@
+/*------------------------------------------------------------------------------
+* MissCache.h : header file of MissCache.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+
+#define MISS_LIST      "miss.list"       /* remote files known to be missing in the root/main directory,
+                                            'expire since prod url', expire 0: never */
+
+class MissCache
+{
+private:
+    struct miss_t
+    {                                     /* one remote file known to be missing */
+        long long expire;                 /* asked again after this time (s since 1970-01-01 UTC), 0: never */
+        long long since;                  /* found missing at this time (s since 1970-01-01 UTC) */
+        int prod;                         /* product (i.e., PRI_OBS) */
+    };
+
+    std::map<string, miss_t> _miss;       /* files known to be missing, key: URL of the file, or of an accept pattern */
+    bool _on;                             /* (0:off  1:on) */
+    string _list;                         /* path of 'miss.list' */
+    int _days[NPRODPRI];                  /* days of each product after which a file of a day is missing for good, 0: never */
+    int _ttl[NPRODPRI];                   /* TTL (s) of a missing file of each product, in the order of PRODPRI_NAMES */
+    int _nskip, _nmiss;                   /* numbers of the requests skipped and of the files found missing */
+
+    /**
+    * @brief   : Load - load 'miss.list'
+    * @param[I]: list (path of 'miss.list')
+    * @param[O]: miss (the files, the last line of each one wins)
+    * @return  : number of the lines read
+    * @note    :
+    **/
+    static int Load(const string &list, std::map<string, miss_t> &miss);
+
+    /**
+    * @brief   : Save - rewrite 'miss.list'
+    * @param[I]: list (path of 'miss.list')
+    * @param[I]: miss (the files)
+    * @param[O]: none
+    * @return  : true: ok, false: error
+    * @note    : written to a temporary file and renamed, so that a job reading it never sees half of it
+    **/
+    static bool Save(const string &list, const std::map<string, miss_t> &miss);
+
+    /**
+    * @brief   : Found - whether a file asked is in the current directory
+    * @param[I]: pat (accept pattern of 'wget -A', or name)
+    * @param[I]: names (files in the current directory)
+    * @param[O]: none
+    * @return  : true: found, false: not
+    * @note    : a pattern without any wildcard is a suffix, as in 'wget -A'
+    **/
+    static bool Found(const string &pat, const std::vector<string> &names);
+
+public:
+    MissCache()
+    {
+        _on = false;
+        for (int i = 0; i < NPRODPRI; i++) _days[i] = _ttl[i] = 0;
+        _nskip = _nmiss = 0;
+    }
+    ~MissCache()
+    {
+
+    }
+
+    /**
+    * @brief   : Set - set the cache and load 'miss.list'
+    * @param[I]: fopt (FTP options)
+    * @param[I]: mainDir (root/main directory)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the expired lines are dropped from 'miss.list'
+    **/
+    void Set(const ftpopt_t *fopt, const char *mainDir);
+
+    /**
+    * @brief   : On - whether the cache is used
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    bool On() const
+    {
+        return _on;
+    }
+
+    /**
+    * @brief   : Missing - whether all the files asked are known to be missing
+    * @param[I]: dirUrl (URL of the remote directory)
+    * @param[I]: pats (accept patterns, or names)
+    * @param[O]: none
+    * @return  : true: known missing, not to be asked for, false: to be asked for
+    * @note    :
+    **/
+    bool Missing(const string &dirUrl, const std::vector<string> &pats);
+
+    /**
+    * @brief   : Record - record the files asked and not downloaded
+    * @param[I]: dirUrl (URL of the remote directory)
+    * @param[I]: pats (accept patterns, or names)
+    * @param[I]: iprod (product, i.e., PRI_OBS)
+    * @param[I]: ts (the day of the files)
+    * @param[O]: none
+    * @return  : number of the files recorded
+    * @note    : only for the files the server answered to be not there (404, FTP 550 or a listing matching none),
+    *            not for a refused login or a local error; the files are looked for in the current directory; with the
+    *            days of the product (i.e., obs), its TTL is doubled for each day the files are late, and a file older
+    *            than them is missing for good; without (i.e., the final orbits), the plain TTL is used
+    **/
+    int Record(const string &dirUrl, const std::vector<string> &pats, int iprod, gtime_t ts);
+
+    /**
+    * @brief   : List - print the files known to be missing
+    * @param[I]: mainDir (root/main directory)
+    * @param[I]: pat (wildcard of the URLs, "": all)
+    * @param[O]: none
+    * @return  : number of the files
+    * @note    :
+    **/
+    static int List(const char *mainDir, const string &pat);
+
+    /**
+    * @brief   : Purge - forget the files known to be missing, so that they are asked for again
+    * @param[I]: mainDir (root/main directory)
+    * @param[I]: pat (wildcard of the URLs, "": all)
+    * @param[O]: none
+    * @return  : number of the files forgotten, -1: error
+    * @note    :
+    **/
+    static int Purge(const char *mainDir, const string &pat);
+
+    /**
+    * @brief   : Report - report the requests skipped and the files found missing
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Report(FILE *fpLog) const;
+};
@@ -0,0 +1,271 @@
+/*------------------------------------------------------------------------------
+* NavUtil.cpp : merging of RINEX broadcast ephemeris files
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    RINEX The Receiver Independent Exchange Format, Version 2.11, 3.04 and 4.00
+*
+* history : 2026/10/18 1.0  new, merge the site-specific hourly broadcast ephemeris files
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "NavUtil.h"
+#include <time.h>
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define NAVVER3    3.04  /* RINEX version of the merged file */
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : str2num - the conversion from substring of a RINEX line to number
+* @param[I]: s (RINEX line)
+* @param[I]: i (start position)
+* @param[I]: n (number of characters)
+* @param[O]: none
+* @return  : the number (0.0 for blank)
+* @note    : the exponent 'D' (FORTRAN) is accepted
+**/
+static double str2num(const string &s, int i, int n)
+{
+    if (i >= s.size()) return 0.0;
+    string sub = s.substr(i, n);
+    for (int j = 0; j < sub.size(); j++) if (sub[j] == 'D' || sub[j] == 'd') sub[j] = 'E';
+
+    return atof(sub.c_str());
+} /* end of str2num */
+
+/**
+* @brief   : AddRecord - add one ephemeris record if it is not present yet
+* @param[I]: lines (record lines in RINEX 3 layout)
+* @param[O]: none
+* @return  : true: added, false: duplicated or invalid
+* @note    :
+**/
+bool NavUtil::AddRecord(std::vector<string> &lines)
+{
+    if (lines.size() < 2 || lines[0].size() < 23) return false;
+
+    char sys = lines[0][0];
+    char buff[64];
+    string key = lines[0].substr(0, 23);
+    if (sys != 'R' && sys != 'S')
+    {
+        /* IODE (GPS, QZSS, IRNSS), IODnav (Galileo) or AODE (BDS) */
+        if (lines[1].size() < 23) return false;
+        sprintf(buff, " %.0f", str2num(lines[1], 4, 19));
+        key += buff;
+        if (sys == 'E' && lines.size() > 5 && lines[5].size() >= 42)
+        {
+            /* I/NAV and F/NAV share Toc and IODnav */
+            sprintf(buff, " %.0f", str2num(lines[5], 23, 19));
+            key += buff;
+        }
+    }
+
+    if (_recs.find(key) != _recs.end())
+    {
+        _ndup++;
+
+        return false;
+    }
+    _recs[key] = lines;
+
+    return true;
+} /* end of AddRecord */
+
+/**
+* @brief   : AddHeader - keep the ionospheric, time system and leap second header lines
+* @param[I]: line (header line without line break)
+* @param[I]: ver (RINEX version)
+* @param[O]: none
+* @return  : none
+* @note    : 'ION ALPHA' and 'ION BETA' of RINEX 2 are converted to 'GPSA' and 'GPSB'
+**/
+void NavUtil::AddHeader(const string &line, double ver)
+{
+    if (line.size() <= 60) return;
+    string label = line.substr(60), body = line.substr(0, 60);
+
+    if (ver < 3.0 && (label.find("ION ALPHA") == 0 || label.find("ION BETA") == 0))
+    {
+        string type = label.find("ION ALPHA") == 0 ? "GPSA" : "GPSB";
+        body = type + " " + line.substr(2, 48);
+        body.resize(60, ' ');
+        label = "IONOSPHERIC CORR";
+    }
+    if (label.find("IONOSPHERIC CORR") == 0 || label.find("TIME SYSTEM CORR") == 0)
+    {
+        string key = label.substr(0, 16) + body.substr(0, 4);
+        if (_corrs.find(key) == _corrs.end()) _corrs[key] = body + label.substr(0, 16);
+    }
+    else if (label.find("LEAP SECONDS") == 0 && _leap.empty())
+    {
+        /* the format of RINEX 2 is the subset of that of RINEX 3 */
+        _leap = body.substr(0, 6);
+        _leap.resize(60, ' ');
+        _leap += "LEAP SECONDS";
+    }
+} /* end of AddHeader */
+
+/**
+* @brief   : InputFile - merge one RINEX broadcast ephemeris file
+* @param[I]: file (RINEX 2, 3 or 4 navigation file)
+* @param[O]: none
+* @return  : number of new records, -1: error
+* @note    : records with the same satellite, Toc and IODE (GLONASS/SBAS: satellite and Toc; Galileo: also
+*            the data source) are kept only once
+**/
+int NavUtil::InputFile(const char *file)
+{
+    ifstream navFil(file);
+    if (!navFil.is_open())
+    {
+        cerr << "*** ERROR(NavUtil::InputFile): open navigation file " << file << " FAILED!" << endl;
+
+        return -1;
+    }
+
+    string line;
+    double ver = 0.0;
+    char sys2 = 'G';  /* the system of RINEX 2 files */
+    bool header = true, skip = false;
+    int nadd = 0;
+    std::vector<string> lines;
+    while (getline(navFil, line))
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        if (header)
+        {
+            if (line.size() > 60 && line.find("RINEX VERSION / TYPE", 60) == 60)
+            {
+                ver = atof(line.substr(0, 9).c_str());
+                char type = line.size() > 20 ? line[20] : 'N';
+                if (type == 'G') sys2 = 'R';
+                else if (type == 'H') sys2 = 'S';
+            }
+            else if (line.size() > 60 && line.find("END OF HEADER", 60) == 60) header = false;
+            else AddHeader(line, ver);
+            continue;
+        }
+        if (line.empty()) continue;
+
+        /* RINEX 4: only the ephemeris of legacy navigation messages */
+        if (ver >= 4.0 && line[0] == '>')
+        {
+            if (lines.size() > 0 && AddRecord(lines)) nadd++;
+            lines.clear();
+            skip = !(line.find("> EPH") == 0 && (line.find("LNAV") != string::npos || line.find("FDMA") != string::npos ||
+                line.find("INAV") != string::npos || line.find("FNAV") != string::npos || line.find(" D1") != string::npos ||
+                line.find(" D2") != string::npos || line.find("SBAS") != string::npos));
+            continue;
+        }
+        if (skip) continue;
+
+        bool first = ver >= 3.0 ? line[0] != ' ' : line.size() > 1 && line[1] != ' ';
+        if (first)
+        {
+            if (lines.size() > 0 && AddRecord(lines)) nadd++;
+            lines.clear();
+            if (ver >= 3.0) lines.push_back(line);
+            else
+            {
+                /* RINEX 2 epoch: PRN, YY, MM, DD, HH, MI, SEC */
+                if (line.size() < 22) continue;
+                int prn = atoi(line.substr(0, 2).c_str()), yy = atoi(line.substr(2, 3).c_str());
+                int mm = atoi(line.substr(5, 3).c_str()), dd = atoi(line.substr(8, 3).c_str());
+                int hh = atoi(line.substr(11, 3).c_str()), mi = atoi(line.substr(14, 3).c_str());
+                double sec = atof(line.substr(17, 5).c_str());
+                char buff[32];
+                sprintf(buff, "%c%02d %04d %02d %02d %02d %02d %02d", sys2, prn, yy < 80 ? yy + 2000 : yy + 1900,
+                    mm, dd, hh, mi, (int)(sec + 0.5));
+                lines.push_back(buff + line.substr(22));
+            }
+        }
+        else if (lines.size() > 0) lines.push_back(ver >= 3.0 ? line : " " + line);
+    }
+    if (lines.size() > 0 && AddRecord(lines)) nadd++;
+    navFil.close();
+    _nfile++;
+
+    return nadd;
+} /* end of InputFile */
+
+/**
+* @brief   : WriteFile - write the merged records to a RINEX 3.04 mixed navigation file
+* @param[I]: file (output file)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool NavUtil::WriteFile(const char *file)
+{
+    FILE *fp = fopen(file, "w");
+    if (!fp)
+    {
+        cerr << "*** ERROR(NavUtil::WriteFile): open navigation file " << file << " FAILED!" << endl;
+
+        return false;
+    }
+
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y%m%d %H%M%S UTC", gmtime(&now));
+    fprintf(fp, "%9.2f%11s%-20s%-20s%-20s\n", NAVVER3, "", "N: GNSS NAV DATA", "M: MIXED", "RINEX VERSION / TYPE");
+    fprintf(fp, "%-20s%-20s%-20s%-20s\n", "GOOD", "", date, "PGM / RUN BY / DATE");
+    char comment[64];
+    sprintf(comment, "merged from %d files, %d duplicates dropped", _nfile, _ndup);
+    fprintf(fp, "%-60s%-20s\n", comment, "COMMENT");
+    for (std::map<string, string>::const_iterator it = _corrs.begin(); it != _corrs.end(); ++it)
+        fprintf(fp, "%s\n", it->second.c_str());
+    if (!_leap.empty()) fprintf(fp, "%s\n", _leap.c_str());
+    fprintf(fp, "%60s%-20s\n", "", "END OF HEADER");
+
+    for (std::map<string, std::vector<string> >::const_iterator it = _recs.begin(); it != _recs.end(); ++it)
+    {
+        for (int i = 0; i < it->second.size(); i++) fprintf(fp, "%s\n", it->second[i].c_str());
+    }
+
+    bool stat = ferror(fp) == 0;
+    fclose(fp);
+
+    return stat;
+} /* end of WriteFile */
+
+/**
+* @brief   : NumRecords - get the number of merged records
+* @param[I]: none
+* @param[O]: none
+* @return  : number of merged records
+* @note    :
+**/
+int NavUtil::NumRecords() const
+{
+    return (int)_recs.size();
+} /* end of NumRecords */
+
+/**
+* @brief   : NumFiles - get the number of merged files
+* @param[I]: none
+* @param[O]: none
+* @return  : number of merged files
+* @note    :
+**/
+int NavUtil::NumFiles() const
+{
+    return _nfile;
+} /* end of NumFiles */
+
+/**
+* @brief   : NumDups - get the number of duplicated records dropped
+* @param[I]: none
+* @param[O]: none
+* @return  : number of duplicated records
+* @note    :
+**/
+int NavUtil::NumDups() const
+{
+    return _ndup;
+} /* end of NumDups */
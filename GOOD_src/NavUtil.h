@@ -0,0 +1,95 @@
+/*------------------------------------------------------------------------------
+* NavUtil.h : header file of NavUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+
+#define NAVMRG_OFF     0          /* no merging of hourly broadcast ephemeris files */
+#define NAVMRG_HOURLY  1          /* one merged broadcast ephemeris file per hour */
+#define NAVMRG_DAILY   2          /* one merged broadcast ephemeris file per day */
+
+class NavUtil
+{
+private:
+    std::map<string, std::vector<string> > _recs;  /* ephemeris records in RINEX 3 layout, keyed by satellite, Toc and IODE */
+    std::map<string, string> _corrs;      /* 'IONOSPHERIC CORR' and 'TIME SYSTEM CORR' header lines, keyed by label and type */
+    string _leap;                         /* 'LEAP SECONDS' header line */
+    int _nfile;                           /* number of files merged */
+    int _ndup;                            /* number of duplicated records dropped */
+
+    /**
+    * @brief   : AddRecord - add one ephemeris record if it is not present yet
+    * @param[I]: lines (record lines in RINEX 3 layout)
+    * @param[O]: none
+    * @return  : true: added, false: duplicated or invalid
+    * @note    :
+    **/
+    bool AddRecord(std::vector<string> &lines);
+
+    /**
+    * @brief   : AddHeader - keep the ionospheric, time system and leap second header lines
+    * @param[I]: line (header line without line break)
+    * @param[I]: ver (RINEX version)
+    * @param[O]: none
+    * @return  : none
+    * @note    : 'ION ALPHA' and 'ION BETA' of RINEX 2 are converted to 'GPSA' and 'GPSB'
+    **/
+    void AddHeader(const string &line, double ver);
+
+public:
+    NavUtil()
+    {
+        _nfile = 0;
+        _ndup = 0;
+    }
+    ~NavUtil()
+    {
+
+    }
+
+    /**
+    * @brief   : InputFile - merge one RINEX broadcast ephemeris file
+    * @param[I]: file (RINEX 2, 3 or 4 navigation file)
+    * @param[O]: none
+    * @return  : number of new records, -1: error
+    * @note    : records with the same satellite, Toc and IODE (GLONASS/SBAS: satellite and Toc; Galileo: also
+    *            the data source) are kept only once
+    **/
+    int InputFile(const char *file);
+
+    /**
+    * @brief   : WriteFile - write the merged records to a RINEX 3.04 mixed navigation file
+    * @param[I]: file (output file)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool WriteFile(const char *file);
+
+    /**
+    * @brief   : NumRecords - get the number of merged records
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of merged records
+    * @note    :
+    **/
+    int NumRecords() const;
+
+    /**
+    * @brief   : NumFiles - get the number of merged files
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of merged files
+    * @note    :
+    **/
+    int NumFiles() const;
+
+    /**
+    * @brief   : NumDups - get the number of duplicated records dropped
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of duplicated records
+    * @note    :
+    **/
+    int NumDups() const;
+};
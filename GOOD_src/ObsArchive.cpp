@@ -0,0 +1,355 @@
+/*------------------------------------------------------------------------------
+* ObsArchive.cpp : compressed-at-rest storage of RINEX observation files with random access by time
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    RFC 1952 GZIP file format specification version 4.3
+*
+* notes   : the compressed file is a multi-member gzip file, so it can still be expanded by 'gzip -d'. The first
+*           member is the header and each of the others holds 'nmax' epochs. The index 'file.idx' is a text file
+*             GOODIDX1 nmax
+*             mjd sod offset length nepoch      (one line per member, mjd = 0 for the header)
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "RnxUtil.h"
+#include "ObsArchive.h"
+#ifdef GOOD_USE_ZLIB
+#include <zlib.h>
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define IDX_MAGIC   "GOODIDX1"  /* magic of the frame index */
+#define ZCHUNK      65536       /* chunk size for compressing and decompressing */
+
+#ifdef _WIN32  /* for Windows */
+#define fseek64     _fseeki64
+#else          /* for Linux or Mac */
+#define fseek64     fseeko
+#endif
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Flush - compress the current frame as an independent gzip member
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ObsArchive::Flush()
+{
+    if (!_fp) return false;
+    if (_buff.empty() && _frames.size() > 0) return true;
+
+#ifdef GOOD_USE_ZLIB
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) return false;  /* gzip wrapper */
+    zs.next_in = (Bytef *)_buff.data();
+    zs.avail_in = (uInt)_buff.size();
+    std::vector<unsigned char> out(ZCHUNK);
+    long long length = 0;
+    int stat;
+    do
+    {
+        zs.next_out = out.data();
+        zs.avail_out = ZCHUNK;
+        stat = deflate(&zs, Z_FINISH);
+        size_t n = ZCHUNK - zs.avail_out;
+        if (fwrite(out.data(), 1, n, _fp) != n) stat = Z_ERRNO;
+        length += n;
+    } while (stat == Z_OK);
+    deflateEnd(&zs);
+    if (stat != Z_STREAM_END)
+    {
+        cerr << "*** ERROR(ObsArchive::Flush): compress frame of " << _file << " FAILED!" << endl;
+
+        return false;
+    }
+
+    frame_t frame;
+    frame.time = _time;
+    frame.offset = _offset;
+    frame.length = length;
+    frame.nepoch = _nepoch;
+    _frames.push_back(frame);
+    _offset += length;
+    _buff.clear();
+    _nepoch = 0;
+    _time = { 0 };
+
+    return true;
+#else
+    cerr << "*** ERROR(ObsArchive::Flush): GOOD is built without zlib, the compressed storage is NOT available!" << endl;
+
+    return false;
+#endif
+} /* end of Flush */
+
+/**
+* @brief   : Inflate - decompress one frame
+* @param[I]: fp (compressed file)
+* @param[I]: frame (frame)
+* @param[O]: text (decompressed text)
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ObsArchive::Inflate(FILE *fp, const frame_t &frame, string &text)
+{
+    text.clear();
+#ifdef GOOD_USE_ZLIB
+    std::vector<unsigned char> in((size_t)frame.length);
+    if (fseek64(fp, frame.offset, SEEK_SET) != 0 || fread(in.data(), 1, in.size(), fp) != in.size()) return false;
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (inflateInit2(&zs, 15 + 16) != Z_OK) return false;
+    zs.next_in = in.data();
+    zs.avail_in = (uInt)in.size();
+    std::vector<char> out(ZCHUNK);
+    int stat;
+    do
+    {
+        zs.next_out = (Bytef *)out.data();
+        zs.avail_out = ZCHUNK;
+        stat = inflate(&zs, Z_NO_FLUSH);
+        text.append(out.data(), ZCHUNK - zs.avail_out);
+    } while (stat == Z_OK);
+    inflateEnd(&zs);
+
+    return stat == Z_STREAM_END;
+#else
+    cerr << "*** ERROR(ObsArchive::Inflate): GOOD is built without zlib, the compressed storage is NOT available!" << endl;
+
+    return false;
+#endif
+} /* end of Inflate */
+
+/**
+* @brief   : Open - create a compressed observation file
+* @param[I]: file (compressed file, i.e., 'oFile.gz')
+* @param[I]: nmax (number of epochs per frame)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ObsArchive::Open(const char *file, int nmax)
+{
+#ifndef GOOD_USE_ZLIB
+    cerr << "*** ERROR(ObsArchive::Open): GOOD is built without zlib, the compressed storage is NOT available!" << endl;
+
+    return false;
+#endif
+    _file = file;
+    _nmax = nmax > 0 ? nmax : 1;
+    _buff.clear();
+    _frames.clear();
+    _nepoch = 0;
+    _offset = 0;
+    _time = { 0 };
+
+    /* remove the index first, so an interrupted run never leaves a complete-looking file */
+    string idxFile = _file + IDX_SUFFIX;
+    remove(idxFile.c_str());
+    _fp = fopen(file, "wb");
+    if (!_fp)
+    {
+        cerr << "*** ERROR(ObsArchive::Open): open compressed file " << file << " FAILED!" << endl;
+
+        return false;
+    }
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Write - append text to the current frame
+* @param[I]: text (RINEX lines with line break)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ObsArchive::Write(const string &text)
+{
+    _buff += text;
+} /* end of Write */
+
+/**
+* @brief   : EndHeader - close the header frame
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ObsArchive::EndHeader()
+{
+    _time = { 0 };
+    _nepoch = 0;
+
+    return Flush();
+} /* end of EndHeader */
+
+/**
+* @brief   : EndEpoch - mark the end of an epoch, the frame being closed after every 'nmax' epochs
+* @param[I]: time (epoch time)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ObsArchive::EndEpoch(gtime_t time)
+{
+    if (_nepoch == 0 || _time.mjd == 0) _time = time;  /* events may have blank time */
+    if (++_nepoch < _nmax) return true;
+
+    return Flush();
+} /* end of EndEpoch */
+
+/**
+* @brief   : Close - close the last frame, the compressed file and write the frame index
+* @param[I]: none
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : the index 'file.idx' is written last, so it marks a complete compressed file
+**/
+bool ObsArchive::Close()
+{
+    if (!_fp) return false;
+    bool stat = Flush();
+    stat = fclose(_fp) == 0 && stat;
+    _fp = nullptr;
+    if (!stat) return false;
+
+    string idxFile = _file + IDX_SUFFIX;
+    FILE *fp = fopen(idxFile.c_str(), "w");
+    if (!fp)
+    {
+        cerr << "*** ERROR(ObsArchive::Close): open index file " << idxFile << " FAILED!" << endl;
+
+        return false;
+    }
+    fprintf(fp, "%s %d\n", IDX_MAGIC, _nmax);
+    for (int i = 0; i < _frames.size(); i++)
+    {
+        const frame_t &frame = _frames[i];
+        fprintf(fp, "%d %.7f %lld %lld %d\n", frame.time.mjd, frame.time.sod, frame.offset, frame.length, frame.nepoch);
+    }
+    stat = ferror(fp) == 0;
+    fclose(fp);
+
+    return stat;
+} /* end of Close */
+
+/**
+* @brief   : Exist - whether a complete compressed observation file exists
+* @param[I]: file (compressed file)
+* @param[O]: none
+* @return  : true: exists, false: not
+* @note    :
+**/
+bool ObsArchive::Exist(const char *file)
+{
+    string idxFile = string(file) + IDX_SUFFIX;
+
+    return access(file, 0) == 0 && access(idxFile.c_str(), 0) == 0;
+} /* end of Exist */
+
+/**
+* @brief   : Decode - decode the epochs within a time range from a compressed observation file
+* @param[I]: file (compressed file)
+* @param[I]: ts (start time, {0, 0.0}: from the first epoch)
+* @param[I]: te (end time, {0, 0.0}: to the last epoch)
+* @param[I]: fp (output file pointer of RINEX observation)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    : only the header and the frames overlapping the time range are decompressed
+**/
+bool ObsArchive::Decode(const char *file, gtime_t ts, gtime_t te, FILE *fp)
+{
+    /* read the index */
+    string idxFile = string(file) + IDX_SUFFIX;
+    FILE *fpIdx = fopen(idxFile.c_str(), "r");
+    if (!fpIdx)
+    {
+        cerr << "*** ERROR(ObsArchive::Decode): open index file " << idxFile << " FAILED!" << endl;
+
+        return false;
+    }
+    char magic[16] = { '\0' };
+    int nmax = 0;
+    std::vector<frame_t> frames;
+    if (fscanf(fpIdx, "%15s %d", magic, &nmax) != 2 || strcmp(magic, IDX_MAGIC) != 0)
+    {
+        cerr << "*** ERROR(ObsArchive::Decode): " << idxFile << " is NOT a valid index file!" << endl;
+        fclose(fpIdx);
+
+        return false;
+    }
+    frame_t frame;
+    while (fscanf(fpIdx, "%d %lf %lld %lld %d", &frame.time.mjd, &frame.time.sod, &frame.offset, &frame.length, &frame.nepoch) == 5)
+        frames.push_back(frame);
+    fclose(fpIdx);
+    if (frames.empty()) return false;
+
+    FILE *fpArc = fopen(file, "rb");
+    if (!fpArc)
+    {
+        cerr << "*** ERROR(ObsArchive::Decode): open compressed file " << file << " FAILED!" << endl;
+
+        return false;
+    }
+
+    /* the header, then the frames overlapping [ts, te], epoch by epoch */
+    TimeUtil tu;
+    RnxUtil rnx;
+    bool stat = true;
+    string text;
+    for (int i = 0; i < frames.size() && stat; i++)
+    {
+        if (i > 0)
+        {
+            /* the frame ends before the start of the next one */
+            if (ts.mjd > 0 && i + 1 < frames.size() && frames[i + 1].time.mjd > 0 && tu.TimeDiff(frames[i + 1].time, ts) <= 0.0) continue;
+            if (te.mjd > 0 && frames[i].time.mjd > 0 && tu.TimeDiff(frames[i].time, te) > 0.0) break;
+        }
+        if (!Inflate(fpArc, frames[i], text))
+        {
+            cerr << "*** ERROR(ObsArchive::Decode): decompress frame " << i << " of " << file << " FAILED!" << endl;
+            stat = false;
+            break;
+        }
+        if (i == 0)
+        {
+            fputs(text.c_str(), fp);
+            for (size_t p = 0, q; p < text.size(); p = q + 1)
+            {
+                q = text.find('\n', p);
+                if (q == string::npos) q = text.size();
+                rnx.InputLine(text.substr(p, q - p).c_str());
+            }
+            continue;
+        }
+
+        string epoch;
+        for (size_t p = 0, q; p < text.size(); p = q + 1)
+        {
+            q = text.find('\n', p);
+            if (q == string::npos) q = text.size();
+            string line = text.substr(p, q - p);
+            epoch += line + "\n";
+            if (rnx.InputLine(line.c_str()) != RNX_EPOCH) continue;
+            gtime_t t = rnx.Epoch().time;
+            bool in = t.mjd == 0 || ((ts.mjd == 0 || tu.TimeDiff(t, ts) >= 0.0) && (te.mjd == 0 || tu.TimeDiff(t, te) <= 0.0));
+            if (in) fputs(epoch.c_str(), fp);
+            epoch.clear();
+        }
+    }
+    fclose(fpArc);
+
+    return stat;
+} /* end of Decode */
@@ -0,0 +1,129 @@
+/*------------------------------------------------------------------------------
+* ObsArchive.h : header file of ObsArchive.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+#define ARC_SUFFIX   ".gz"        /* suffix of the compressed observation file appended to the RINEX observation file name */
+#define IDX_SUFFIX   ".idx"       /* suffix of the frame index appended to the compressed observation file name */
+
+class ObsArchive
+{
+public:
+    struct frame_t
+    {                                     /* one independently compressed frame */
+        gtime_t time;                     /* time of the first epoch ({0, 0.0} for the header) */
+        long long offset;                 /* offset in the compressed file */
+        long long length;                 /* compressed length */
+        int nepoch;                       /* number of epochs */
+    };
+
+private:
+    FILE *_fp;                            /* compressed file being written */
+    string _file;                         /* compressed file being written */
+    int _nmax;                            /* number of epochs per frame */
+    string _buff;                         /* text of the current frame */
+    gtime_t _time;                        /* time of the first epoch of the current frame */
+    int _nepoch;                          /* number of epochs in the current frame */
+    long long _offset;                    /* current offset in the compressed file */
+    std::vector<frame_t> _frames;         /* frames written */
+
+    /**
+    * @brief   : Flush - compress the current frame as an independent gzip member
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Flush();
+
+    /**
+    * @brief   : Inflate - decompress one frame
+    * @param[I]: fp (compressed file)
+    * @param[I]: frame (frame)
+    * @param[O]: text (decompressed text)
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    static bool Inflate(FILE *fp, const frame_t &frame, string &text);
+
+public:
+    ObsArchive()
+    {
+        _fp = nullptr;
+        _nmax = 0;
+        _time = { 0 };
+        _nepoch = 0;
+        _offset = 0;
+    }
+    ~ObsArchive()
+    {
+        if (_fp) fclose(_fp);
+    }
+
+    /**
+    * @brief   : Open - create a compressed observation file
+    * @param[I]: file (compressed file, i.e., 'oFile.gz')
+    * @param[I]: nmax (number of epochs per frame)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Open(const char *file, int nmax);
+
+    /**
+    * @brief   : Write - append text to the current frame
+    * @param[I]: text (RINEX lines with line break)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Write(const string &text);
+
+    /**
+    * @brief   : EndHeader - close the header frame
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool EndHeader();
+
+    /**
+    * @brief   : EndEpoch - mark the end of an epoch, the frame being closed after every 'nmax' epochs
+    * @param[I]: time (epoch time)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool EndEpoch(gtime_t time);
+
+    /**
+    * @brief   : Close - close the last frame, the compressed file and write the frame index
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : the index 'file.idx' is written last, so it marks a complete compressed file
+    **/
+    bool Close();
+
+    /**
+    * @brief   : Exist - whether a complete compressed observation file exists
+    * @param[I]: file (compressed file)
+    * @param[O]: none
+    * @return  : true: exists, false: not
+    * @note    :
+    **/
+    static bool Exist(const char *file);
+
+    /**
+    * @brief   : Decode - decode the epochs within a time range from a compressed observation file
+    * @param[I]: file (compressed file)
+    * @param[I]: ts (start time, {0, 0.0}: from the first epoch)
+    * @param[I]: te (end time, {0, 0.0}: to the last epoch)
+    * @param[I]: fp (output file pointer of RINEX observation)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : only the header and the frames overlapping the time range are decompressed
+    **/
+    static bool Decode(const char *file, gtime_t ts, gtime_t te, FILE *fp);
+};
@@ -0,0 +1,270 @@
+/*------------------------------------------------------------------------------
+* ObsCheck.cpp : sanity checking of RINEX observation files after downloading
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    RINEX The Receiver Independent Exchange Format, Version 2.11 and Version 3.04
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "ObsCheck.h"
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define GOOD_SSE2
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define SCANBUFF   (1 << 20)    /* buffer size for scanning */
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : FindNewline - find the next line break
+* @param[I]: p (start of the buffer)
+* @param[I]: end (end of the buffer)
+* @param[O]: none
+* @return  : position of the line break, 'end' if not found
+* @note    : 16 bytes are compared at once with SSE2
+**/
+static const char *FindNewline(const char *p, const char *end)
+{
+#ifdef GOOD_SSE2
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; p + 16 <= end; p += 16)
+    {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), nl));
+        if (mask == 0) continue;
+        for (int i = 0; i < 16; i++) if (mask & (1 << i)) return p + i;
+    }
+#endif
+    const void *q = memchr(p, '\n', end - p);
+
+    return q ? (const char *)q : end;
+} /* end of FindNewline */
+
+/**
+* @brief   : Str2Num - the conversion from substring to number without copying
+* @param[I]: s (string)
+* @param[I]: i (start position)
+* @param[I]: n (number of characters)
+* @param[O]: none
+* @return  : number
+* @note    : for fixed-format fields of digits, blanks and one decimal point
+**/
+static double Str2Num(const char *s, int i, int n)
+{
+    double val = 0.0, scale = 0.0;
+    for (const char *p = s + i; p < s + i + n; p++)
+    {
+        if (*p == '.') scale = 1.0;
+        else if (*p >= '0' && *p <= '9')
+        {
+            val = val * 10.0 + (*p - '0');
+            if (scale > 0.0) scale *= 10.0;
+        }
+    }
+
+    return scale > 0.0 ? val / scale : val;
+} /* end of Str2Num */
+
+/**
+* @brief   : InputLine - check one line of RINEX observation file
+* @param[I]: line (start of the line)
+* @param[I]: n (length of the line without line break)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ObsCheck::InputLine(const char *line, int n)
+{
+    if (n > 0 && line[n - 1] == '\r') n--;
+    if (!_endHdr)
+    {
+        if (n >= 73 && memcmp(line + 60, "END OF HEADER", 13) == 0) _endHdr = true;
+        else if (n >= 80 && memcmp(line + 60, "RINEX VERSION / TYPE", 20) == 0) _ver = Str2Num(line, 0, 9);
+
+        return;
+    }
+
+    /* epoch lines, i.e., '> 2021 02 01 00 00  0.0000000  0 30' or ' 21  2  1  0  0  0.0000000  0 30G01...' */
+    double ep[6];
+    int flag;
+    if (_ver >= 3.0)
+    {
+        if (n < 32 || line[0] != '>') return;
+        ep[0] = Str2Num(line, 2, 4);
+        for (int i = 0; i < 4; i++) ep[i + 1] = Str2Num(line, 7 + 3 * i, 2);
+        ep[5] = Str2Num(line, 19, 11);
+        flag = line[31] - '0';
+    }
+    else
+    {
+        if (n < 29 || line[18] != '.' || line[0] != ' ' || line[28] < '0' || line[28] > '9' || line[2] < '0' || line[2] > '9') return;
+        ep[0] = Str2Num(line, 1, 2);
+        ep[0] += ep[0] < 80.0 ? 2000.0 : 1900.0;
+        for (int i = 0; i < 4; i++) ep[i + 1] = Str2Num(line, 4 + 3 * i, 2);
+        ep[5] = Str2Num(line, 15, 11);
+        flag = line[28] - '0';
+    }
+    if (flag > 1 && flag < 6) return;  /* events */
+
+    TimeUtil tu;
+    InputEpoch(tu.ymdhms2time(ep));
+} /* end of InputLine */
+
+/**
+* @brief   : EndHeader - mark the end of header found
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : for the checking driven by a reader
+**/
+void ObsCheck::EndHeader()
+{
+    _endHdr = true;
+} /* end of EndHeader */
+
+/**
+* @brief   : InputEpoch - input the time of one epoch
+* @param[I]: time (epoch time)
+* @param[O]: none
+* @return  : none
+* @note    : for the checking driven by a reader; event epochs should not be input
+**/
+void ObsCheck::InputEpoch(gtime_t time)
+{
+    TimeUtil tu;
+    if (_nepoch == 0) _first = time;
+    else if (_mono && tu.TimeDiff(time, _last) <= 0.0)
+    {
+        _mono = false;
+        _bad = time;
+    }
+    _last = time;
+    _nepoch++;
+} /* end of InputEpoch */
+
+/**
+* @brief   : ScanFile - scan a RINEX observation file for its header and epochs
+* @param[I]: file (RINEX observation file)
+* @param[O]: none
+* @return  : true:ok, false:error in opening
+* @note    : the lines are split by SSE2 where available, and only epoch lines are parsed
+**/
+bool ObsCheck::ScanFile(const char *file)
+{
+    FILE *fp = fopen(file, "rb");
+    if (!fp) return false;
+
+    std::vector<char> buff(SCANBUFF);
+    size_t nrem = 0;  /* bytes of the incomplete line carried over */
+    while (true)
+    {
+        size_t n = fread(buff.data() + nrem, 1, buff.size() - nrem, fp);
+        const char *p = buff.data(), *end = buff.data() + nrem + n;
+        if (n == 0)
+        {
+            if (nrem > 0) InputLine(p, (int)nrem);  /* the last line without line break */
+            break;
+        }
+        while (p < end)
+        {
+            const char *q = FindNewline(p, end);
+            if (q == end) break;
+            InputLine(p, (int)(q - p));
+            p = q + 1;
+        }
+        nrem = end - p;
+        if (nrem == buff.size()) nrem = 0;  /* the line is too long, which is skipped */
+        else if (nrem > 0) memmove(buff.data(), p, nrem);
+    }
+    fclose(fp);
+
+    return true;
+} /* end of ScanFile */
+
+/**
+* @brief   : Result - the checking result
+* @param[I]: te (expected end time, {0, 0.0}: not checked)
+* @param[I]: tol (tolerance of the last epoch before the expected end in seconds)
+* @param[O]: msg (reason of failure)
+* @return  : true: valid, false: invalid
+* @note    :
+**/
+bool ObsCheck::Result(gtime_t te, double tol, string &msg) const
+{
+    TimeUtil tu;
+    char buff[MAXCHARS];
+    if (!_endHdr)
+    {
+        msg = "no 'END OF HEADER'";
+
+        return false;
+    }
+    if (_nepoch == 0)
+    {
+        msg = "no epoch";
+
+        return false;
+    }
+    if (!_mono)
+    {
+        sprintf(buff, "epochs not increasing at %d %.1f", _bad.mjd, _bad.sod);
+        msg = buff;
+
+        return false;
+    }
+    if (te.mjd > 0 && tu.TimeDiff(te, _last) > tol)
+    {
+        sprintf(buff, "the last epoch %d %.1f is %.0f s before the expected end", _last.mjd, _last.sod, tu.TimeDiff(te, _last));
+        msg = buff;
+
+        return false;
+    }
+
+    return true;
+} /* end of Result */
+
+/**
+* @brief   : ExpectedSpan - get the expected time span from a RINEX short file name
+* @param[I]: oFile (RINEX observation file, i.e., 'abmf0320.21o', 'abmf032a.21o' or 'abmf032a15.21o')
+* @param[O]: ts (expected start time)
+* @param[O]: span (expected time span in seconds, 86400, 3600 or 900)
+* @return  : true:ok, false:not a short file name
+* @note    :
+**/
+bool ObsCheck::ExpectedSpan(const string &oFile, gtime_t &ts, double &span)
+{
+    size_t pos = oFile.find_last_of("/\\");
+    string name = pos == string::npos ? oFile : oFile.substr(pos + 1);
+    size_t dot = name.find('.');
+    if (dot != 8 && dot != 10) return false;
+    if (name.size() < dot + 3) return false;
+
+    int doy = atoi(name.substr(4, 3).c_str()), yy = atoi(name.substr(dot + 1, 2).c_str());
+    char ch = name[7];
+    if (doy < 1 || doy > 366) return false;
+
+    TimeUtil tu;
+    int yyyy = yy < 80 ? yy + 2000 : yy + 1900;
+    ts = tu.yrdoy2time(yyyy, doy);
+    if (ch == '0' && dot == 8) span = 86400.0;
+    else if (ch >= 'a' && ch <= 'x')
+    {
+        ts.sod = (ch - 'a') * 3600.0;
+        span = 3600.0;
+        if (dot == 10)
+        {
+            ts.sod += atoi(name.substr(8, 2).c_str()) * 60.0;
+            span = 900.0;
+        }
+    }
+    else return false;
+
+    return true;
+} /* end of ExpectedSpan */
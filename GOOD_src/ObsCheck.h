@@ -0,0 +1,92 @@
+/*------------------------------------------------------------------------------
+* ObsCheck.h : header file of ObsCheck.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+#define BAD_SUFFIX   ".bad"              /* suffix of the marker of an observation file failing the check, kept until it is
+                                            downloaded again */
+
+class ObsCheck
+{
+private:
+    double _ver;                          /* RINEX version */
+    bool _endHdr;                         /* 'END OF HEADER' found */
+    int _nepoch;                          /* number of epochs */
+    gtime_t _first;                       /* time of the first epoch */
+    gtime_t _last;                        /* time of the last epoch */
+    bool _mono;                           /* whether the epochs are strictly increasing */
+    gtime_t _bad;                         /* time of the first epoch not increasing */
+
+    /**
+    * @brief   : InputLine - check one line of RINEX observation file
+    * @param[I]: line (start of the line)
+    * @param[I]: n (length of the line without line break)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void InputLine(const char *line, int n);
+
+public:
+    ObsCheck()
+    {
+        _ver = 0.0;
+        _endHdr = false;
+        _nepoch = 0;
+        _first = { 0 };
+        _last = { 0 };
+        _mono = true;
+        _bad = { 0 };
+    }
+    ~ObsCheck()
+    {
+
+    }
+
+    /**
+    * @brief   : EndHeader - mark the end of header found
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : for the checking driven by a reader
+    **/
+    void EndHeader();
+
+    /**
+    * @brief   : InputEpoch - input the time of one epoch
+    * @param[I]: time (epoch time)
+    * @param[O]: none
+    * @return  : none
+    * @note    : for the checking driven by a reader; event epochs should not be input
+    **/
+    void InputEpoch(gtime_t time);
+
+    /**
+    * @brief   : ScanFile - scan a RINEX observation file for its header and epochs
+    * @param[I]: file (RINEX observation file)
+    * @param[O]: none
+    * @return  : true:ok, false:error in opening
+    * @note    : the lines are split by SSE2 where available, and only epoch lines are parsed
+    **/
+    bool ScanFile(const char *file);
+
+    /**
+    * @brief   : Result - the checking result
+    * @param[I]: te (expected end time, {0, 0.0}: not checked)
+    * @param[I]: tol (tolerance of the last epoch before the expected end in seconds)
+    * @param[O]: msg (reason of failure)
+    * @return  : true: valid, false: invalid
+    * @note    :
+    **/
+    bool Result(gtime_t te, double tol, string &msg) const;
+
+    /**
+    * @brief   : ExpectedSpan - get the expected time span from a RINEX short file name
+    * @param[I]: oFile (RINEX observation file, i.e., 'abmf0320.21o', 'abmf032a.21o' or 'abmf032a15.21o')
+    * @param[O]: ts (expected start time)
+    * @param[O]: span (expected time span in seconds, 86400, 3600 or 900)
+    * @return  : true:ok, false:not a short file name
+    * @note    :
+    **/
+    static bool ExpectedSpan(const string &oFile, gtime_t &ts, double &span);
+};
@@ -0,0 +1,326 @@
+/*------------------------------------------------------------------------------
+* ObsStore.cpp : columnar binary store of decoded RINEX observations
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : layout of the store (native byte order)
+*             magic "GOODOBC1" (8 bytes), number of epochs (int32), number of systems (int32)
+*             MJD of each epoch (int32 x nepoch), seconds of day of each epoch (double x nepoch)
+*             directory of each system: system (char), padding (3 bytes), number of types (int32),
+*               number of records (int32), reserved (int32), offset of the block (int64),
+*               observation types (4 bytes each)
+*             block of each system: epoch index (uint32 x nrec), PRN (uint8 x nrec),
+*               values of each type (double x nrec each), flags of each type (uint8 x nrec each)
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "RnxUtil.h"
+#include "ObsStore.h"
+#include <cmath>
+#include <map>
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define OBC_MAGIC   "GOODOBC1"  /* magic of the store file */
+#define OBC_DIRLEN  24          /* fixed length of one directory entry */
+
+#ifdef _WIN32  /* for Windows */
+#define fseek64     _fseeki64
+#else          /* for Linux or Mac */
+#define fseek64     fseeko
+#endif
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : FindCol - get the columns of a system, created with the observation types from the reader if absent
+* @param[I]: sys (system)
+* @param[I]: rnx (RINEX reader)
+* @param[O]: idx (column of each observation type of the reader)
+* @return  : index of the columns of the system in '_data.cols'
+* @note    : the types redefined by an event header (flag 4) are matched by name, a new type being appended as a
+*            column missing in the records before
+**/
+int ObsStore::FindCol(char sys, const RnxUtil &rnx, std::vector<int> &idx)
+{
+    const std::vector<string> &types = rnx.ObsTypes(sys);
+    int icol = 0;
+    for (; icol < _data.cols.size(); icol++)
+    {
+        if (_data.cols[icol].sys == sys) break;
+    }
+    if (icol == _data.cols.size())
+    {
+        obscol_t col;
+        col.sys = sys;
+        _data.cols.push_back(col);
+    }
+
+    obscol_t &col = _data.cols[icol];
+    idx.resize(types.size());
+    for (int i = 0; i < types.size(); i++)
+    {
+        int j = 0;
+        while (j < col.obsTypes.size() && col.obsTypes[j] != types[i]) j++;
+        if (j == col.obsTypes.size())
+        {
+            col.obsTypes.push_back(types[i]);
+            col.val.push_back(std::vector<double>(col.epoch.size(), NAN));
+            col.flag.push_back(std::vector<uint8_t>(col.epoch.size(), 0));
+        }
+        idx[i] = j;
+    }
+
+    return icol;
+} /* end of FindCol */
+
+/**
+* @brief   : AddEpoch - append the current epoch of a RINEX reader to the columns
+* @param[I]: rnx (RINEX reader that has just returned RNX_EPOCH)
+* @param[O]: none
+* @return  : none
+* @note    : event epochs are skipped
+**/
+void ObsStore::AddEpoch(const RnxUtil &rnx)
+{
+    const RnxUtil::rnxepoch_t &epoch = rnx.Epoch();
+    if (epoch.flag > 1 && epoch.flag < 6) return;
+
+    uint32_t iepoch = (uint32_t)_data.epochs.size();
+    _data.epochs.push_back(epoch.time);
+    std::map<char, std::pair<int, std::vector<int> > > cols;  /* columns of each system in this epoch */
+    char buff[16];
+    for (int i = 0; i < epoch.sats.size(); i++)
+    {
+        const RnxUtil::rnxsat_t &sat = epoch.sats[i];
+        char sys = RnxUtil::SatSys(sat.sat);
+        auto it = cols.find(sys);
+        if (it == cols.end())
+        {
+            it = cols.insert(std::make_pair(sys, std::make_pair(0, std::vector<int>()))).first;
+            it->second.first = FindCol(sys, rnx, it->second.second);
+        }
+        obscol_t &col = _data.cols[it->second.first];
+        const std::vector<int> &idx = it->second.second;
+        size_t irec = col.epoch.size();
+        col.epoch.push_back(iepoch);
+        col.prn.push_back((uint8_t)atoi(sat.sat.substr(1, 2).c_str()));
+        for (int j = 0; j < col.val.size(); j++)
+        {
+            col.val[j].push_back(NAN);
+            col.flag[j].push_back(0);
+        }
+        for (int j = 0; j < idx.size() && j < sat.fields.size(); j++)
+        {
+            const string &field = sat.fields[j];
+            double val = NAN;
+            uint8_t flag = 0;
+            memcpy(buff, field.c_str(), 14);
+            buff[14] = '\0';
+            if (strspn(buff, " ") < 14) val = atof(buff);
+            if (field[14] >= '0' && field[14] <= '9') flag |= (uint8_t)(field[14] - '0');
+            if (field[15] >= '0' && field[15] <= '9') flag |= (uint8_t)((field[15] - '0') << 4);
+            col.val[idx[j]][irec] = val;
+            col.flag[idx[j]][irec] = flag;
+        }
+    }
+} /* end of AddEpoch */
+
+/**
+* @brief   : Write - write the collected observations to a columnar binary store
+* @param[I]: file (store file)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool ObsStore::Write(const char *file)
+{
+    FILE *fp = fopen(file, "wb");
+    if (!fp)
+    {
+        cerr << "*** ERROR(ObsStore::Write): open store file " << file << " FAILED!" << endl;
+
+        return false;
+    }
+
+    int32_t nepoch = (int32_t)_data.epochs.size(), nsys = (int32_t)_data.cols.size();
+    fwrite(OBC_MAGIC, 1, 8, fp);
+    fwrite(&nepoch, sizeof(int32_t), 1, fp);
+    fwrite(&nsys, sizeof(int32_t), 1, fp);
+    std::vector<int32_t> mjd(nepoch);
+    std::vector<double> sod(nepoch);
+    for (int i = 0; i < nepoch; i++)
+    {
+        mjd[i] = _data.epochs[i].mjd;
+        sod[i] = _data.epochs[i].sod;
+    }
+    if (nepoch > 0)
+    {
+        fwrite(mjd.data(), sizeof(int32_t), nepoch, fp);
+        fwrite(sod.data(), sizeof(double), nepoch, fp);
+    }
+
+    /* directory */
+    int64_t offset = 16 + (int64_t)nepoch * (sizeof(int32_t) + sizeof(double));
+    for (int i = 0; i < nsys; i++) offset += OBC_DIRLEN + 4 * (int64_t)_data.cols[i].obsTypes.size();
+    for (int i = 0; i < nsys; i++)
+    {
+        const obscol_t &col = _data.cols[i];
+        char sys[4] = { col.sys, 0, 0, 0 };
+        int32_t nobs = (int32_t)col.obsTypes.size(), nrec = (int32_t)col.epoch.size(), reserved = 0;
+        fwrite(sys, 1, 4, fp);
+        fwrite(&nobs, sizeof(int32_t), 1, fp);
+        fwrite(&nrec, sizeof(int32_t), 1, fp);
+        fwrite(&reserved, sizeof(int32_t), 1, fp);
+        fwrite(&offset, sizeof(int64_t), 1, fp);
+        for (int j = 0; j < nobs; j++)
+        {
+            char code[4] = { 0 };
+            strncpy(code, col.obsTypes[j].c_str(), 4);
+            fwrite(code, 1, 4, fp);
+        }
+        offset += (int64_t)nrec * (sizeof(uint32_t) + sizeof(uint8_t) + nobs * (sizeof(double) + sizeof(uint8_t)));
+    }
+
+    /* blocks, each column is contiguous for sequential scans */
+    for (int i = 0; i < nsys; i++)
+    {
+        const obscol_t &col = _data.cols[i];
+        size_t nrec = col.epoch.size();
+        if (nrec == 0) continue;
+        fwrite(col.epoch.data(), sizeof(uint32_t), nrec, fp);
+        fwrite(col.prn.data(), sizeof(uint8_t), nrec, fp);
+        for (int j = 0; j < col.val.size(); j++) fwrite(col.val[j].data(), sizeof(double), nrec, fp);
+        for (int j = 0; j < col.flag.size(); j++) fwrite(col.flag[j].data(), sizeof(uint8_t), nrec, fp);
+    }
+
+    bool stat = ferror(fp) == 0;
+    fclose(fp);
+
+    return stat;
+} /* end of Write */
+
+/**
+* @brief   : Read - read selected systems and observation types from a columnar binary store
+* @param[I]: file (store file)
+* @param[I]: sysSel (selected systems, i.e., "GE", "" or nullptr: all)
+* @param[I]: obsSel (selected observation types, i.e., {"C1C", "L1C"}, empty: all)
+* @param[O]: data (observations)
+* @return  : true:ok, false:error
+* @note    : only the selected columns are read from the file
+**/
+bool ObsStore::Read(const char *file, const char *sysSel, const std::vector<string> &obsSel, obsdata_t &data)
+{
+    data.epochs.clear();
+    data.cols.clear();
+
+    FILE *fp = fopen(file, "rb");
+    if (!fp)
+    {
+        cerr << "*** ERROR(ObsStore::Read): open store file " << file << " FAILED!" << endl;
+
+        return false;
+    }
+
+    char magic[8];
+    int32_t nepoch = 0, nsys = 0;
+    if (fread(magic, 1, 8, fp) != 8 || memcmp(magic, OBC_MAGIC, 8) != 0 ||
+        fread(&nepoch, sizeof(int32_t), 1, fp) != 1 || fread(&nsys, sizeof(int32_t), 1, fp) != 1 ||
+        nepoch < 0 || nsys < 0)
+    {
+        cerr << "*** ERROR(ObsStore::Read): " << file << " is NOT a valid store file!" << endl;
+        fclose(fp);
+
+        return false;
+    }
+    std::vector<int32_t> mjd(nepoch);
+    std::vector<double> sod(nepoch);
+    if (nepoch > 0 && (fread(mjd.data(), sizeof(int32_t), nepoch, fp) != (size_t)nepoch ||
+        fread(sod.data(), sizeof(double), nepoch, fp) != (size_t)nepoch))
+    {
+        fclose(fp);
+
+        return false;
+    }
+    data.epochs.resize(nepoch);
+    for (int i = 0; i < nepoch; i++)
+    {
+        data.epochs[i].mjd = mjd[i];
+        data.epochs[i].sod = sod[i];
+    }
+
+    /* directory */
+    struct dir_t { char sys; std::vector<string> types; int32_t nrec; int64_t offset; };
+    std::vector<dir_t> dirs;
+    for (int i = 0; i < nsys; i++)
+    {
+        char sys[4];
+        int32_t nobs = 0, reserved = 0;
+        dir_t dir;
+        if (fread(sys, 1, 4, fp) != 4 || fread(&nobs, sizeof(int32_t), 1, fp) != 1 ||
+            fread(&dir.nrec, sizeof(int32_t), 1, fp) != 1 || fread(&reserved, sizeof(int32_t), 1, fp) != 1 ||
+            fread(&dir.offset, sizeof(int64_t), 1, fp) != 1)
+        {
+            fclose(fp);
+
+            return false;
+        }
+        dir.sys = sys[0];
+        for (int j = 0; j < nobs; j++)
+        {
+            char code[5] = { 0 };
+            if (fread(code, 1, 4, fp) != 4) break;
+            dir.types.push_back(code);
+        }
+        dirs.push_back(dir);
+    }
+
+    /* selected blocks and columns */
+    bool stat = true;
+    for (int i = 0; i < dirs.size() && stat; i++)
+    {
+        const dir_t &dir = dirs[i];
+        if (sysSel && sysSel[0] != '\0' && !strchr(sysSel, dir.sys)) continue;
+
+        obscol_t col;
+        col.sys = dir.sys;
+        size_t nrec = dir.nrec, nobs = dir.types.size();
+        col.epoch.resize(nrec);
+        col.prn.resize(nrec);
+        if (nrec > 0)
+        {
+            fseek64(fp, dir.offset, SEEK_SET);
+            stat = fread(col.epoch.data(), sizeof(uint32_t), nrec, fp) == nrec &&
+                fread(col.prn.data(), sizeof(uint8_t), nrec, fp) == nrec;
+        }
+        int64_t valOff = dir.offset + (int64_t)nrec * (sizeof(uint32_t) + sizeof(uint8_t));
+        int64_t flagOff = valOff + (int64_t)nrec * nobs * sizeof(double);
+        for (size_t j = 0; j < nobs && stat; j++)
+        {
+            if (!obsSel.empty() && std::find(obsSel.begin(), obsSel.end(), dir.types[j]) == obsSel.end()) continue;
+            std::vector<double> val(nrec);
+            std::vector<uint8_t> flag(nrec);
+            if (nrec > 0)
+            {
+                fseek64(fp, valOff + (int64_t)(j * nrec * sizeof(double)), SEEK_SET);
+                stat = fread(val.data(), sizeof(double), nrec, fp) == nrec;
+                fseek64(fp, flagOff + (int64_t)(j * nrec), SEEK_SET);
+                stat = stat && fread(flag.data(), sizeof(uint8_t), nrec, fp) == nrec;
+            }
+            col.obsTypes.push_back(dir.types[j]);
+            col.val.push_back(val);
+            col.flag.push_back(flag);
+        }
+        data.cols.push_back(col);
+    }
+    fclose(fp);
+
+    if (!stat) cerr << "*** ERROR(ObsStore::Read): store file " << file << " is truncated!" << endl;
+
+    return stat;
+} /* end of Read */
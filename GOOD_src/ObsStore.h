@@ -0,0 +1,80 @@
+/*------------------------------------------------------------------------------
+* ObsStore.h : header file of ObsStore.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <stdint.h>
+
+#define OBC_SUFFIX   ".obc"       /* suffix of the columnar binary store appended to the RINEX observation file name */
+
+class ObsStore
+{
+public:
+    struct obscol_t
+    {                                     /* observation columns of one system */
+        char sys;                         /* system, i.e., 'G', 'R', 'E', 'C', 'J', 'I', 'S' */
+        std::vector<string> obsTypes;     /* observation types, i.e., "C1C", "L1C" (RINEX 2: "C1", "L1") */
+        std::vector<uint32_t> epoch;      /* epoch index of each record */
+        std::vector<uint8_t> prn;         /* satellite PRN of each record */
+        std::vector<std::vector<double> > val;      /* observation values of each type (NaN: missing) */
+        std::vector<std::vector<uint8_t> > flag;    /* LLI (bits 0-3) and signal strength (bits 4-7) of each type */
+    };
+
+    struct obsdata_t
+    {                                     /* decoded observations of one file */
+        std::vector<gtime_t> epochs;      /* epoch times */
+        std::vector<obscol_t> cols;       /* observation columns of each system */
+    };
+
+private:
+    obsdata_t _data;                      /* observations collected so far */
+
+    /**
+    * @brief   : FindCol - get the columns of a system, created with the observation types from the reader if absent
+    * @param[I]: sys (system)
+    * @param[I]: rnx (RINEX reader)
+    * @param[O]: idx (column of each observation type of the reader)
+    * @return  : index of the columns of the system in '_data.cols'
+    * @note    : the types redefined by an event header (flag 4) are matched by name, a new type being appended as a
+    *            column missing in the records before
+    **/
+    int FindCol(char sys, const RnxUtil &rnx, std::vector<int> &idx);
+
+public:
+    ObsStore()
+    {
+
+    }
+    ~ObsStore()
+    {
+
+    }
+
+    /**
+    * @brief   : AddEpoch - append the current epoch of a RINEX reader to the columns
+    * @param[I]: rnx (RINEX reader that has just returned RNX_EPOCH)
+    * @param[O]: none
+    * @return  : none
+    * @note    : event epochs are skipped
+    **/
+    void AddEpoch(const RnxUtil &rnx);
+
+    /**
+    * @brief   : Write - write the collected observations to a columnar binary store
+    * @param[I]: file (store file)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool Write(const char *file);
+
+    /**
+    * @brief   : Read - read selected systems and observation types from a columnar binary store
+    * @param[I]: file (store file)
+    * @param[I]: sysSel (selected systems, i.e., "GE", "" or nullptr: all)
+    * @param[I]: obsSel (selected observation types, i.e., {"C1C", "L1C"}, empty: all)
+    * @param[O]: data (observations)
+    * @return  : true:ok, false:error
+    * @note    : only the selected columns are read from the file
+    **/
+    bool Read(const char *file, const char *sysSel, const std::vector<string> &obsSel, obsdata_t &data);
+};
@@ -9,17 +9,20 @@
  * history : 2020/09/25 1.0  new (by Feng Zhou)
  *           2021/04/30      a bug for EOP downloading is fixed (by Feng Zhou @ SDUST)
  *           2021/04/30      the option "minusAdd1day" is added (by Feng Zhou @ SDUST)
+ *           2026/10/18      the configure files are read by the schema table of CfgUtil
+ *           2026/10/18      add "Estimate" for predicting the cost of a configuration without downloading
+ *           2026/10/18      the (day, product) jobs left unfinished by the transient failures are retried by the next run
+ *           2026/10/18      the (day, product) jobs are journaled, so that a restart skips the jobs done by the previous runs
  *-----------------------------------------------------------------------------*/
 #include "GOOD.h"
 #include "StringUtil.h"
 #include "TimeUtil.h"
 #include "FtpUtil.h"
+#include "CfgUtil.h"
+#include "JobPlan.h"
+#include "RunJournal.h"
 #include "PreProcess.h"
-#ifdef _WIN32 /* for Windows */
-#include "yaml-cpp\yaml.h"
-#else /* for Linux or Mac */
-#include <yaml-cpp/yaml.h>
-#endif
+#include <sstream>
 
 /* constants/macros ----------------------------------------------------------*/
 #define MIN(x, y) ((x) <= (y) ? (x) : (y))
@@ -76,6 +79,47 @@ void PreProcess::init(prcopt_t *popt, ftpopt_t *fopt)
                                              products downloading */
     fopt->printInfoWget = false;          /* (0:off  1:on) print the information generated by 'wget' */
     str.SetStr(fopt->qr, "", 1);          /* '-qr' (printInfoWget == false) or '-r' (printInfoWget == true) in 'wget' command line */
+    fopt->mergeNav = 0;                   /* (0:off  1:hourly  2:daily) merge the site-specific hourly broadcast ephemeris files */
+    str.SetStr(fopt->obsSys, "all", 3);   /* systems kept when decoding Hatanaka-compressed observations */
+    str.SetStr(fopt->obsTypes, "all", 3); /* observation types kept when decoding Hatanaka-compressed observations */
+    fopt->obsCheck = false;               /* (0:off  1:on) check each converted observation file */
+    fopt->obsFrame = 0;                   /* (0:off  N:on) keep the decoded observations compressed at rest, N epochs per frame */
+    fopt->obsStore = false;               /* (0:off  1:on) write the decoded observations to a columnar binary store ('*.obc') */
+    fopt->maxJobs = 1;                    /* max number of analysis centers downloaded concurrently (1: one after another) */
+    fopt->maxJobsHost = 2;                /* max number of concurrent downloads from one host */
+    fopt->distributed = false;            /* (0:off  1:on) distribute the jobs over the nodes sharing 'leaseDir' */
+    str.SetStr(fopt->leaseDir, "", 1);    /* work directory shared by the nodes */
+    fopt->leaseSec = 1800;                /* seconds after which the lease of a job expires */
+    for (int i = 0; i < NPRODPRI; i++) fopt->priority[i] = 0;  /* priority class of each product (0: the highest) */
+    fopt->priority[PRI_OBS] = 1;          /* the bulk observation and tropospheric product downloading yield to the others */
+    fopt->priority[PRI_TRP] = 1;
+    fopt->maxRetry = 3;                   /* max number of retries of a transient download failure, 0: off */
+    fopt->backoff = 2.0;                  /* backoff of the first retry (s), doubled for each next one */
+    fopt->backoffMax = 60.0;              /* cap of the backoff (s) */
+    fopt->timeout = 30;                   /* network timeout of 'wget' (s) */
+    fopt->hostFails = 5;                  /* number of consecutive transient failures pausing a host */
+    fopt->hostPause = 300.0;              /* seconds of a paused host */
+    fopt->connTimeout = 30;               /* connect timeout of 'wget' (s) */
+    fopt->lowSpeed = 1024.0;              /* min average speed of a transfer over the window (B/s) */
+    fopt->lowSpeedWin = 60;               /* sliding window of the average speed (s) */
+    fopt->deadline = 3600;                /* total deadline of one transfer (s) */
+    fopt->ngsS3 = true;                   /* (0:off  1:on) NGS/NOAA CORS observations via the S3 API */
+    str.SetStr(fopt->ngsS3Url, "https://noaa-cors-pds.s3.amazonaws.com", 39);  /* base URL of the NGS/NOAA CORS bucket */
+    fopt->s3Conns = 16;                   /* max number of parallel S3 transfers */
+    fopt->manifest = true;                /* (0:off  1:on) checksum manifests of the remote directories */
+    fopt->manifestAge = 3600;             /* max age of a cached checksum manifest (s) */
+    fopt->refresh = true;                 /* (0:off  1:on) conditional refresh of the mutable products */
+    fopt->missCache = true;               /* (0:off  1:on) negative cache of the remote files known to be missing */
+    const int missDays[NPRODPRI] = { 14, 14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < NPRODPRI; i++) fopt->missDays[i] = missDays[i];  /* days after which a missing remote file is missing for good */
+    const int missTtl[NPRODPRI] = { 600, 600, 3600, 3600, 3600, 21600, 21600, 86400, 3600, 3600, 3600, 86400 };
+    for (int i = 0; i < NPRODPRI; i++) fopt->missTtl[i] = missTtl[i];  /* TTL (s) of a missing remote file of each product */
+    fopt->longName = true;                /* (0:off  1:on) long names of the sites learned from the remote listings */
+    fopt->http2 = true;                   /* (0:off  1:on) HTTP/2 over TLS */
+    fopt->h2Streams = 100;                /* max number of the transfers multiplexed over one HTTP/2 connection */
+    fopt->ftpSession = true;              /* (0:off  1:on) native FTP sessions kept alive for the plain FTP archives */
+    fopt->maxProcs = 4;                   /* max number of the external tools run at once in one job */
+    fopt->journal = true;                 /* (0:off  1:on) the run journal next to the log file */
 
     /* initialization for FTP options */
     fopt->ftpDownloading = false;      /* the master switch for data downloading, 0:off  1:on, only for data downloading */
@@ -122,399 +166,9 @@ void PreProcess::init(prcopt_t *popt, ftpopt_t *fopt)
  **/
 bool PreProcess::ReadCfgTxt(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt)
 {
-    /* open configure file */
-    FILE *fp = nullptr;
-    if (!(fp = fopen(cfgFile, "r")))
-    {
-        cerr << "*** ERROR(PreProcess::ReadCfgFile): open configure file " << cfgFile << " FAILED!" << endl;
-
-        return false;
-    }
-
-    StringUtil str;
-    TimeUtil tu;
-    char *p, sline[MAXCHARS] = {'\0'}, tmpLine[MAXCHARS] = {'\0'};
-    bool debug = false;
-    int j = 0;
-    gtime_t tt = {0};
-    if (debug)
-        cout << "##################### Start of configure file #########################" << endl;
-    while (fgets(sline, MAXCHARS, fp))
-    {
-        if ((sline != nullptr) && (sline[0] == '#'))
-            continue;
-
-        p = strrchr(sline, '=');
-
-        /* processing directory */
-        if (strstr(sline, "mainDir")) /* the root/main directory of GNSS observations and products */
-        {
-            sscanf(p + 1, "%[^%]", tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            strcpy(popt->mainDir, tmpLine);
-            if (debug)
-                cout << "* mainDir = " << popt->mainDir << endl;
-        }
-        else if (strstr(sline, "obsDir")) /* the sub-directory of RINEX format observation files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->obsDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* obsDir = " << popt->obsDir << endl;
-        }
-        else if (strstr(sline, "navDir")) /* the sub-directory of RINEX format broadcast ephemeris files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->navDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* navDir = " << popt->navDir << endl;
-        }
-        else if (strstr(sline, "orbDir")) /* the sub-directory of SP3 format precise ephemeris files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->orbDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* orbDir = " << popt->orbDir << endl;
-        }
-        else if (strstr(sline, "clkDir")) /* the sub-directory of RINEX format precise clock files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->clkDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* clkDir = " << popt->clkDir << endl;
-        }
-        else if (strstr(sline, "eopDir")) /* the sub-directory of earth rotation/orientation parameter (EOP) files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->eopDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* eopDir = " << popt->eopDir << endl;
-        }
-        else if (strstr(sline, "obxDir")) /* the sub-directory of MGEX final/rapid and/or CNES real-time ORBEX (ORBit EXchange format) files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->obxDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* obxDir = " << popt->obxDir << endl;
-        }
-        else if (strstr(sline, "biaDir")) /* the directory of CODE and/or MGEX differential code bias (DCB) files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->biaDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* biaDir = " << popt->biaDir << endl;
-        }
-        else if (strstr(sline, "snxDir")) /* the directory of SINEX format IGS weekly solution files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->snxDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* snxDir = " << popt->snxDir << endl;
-        }
-        else if (strstr(sline, "ionDir")) /* the directory of CODE and/or IGS global ionosphere map (GIM) files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->ionDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* ionDir = " << popt->ionDir << endl;
-        }
-        else if (strstr(sline, "ztdDir")) /* the directory of CODE and/or IGS tropospheric product files */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->ztdDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* ztdDir = " << popt->ztdDir << endl;
-        }
-        else if (strstr(sline, "tblDir")) /* the directory of table files for processing */
-        {
-            sscanf(p + 1, "%[^%]", &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            char sep = (char)FILEPATHSEP;
-            sprintf(popt->tblDir, "%s%c%s", popt->mainDir, sep, tmpLine);
-            if (debug)
-                cout << "* tblDir = " << popt->tblDir << endl;
-        }
-        else if (strstr(sline, "3partyDir")) /* (optional) the directory where third-party softwares (i.e., 'wget', 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
-        {
-            sscanf(p + 1, "%d %[^%]", &j, &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            strcpy(fopt->dir3party, tmpLine);
-            fopt->key43party = j == 1 ? true : false;
-            if (debug)
-                cout << "* 3partyDir = " << fopt->dir3party << "  " << fopt->key43party << endl;
-        }
-        else if (strstr(sline, "logFile")) /* The log file with full path that gives the indications of whether the data downloading is successful or not */
-        {
-            sscanf(p + 1, "%d %[^%]", &fopt->logWriteMode, &tmpLine); /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
-            str.TrimSpace4Char(tmpLine);
-            str.CutFilePathSep(tmpLine);
-            strcpy(fopt->logFil, tmpLine);
-            if (debug)
-                cout << "* logFile = " << fopt->logFil << endl;
-        }
-
-        /* time settings */
-        else if (strstr(sline, "procTime")) /* start time for processing */
-        {
-            sscanf(p + 1, "%d", &j);
-            if (j == 1)
-            {
-                double date[6] = {0.0};
-                if (sscanf(p + 1, "%d %lf %lf %lf %d", &j, date + 0, date + 1, date + 2,
-                           &popt->ndays) < 5)
-                {
-                    cerr << "*** ERROR(PreProcess::ReadCfgFile): the parameter of number of consecutive days is MISSING, please check it!" << endl;
-
-                    return false;
-                }
-                popt->ts = tu.ymdhms2time(date);
-            }
-            else if (j == 2)
-            {
-                double year = 0.0, doy = 0.0;
-                if (sscanf(p + 1, "%d %lf %lf %d", &j, &year, &doy, &popt->ndays) < 4)
-                {
-                    cerr << "*** ERROR(PreProcess::ReadCfgFile): the parameter of number of consecutive days is MISSING, please check it!" << endl;
-
-                    return false;
-                };
-                int iYear = (int)year, iDoy = (int)doy;
-                popt->ts = tu.yrdoy2time(iYear, iDoy);
-            }
-
-            if (debug)
-                cout << "* procTime = " << popt->ts.mjd << "  " << popt->ts.sod << endl;
-        }
-
-        /* FTP downloading settings */
-        else if (strstr(sline, "minusAdd1day")) /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock products downloading */
-        {
-            sscanf(p + 1, "%d", &j);
-            fopt->minusAdd1day = j == 1 ? true : false;
-            if (debug)
-                cout << "* minusAdd1day = " << fopt->minusAdd1day << endl;
-        }
-        else if (strstr(sline, "printInfoWget")) /* (0:off  1:on) print the information generated by 'wget' */
-        {
-            sscanf(p + 1, "%d", &j);
-            fopt->printInfoWget = j == 1 ? true : false;
-            if (debug)
-                cout << "* printInfoWget = " << fopt->printInfoWget << endl;
-        }
-
-        /* handling of FTP downloading */
-        else if (strstr(sline, "ftpDownloading")) /* the master switch for data downloading (0:off  1:on, only for data downloading); the FTP archive, i.e., CDDIS, IGN, or WHU */
-        {
-            sscanf(p + 1, "%d %s", &j, &fopt->ftpFrom);
-            fopt->ftpDownloading = j == 1 ? true : false;
-            if (debug)
-                cout << "* ftpDownloading = " << fopt->ftpDownloading << "  " << fopt->ftpFrom << endl;
-
-            if (fopt->ftpDownloading)
-            {
-                int hh = 0, nh = 0, step = 1;
-                while (fgets(sline, MAXCHARS, fp))
-                {
-                    if ((sline != nullptr) && (sline[0] == '#'))
-                        continue;
-                    p = strrchr(sline, '=');
-
-                    if (strstr(sline, "getObs")) /* (0:off  1:on) GNSS observation data */
-                    {
-                        sscanf(p + 1, "%d %s %s %s %d %d", &j, &fopt->obsTyp, &fopt->obsFrom, &fopt->obsLst, &hh, &nh);
-                        fopt->getObs = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getObs = " << fopt->getObs << "  " << fopt->obsTyp << "  " << fopt->obsFrom << "  " << fopt->obsLst << endl;
-
-                        int imax = MIN(hh + nh, 24);
-                        for (int i = hh; i < imax; i++)
-                            fopt->hhObs.push_back(i);
-                    }
-                    else if (strstr(sline, "getNav")) /* (0:off  1:on) broadcast ephemeris */
-                    {
-                        sscanf(p + 1, "%d %s %s %s %s %d %d", &j, &fopt->navTyp, &fopt->navSys, &fopt->navAc, &fopt->navLst, &hh, &nh);
-                        fopt->getNav = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getNav = " << fopt->getNav << "  " << fopt->navTyp << "  " << fopt->navSys << "  " << fopt->navAc << "  " << fopt->navLst << endl;
-
-                        int imax = MIN(hh + nh, 24);
-                        for (int i = hh; i < imax; i += step)
-                            fopt->hhNav.push_back(i);
-                    }
-                    else if (strstr(sline, "getOrbClk")) /* (0:off  1:on) precise orbit and clock */
-                    {
-                        sscanf(p + 1, "%d %s %d %d", &j, &fopt->orbClkAc, &hh, &nh);
-                        fopt->getOrbClk = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getOrbClk = " << fopt->getOrbClk << "  " << fopt->orbClkAc << endl;
-
-                        string ocOpt = fopt->orbClkAc;
-                        std::vector<string> acs;
-                        int iPos = (int)ocOpt.find_first_of('+');
-                        if (iPos > 0)
-                            str.GetSubStr(ocOpt, "+", acs);
-                        else
-                            acs.push_back(ocOpt);
-                        fopt->hhOrbClk.resize(4); /* for "esa_u", "gfz_u", "igs_u", and "whu_u" */
-                        for (int i = 0; i < acs.size(); i++)
-                        {
-                            string ac_i = acs[i];
-                            if (ac_i == "igs_u" || ac_i == "esa_u")
-                                step = 6;
-                            else if (ac_i == "gfz_u")
-                                step = 3;
-                            else if (ac_i == "whu_u")
-                                step = 1;
-                            else
-                                step = 24;
-                            int imax = 24;
-                            for (int i = 0; i < imax; i += step)
-                            {
-                                if (hh > i)
-                                    hh = i + step;
-                                else
-                                    break;
-                            }
-                            imax = MIN(hh + nh * step, 24);
-                            for (int i = hh; i < imax; i += step)
-                            {
-                                if (ac_i == "esa_u")
-                                    fopt->hhOrbClk[0].push_back(i);
-                                else if (ac_i == "gfz_u")
-                                    fopt->hhOrbClk[1].push_back(i);
-                                else if (ac_i == "igs_u")
-                                    fopt->hhOrbClk[2].push_back(i);
-                                else if (ac_i == "whu_u")
-                                    fopt->hhOrbClk[3].push_back(i);
-                            }
-                        }
-                    }
-                    else if (strstr(sline, "getEop")) /* (0:off  1:on) earth rotation parameter */
-                    {
-                        sscanf(p + 1, "%d %s %d %d", &j, &fopt->eopAc, &hh, &nh);
-                        fopt->getEop = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getEop = " << fopt->getEop << "  " << fopt->eopAc << endl;
-
-                        string eOpt = fopt->eopAc;
-                        if (eOpt == "igs_u" || eOpt == "esa_u")
-                            step = 6;
-                        else if (eOpt == "gfz_u")
-                            step = 3;
-                        else
-                            step = 24;
-                        int imax = 24;
-                        for (int i = 0; i < imax; i += step)
-                        {
-                            if (hh > i)
-                                hh = i + step;
-                            else
-                                break;
-                        }
-                        imax = MIN(hh + nh * step, 24);
-                        for (int i = hh; i < imax; i += step)
-                            fopt->hhEop.push_back(i);
-                    }
-                    else if (strstr(sline, "getObx")) /* (0:off  1:on) ORBEX (ORBit EXchange format) for satllite attitude information */
-                    {
-                        sscanf(p + 1, "%d %s", &j, &fopt->obxAc);
-                        fopt->getObx = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getObx = " << fopt->getObx << "  " << fopt->obxAc << endl;
-                    }
-                    else if (strstr(sline, "getDsb")) /* (0:off  1:on) differential code/signal bias (DCB/DSB) */
-                    {
-                        sscanf(p + 1, "%d %s", &j, &fopt->dsbAc);
-                        fopt->getDsb = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getDsb = " << fopt->getDsb << "  " << fopt->dsbAc << endl;
-                    }
-                    else if (strstr(sline, "getOsb")) /* (0:off  1:on) observable-specific signal bias (OSB) */
-                    {
-                        sscanf(p + 1, "%d %s", &j, &fopt->osbAc);
-                        fopt->getOsb = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getOsb = " << fopt->getOsb << "  " << fopt->osbAc << endl;
-                    }
-                    else if (strstr(sline, "getSnx")) /* (0:off  1:on) IGS weekly SINEX */
-                    {
-                        sscanf(p + 1, "%d", &j);
-                        fopt->getSnx = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getSnx = " << fopt->getSnx << endl;
-                    }
-                    else if (strstr(sline, "getIon")) /* (0:off  1:on) CODE and/or IGS global ionosphere map (GIM) */
-                    {
-                        sscanf(p + 1, "%d %s", &j, &fopt->ionAc);
-                        fopt->getIon = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getIon = " << fopt->getIon << "  " << fopt->ionAc << endl;
-                    }
-                    else if (strstr(sline, "getRoti")) /* (0:off  1:on) Rate of TEC index (ROTI) */
-                    {
-                        sscanf(p + 1, "%d", &j);
-                        fopt->getRoti = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getRoti = " << fopt->getRoti << endl;
-                    }
-                    else if (strstr(sline, "getTrp")) /* (0:off  1:on) CODE and/or IGS tropospheric product */
-                    {
-                        sscanf(p + 1, "%d %s %s", &j, &fopt->trpAc, &fopt->trpLst);
-                        fopt->getTrp = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getTrp = " << fopt->getTrp << "  " << fopt->trpAc << "  " << fopt->trpLst << endl;
-                    }
-                    else if (strstr(sline, "getAtx")) /* (0:off  1:on) ANTEX format antenna phase center correction */
-                    {
-                        sscanf(p + 1, "%d", &j);
-                        fopt->getAtx = j == 1 ? true : false;
-                        if (debug)
-                            cout << "* getAtx = " << fopt->getAtx << endl;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-    fclose(fp);
-
-    if (debug)
-        cout << "##################### End of configure file ###########################" << endl;
+    CfgUtil cfg;
 
-    return true;
+    return cfg.ReadTxt(cfgFile, popt, fopt);
 } /* end of ReadCfgTxt */
 
 /**
@@ -527,248 +181,165 @@ bool PreProcess::ReadCfgTxt(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt)
  **/
 bool PreProcess::ReadCfgYaml(string cfgFile, prcopt_t *popt, ftpopt_t *fopt)
 {
-    YAML::Node cfg = YAML::LoadFile(cfgFile);
+    CfgUtil cfg;
 
-    StringUtil str;
-    char sep = (char)FILEPATHSEP;
-    if (cfg["mainDir"].IsDefined())
-    {
-        strcpy(popt->mainDir, cfg["mainDir"].as<string>().c_str()); /* the root/main directory of GNSS observations and products */
-
-        /* the sub-directory of RINEX format observation files */
-        if (cfg["obsDir"].IsDefined())
-            sprintf(popt->obsDir, "%s%c%s", popt->mainDir, sep, cfg["obsDir"].as<string>().c_str());
-
-        /* the sub-directory of RINEX format broadcast ephemeris files */
-        if (cfg["navDir"].IsDefined())
-            sprintf(popt->navDir, "%s%c%s", popt->mainDir, sep, cfg["navDir"].as<string>().c_str());
-
-        /* the sub-directory of SP3 format precise ephemeris files */
-        if (cfg["orbDir"].IsDefined())
-            sprintf(popt->orbDir, "%s%c%s", popt->mainDir, sep, cfg["orbDir"].as<string>().c_str());
-
-        /* the sub-directory of RINEX format precise clock files */
-        if (cfg["clkDir"].IsDefined())
-            sprintf(popt->clkDir, "%s%c%s", popt->mainDir, sep, cfg["clkDir"].as<string>().c_str());
-
-        /* the sub-directory of earth rotation/orientation parameter (EOP) files */
-        if (cfg["eopDir"].IsDefined())
-            sprintf(popt->eopDir, "%s%c%s", popt->mainDir, sep, cfg["eopDir"].as<string>().c_str());
-
-        /* the sub-directory of MGEX final/rapid and/or CNES real-time ORBEX (ORBit EXchange format) files */
-        if (cfg["obxDir"].IsDefined())
-            sprintf(popt->obxDir, "%s%c%s", popt->mainDir, sep, cfg["obxDir"].as<string>().c_str());
-
-        /* the sub-directory of CODE and/or MGEX differential code bias (DCB) files */
-        if (cfg["biaDir"].IsDefined())
-            sprintf(popt->biaDir, "%s%c%s", popt->mainDir, sep, cfg["biaDir"].as<string>().c_str());
-
-        /* the sub-directory of SINEX format IGS weekly solution files */
-        if (cfg["snxDir"].IsDefined())
-            sprintf(popt->snxDir, "%s%c%s", popt->mainDir, sep, cfg["snxDir"].as<string>().c_str());
-
-        /* the sub-directory of CODE and/or IGS global ionosphere map (GIM) files */
-        if (cfg["ionDir"].IsDefined())
-            sprintf(popt->ionDir, "%s%c%s", popt->mainDir, sep, cfg["ionDir"].as<string>().c_str());
+    return cfg.ReadYaml(cfgFile.c_str(), popt, fopt);
+} /* end of ReadCfgYaml */
 
-        /* the sub-directory of CODE and/or IGS tropospheric product files */
-        if (cfg["ztdDir"].IsDefined())
-            sprintf(popt->ztdDir, "%s%c%s", popt->mainDir, sep, cfg["ztdDir"].as<string>().c_str());
+/**
+ * @brief   : DayDirs - set and create the data sub-directories of one day
+ * @param[I]: day (the day)
+ * @param[I]: popt0 (processing options with the main data directories)
+ * @param[I]: fopt (FTP options)
+ * @param[O]: popt (processing options with the sub-directories of the day)
+ * @return  : none
+ * @note    :
+ **/
+void PreProcess::DayDirs(const daydesc_t &day, const prcopt_t *popt0, const ftpopt_t *fopt, prcopt_t *popt)
+{
+    StringUtil str;
+    string sYyyy = day.sYyyy;
+    string sDoy = day.sDoy;
 
-        /* the directory of table files for processing */
-        if (cfg["tblDir"].IsDefined())
-            sprintf(popt->tblDir, "%s%c%s", popt->mainDir, sep, cfg["tblDir"].as<string>().c_str());
-    }
-    if (cfg["3partyDir"].IsDefined()) /* (optional) the directory where third-party softwares (i.e., 'wget', 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
-    {
-        fopt->key43party = cfg["3partyDir"]["key43party"].as<int>() == 1 ? true : false;
-        strcpy(fopt->dir3party, cfg["3partyDir"]["path43party"].as<string>().c_str());
-    }
-    if (cfg["logFile"].IsDefined()) /* The log file with full path that gives the indications of whether the data downloading is successful or not */
+    /* creat new observation sub-directory */
+    if (fopt->getObs)
     {
-        fopt->logWriteMode = cfg["logFile"]["opt4logFil"].as<int>();
-        strcpy(fopt->logFil, cfg["logFile"]["path4logFil"].as<string>().c_str());
+        char dir[MAXSTRPATH] = {'\0'};
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt0->obsDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace4Char(dir);
+        str.CutFilePathSep(dir);
+        strcpy(popt->obsDir, dir);
+        string tmpDir = dir;
+        if (access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32 /* for Windows */
+            string cmd = "mkdir " + tmpDir;
+#else /* for Linux or Mac */
+            string cmd = "mkdir -p " + tmpDir;
+#endif
+            std::system(cmd.c_str());
+        }
     }
 
-    char sline[MAXCHARS] = {'\0'};
-    if (cfg["procTime"].IsDefined()) /* time settings */
+    /* creat new NAV sub-directory */
+    if (fopt->getNav)
     {
-        TimeUtil tu;
-        strcpy(sline, cfg["procTime"].as<string>().c_str());
-        int j = (int)str.str2num(sline, 0, 1);
-        if (j == 1)
+        char dir[MAXSTRPATH] = {'\0'};
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s", popt0->navDir, sep, sYyyy.c_str());
+        str.TrimSpace4Char(dir);
+        str.CutFilePathSep(dir);
+        strcpy(popt->navDir, dir);
+        string tmpDir = dir;
+        if (access(tmpDir.c_str(), 0) == -1)
         {
-            double date[6] = {0.0};
-            if (sscanf(sline, "%d %lf %lf %lf %d", &j, date + 0, date + 1, date + 2,
-                       &popt->ndays) < 5)
-            {
-                cerr << "*** ERROR(PreProcess::ReadCfgFile): the parameter of number of consecutive days is MISSING, please check it!" << endl;
-
-                return false;
-            }
-            popt->ts = tu.ymdhms2time(date);
-        }
-        else if (j == 2)
-        {
-            double year = 0.0, doy = 0.0;
-            if (sscanf(sline, "%d %lf %lf %d", &j, &year, &doy, &popt->ndays) < 4)
-            {
-                cerr << "*** ERROR(PreProcess::ReadCfgFile): the parameter of number of consecutive days is MISSING, please check it!" << endl;
-
-                return false;
-            };
-            int iYear = (int)year, iDoy = (int)doy;
-            popt->ts = tu.yrdoy2time(iYear, iDoy);
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32 /* for Windows */
+            string cmd = "mkdir " + tmpDir;
+#else /* for Linux or Mac */
+            string cmd = "mkdir -p " + tmpDir;
+#endif
+            std::system(cmd.c_str());
         }
     }
 
-    /* FTP downloading settings */
-    if (cfg["minusAdd1day"].IsDefined())
-        fopt->minusAdd1day = cfg["minusAdd1day"].as<int>() == 1 ? true : false; /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock products downloading */
-    if (cfg["printInfoWget"].IsDefined())
-        fopt->printInfoWget = cfg["printInfoWget"].as<int>() == 1 ? true : false; /* (0:off  1:on) print the information generated by 'wget' */
-
-    /* handling of FTP downloading */
-    if (cfg["ftpDownloading"].IsDefined())
-    {
-        fopt->ftpDownloading = cfg["ftpDownloading"]["key4ftp"].as<int>() == 1 ? true : false;
-        strcpy(fopt->ftpFrom, cfg["ftpDownloading"]["ftpArch"].as<string>().c_str());
-    }
-    int hh = 0, nh = 0, imax = 0, step = 1;
-    if (cfg["getObs"].IsDefined())
-    {
-        fopt->getObs = cfg["getObs"]["key4obs"].as<int>() == 1 ? true : false; /* (0:off  1:on) GNSS observation data */
-        strcpy(fopt->obsTyp, cfg["getObs"]["obsType"].as<string>().c_str());
-        strcpy(fopt->obsFrom, cfg["getObs"]["obsFrom"].as<string>().c_str());
-        strcpy(fopt->obsLst, cfg["getObs"]["obsList"].as<string>().c_str());
-        int hh = cfg["getObs"]["sHH4obs"].as<int>();
-        int nh = cfg["getObs"]["nHH4obs"].as<int>();
-        int imax = MIN(hh + nh, 24);
-        for (int i = hh; i < imax; i++)
-            fopt->hhObs.push_back(i);
-    }
-    if (cfg["getNav"].IsDefined())
-    {
-        fopt->getNav = cfg["getNav"]["key4nav"].as<int>() == 1 ? true : false; /* (0:off  1:on) broadcast ephemeris */
-        strcpy(fopt->navTyp, cfg["getNav"]["navType"].as<string>().c_str());
-        strcpy(fopt->navSys, cfg["getNav"]["navSys"].as<string>().c_str());
-        strcpy(fopt->navAc, cfg["getNav"]["navFrom"].as<string>().c_str());
-        strcpy(fopt->navLst, cfg["getNav"]["navList"].as<string>().c_str());
-        hh = cfg["getNav"]["sHH4nav"].as<int>();
-        nh = cfg["getNav"]["nHH4nav"].as<int>();
-        imax = MIN(hh + nh, 24);
-        for (int i = hh; i < imax; i++)
-            fopt->hhNav.push_back(i);
-    }
-    if (cfg["getOrbClk"].IsDefined())
+    if (fopt->getOrbClk)
     {
-        fopt->getOrbClk = cfg["getOrbClk"]["key4oc"].as<int>() == 1 ? true : false; /* (0:off  1:on) precise orbit and clock */
-        strcpy(fopt->orbClkAc, cfg["getOrbClk"]["ocFrom"].as<string>().c_str());
-        hh = cfg["getOrbClk"]["sHH4oc"].as<int>();
-        nh = cfg["getOrbClk"]["nHH4oc"].as<int>();
-
-        string ocOpt = fopt->orbClkAc;
-        std::vector<string> acs;
-        int iPos = (int)ocOpt.find_first_of('+');
-        if (iPos > 0)
-            str.GetSubStr(ocOpt, "+", acs);
-        else
-            acs.push_back(ocOpt);
-        fopt->hhOrbClk.resize(4); /* for "esa_u", "gfz_u", "igs_u", and "whu_u" */
-        for (int i = 0; i < acs.size(); i++)
+        char dir[MAXSTRPATH] = {'\0'};
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s", popt0->orbDir, sep, sYyyy.c_str());
+        str.TrimSpace4Char(dir);
+        str.CutFilePathSep(dir);
+        strcpy(popt->orbDir, dir);
+        string tmpDir = dir;
+        if (access(tmpDir.c_str(), 0) == -1)
         {
-            string ac_i = acs[i];
-            if (ac_i == "igs_u" || ac_i == "esa_u")
-                step = 6;
-            else if (ac_i == "gfz_u")
-                step = 3;
-            else if (ac_i == "whu_u")
-                step = 1;
-            else
-                step = 24;
-            int imax = 24;
-            for (int i = 0; i < imax; i += step)
-            {
-                if (hh > i)
-                    hh = i + step;
-                else
-                    break;
-            }
-            imax = MIN(hh + nh * step, 24);
-            for (int i = hh; i < imax; i += step)
-            {
-                if (ac_i == "esa_u")
-                    fopt->hhOrbClk[0].push_back(i);
-                else if (ac_i == "gfz_u")
-                    fopt->hhOrbClk[1].push_back(i);
-                else if (ac_i == "igs_u")
-                    fopt->hhOrbClk[2].push_back(i);
-                else if (ac_i == "whu_u")
-                    fopt->hhOrbClk[3].push_back(i);
-            }
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32 /* for Windows */
+            string cmd = "mkdir " + tmpDir;
+#else /* for Linux or Mac */
+            string cmd = "mkdir -p " + tmpDir;
+#endif
+            std::system(cmd.c_str());
         }
     }
-    if (cfg["getEop"].IsDefined())
+
+    /* creat new ION sub-directory */
+    if (fopt->getIon)
     {
-        fopt->getEop = cfg["getEop"]["key4eop"].as<int>() == 1 ? true : false; /* (0:off  1:on) earth rotation parameter */
-        strcpy(fopt->eopAc, cfg["getEop"]["eopFrom"].as<string>().c_str());
-        hh = cfg["getEop"]["sHH4eop"].as<int>();
-        nh = cfg["getEop"]["nHH4eop"].as<int>();
-
-        string eOpt = fopt->eopAc;
-        if (eOpt == "igs_u" || eOpt == "esa_u")
-            step = 6;
-        else if (eOpt == "gfz_u")
-            step = 3;
-        else
-            step = 24;
-        imax = 24;
-        for (int i = 0; i < imax; i += step)
+        char dir[MAXSTRPATH] = {'\0'};
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s", popt0->ionDir, sep, sYyyy.c_str());
+        str.TrimSpace4Char(dir);
+        str.CutFilePathSep(dir);
+        strcpy(popt->ionDir, dir);
+        string tmpDir = dir;
+        if (access(tmpDir.c_str(), 0) == -1)
         {
-            if (hh > i)
-                hh = i + step;
-            else
-                break;
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32 /* for Windows */
+            string cmd = "mkdir " + tmpDir;
+#else /* for Linux or Mac */
+            string cmd = "mkdir -p " + tmpDir;
+#endif
+            std::system(cmd.c_str());
         }
-        imax = MIN(hh + nh * step, 24);
-        for (int i = hh; i < imax; i += step)
-            fopt->hhEop.push_back(i);
     }
-    if (cfg["getObx"].IsDefined())
-    {
-        fopt->getObx = cfg["getObx"]["key4obx"].as<int>() == 1 ? true : false; /* (0:off  1:on) ORBEX (ORBit EXchange format) for satllite attitude information */
-        strcpy(fopt->obxAc, cfg["getObx"]["obxFrom"].as<string>().c_str());
-    }
-    if (cfg["getDsb"].IsDefined())
-    {
-        fopt->getDsb = cfg["getDsb"]["key4dsb"].as<int>() == 1 ? true : false; /* (0:off  1:on) differential code/signal bias (DCB/DSB) */
-        strcpy(fopt->dsbAc, cfg["getDsb"]["dsbFrom"].as<string>().c_str());
-    }
-    if (cfg["getOsb"].IsDefined())
-    {
-        fopt->getOsb = cfg["getOsb"]["key4osb"].as<int>() == 1 ? true : false; /* (0:off  1:on) observable-specific signal bias (OSB) */
-        strcpy(fopt->osbAc, cfg["getOsb"]["osbFrom"].as<string>().c_str());
-    }
-    if (cfg["getSnx"].IsDefined())
-        fopt->getSnx = cfg["getSnx"].as<int>() == 1 ? true : false; /* (0:off  1:on) IGS weekly SINEX */
-    if (cfg["getIon"].IsDefined())
+
+    /* creat new ZTD sub-directory */
+    if (fopt->getTrp)
     {
-        fopt->getIon = cfg["getIon"]["key4ion"].as<int>() == 1 ? true : false; /* (0:off  1:on) CODE and/or IGS global ionosphere map (GIM) */
-        strcpy(fopt->ionAc, cfg["getIon"]["ionFrom"].as<string>().c_str());
+        char dir[MAXSTRPATH] = {'\0'};
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt0->ztdDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace4Char(dir);
+        str.CutFilePathSep(dir);
+        strcpy(popt->ztdDir, dir);
+        string tmpDir = dir;
+        if (access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32 /* for Windows */
+            string cmd = "mkdir " + tmpDir;
+#else /* for Linux or Mac */
+            string cmd = "mkdir -p " + tmpDir;
+#endif
+            std::system(cmd.c_str());
+        }
     }
-    if (cfg["getRoti"].IsDefined())
-        fopt->getRoti = cfg["getRoti"].as<int>() == 1 ? true : false; /* (0:off  1:on) Rate of TEC index (ROTI) */
-    if (cfg["getTrp"].IsDefined())
+} /* end of DayDirs */
+
+/**
+ * @brief   : OnlyProduct - switch on one product and switch off all the others
+ * @param[I]: prod (product in PRODPRI_NAMES, i.e., "nav")
+ * @param[O]: fopt (FTP options)
+ * @param[O]: on (whether the product was switched on in the configuration)
+ * @return  : true:ok, false:unknown product
+ * @note    : for retrying a (day, product) job left unfinished, also of a product switched off since, with the
+ *            settings of the configuration
+ **/
+bool PreProcess::OnlyProduct(const string &prod, ftpopt_t *fopt, bool &on)
+{
+    bool *gets[NPRODPRI] = { &fopt->getObs, &fopt->getNav, &fopt->getOrbClk, &fopt->getEop, &fopt->getObx, &fopt->getDsb,
+        &fopt->getOsb, &fopt->getSnx, &fopt->getIon, &fopt->getRoti, &fopt->getTrp, &fopt->getAtx };
+    std::istringstream names(PRODPRI_NAMES);
+    string name;
+    bool found = false;
+    for (int i = 0; i < NPRODPRI && names >> name; i++)
     {
-        fopt->getTrp = cfg["getTrp"]["key4trp"].as<int>() == 1 ? true : false; /* (0:off  1:on) CODE and/or IGS tropospheric product */
-        strcpy(fopt->trpAc, cfg["getTrp"]["trpFrom"].as<string>().c_str());
-        strcpy(fopt->trpLst, cfg["getTrp"]["trpList"].as<string>().c_str());
+        if (name == prod)
+        {
+            found = true;
+            on = *gets[i];
+            *gets[i] = true;
+        }
+        else *gets[i] = false;
     }
-    if (cfg["getAtx"].IsDefined())
-        fopt->getAtx = cfg["getAtx"].as<int>() == 1 ? true : false; /* (0:off  1:on) ANTEX format antenna phase center correction */
 
-    return true;
-} /* end of ReadCfgYaml */
+    return found;
+} /* end of OnlyProduct */
 
 /**
  * @brief   : run - start GOOD processing
@@ -787,11 +358,13 @@ void PreProcess::run(const char *cfgFile, int readCfgMode)
 
     /* read configure file to get processing information */
     if (readCfgMode == readCfgTxt)
-        ReadCfgTxt(cfgFile, &popt, &fopt);
+    {
+        if (!ReadCfgTxt(cfgFile, &popt, &fopt)) return;
+    }
     else if (readCfgMode == readCfgYaml)
     {
         string strCfgFile = cfgFile;
-        ReadCfgYaml(strCfgFile, &popt, &fopt);
+        if (!ReadCfgYaml(strCfgFile, &popt, &fopt)) return;
     }
 
     /* data downloading for GNSS further processing */
@@ -800,11 +373,7 @@ void PreProcess::run(const char *cfgFile, int readCfgMode)
         FtpUtil ftp;
         TimeUtil tu;
         StringUtil str;
-        string obsDirMain = popt.obsDir;
-        string navDirMain = popt.navDir;
-        string orbclkDirMain = popt.orbDir;
-        string ionDirMain = popt.ionDir;
-        string ztdDirMain = popt.ztdDir;
+        prcopt_t popt0 = popt;  /* with the main data directories */
 
         /* check if it need to write log file */
         fopt.fpLog = nullptr;
@@ -837,129 +406,117 @@ void PreProcess::run(const char *cfgFile, int readCfgMode)
                 fopt.fpLog = fopen(fopt.logFil, "a"); /* append mode */
         }
 
-        for (int i = 0; i < popt.ndays; i++)
-        {
-            int yyyy, doy;
-            tu.time2yrdoy(popt.ts, &yyyy, &doy);
-            string sYyyy = str.yyyy2str(yyyy);
-            string sDoy = str.doy2str(doy);
+        /* the (day, product) jobs left unfinished by the transient failures of the previous runs */
+        std::vector<gtime_t> retryDays;
+        std::vector<string> retryProds;
+        long retryBytes = 0;
+        RetryPolicy::Load(popt.mainDir, retryDays, retryProds, retryBytes);
 
-            /* creat new observation sub-directory */
-            if (fopt.getObs)
-            {
-                char dir[MAXSTRPATH] = {'\0'};
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obsDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace4Char(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obsDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32 /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
-                }
-            }
+        std::vector<daydesc_t> days;
+        tu.DayDescs(popt.ts, popt.ndays, days);
 
-            /* creat new NAV sub-directory */
-            if (fopt.getNav)
+        /* the jobs of the run journaled next to the log file, the jobs of 'retry.list' being run again */
+        bool gets[NPRODPRI] = { fopt.getObs, fopt.getNav, fopt.getOrbClk, fopt.getEop, fopt.getObx, fopt.getDsb,
+            fopt.getOsb, fopt.getSnx, fopt.getIon, fopt.getRoti, fopt.getTrp, fopt.getAtx };
+        std::vector<int> iprods;
+        for (int j = 0; j < NPRODPRI; j++)
+        {
+            if (gets[j]) iprods.push_back(j);
+        }
+        RunJournal journal;
+        if (journal.Open(&fopt, cfgFile))
+        {
+            journal.Plan(days, iprods);
+            for (int i = 0; i < retryDays.size(); i++) journal.Reopen(retryDays[i], retryProds[i]);
+        }
+        /* the priority classes one after another, each for all the days, so that the latency-critical products of all the
+           days are downloaded before the bulk ones */
+        std::vector<int> classes(fopt.priority, fopt.priority + NPRODPRI);
+        sort(classes.begin(), classes.end());
+        classes.erase(unique(classes.begin(), classes.end()), classes.end());
+        gtime_t ts0 = popt.ts;
+        for (int k = 0; k < classes.size(); k++)
+        {
+            popt.ts = ts0;
+            for (int i = 0; i < popt.ndays; i++)
             {
-                char dir[MAXSTRPATH] = {'\0'};
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s", navDirMain.c_str(), sep, sYyyy.c_str());
-                str.TrimSpace4Char(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.navDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
+                /* a day whose jobs of this class were all done by the previous runs is not touched at all */
+                bool done = journal.On();
+                for (int j = 0; done && j < iprods.size(); j++)
                 {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32 /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
+                    if (fopt.priority[iprods[j]] == classes[k] && !journal.Done(days[i].t, iprods[j])) done = false;
                 }
-            }
-
-            if (fopt.getOrbClk)
-            {
-                char dir[MAXSTRPATH] = {'\0'};
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s", orbclkDirMain.c_str(), sep, sYyyy.c_str());
-                str.TrimSpace4Char(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.orbDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
+                if (!done)
                 {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32 /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
-                }
-            }
+                    DayDirs(days[i], &popt0, &fopt, &popt);
 
-            /* creat new ION sub-directory */
-            if (fopt.getIon)
-            {
-                char dir[MAXSTRPATH] = {'\0'};
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s", ionDirMain.c_str(), sep, sYyyy.c_str());
-                str.TrimSpace4Char(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.ionDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32 /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
+                    /* the main entry of FTP downloader */
+                    ftp.FtpDownload(&popt, &fopt, classes[k], &journal);
                 }
-            }
 
-            /* creat new ZTD sub-directory */
-            if (fopt.getTrp)
+                popt.ts = tu.TimeAdd(popt.ts, 86400.0);
+            }
+        }
+        for (int i = 0; i < retryDays.size(); i++)
+        {
+            double dt = tu.TimeDiff(retryDays[i], ts0);
+            ftpopt_t fopt1 = fopt;
+            bool on = false;
+            if (!OnlyProduct(retryProds[i], &fopt1, on)) continue;
+            daydesc_t day;
+            tu.DayDesc(retryDays[i], day);
+            if (on && dt >= 0.0 && dt < popt.ndays * 86400.0)
             {
-                char dir[MAXSTRPATH] = {'\0'};
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", ztdDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace4Char(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.ztdDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
-#ifdef _WIN32 /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
-#else /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
-#endif
-                    std::system(cmd.c_str());
-                }
+                if (fopt.fpLog) fprintf(fopt.fpLog, "* INFO(run): %s of %s %s left unfinished is downloaded in this run\n",
+                    retryProds[i].c_str(), day.sYyyy, day.sDoy);
+                continue;
             }
-
-            /* the main entry of FTP downloader */
-            ftp.FtpDownload(&popt, &fopt);
-
-            popt.ts = tu.TimeAdd(popt.ts, 86400.0);
+            if (fopt.fpLog) fprintf(fopt.fpLog, "* INFO(run): retry %s of %s %s left unfinished\n", retryProds[i].c_str(),
+                day.sYyyy, day.sDoy);
+            DayDirs(day, &popt0, &fopt1, &popt);
+            popt.ts = day.t;
+            ftp.FtpDownload(&popt, &fopt1, -1, &journal);
         }
+        RetryPolicy::Consume(popt.mainDir, retryBytes);  /* only now, so that a run stopped before keeps them */
+        ftp.QueueReport(fopt.fpLog);
+        journal.Report(fopt.fpLog);
+        journal.Complete();
 
         if (fopt.fpLog)
             fclose(fopt.fpLog); /* close the log file */
     }
-} /* end of run */
\ No newline at end of file
+} /* end of run */
+
+/**
+ * @brief   : Estimate - predict the files, transfer volume, decoding time and wall time of a configuration
+ * @param[I]: cfgFile (configure file with full path)
+ * @param[I]: readCfgMode (1: TXT  2: YAML)
+ * @param[I]: npar (parallelism, number of concurrent downloads)
+ * @param[O]: none
+ * @return  : true:ok, false:error
+ * @note    : nothing is downloaded, and the directories are not created
+ **/
+bool PreProcess::Estimate(const char *cfgFile, int readCfgMode, int npar)
+{
+    prcopt_t popt;
+    ftpopt_t fopt;
+    /* initialization */
+    init(&popt, &fopt);
+
+    /* read configure file to get processing information */
+    if (readCfgMode == readCfgTxt)
+    {
+        if (!ReadCfgTxt(cfgFile, &popt, &fopt)) return false;
+    }
+    else if (readCfgMode == readCfgYaml)
+    {
+        string strCfgFile = cfgFile;
+        if (!ReadCfgYaml(strCfgFile, &popt, &fopt)) return false;
+    }
+
+    JobPlan plan;
+    plan.Expand(&popt, &fopt);
+    plan.Report(npar, stdout);
+
+    return true;
+} /* end of Estimate */
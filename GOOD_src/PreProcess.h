@@ -36,6 +36,28 @@ private:
     **/
     bool ReadCfgYaml(string cfgFile, prcopt_t *popt, ftpopt_t *fopt);
 
+    /**
+    * @brief   : DayDirs - set and create the data sub-directories of one day
+    * @param[I]: day (the day)
+    * @param[I]: popt0 (processing options with the main data directories)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: popt (processing options with the sub-directories of the day)
+    * @return  : none
+    * @note    :
+    **/
+    void DayDirs(const daydesc_t &day, const prcopt_t *popt0, const ftpopt_t *fopt, prcopt_t *popt);
+
+    /**
+    * @brief   : OnlyProduct - switch on one product and switch off all the others
+    * @param[I]: prod (product in PRODPRI_NAMES, i.e., "nav")
+    * @param[O]: fopt (FTP options)
+    * @param[O]: on (whether the product was switched on in the configuration)
+    * @return  : true:ok, false:unknown product
+    * @note    : for retrying a (day, product) job left unfinished, also of a product switched off since, with the
+    *            settings of the configuration
+    **/
+    bool OnlyProduct(const string &prod, ftpopt_t *fopt, bool &on);
+
 public:
     PreProcess()
 	{
@@ -55,4 +77,15 @@ public:
     * @note    :
     **/
     void run(const char *cfgFile, int readCfgMode);
+
+    /**
+    * @brief   : Estimate - predict the files, transfer volume, decoding time and wall time of a configuration
+    * @param[I]: cfgFile (configure file with full path)
+    * @param[I]: readCfgMode (1: TXT  2: YAML)
+    * @param[I]: npar (parallelism, number of concurrent downloads)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    : nothing is downloaded, and the directories are not created
+    **/
+    bool Estimate(const char *cfgFile, int readCfgMode, int npar);
 };
\ No newline at end of file
@@ -0,0 +1,417 @@
+/*------------------------------------------------------------------------------
+* ProcPool.cpp : external tools run without a shell, several at once, chained through pipes
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    1. POSIX.1-2008, posix_spawn and posix_spawn_file_actions
+*
+* notes   : the external tools ('gzip', 'crx2rnx', 'mv', 'rm', ...) were run one after another by 'std::system', each
+*           through a shell, with their exit status ignored. A plain command line is now split into its arguments
+*           and the tool is started by 'posix_spawnp' without a shell (a command line with the wildcards of a file
+*           name, the quotes or a redirection is still left to the shell). A pipeline (i.e., 'gzip -dc | crx2rnx')
+*           is chained through pipes, its input and output files opened for it, so no 'cat' is needed. Up to
+*           'maxProcs' pipelines are run at once, i.e., for the decoding of all the observation files of a day. The
+*           standard error of a pipeline goes to a hidden file, which is written into the log with the exit status
+*           when it fails, and removed. On Windows, the pipelines are run by the shell one after another.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "ProcPool.h"
+#include <chrono>
+#include <sstream>
+#include <thread>
+#ifdef _WIN32  /* for Windows */
+#include <process.h>
+#else          /* for Linux or Mac */
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+extern char **environ;
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : CmdLine - the command line of a pipeline
+* @param[I]: stages (argument vectors)
+* @param[I]: inFile (standard input of the first stage, "": none)
+* @param[I]: outFile (standard output of the last stage, "": none)
+* @param[O]: none
+* @return  : command line, i.e., 'gzip -dc < a.crx.gz | crx2rnx -f - > a.24o'
+* @note    : for the log, and for the shell on Windows
+**/
+string ProcPool::CmdLine(const stages_t &stages, const string &inFile, const string &outFile)
+{
+    string line;
+    for (int k = 0; k < stages.size(); k++)
+    {
+        if (k > 0) line += " | ";
+        for (int i = 0; i < stages[k].size(); i++)
+        {
+            const string &arg = stages[k][i];
+            if (i > 0) line += " ";
+            line += arg.find(' ') == string::npos ? arg : "\"" + arg + "\"";
+        }
+        if (k == 0 && !inFile.empty()) line += " < " + inFile;
+    }
+    if (!outFile.empty()) line += " > " + outFile;
+
+    return line;
+} /* end of CmdLine */
+
+/**
+* @brief   : Spawn - start a pipeline
+* @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+* @param[I]: inFile (standard input of the first stage, "": none)
+* @param[I]: outFile (standard output of the last stage, "": a pipe to 'fpOut' if asked, else inherited)
+* @param[O]: p (the pipeline)
+* @param[O]: fpOut (the standard output of the last stage to be read, nullptr: not asked)
+* @return  : true: started, false: failed
+* @note    : no shell is run; the standard error of all the stages goes to 'p.errFile'
+**/
+bool ProcPool::Spawn(const stages_t &stages, const string &inFile, const string &outFile, proc_t &p, FILE **fpOut)
+{
+    p.desc = CmdLine(stages, inFile, outFile);
+    p.pids.clear();
+    p.stats.clear();
+#ifdef _WIN32  /* for Windows */
+    p.errFile = PROC_ERR_PREFIX + to_string((int)_getpid()) + "_" + to_string(_seq++) + ".err";
+    string line = p.desc + " 2> " + p.errFile;
+    if (fpOut)
+    {
+        *fpOut = _popen(line.c_str(), "r");
+
+        return *fpOut != nullptr;
+    }
+    p.stats.push_back(std::system(line.c_str()));
+
+    return true;
+#else          /* for Linux or Mac */
+    p.errFile = PROC_ERR_PREFIX + to_string((int)getpid()) + "_" + to_string(_seq++) + ".err";
+    FILE *fpErr = fopen(p.errFile.c_str(), "w");
+    if (fpErr) fclose(fpErr);
+
+    /* the pipes are closed in the tools, except for the ends duplicated onto their standard input and output */
+    int outPipe[2] = { -1, -1 };
+    if (fpOut)
+    {
+        *fpOut = nullptr;
+        if (pipe(outPipe) != 0) return false;
+        fcntl(outPipe[0], F_SETFD, FD_CLOEXEC);
+        fcntl(outPipe[1], F_SETFD, FD_CLOEXEC);
+    }
+    int prevRead = -1;
+    bool ok = true;
+    for (int k = 0; k < stages.size() && ok; k++)
+    {
+        int pfd[2] = { -1, -1 };
+        bool last = k == (int)stages.size() - 1;
+        if (!last)
+        {
+            if (pipe(pfd) != 0)
+            {
+                ok = false;
+                break;
+            }
+            fcntl(pfd[0], F_SETFD, FD_CLOEXEC);
+            fcntl(pfd[1], F_SETFD, FD_CLOEXEC);
+        }
+
+        posix_spawn_file_actions_t fa;
+        posix_spawn_file_actions_init(&fa);
+        if (k > 0) posix_spawn_file_actions_adddup2(&fa, prevRead, 0);
+        else if (!inFile.empty()) posix_spawn_file_actions_addopen(&fa, 0, inFile.c_str(), O_RDONLY, 0);
+        if (!last) posix_spawn_file_actions_adddup2(&fa, pfd[1], 1);
+        else if (!outFile.empty()) posix_spawn_file_actions_addopen(&fa, 1, outFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        else if (fpOut) posix_spawn_file_actions_adddup2(&fa, outPipe[1], 1);
+        posix_spawn_file_actions_addopen(&fa, 2, p.errFile.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+
+        std::vector<char *> argv;
+        for (int i = 0; i < stages[k].size(); i++) argv.push_back((char *)stages[k][i].c_str());
+        argv.push_back(nullptr);
+        pid_t pid;
+        ok = !stages[k].empty() && posix_spawnp(&pid, argv[0], &fa, nullptr, argv.data(), environ) == 0;
+        posix_spawn_file_actions_destroy(&fa);
+        if (ok)
+        {
+            p.pids.push_back((int)pid);
+            p.stats.push_back(PROC_RUNNING);
+        }
+
+        if (prevRead >= 0) close(prevRead);
+        if (pfd[1] >= 0) close(pfd[1]);
+        prevRead = pfd[0];
+    }
+    if (prevRead >= 0) close(prevRead);
+    if (fpOut)
+    {
+        close(outPipe[1]);
+        if (ok) *fpOut = fdopen(outPipe[0], "r");
+        else close(outPipe[0]);
+    }
+
+    /* the stages started before a failure end on the closed pipes */
+    if (!ok) Poll(p, true);
+
+    return ok;
+#endif
+} /* end of Spawn */
+
+/**
+* @brief   : Poll - reap the stages of a pipeline that have finished
+* @param[I/O]: p (the pipeline)
+* @param[I]: block (whether to wait for all of them)
+* @return  : true: all finished, false: not yet
+* @note    :
+**/
+bool ProcPool::Poll(proc_t &p, bool block)
+{
+    bool all = true;
+#ifndef _WIN32  /* for Linux or Mac */
+    for (int k = 0; k < p.pids.size(); k++)
+    {
+        if (p.stats[k] != PROC_RUNNING) continue;
+        int status = 0;
+        pid_t rc = waitpid((pid_t)p.pids[k], &status, block ? 0 : WNOHANG);
+        if (rc == (pid_t)p.pids[k]) p.stats[k] = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        else if (rc < 0) p.stats[k] = -1;
+        else all = false;
+    }
+#endif
+
+    return all;
+} /* end of Poll */
+
+/**
+* @brief   : Finish - the exit status of a pipeline finished, its failure being logged
+* @param[I]: p (the pipeline)
+* @param[I]: rc (exit status, the first non-zero one of the stages, -1: not run or killed)
+* @param[O]: none
+* @return  : exit status
+* @note    : 'p.errFile' is removed
+**/
+int ProcPool::Finish(const proc_t &p, int rc)
+{
+    if (rc != 0 && _fpLog)
+    {
+        /* the first line of the standard error */
+        char msg[MAXCHARS] = { '\0' };
+        FILE *fp = fopen(p.errFile.c_str(), "r");
+        if (fp)
+        {
+            if (!fgets(msg, MAXCHARS, fp)) msg[0] = '\0';
+            fclose(fp);
+        }
+        size_t len = strlen(msg);
+        while (len > 0 && (msg[len - 1] == '\n' || msg[len - 1] == '\r')) msg[--len] = '\0';
+        fprintf(_fpLog, "* WARNING(ProcPool): '%s' exited with %d%s%s\n", p.desc.c_str(), rc, len > 0 ? ": " : "", msg);
+    }
+    remove(p.errFile.c_str());
+
+    return rc;
+} /* end of Finish */
+
+/**
+* @brief   : Set - set the pool
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ProcPool::Set(const ftpopt_t *fopt)
+{
+    Wait();
+    _maxProcs = fopt->maxProcs > 1 ? fopt->maxProcs : 1;
+    _fpLog = fopt->fpLog;
+} /* end of Set */
+
+/**
+* @brief   : Split - the argument vector of a command line
+* @param[I]: cmd (command line, i.e., 'gzip -d -f abmf0320.24d.gz')
+* @param[O]: args (arguments)
+* @return  : true: a plain command, false: it needs a shell (i.e., for the wildcards, the quotes or a redirection)
+* @note    :
+**/
+bool ProcPool::Split(const string &cmd, std::vector<string> &args)
+{
+    args.clear();
+    if (cmd.find_first_of("*?[]~|&;<>()$`'\"\\\n") != string::npos) return false;
+    std::istringstream iss(cmd);
+    string arg;
+    while (iss >> arg) args.push_back(arg);
+
+    return !args.empty();
+} /* end of Split */
+
+/**
+* @brief   : Start - start a pipeline, after one of the running ones finishes if the pool is full
+* @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+* @param[I]: inFile (standard input of the first stage, "": none)
+* @param[I]: outFile (standard output of the last stage, "": inherited)
+* @param[I]: done (called with the exit status when it is finished, nullptr: none)
+* @param[O]: none
+* @return  : true: started, false: failed, 'done' being called with -1
+* @note    : on Windows, the pipeline is run by the shell and finished before the return
+**/
+bool ProcPool::Start(const stages_t &stages, const string &inFile, const string &outFile, std::function<void(int rc)> done)
+{
+    /* a slot, freed by the first pipeline finished */
+    while ((int)_running.size() >= _maxProcs)
+    {
+        bool freed = false;
+        for (int i = 0; i < _running.size() && !freed; i++)
+        {
+            if (!Poll(_running[i], false)) continue;
+            proc_t p = _running[i];
+            _running.erase(_running.begin() + i);
+            int rc = 0;
+            for (int k = 0; k < p.stats.size() && rc == 0; k++) rc = p.stats[k];
+            Finish(p, rc);
+            if (p.done) p.done(rc);
+            freed = true;
+        }
+        if (!freed) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    proc_t p;
+    p.done = done;
+    if (!Spawn(stages, inFile, outFile, p, nullptr))
+    {
+        Finish(p, -1);
+        if (done) done(-1);
+
+        return false;
+    }
+    _running.push_back(p);
+#ifdef _WIN32  /* for Windows */
+    Wait();
+#endif
+
+    return true;
+} /* end of Start */
+
+/**
+* @brief   : Wait - wait for all the pipelines started
+* @param[I]: none
+* @param[O]: none
+* @return  : number of pipelines failed
+* @note    :
+**/
+int ProcPool::Wait()
+{
+    int nfail = 0;
+    while (!_running.empty())
+    {
+        proc_t p = _running.front();
+        _running.erase(_running.begin());
+        Poll(p, true);
+        int rc = 0;
+        for (int k = 0; k < p.stats.size() && rc == 0; k++) rc = p.stats[k];
+        Finish(p, rc);
+        if (p.done) p.done(rc);
+        if (rc != 0) nfail++;
+    }
+
+    return nfail;
+} /* end of Wait */
+
+/**
+* @brief   : Run - run a pipeline and wait for it
+* @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+* @param[I]: inFile (standard input of the first stage, "": none)
+* @param[I]: outFile (standard output of the last stage, "": inherited)
+* @param[O]: none
+* @return  : exit status, -1: not run or killed
+* @note    : the pipelines started are not waited for
+**/
+int ProcPool::Run(const stages_t &stages, const string &inFile, const string &outFile)
+{
+    proc_t p;
+    if (!Spawn(stages, inFile, outFile, p, nullptr)) return Finish(p, -1);
+    Poll(p, true);
+    int rc = 0;
+    for (int k = 0; k < p.stats.size() && rc == 0; k++) rc = p.stats[k];
+
+    return Finish(p, rc);
+} /* end of Run */
+
+/**
+* @brief   : Open - start a pipeline whose standard output is read
+* @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+* @param[I]: inFile (standard input of the first stage, "": none)
+* @param[O]: none
+* @return  : the standard output of the last stage, nullptr: failed
+* @note    : closed by "Close"
+**/
+FILE *ProcPool::Open(const stages_t &stages, const string &inFile)
+{
+    proc_t p;
+    FILE *fp = nullptr;
+    if (!Spawn(stages, inFile, "", p, &fp) || !fp)
+    {
+        Finish(p, -1);
+
+        return nullptr;
+    }
+    _opened[fp] = p;
+
+    return fp;
+} /* end of Open */
+
+/**
+* @brief   : Close - close a pipeline opened by "Open" and wait for it
+* @param[I]: fp (the standard output of the pipeline)
+* @param[O]: none
+* @return  : exit status, -1: not run or killed
+* @note    :
+**/
+int ProcPool::Close(FILE *fp)
+{
+    auto it = _opened.find(fp);
+    if (it == _opened.end()) return -1;
+    proc_t p = it->second;
+    _opened.erase(it);
+    int rc = 0;
+#ifdef _WIN32  /* for Windows */
+    rc = _pclose(fp);
+#else          /* for Linux or Mac */
+    fclose(fp);
+    Poll(p, true);
+    for (int k = 0; k < p.stats.size() && rc == 0; k++) rc = p.stats[k];
+#endif
+
+    return Finish(p, rc);
+} /* end of Close */
+
+/**
+* @brief   : System - run a command line and wait for it
+* @param[I]: cmd (command line)
+* @param[O]: none
+* @return  : exit status, -1: not run or killed
+* @note    : a plain command is run without a shell, the others (i.e., with the wildcards of a file name) by the
+*            shell; a failure is logged with its standard error
+**/
+int ProcPool::System(const string &cmd)
+{
+    std::vector<string> args;
+#ifndef _WIN32  /* for Linux or Mac */
+    if (Split(cmd, args)) return Run({ args }, "", "");
+#endif
+
+    proc_t p;
+    p.desc = cmd;
+#ifdef _WIN32  /* for Windows */
+    p.errFile = PROC_ERR_PREFIX + to_string((int)_getpid()) + "_" + to_string(_seq++) + ".err";
+    int rc = std::system((cmd + " 2> " + p.errFile).c_str());
+#else          /* for Linux or Mac */
+    p.errFile = PROC_ERR_PREFIX + to_string((int)getpid()) + "_" + to_string(_seq++) + ".err";
+    int status = std::system((cmd + " 2> " + p.errFile).c_str());
+    int rc = status != -1 && WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+
+    return Finish(p, rc);
+} /* end of System */
\ No newline at end of file
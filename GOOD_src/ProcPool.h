@@ -0,0 +1,163 @@
+/*------------------------------------------------------------------------------
+* ProcPool.h : header file of ProcPool.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <functional>
+#include <map>
+
+#define PROC_ERR_PREFIX ".proc_"         /* prefix of the hidden files of the standard error of the external tools */
+#define PROC_RUNNING    (-999)           /* exit status of a stage still running */
+
+typedef std::vector<std::vector<string> > stages_t;  /* the argument vectors of the stages of a pipeline */
+
+class ProcPool
+{
+private:
+    struct proc_t
+    {                                     /* one pipeline running */
+        std::vector<int> pids;            /* process ids of the stages */
+        std::vector<int> stats;           /* exit status of each stage, PROC_RUNNING: not yet */
+        string desc;                      /* the pipeline, for the log */
+        string errFile;                   /* standard error of the stages */
+        std::function<void(int rc)> done; /* called with the exit status when it is finished, nullptr: none */
+    };
+
+    std::vector<proc_t> _running;         /* pipelines running */
+    std::map<FILE *, proc_t> _opened;     /* pipelines opened by "Open", key: their standard output */
+    int _maxProcs;                        /* max number of pipelines running at once */
+    FILE *_fpLog;                         /* log file pointer, nullptr: no log */
+    int _seq;                             /* sequence number of the files of the standard error */
+
+    /**
+    * @brief   : CmdLine - the command line of a pipeline
+    * @param[I]: stages (argument vectors)
+    * @param[I]: inFile (standard input of the first stage, "": none)
+    * @param[I]: outFile (standard output of the last stage, "": none)
+    * @param[O]: none
+    * @return  : command line, i.e., 'gzip -dc < a.crx.gz | crx2rnx -f - > a.24o'
+    * @note    : for the log, and for the shell on Windows
+    **/
+    static string CmdLine(const stages_t &stages, const string &inFile, const string &outFile);
+
+    /**
+    * @brief   : Spawn - start a pipeline
+    * @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+    * @param[I]: inFile (standard input of the first stage, "": none)
+    * @param[I]: outFile (standard output of the last stage, "": a pipe to 'fpOut' if asked, else inherited)
+    * @param[O]: p (the pipeline)
+    * @param[O]: fpOut (the standard output of the last stage to be read, nullptr: not asked)
+    * @return  : true: started, false: failed
+    * @note    : no shell is run; the standard error of all the stages goes to 'p.errFile'
+    **/
+    bool Spawn(const stages_t &stages, const string &inFile, const string &outFile, proc_t &p, FILE **fpOut);
+
+    /**
+    * @brief   : Poll - reap the stages of a pipeline that have finished
+    * @param[I/O]: p (the pipeline)
+    * @param[I]: block (whether to wait for all of them)
+    * @return  : true: all finished, false: not yet
+    * @note    :
+    **/
+    static bool Poll(proc_t &p, bool block);
+
+    /**
+    * @brief   : Finish - the exit status of a pipeline finished, its failure being logged
+    * @param[I]: p (the pipeline)
+    * @param[I]: rc (exit status, the first non-zero one of the stages, -1: not run or killed)
+    * @param[O]: none
+    * @return  : exit status
+    * @note    : 'p.errFile' is removed
+    **/
+    int Finish(const proc_t &p, int rc);
+
+public:
+    ProcPool()
+    {
+        _maxProcs = 1;
+        _fpLog = nullptr;
+        _seq = 0;
+    }
+    ~ProcPool()
+    {
+        Wait();
+    }
+
+    /**
+    * @brief   : Set - set the pool
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Set(const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Split - the argument vector of a command line
+    * @param[I]: cmd (command line, i.e., 'gzip -d -f abmf0320.24d.gz')
+    * @param[O]: args (arguments)
+    * @return  : true: a plain command, false: it needs a shell (i.e., for the wildcards, the quotes or a redirection)
+    * @note    :
+    **/
+    static bool Split(const string &cmd, std::vector<string> &args);
+
+    /**
+    * @brief   : Start - start a pipeline, after one of the running ones finishes if the pool is full
+    * @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+    * @param[I]: inFile (standard input of the first stage, "": none)
+    * @param[I]: outFile (standard output of the last stage, "": inherited)
+    * @param[I]: done (called with the exit status when it is finished, nullptr: none)
+    * @param[O]: none
+    * @return  : true: started, false: failed, 'done' being called with -1
+    * @note    : on Windows, the pipeline is run by the shell and finished before the return
+    **/
+    bool Start(const stages_t &stages, const string &inFile, const string &outFile, std::function<void(int rc)> done);
+
+    /**
+    * @brief   : Wait - wait for all the pipelines started
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of pipelines failed
+    * @note    :
+    **/
+    int Wait();
+
+    /**
+    * @brief   : Run - run a pipeline and wait for it
+    * @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+    * @param[I]: inFile (standard input of the first stage, "": none)
+    * @param[I]: outFile (standard output of the last stage, "": inherited)
+    * @param[O]: none
+    * @return  : exit status, -1: not run or killed
+    * @note    : the pipelines started are not waited for
+    **/
+    int Run(const stages_t &stages, const string &inFile, const string &outFile);
+
+    /**
+    * @brief   : Open - start a pipeline whose standard output is read
+    * @param[I]: stages (argument vectors, the standard output of each being the standard input of the next)
+    * @param[I]: inFile (standard input of the first stage, "": none)
+    * @param[O]: none
+    * @return  : the standard output of the last stage, nullptr: failed
+    * @note    : closed by "Close"
+    **/
+    FILE *Open(const stages_t &stages, const string &inFile);
+
+    /**
+    * @brief   : Close - close a pipeline opened by "Open" and wait for it
+    * @param[I]: fp (the standard output of the pipeline)
+    * @param[O]: none
+    * @return  : exit status, -1: not run or killed
+    * @note    :
+    **/
+    int Close(FILE *fp);
+
+    /**
+    * @brief   : System - run a command line and wait for it
+    * @param[I]: cmd (command line)
+    * @param[O]: none
+    * @return  : exit status, -1: not run or killed
+    * @note    : a plain command is run without a shell, the others (i.e., with the wildcards of a file name) by the
+    *            shell; a failure is logged with its standard error
+    **/
+    int System(const string &cmd);
+};
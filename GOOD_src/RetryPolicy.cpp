@@ -0,0 +1,328 @@
+/*------------------------------------------------------------------------------
+* RetryPolicy.cpp : retries of transient download failures with per-host circuit breakers
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : every 'wget' command is run by RetryPolicy::Run. The exit status of 'wget' (and its log, if the messages
+*           are not printed) tells a permanent failure (i.e., 404, the file is not there) from a transient one
+*           (i.e., timeout, 5xx during the maintenance of a server). Only the transient ones are retried, after a
+*           capped exponential backoff with jitter. A host failing transiently again and again is paused by its
+*           circuit breaker, so that its commands return at once while the jobs of the other hosts go on, and it
+*           is tried once again after the pause. The (day, product) jobs hit by a transient failure are kept in
+*           'retry.list' in the root/main directory and retried by the next run.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "RetryPolicy.h"
+#include <chrono>
+#include <thread>
+#ifdef _WIN32  /* for Windows */
+#include <process.h>
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : UrlHost - the host of the URL in a 'wget' command
+* @param[I]: cmd ('wget' command)
+* @param[O]: none
+* @return  : host, "" if no URL
+* @note    :
+**/
+string RetryPolicy::UrlHost(const string &cmd)
+{
+    size_t ipos = cmd.find("://");
+    if (ipos == string::npos) return "";
+    ipos += 3;
+    size_t iend = cmd.find_first_of("/ :\"'", ipos);
+    string host = cmd.substr(ipos, iend == string::npos ? string::npos : iend - ipos);
+    size_t iat = host.rfind('@');  /* user:password@host */
+    if (iat != string::npos) host = host.substr(iat + 1);
+
+    return host;
+} /* end of UrlHost */
+
+/**
+* @brief   : Classify - classify the result of 'wget'
+* @param[I]: rc (exit status of 'wget')
+* @param[I]: logFile (log of 'wget', "": no log)
+* @param[O]: none
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT
+* @note    : network failures (4), SSL (5) and protocol (7) errors are transient, and so is a server error (8) with
+*            5xx, 429 or FTP 421 in the log; a server error with 404 or 'No such file' in the log is an absent
+*            file; the others, i.e., 401, 403 or no log, are permanent
+**/
+int RetryPolicy::Classify(int rc, const string &logFile)
+{
+    if (rc == 0) return WGET_OK;
+    if (rc == 4 || rc == 5 || rc == 7) return WGET_TRANSIENT;
+    if (rc != 8 || logFile.empty()) return WGET_PERMANENT;
+
+    int stat = WGET_PERMANENT;
+    FILE *fp = fopen(logFile.c_str(), "r");
+    if (!fp) return stat;
+    char line[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        if (strstr(line, "ERROR 5") || strstr(line, "ERROR 429") || strstr(line, "421 "))
+        {
+            stat = WGET_TRANSIENT;
+            break;
+        }
+        if (strstr(line, "ERROR 404") || strstr(line, "No such file") || strstr(line, "No such directory"))
+            stat = WGET_ABSENT;
+    }
+    fclose(fp);
+
+    return stat;
+} /* end of Classify */
+
+/**
+* @brief   : Now - the current time
+* @param[I]: none
+* @param[O]: none
+* @return  : seconds
+* @note    :
+**/
+double RetryPolicy::Now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} /* end of Now */
+
+/**
+* @brief   : Set - set the retry policy
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void RetryPolicy::Set(const ftpopt_t *fopt)
+{
+    _maxRetry = fopt->maxRetry > 0 ? fopt->maxRetry : 0;
+    _backoff = fopt->backoff > 0 ? fopt->backoff : 1.0;
+    _backoffMax = fopt->backoffMax > _backoff ? fopt->backoffMax : _backoff;
+    _hostFails = fopt->hostFails;
+    _hostPause = fopt->hostPause > 0 ? fopt->hostPause : 0.0;
+    _watchdog.Set(fopt);
+} /* end of Set */
+
+/**
+* @brief   : Backoff - the delay before a retry
+* @param[I]: k (index of the retry, 0: the first)
+* @param[O]: none
+* @return  : seconds
+* @note    : capped exponential backoff with jitter, the delay being drawn in [0.5, 1] of the capped one
+**/
+double RetryPolicy::Backoff(int k)
+{
+    double delay = _backoff * pow(2.0, k);
+    if (delay > _backoffMax) delay = _backoffMax;
+    std::uniform_real_distribution<double> jitter(0.5, 1.0);
+
+    return delay * jitter(_rng);
+} /* end of Backoff */
+
+/**
+* @brief   : Run - run a 'wget' command with the retries of transient failures
+* @param[I]: cmd ('wget' command)
+* @param[I]: quiet (whether the messages of 'wget' are not printed, then they are logged for the classification)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+* @note    : the retries are delayed by the capped exponential backoff with jitter; a host is paused after
+*            'hostFails' consecutive transient failures, and tried once again after the pause; a transfer aborted
+*            by the watchdog is a transient failure
+**/
+int RetryPolicy::Run(const string &cmd, bool quiet, FILE *fpLog)
+{
+    string host = UrlHost(cmd);
+
+    /* the messages of 'wget' go to a hidden file of the working directory, which the job pool drops */
+    string logFile, runCmd = cmd;
+    if (quiet)
+    {
+        char tmpFile[MAXCHARS];
+#ifdef _WIN32   /* for Windows */
+        sprintf(tmpFile, ".wget_%d.log", (int)_getpid());
+#else           /* for Linux or Mac */
+        sprintf(tmpFile, ".wget_%d.log", (int)getpid());
+#endif
+        logFile = tmpFile;
+        runCmd += " -o " + logFile;
+    }
+
+    int stat = Run(host, [&](int &rc)
+    {
+        int event = WDOG_NONE;
+        rc = _watchdog.Run(runCmd, host, fpLog, event);
+
+        return event != WDOG_NONE ? WGET_TRANSIENT : Classify(rc, logFile);
+    }, fpLog);
+    if (!logFile.empty()) remove(logFile.c_str());
+
+    return stat;
+} /* end of Run */
+
+/**
+* @brief   : Run - run a transfer with the retries of transient failures
+* @param[I]: host (host of the transfer, for its circuit breaker)
+* @param[I]: once (one try of the transfer, returning WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT, with
+*            its status for the log, i.e., the exit status of 'wget' or an FTP reply code)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+* @note    : the backoff and the circuit breaker of the host are those of the 'wget' commands
+**/
+int RetryPolicy::Run(const string &host, std::function<int(int &rc)> once, FILE *fpLog)
+{
+    breaker_t &brk = _breakers[host];
+    if (brk.until > Now()) return WGET_PAUSED;
+
+    int stat = WGET_OK;
+    for (int k = 0; ; k++)
+    {
+        int rc = 0;
+        stat = once(rc);
+        if (stat != WGET_TRANSIENT || k >= _maxRetry) break;
+
+        double delay = Backoff(k);
+        if (fpLog) fprintf(fpLog, "* INFO(RetryPolicy): %s failed transiently (status %d), retry %d of %d in %.1f s\n",
+            host.c_str(), rc, k + 1, _maxRetry, delay);
+        std::this_thread::sleep_for(std::chrono::duration<double>(delay));
+    }
+
+    if (stat != WGET_TRANSIENT)
+    {
+        /* the host answered, even if the file is not there */
+        brk.nfail = 0;
+        brk.until = 0.0;
+
+        return stat;
+    }
+
+    brk.nfail++;
+    if (_hostFails > 0 && brk.nfail >= _hostFails)
+    {
+        brk.until = Now() + _hostPause;
+        brk.nfail = _hostFails - 1;  /* half open after the pause: one more failure pauses it again */
+        if (fpLog) fprintf(fpLog, "* WARNING(RetryPolicy): %s paused for %.0f s after %d transient failures\n",
+            host.c_str(), _hostPause, _hostFails);
+    }
+
+    return stat;
+} /* end of Run */
+
+/**
+* @brief   : Persist - keep a (day, product) job left unfinished for the next run
+* @param[I]: mainDir (root/main directory)
+* @param[I]: ts (the day)
+* @param[I]: prod (product, i.e., "nav")
+* @param[O]: none
+* @return  : none
+* @note    : one short line is appended, so the concurrent jobs do not mix their lines
+**/
+void RetryPolicy::Persist(const char *mainDir, gtime_t ts, const string &prod)
+{
+    TimeUtil tu;
+    daydesc_t day;
+    tu.DayDesc(ts, day);
+    string list = string(mainDir) + (char)FILEPATHSEP + RETRY_LIST;
+    FILE *fp = fopen(list.c_str(), "a");
+    if (!fp)
+    {
+        cerr << "*** ERROR(RetryPolicy::Persist): failed to open " << list << endl;
+
+        return;
+    }
+    fprintf(fp, "%s %s %s\n", day.sYyyy, day.sDoy, prod.c_str());
+    fclose(fp);
+} /* end of Persist */
+
+/**
+* @brief   : Load - load the (day, product) jobs left unfinished by the previous runs
+* @param[I]: mainDir (root/main directory)
+* @param[O]: days (the days)
+* @param[O]: prods (the products)
+* @param[O]: nbytes (size of 'retry.list' read, for "Consume")
+* @return  : number of jobs
+* @note    : the duplicated jobs are dropped; 'retry.list' is kept until the jobs are replayed, so that a run
+*            stopped before does not lose them
+**/
+int RetryPolicy::Load(const char *mainDir, std::vector<gtime_t> &days, std::vector<string> &prods, long &nbytes)
+{
+    days.clear();
+    prods.clear();
+    nbytes = 0;
+    string list = string(mainDir) + (char)FILEPATHSEP + RETRY_LIST;
+    FILE *fp = fopen(list.c_str(), "r");
+    if (!fp) return 0;
+
+    TimeUtil tu;
+    std::vector<string> keys;
+    char line[MAXCHARS], prod[MAXCHARS];
+    int yyyy, doy;
+    while (fgets(line, MAXCHARS, fp))
+    {
+        if (sscanf(line, "%d %d %s", &yyyy, &doy, prod) != 3) continue;
+        char key[MAXCHARS];
+        sprintf(key, "%04d %03d %s", yyyy, doy, prod);
+        if (std::find(keys.begin(), keys.end(), key) != keys.end()) continue;
+        keys.push_back(key);
+        days.push_back(tu.yrdoy2time(yyyy, doy));
+        prods.push_back(prod);
+    }
+    nbytes = ftell(fp);
+    fclose(fp);
+
+    return (int)days.size();
+} /* end of Load */
+
+/**
+* @brief   : Consume - remove the jobs replayed from 'retry.list'
+* @param[I]: mainDir (root/main directory)
+* @param[I]: nbytes (size of 'retry.list' read by "Load")
+* @param[O]: none
+* @return  : none
+* @note    : the jobs appended by this run after "Load" are kept for the next run
+**/
+void RetryPolicy::Consume(const char *mainDir, long nbytes)
+{
+    if (nbytes <= 0) return;
+
+    string list = string(mainDir) + (char)FILEPATHSEP + RETRY_LIST;
+    FILE *fp = fopen(list.c_str(), "r");
+    if (!fp) return;
+
+    /* the lines appended after the part read, written to a temporary file and renamed */
+    string rest;
+    char line[MAXCHARS];
+    if (fseek(fp, nbytes, SEEK_SET) == 0)
+    {
+        while (fgets(line, MAXCHARS, fp)) rest += line;
+    }
+    fclose(fp);
+    if (rest.empty())
+    {
+        remove(list.c_str());
+
+        return;
+    }
+    string tmp = list + ".tmp";
+    fp = fopen(tmp.c_str(), "w");
+    if (!fp)
+    {
+        cerr << "*** ERROR(RetryPolicy::Consume): failed to open " << tmp << endl;
+
+        return;
+    }
+    fputs(rest.c_str(), fp);
+    fclose(fp);
+    remove(list.c_str());  /* 'rename' does not replace a file on Windows */
+    if (rename(tmp.c_str(), list.c_str()) != 0) cerr << "*** ERROR(RetryPolicy::Consume): failed to rename " << tmp << endl;
+} /* end of Consume */
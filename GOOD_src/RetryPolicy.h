@@ -0,0 +1,179 @@
+/*------------------------------------------------------------------------------
+* RetryPolicy.h : header file of RetryPolicy.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <functional>
+#include <map>
+#include <random>
+#include "Watchdog.h"
+
+#define RETRY_LIST     "retry.list"      /* (day, product) jobs left unfinished by transient failures in the root/main directory,
+                                            'yyyy doy prod' */
+
+#define WGET_OK        0                 /* downloaded, or nothing to download */
+#define WGET_PERMANENT 1                 /* failed permanently, i.e., 404 */
+#define WGET_TRANSIENT 2                 /* failed transiently after all the retries, i.e., timeout or 5xx */
+#define WGET_PAUSED    3                 /* not tried, the host is paused by its circuit breaker */
+#define WGET_ABSENT    4                 /* failed permanently, the file is not there, i.e., 404 or FTP 550 */
+
+class RetryPolicy
+{
+private:
+    struct breaker_t
+    {                                     /* circuit breaker of one host */
+        int nfail;                        /* number of consecutive transient failures */
+        double until;                     /* paused until this time (s), 0: closed */
+    };
+
+    std::map<string, breaker_t> _breakers;  /* circuit breakers, key: host */
+    int _maxRetry;                        /* max number of retries of a transient failure, 0: off */
+    double _backoff;                      /* backoff of the first retry (s), doubled for each next one */
+    double _backoffMax;                   /* cap of the backoff (s) */
+    int _hostFails;                       /* number of consecutive transient failures pausing a host */
+    double _hostPause;                    /* seconds of a paused host */
+    std::mt19937 _rng;                    /* random number generator for the jitter */
+    Watchdog _watchdog;                   /* stalled-transfer detection */
+
+    /**
+    * @brief   : UrlHost - the host of the URL in a 'wget' command
+    * @param[I]: cmd ('wget' command)
+    * @param[O]: none
+    * @return  : host, "" if no URL
+    * @note    :
+    **/
+    static string UrlHost(const string &cmd);
+
+    /**
+    * @brief   : Classify - classify the result of 'wget'
+    * @param[I]: rc (exit status of 'wget')
+    * @param[I]: logFile (log of 'wget', "": no log)
+    * @param[O]: none
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT
+    * @note    : network failures (4), SSL (5) and protocol (7) errors are transient, and so is a server error (8) with
+    *            5xx, 429 or FTP 421 in the log; a server error with 404 or 'No such file' in the log is an absent
+    *            file; the others, i.e., 401, 403 or no log, are permanent
+    **/
+    static int Classify(int rc, const string &logFile);
+
+    /**
+    * @brief   : Now - the current time
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : seconds
+    * @note    :
+    **/
+    static double Now();
+
+public:
+    RetryPolicy()
+    {
+        _maxRetry = 0;
+        _backoff = _backoffMax = _hostPause = 0.0;
+        _hostFails = 0;
+        _rng.seed((unsigned int)std::random_device()());
+    }
+    ~RetryPolicy()
+    {
+
+    }
+
+    /**
+    * @brief   : Set - set the retry policy
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Set(const ftpopt_t *fopt);
+
+    /**
+    * @brief   : MaxRetry - max number of retries of a transient failure
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of retries, 0: off
+    * @note    :
+    **/
+    int MaxRetry() const
+    {
+        return _maxRetry;
+    }
+
+    /**
+    * @brief   : Backoff - the delay before a retry
+    * @param[I]: k (index of the retry, 0: the first)
+    * @param[O]: none
+    * @return  : seconds
+    * @note    : capped exponential backoff with jitter, the delay being drawn in [0.5, 1] of the capped one
+    **/
+    double Backoff(int k);
+
+    /**
+    * @brief   : Run - run a 'wget' command with the retries of transient failures
+    * @param[I]: cmd ('wget' command)
+    * @param[I]: quiet (whether the messages of 'wget' are not printed, then they are logged for the classification)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+    * @note    : the retries are delayed by the capped exponential backoff with jitter; a host is paused after
+    *            'hostFails' consecutive transient failures, and tried once again after the pause; a transfer aborted
+    *            by the watchdog is a transient failure
+    **/
+    int Run(const string &cmd, bool quiet, FILE *fpLog);
+
+    /**
+    * @brief   : Run - run a transfer with the retries of transient failures
+    * @param[I]: host (host of the transfer, for its circuit breaker)
+    * @param[I]: once (one try of the transfer, returning WGET_OK, WGET_PERMANENT, WGET_ABSENT or WGET_TRANSIENT, with
+    *            its status for the log, i.e., the exit status of 'wget' or an FTP reply code)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : WGET_OK, WGET_PERMANENT, WGET_ABSENT, WGET_TRANSIENT or WGET_PAUSED
+    * @note    : the backoff and the circuit breaker of the host are those of the 'wget' commands
+    **/
+    int Run(const string &host, std::function<int(int &rc)> once, FILE *fpLog);
+
+    /**
+    * @brief   : Persist - keep a (day, product) job left unfinished for the next run
+    * @param[I]: mainDir (root/main directory)
+    * @param[I]: ts (the day)
+    * @param[I]: prod (product, i.e., "nav")
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    static void Persist(const char *mainDir, gtime_t ts, const string &prod);
+
+    /**
+    * @brief   : Load - load the (day, product) jobs left unfinished by the previous runs
+    * @param[I]: mainDir (root/main directory)
+    * @param[O]: days (the days)
+    * @param[O]: prods (the products)
+    * @param[O]: nbytes (size of 'retry.list' read, for "Consume")
+    * @return  : number of jobs
+    * @note    : the duplicated jobs are dropped; 'retry.list' is kept until the jobs are replayed, so that a run
+    *            stopped before does not lose them
+    **/
+    static int Load(const char *mainDir, std::vector<gtime_t> &days, std::vector<string> &prods, long &nbytes);
+
+    /**
+    * @brief   : Consume - remove the jobs replayed from 'retry.list'
+    * @param[I]: mainDir (root/main directory)
+    * @param[I]: nbytes (size of 'retry.list' read by "Load")
+    * @param[O]: none
+    * @return  : none
+    * @note    : the jobs appended by this run after "Load" are kept for the next run
+    **/
+    static void Consume(const char *mainDir, long nbytes);
+
+    /**
+    * @brief   : Report - report the transfers aborted by the watchdog
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Report(FILE *fpLog) const
+    {
+        _watchdog.Report(fpLog);
+    }
+};
@@ -0,0 +1,609 @@
+/*------------------------------------------------------------------------------
+* RnxUtil.cpp : line-by-line reader of RINEX observation files
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    RINEX The Receiver Independent Exchange Format, Version 2.11 and Version 3.04
+*
+* history : 2026/10/18 1.0  new, the streaming reader for the output of 'crx2rnx'
+*           2026/10/18      add the filter of systems and observation types, and the writer of the filtered file
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "RnxUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define NOBSLINE2  5    /* number of observations per line in RINEX 2 */
+#define NSATLINE2  12   /* number of satellites per epoch line in RINEX 2 */
+#define NTYPLINE2  9    /* number of observation types per header line in RINEX 2 */
+#define NTYPLINE3  13   /* number of observation types per header line in RINEX 3 */
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : ParseHeader - parse one header line
+* @param[I]: line (header line without line break)
+* @param[O]: none
+* @return  : true: 'END OF HEADER', false: others
+* @note    :
+**/
+bool RnxUtil::ParseHeader(const string &line)
+{
+    string label = line.size() > 60 ? line.substr(60) : "";
+
+    if (label.find("RINEX VERSION / TYPE") == 0)
+        _ver = atof(line.substr(0, 9).c_str());
+    else if (label.find("SYS / # / OBS TYPES") == 0)  /* RINEX 3 */
+    {
+        if (line[0] != ' ')
+        {
+            _lastSys = line[0];
+            _obsTypes[_lastSys].clear();
+        }
+        std::vector<string> &types = _obsTypes[_lastSys];
+        for (int i = 0; i < NTYPLINE3; i++)
+        {
+            int pos = 7 + 4 * i;
+            if (pos + 3 > 60) break;
+            string code = line.substr(pos, 3);
+            if (code == "   ") break;
+            types.push_back(code);
+        }
+    }
+    else if (label.find("# / TYPES OF OBSERV") == 0)  /* RINEX 2 */
+    {
+        std::vector<string> &types = _obsTypes[' '];
+        if (line.substr(0, 6) != "      ") types.clear();
+        for (int i = 0; i < NTYPLINE2; i++)
+        {
+            int pos = 10 + 6 * i;
+            if (pos + 2 > 60) break;
+            string code = line.substr(pos, 2);
+            if (code == "  ") break;
+            types.push_back(code);
+        }
+    }
+    else if (label.find("END OF HEADER") == 0) return true;
+
+    return false;
+} /* end of ParseHeader */
+
+/**
+* @brief   : ParseEpoch - parse the first epoch line
+* @param[I]: line (epoch line without line break)
+* @param[O]: none
+* @return  : true:ok, false:error
+* @note    :
+**/
+bool RnxUtil::ParseEpoch(const string &line)
+{
+    TimeUtil tu;
+    _epoch.line = line;
+    _epoch.sats.clear();
+    _epoch.events.clear();
+    _epoch.clk.clear();
+    _epoch.time.mjd = 0;
+    _epoch.time.sod = 0.0;
+    if (_ver >= 3.0)
+    {
+        if (line.size() < 35 || line[0] != '>') return false;
+        _epoch.flag = atoi(line.substr(31, 1).c_str());
+        _epoch.nsat = atoi(line.substr(32, 3).c_str());
+        if (line.size() > 41) _epoch.clk = line.substr(41);
+        if (_epoch.flag <= 1 || _epoch.flag == 6)
+        {
+            if (!tu.str2time(line.c_str(), 1, 28, _epoch.time)) return false;
+        }
+        else tu.str2time(line.c_str(), 1, 28, _epoch.time);  /* the time may be blank for events */
+    }
+    else
+    {
+        if (line.size() < 32) return false;
+        _epoch.flag = atoi(line.substr(28, 1).c_str());
+        _epoch.nsat = atoi(line.substr(29, 3).c_str());
+        if (line.size() > 68) _epoch.clk = line.substr(68);
+        if (_epoch.flag <= 1 || _epoch.flag == 6)
+        {
+            if (!tu.str2time(line.c_str(), 0, 26, _epoch.time)) return false;
+            for (int i = 0; i < _epoch.nsat && i < NSATLINE2; i++)
+            {
+                rnxsat_t sat;
+                sat.sat = line.size() >= 35 + 3 * i ? line.substr(32 + 3 * i, 3) : "   ";
+                _epoch.sats.push_back(sat);
+            }
+        }
+        else tu.str2time(line.c_str(), 0, 26, _epoch.time);
+    }
+
+    return true;
+} /* end of ParseEpoch */
+
+/**
+* @brief   : AddFields - split the observation part of a line into 16-character fields
+* @param[I]: line (observation line without line break)
+* @param[I]: pos (start position of the first field)
+* @param[I]: nmax (maximum number of fields)
+* @param[O]: fields (observation fields)
+* @return  : none
+* @note    : missing trailing fields are filled with blanks
+**/
+void RnxUtil::AddFields(const string &line, int pos, int nmax, std::vector<string> &fields)
+{
+    for (int i = 0; i < nmax; i++, pos += 16)
+    {
+        if ((int)line.size() >= pos + 16) fields.push_back(line.substr(pos, 16));
+        else if ((int)line.size() > pos)
+        {
+            string field = line.substr(pos);
+            field.resize(16, ' ');
+            fields.push_back(field);
+        }
+        else fields.push_back(string(16, ' '));
+    }
+} /* end of AddFields */
+
+/**
+* @brief   : AllTypes - get all the observation types of a system in the file
+* @param[I]: sys (system, i.e., 'G', 'R', 'E', 'C', 'J', 'I', 'S')
+* @param[O]: none
+* @return  : observation types
+* @note    : the common list is returned for RINEX 2
+**/
+const std::vector<string> &RnxUtil::AllTypes(char sys) const
+{
+    static const std::vector<string> none;
+    std::map<char, std::vector<string> >::const_iterator it = _obsTypes.find(_ver < 3.0 ? ' ' : sys);
+
+    return it == _obsTypes.end() ? none : it->second;
+} /* end of AllTypes */
+
+/**
+* @brief   : SysSelected - whether a system passes the filter
+* @param[I]: sys (system)
+* @param[O]: none
+* @return  : true: selected, false: dropped
+* @note    :
+**/
+bool RnxUtil::SysSelected(char sys) const
+{
+    return _selSys.empty() || _selSys.find(sys) != string::npos;
+} /* end of SysSelected */
+
+/**
+* @brief   : TypeSelected - whether an observation type passes the filter
+* @param[I]: type (observation type, i.e., "L1C" or "L1")
+* @param[O]: none
+* @return  : true: selected, false: dropped
+* @note    : a selected item matches the types it is the prefix of, i.e., "L1" matches "L1C" and "L1W",
+*            and "L1C" matches "L1" of RINEX 2
+**/
+bool RnxUtil::TypeSelected(const string &type) const
+{
+    if (_selTypes.empty()) return true;
+    for (int i = 0; i < _selTypes.size(); i++)
+    {
+        const string &sel = _selTypes[i];
+        if (type.compare(0, sel.size(), sel) == 0) return true;
+        if (type.size() == 2 && sel.compare(0, 2, type) == 0) return true;
+    }
+
+    return false;
+} /* end of TypeSelected */
+
+/**
+* @brief   : UpdateSel - update the selected observation types of each system
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : called at the end of header and after the header information is changed by an event
+**/
+void RnxUtil::UpdateSel()
+{
+    _selIdx.clear();
+    _selObsTypes.clear();
+    for (std::map<char, std::vector<string> >::const_iterator it = _obsTypes.begin(); it != _obsTypes.end(); ++it)
+    {
+        std::vector<int> &idx = _selIdx[it->first];
+        std::vector<string> &types = _selObsTypes[it->first];
+        for (int i = 0; i < it->second.size(); i++)
+        {
+            if (!TypeSelected(it->second[i])) continue;
+            idx.push_back(i);
+            types.push_back(it->second[i]);
+        }
+    }
+} /* end of UpdateSel */
+
+/**
+* @brief   : EndEpoch - finish the current epoch, the filter being applied
+* @param[I]: none
+* @param[O]: none
+* @return  : RNX_EPOCH
+* @note    :
+**/
+int RnxUtil::EndEpoch()
+{
+    _state = 1;
+    if (_epoch.flag == 4) UpdateSel();
+    if (!Filtered() || (_epoch.flag > 1 && _epoch.flag < 6)) return RNX_EPOCH;
+
+    std::vector<rnxsat_t> sats;
+    for (int i = 0; i < _epoch.sats.size(); i++)
+    {
+        const rnxsat_t &sat = _epoch.sats[i];
+        char sys = SatSys(sat.sat);
+        if (!SysSelected(sys)) continue;
+        std::map<char, std::vector<int> >::const_iterator it = _selIdx.find(_ver < 3.0 ? ' ' : sys);
+        if (it == _selIdx.end() || it->second.empty()) continue;
+        rnxsat_t selSat;
+        selSat.sat = sat.sat;
+        for (int j = 0; j < it->second.size(); j++)
+        {
+            int k = it->second[j];
+            selSat.fields.push_back(k < sat.fields.size() ? sat.fields[k] : string(16, ' '));
+        }
+        sats.push_back(selSat);
+    }
+    _epoch.sats.swap(sats);
+
+    return RNX_EPOCH;
+} /* end of EndEpoch */
+
+/**
+* @brief   : TypesLines - format the observation types header lines of a system
+* @param[I]: sys (system, ' ' for RINEX 2)
+* @param[I]: types (observation types)
+* @param[O]: lines (header lines)
+* @return  : none
+* @note    :
+**/
+void RnxUtil::TypesLines(char sys, const std::vector<string> &types, std::vector<string> &lines) const
+{
+    char buff[16];
+    int nper = _ver >= 3.0 ? NTYPLINE3 : NTYPLINE2;
+    string line;
+    for (int i = 0; i < types.size() || i == 0; i += nper)
+    {
+        if (i == 0)
+        {
+            if (_ver >= 3.0) sprintf(buff, "%c  %3d", sys, (int)types.size());
+            else sprintf(buff, "%6d", (int)types.size());
+            line = buff;
+        }
+        else line = "      ";
+        for (int j = i; j < i + nper && j < types.size(); j++)
+        {
+            if (_ver >= 3.0) sprintf(buff, " %-3s", types[j].c_str());
+            else sprintf(buff, "    %-2s", types[j].c_str());
+            line += buff;
+        }
+        line.resize(60, ' ');
+        line += _ver >= 3.0 ? "SYS / # / OBS TYPES" : "# / TYPES OF OBSERV";
+        lines.push_back(line);
+    }
+} /* end of TypesLines */
+
+/**
+* @brief   : FilterHeader - rewrite header lines for the selected systems and observation types
+* @param[I]: in (header lines)
+* @param[O]: out (rewritten header lines)
+* @return  : none
+* @note    : 'PRN / # OF OBS' and '# OF SATELLITES' are dropped since they are no longer valid
+**/
+void RnxUtil::FilterHeader(const std::vector<string> &in, std::vector<string> &out) const
+{
+    bool typesDone = false, drop = false;
+    for (int i = 0; i < in.size(); i++)
+    {
+        const string &line = in[i];
+        string label = line.size() > 60 ? line.substr(60) : "";
+        if (label.find("SYS / # / OBS TYPES") == 0 || label.find("# / TYPES OF OBSERV") == 0)
+        {
+            if (typesDone) continue;
+            for (std::map<char, std::vector<string> >::const_iterator it = _selObsTypes.begin(); it != _selObsTypes.end(); ++it)
+            {
+                if (_ver >= 3.0 && (!SysSelected(it->first) || it->second.empty())) continue;
+                TypesLines(it->first, it->second, out);
+            }
+            typesDone = true;
+            continue;
+        }
+        if (label.find("PRN / # OF OBS") == 0 || label.find("# OF SATELLITES") == 0) continue;
+        if (label.find("SYS / ") == 0)
+        {
+            /* 'SYS / PHASE SHIFT', 'SYS / SCALE FACTOR', 'SYS / DCBS APPLIED' and 'SYS / PCVS APPLIED' */
+            if (line[0] != ' ')
+            {
+                drop = !SysSelected(line[0]);
+                if (!drop && label.find("SYS / PHASE SHIFT") == 0 && line.size() >= 5 && line.substr(2, 3) != "   ")
+                    drop = !TypeSelected(line.substr(2, 3));
+            }
+            if (drop) continue;
+        }
+        out.push_back(line);
+    }
+} /* end of FilterHeader */
+
+/**
+* @brief   : InputLine - input one line of RINEX observation file
+* @param[I]: line (RINEX line with or without line break)
+* @param[O]: none
+* @return  : RNX_NONE, RNX_HEADER, RNX_ENDHDR, RNX_EPOCH or RNX_ERROR
+* @note    : after RNX_EPOCH the complete epoch is available via Epoch()
+**/
+int RnxUtil::InputLine(const char *line)
+{
+    string sline = line;
+    while (!sline.empty() && (sline.back() == '\n' || sline.back() == '\r')) sline.pop_back();
+
+    if (_state == 0)  /* header */
+    {
+        _header.push_back(sline);
+        if (ParseHeader(sline))
+        {
+            _state = 1;
+            UpdateSel();
+
+            return RNX_ENDHDR;
+        }
+
+        return RNX_HEADER;
+    }
+    else if (_state == 1)  /* the first epoch line */
+    {
+        if (sline.empty()) return RNX_NONE;
+        if (!ParseEpoch(sline)) return RNX_ERROR;
+        _nrem = _epoch.nsat;
+        _nline = 0;
+        if (_epoch.flag > 1 && _epoch.flag < 6) _state = 4;
+        else if (_ver < 3.0 && _epoch.nsat > NSATLINE2) _state = 2;
+        else _state = 3;
+        if (_nrem <= 0) return EndEpoch();
+    }
+    else if (_state == 2)  /* continuation lines of the RINEX 2 satellite list */
+    {
+        for (int i = 0; i < NSATLINE2 && (int)_epoch.sats.size() < _epoch.nsat; i++)
+        {
+            rnxsat_t sat;
+            sat.sat = (int)sline.size() >= 35 + 3 * i ? sline.substr(32 + 3 * i, 3) : "   ";
+            _epoch.sats.push_back(sat);
+        }
+        if ((int)_epoch.sats.size() >= _epoch.nsat) _state = 3;
+    }
+    else if (_state == 3)  /* satellite records */
+    {
+        if (_ver >= 3.0)
+        {
+            rnxsat_t sat;
+            sat.sat = sline.substr(0, 3);
+            sat.sat.resize(3, ' ');
+            AddFields(sline, 3, (int)AllTypes(sat.sat[0]).size(), sat.fields);
+            _epoch.sats.push_back(sat);
+        }
+        else
+        {
+            int isat = _epoch.nsat - _nrem;
+            int nobs = (int)AllTypes(' ').size();
+            int nline = nobs <= 0 ? 1 : (nobs + NOBSLINE2 - 1) / NOBSLINE2;
+            int nmax = nobs - _nline * NOBSLINE2;
+            if (nmax > NOBSLINE2) nmax = NOBSLINE2;
+            if (isat < (int)_epoch.sats.size()) AddFields(sline, 0, nmax, _epoch.sats[isat].fields);
+            if (++_nline < nline) return RNX_NONE;
+            _nline = 0;
+        }
+        if (--_nrem <= 0) return EndEpoch();
+    }
+    else if (_state == 4)  /* special records */
+    {
+        _epoch.events.push_back(sline);
+        if (_epoch.flag == 4) ParseHeader(sline);  /* header information may be changed */
+        if (--_nrem <= 0) return EndEpoch();
+    }
+
+    return RNX_NONE;
+} /* end of InputLine */
+
+/**
+* @brief   : Version - get RINEX version
+* @param[I]: none
+* @param[O]: none
+* @return  : RINEX version (i.e., 2.11, 3.04)
+* @note    :
+**/
+double RnxUtil::Version() const
+{
+    return _ver;
+} /* end of Version */
+
+/**
+* @brief   : Header - get the header lines read so far
+* @param[I]: none
+* @param[O]: none
+* @return  : header lines without line break
+* @note    :
+**/
+const std::vector<string> &RnxUtil::Header() const
+{
+    return _header;
+} /* end of Header */
+
+/**
+* @brief   : Epoch - get the current epoch
+* @param[I]: none
+* @param[O]: none
+* @return  : the current epoch
+* @note    :
+**/
+const RnxUtil::rnxepoch_t &RnxUtil::Epoch() const
+{
+    return _epoch;
+} /* end of Epoch */
+
+/**
+* @brief   : ObsTypes - get the observation types of a system
+* @param[I]: sys (system, i.e., 'G', 'R', 'E', 'C', 'J', 'I', 'S')
+* @param[O]: none
+* @return  : observation types (2-character for RINEX 2, 3-character for RINEX 3)
+* @note    : the common list is returned for RINEX 2; only the selected types if the filter is set
+**/
+const std::vector<string> &RnxUtil::ObsTypes(char sys) const
+{
+    if (!Filtered()) return AllTypes(sys);
+
+    static const std::vector<string> none;
+    std::map<char, std::vector<string> >::const_iterator it = _selObsTypes.find(_ver < 3.0 ? ' ' : sys);
+
+    return it == _selObsTypes.end() ? none : it->second;
+} /* end of ObsTypes */
+
+/**
+* @brief   : SatSys - get the system of a satellite ID
+* @param[I]: sat (satellite ID, i.e., "G01", " 01")
+* @param[O]: none
+* @return  : system character ('G' for blank)
+* @note    :
+**/
+char RnxUtil::SatSys(const string &sat)
+{
+    if (sat.empty() || sat[0] == ' ') return 'G';
+
+    return sat[0];
+} /* end of SatSys */
+
+/**
+* @brief   : SetFilter - set the systems and observation types to keep
+* @param[I]: sys (systems, i.e., "GE"; "all" or "": all)
+* @param[I]: types (observation types or their prefixes separated by blank, '+' or ',', i.e., "C1C L1C C5Q L5Q";
+*                   "all" or "": all)
+* @param[O]: none
+* @return  : none
+* @note    : to be called before the first line is input
+**/
+void RnxUtil::SetFilter(const char *sys, const char *types)
+{
+    _selSys.clear();
+    _selTypes.clear();
+    if (sys && strcasecmp(sys, "all") != 0)
+    {
+        for (const char *p = sys; *p; p++)
+        {
+            char c = (char)toupper(*p);
+            if (strchr("GRECJIS", c) && _selSys.find(c) == string::npos) _selSys.push_back(c);
+        }
+    }
+    if (types && strcasecmp(types, "all") != 0)
+    {
+        string item;
+        for (const char *p = types; ; p++)
+        {
+            if (*p == '\0' || *p == ' ' || *p == '+' || *p == ',' || *p == '\t')
+            {
+                if (!item.empty()) _selTypes.push_back(item);
+                item.clear();
+                if (*p == '\0') break;
+            }
+            else item.push_back((char)toupper(*p));
+        }
+    }
+} /* end of SetFilter */
+
+/**
+* @brief   : Filtered - whether the filter is set
+* @param[I]: none
+* @param[O]: none
+* @return  : true: set, false: not set
+* @note    :
+**/
+bool RnxUtil::Filtered() const
+{
+    return !_selSys.empty() || !_selTypes.empty();
+} /* end of Filtered */
+
+/**
+* @brief   : WriteHeader - write the header, rewritten for the filter
+* @param[I]: none
+* @param[O]: buff (the header lines with line break are appended)
+* @return  : none
+* @note    : to be called after RNX_ENDHDR
+**/
+void RnxUtil::WriteHeader(string &buff) const
+{
+    std::vector<string> lines;
+    if (Filtered()) FilterHeader(_header, lines);
+    else lines = _header;
+    for (int i = 0; i < lines.size(); i++) buff += lines[i] + "\n";
+} /* end of WriteHeader */
+
+/**
+* @brief   : WriteEpoch - write the current epoch, rewritten for the filter
+* @param[I]: none
+* @param[O]: buff (the epoch lines with line break are appended)
+* @return  : none
+* @note    : to be called after RNX_EPOCH
+**/
+void RnxUtil::WriteEpoch(string &buff) const
+{
+    const rnxepoch_t &epoch = _epoch;
+    int npos = _ver >= 3.0 ? 32 : 29;  /* position of the number of satellites or special records */
+    char snum[16];
+    string line = epoch.line;
+    if (line.size() < npos + 3) line.resize(npos + 3, ' ');
+
+    /* special records */
+    if (epoch.flag > 1 && epoch.flag < 6)
+    {
+        std::vector<string> events;
+        if (Filtered() && epoch.flag == 4) FilterHeader(epoch.events, events);
+        else events = epoch.events;
+        sprintf(snum, "%3d", (int)events.size());
+        line.replace(npos, 3, snum);
+        buff += line + "\n";
+        for (int i = 0; i < events.size(); i++) buff += events[i] + "\n";
+
+        return;
+    }
+
+    sprintf(snum, "%3d", (int)epoch.sats.size());
+    if (_ver >= 3.0)
+    {
+        line.replace(npos, 3, snum);
+        buff += line + "\n";
+        for (int i = 0; i < epoch.sats.size(); i++)
+        {
+            string rec = epoch.sats[i].sat;
+            for (int j = 0; j < epoch.sats[i].fields.size(); j++) rec += epoch.sats[i].fields[j];
+            while (!rec.empty() && rec.back() == ' ') rec.pop_back();
+            buff += rec + "\n";
+        }
+
+        return;
+    }
+
+    /* RINEX 2: satellite list of 12 per line, observations of 5 per line */
+    line = line.substr(0, npos) + snum;
+    for (int i = 0; i < epoch.sats.size() || i == 0; i += NSATLINE2)
+    {
+        if (i > 0) line = string(32, ' ');
+        for (int j = i; j < i + NSATLINE2 && j < epoch.sats.size(); j++) line += epoch.sats[j].sat;
+        if (i == 0 && !epoch.clk.empty())
+        {
+            line.resize(68, ' ');
+            line += epoch.clk;
+        }
+        buff += line + "\n";
+    }
+    for (int i = 0; i < epoch.sats.size(); i++)
+    {
+        const std::vector<string> &fields = epoch.sats[i].fields;
+        for (int j = 0; j < fields.size() || j == 0; j += NOBSLINE2)
+        {
+            string rec;
+            for (int k = j; k < j + NOBSLINE2 && k < fields.size(); k++) rec += fields[k];
+            while (!rec.empty() && rec.back() == ' ') rec.pop_back();
+            buff += rec + "\n";
+        }
+    }
+} /* end of WriteEpoch */
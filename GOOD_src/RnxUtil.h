@@ -0,0 +1,249 @@
+/*------------------------------------------------------------------------------
+* RnxUtil.h : header file of RnxUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+
+/* return values of RnxUtil::InputLine ---------------------------------------*/
+#define RNX_NONE     0            /* line consumed, nothing complete yet */
+#define RNX_HEADER   1            /* header line (other than 'END OF HEADER') */
+#define RNX_ENDHDR   2            /* 'END OF HEADER' line */
+#define RNX_EPOCH    3            /* one epoch (epoch line + satellite or special records) complete */
+#define RNX_ERROR   -1            /* format error */
+
+#define MAXRNXLEN    4096         /* maximum characters in one RINEX line */
+
+class RnxUtil
+{
+public:
+    struct rnxsat_t
+    {                                     /* observation record of one satellite */
+        string sat;                       /* satellite ID as written in the file (i.e., "G01", " 01") */
+        std::vector<string> fields;       /* 16-character observation fields (F14.3, LLI, SNR) */
+    };
+
+    struct rnxepoch_t
+    {                                     /* one observation epoch */
+        string line;                      /* the first epoch line as written in the file */
+        gtime_t time;                     /* epoch time */
+        int flag;                         /* epoch flag (0: OK  1: power failure  2-5: event  6: cycle slip) */
+        int nsat;                         /* number of satellites or special records */
+        string clk;                       /* receiver clock offset as written in the file (may be empty) */
+        std::vector<rnxsat_t> sats;       /* satellite records (epoch flag 0, 1 or 6) */
+        std::vector<string> events;       /* special records (epoch flag 2-5) */
+    };
+
+private:
+    int _state;                           /* 0: header  1: epoch line  2: RINEX 2 satellite list  3: satellite records  4: special records */
+    double _ver;                          /* RINEX version */
+    char _lastSys;                        /* the system of the last 'SYS / # / OBS TYPES' line */
+    std::map<char, std::vector<string> > _obsTypes;  /* observation types of each system (' ' for RINEX 2) */
+    std::vector<string> _header;          /* header lines */
+    rnxepoch_t _epoch;                    /* the current epoch */
+    int _nrem;                            /* the number of remaining records of the current epoch */
+    int _nline;                           /* the number of lines read of the current RINEX 2 satellite record */
+    string _selSys;                       /* selected systems (empty: all) */
+    std::vector<string> _selTypes;        /* selected observation types or their prefixes (empty: all) */
+    std::map<char, std::vector<int> > _selIdx;          /* indexes of the selected observation types of each system */
+    std::map<char, std::vector<string> > _selObsTypes;  /* selected observation types of each system */
+
+    /**
+    * @brief   : ParseHeader - parse one header line
+    * @param[I]: line (header line without line break)
+    * @param[O]: none
+    * @return  : true: 'END OF HEADER', false: others
+    * @note    :
+    **/
+    bool ParseHeader(const string &line);
+
+    /**
+    * @brief   : ParseEpoch - parse the first epoch line
+    * @param[I]: line (epoch line without line break)
+    * @param[O]: none
+    * @return  : true:ok, false:error
+    * @note    :
+    **/
+    bool ParseEpoch(const string &line);
+
+    /**
+    * @brief   : AddFields - split the observation part of a line into 16-character fields
+    * @param[I]: line (observation line without line break)
+    * @param[I]: pos (start position of the first field)
+    * @param[I]: nmax (maximum number of fields)
+    * @param[O]: fields (observation fields)
+    * @return  : none
+    * @note    :
+    **/
+    void AddFields(const string &line, int pos, int nmax, std::vector<string> &fields);
+
+    /**
+    * @brief   : AllTypes - get all the observation types of a system in the file
+    * @param[I]: sys (system, i.e., 'G', 'R', 'E', 'C', 'J', 'I', 'S')
+    * @param[O]: none
+    * @return  : observation types
+    * @note    : the common list is returned for RINEX 2
+    **/
+    const std::vector<string> &AllTypes(char sys) const;
+
+    /**
+    * @brief   : SysSelected - whether a system passes the filter
+    * @param[I]: sys (system)
+    * @param[O]: none
+    * @return  : true: selected, false: dropped
+    * @note    :
+    **/
+    bool SysSelected(char sys) const;
+
+    /**
+    * @brief   : TypeSelected - whether an observation type passes the filter
+    * @param[I]: type (observation type, i.e., "L1C" or "L1")
+    * @param[O]: none
+    * @return  : true: selected, false: dropped
+    * @note    : a selected item matches the types it is the prefix of, i.e., "L1" matches "L1C" and "L1W",
+    *            and "L1C" matches "L1" of RINEX 2
+    **/
+    bool TypeSelected(const string &type) const;
+
+    /**
+    * @brief   : UpdateSel - update the selected observation types of each system
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : called at the end of header and after the header information is changed by an event
+    **/
+    void UpdateSel();
+
+    /**
+    * @brief   : EndEpoch - finish the current epoch, the filter being applied
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : RNX_EPOCH
+    * @note    :
+    **/
+    int EndEpoch();
+
+    /**
+    * @brief   : TypesLines - format the observation types header lines of a system
+    * @param[I]: sys (system, ' ' for RINEX 2)
+    * @param[I]: types (observation types)
+    * @param[O]: lines (header lines)
+    * @return  : none
+    * @note    :
+    **/
+    void TypesLines(char sys, const std::vector<string> &types, std::vector<string> &lines) const;
+
+    /**
+    * @brief   : FilterHeader - rewrite header lines for the selected systems and observation types
+    * @param[I]: in (header lines)
+    * @param[O]: out (rewritten header lines)
+    * @return  : none
+    * @note    : 'PRN / # OF OBS' and '# OF SATELLITES' are dropped since they are no longer valid
+    **/
+    void FilterHeader(const std::vector<string> &in, std::vector<string> &out) const;
+
+public:
+    RnxUtil()
+    {
+        _state = 0;
+        _ver = 0.0;
+        _lastSys = ' ';
+        _nrem = 0;
+        _nline = 0;
+    }
+    ~RnxUtil()
+    {
+
+    }
+
+    /**
+    * @brief   : InputLine - input one line of RINEX observation file
+    * @param[I]: line (RINEX line with or without line break)
+    * @param[O]: none
+    * @return  : RNX_NONE, RNX_HEADER, RNX_ENDHDR, RNX_EPOCH or RNX_ERROR
+    * @note    : after RNX_EPOCH the complete epoch is available via Epoch()
+    **/
+    int InputLine(const char *line);
+
+    /**
+    * @brief   : Version - get RINEX version
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : RINEX version (i.e., 2.11, 3.04)
+    * @note    :
+    **/
+    double Version() const;
+
+    /**
+    * @brief   : Header - get the header lines read so far
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : header lines without line break
+    * @note    :
+    **/
+    const std::vector<string> &Header() const;
+
+    /**
+    * @brief   : Epoch - get the current epoch
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : the current epoch
+    * @note    :
+    **/
+    const rnxepoch_t &Epoch() const;
+
+    /**
+    * @brief   : ObsTypes - get the observation types of a system
+    * @param[I]: sys (system, i.e., 'G', 'R', 'E', 'C', 'J', 'I', 'S')
+    * @param[O]: none
+    * @return  : observation types (2-character for RINEX 2, 3-character for RINEX 3)
+    * @note    : the common list is returned for RINEX 2; only the selected types if the filter is set
+    **/
+    const std::vector<string> &ObsTypes(char sys) const;
+
+    /**
+    * @brief   : SetFilter - set the systems and observation types to keep
+    * @param[I]: sys (systems, i.e., "GE"; "all" or "": all)
+    * @param[I]: types (observation types or their prefixes separated by blank, '+' or ',', i.e., "C1C L1C C5Q L5Q";
+    *                   "all" or "": all)
+    * @param[O]: none
+    * @return  : none
+    * @note    : to be called before the first line is input
+    **/
+    void SetFilter(const char *sys, const char *types);
+
+    /**
+    * @brief   : Filtered - whether the filter is set
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: set, false: not set
+    * @note    :
+    **/
+    bool Filtered() const;
+
+    /**
+    * @brief   : WriteHeader - write the header, rewritten for the filter
+    * @param[I]: none
+    * @param[O]: buff (the header lines with line break are appended)
+    * @return  : none
+    * @note    : to be called after RNX_ENDHDR
+    **/
+    void WriteHeader(string &buff) const;
+
+    /**
+    * @brief   : WriteEpoch - write the current epoch, rewritten for the filter
+    * @param[I]: none
+    * @param[O]: buff (the epoch lines with line break are appended)
+    * @return  : none
+    * @note    : to be called after RNX_EPOCH
+    **/
+    void WriteEpoch(string &buff) const;
+
+    /**
+    * @brief   : SatSys - get the system of a satellite ID
+    * @param[I]: sat (satellite ID, i.e., "G01", " 01")
+    * @param[O]: none
+    * @return  : system character ('G' for blank)
+    * @note    :
+    **/
+    static char SatSys(const string &sat);
+};
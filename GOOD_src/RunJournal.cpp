@@ -0,0 +1,433 @@
+/*------------------------------------------------------------------------------
+* RunJournal.cpp : write-ahead journal of the (day, product) jobs of a run, for resuming where it stopped
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : a run of many days walks all the days again after a crash, creating their directories, checking their
+*           files and, for the 'all' sites, listing the complete remote directories again. The jobs of a run are
+*           planned in the journal next to the log file (i.e., 'GOOD.log' -> 'GOOD.journal'), and each job is
+*           recorded as started before any of its downloads and as done or unfinished at its end, each record being
+*           flushed to the disk. A restart of the same configuration loads the last record of each job into a hash
+*           table and skips the jobs done, so only the jobs in flight at the crash, unfinished or pending are run.
+*           A run that reaches its end records so, and the run after it starts a new journal, so that the files not
+*           published yet or removed locally are asked for again as before. The journal is compacted to one record per job when it is opened, and its progress is printed by
+*           'run_GOOD -journal GOOD.journal', also while the run is going on.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "StringUtil.h"
+#include "TimeUtil.h"
+#include "RunJournal.h"
+#include <ctime>
+#include <map>
+#ifdef _WIN32  /* for Windows */
+#include <io.h>
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : ProdName - the name of a product in PRODPRI_NAMES
+* @param[I]: iprod (product, i.e., PRI_OBS)
+* @param[O]: none
+* @return  : name, i.e., "obs"
+* @note    :
+**/
+static string ProdName(int iprod)
+{
+    static std::vector<string> names;
+    if (names.empty())
+    {
+        StringUtil str;
+        str.GetSubStr(PRODPRI_NAMES, " ", names);
+    }
+
+    return iprod >= 0 && iprod < names.size() ? names[iprod] : "-";
+} /* end of ProdName */
+
+/**
+* @brief   : Key - the key of a (day, product) job
+* @param[I]: ts (the day)
+* @param[I]: prod (product in PRODPRI_NAMES, i.e., "nav")
+* @param[O]: none
+* @return  : 'yyyy ddd prod'
+* @note    :
+**/
+string RunJournal::Key(gtime_t ts, const string &prod)
+{
+    TimeUtil tu;
+    daydesc_t day;
+    tu.DayDesc(ts, day);
+
+    return string(day.sYyyy) + " " + day.sDoy + " " + prod;
+} /* end of Key */
+
+/**
+* @brief   : Load - load a journal
+* @param[I]: file (path of the journal)
+* @param[O]: jobs (the jobs, the last record of each one wins)
+* @param[O]: sig (signature of the configuration of the last run, "": none)
+* @param[O]: trun (start time of the last run, 0: none)
+* @param[O]: complete (whether the last run ran to its end)
+* @return  : number of the records read
+* @note    : a line cut by a crash is dropped
+**/
+int RunJournal::Load(const string &file, std::unordered_map<string, job_t> &jobs, string &sig, long long &trun,
+    bool &complete)
+{
+    jobs.clear();
+    sig = "";
+    trun = 0;
+    complete = false;
+    FILE *fp = fopen(file.c_str(), "r");
+    if (!fp) return 0;
+
+    int n = 0;
+    char line[MAXCHARS], str[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        if (strchr(line, '\n') == nullptr) continue;
+        job_t job;
+        int yyyy, doy;
+        if (line[0] == JOB_RUN)
+        {
+            if (sscanf(line, "%*c %s %lld", str, &job.time) != 2) continue;
+            sig = str;
+            trun = job.time;
+            complete = false;
+        }
+        else if (line[0] == JOB_COMPLETE) complete = true;
+        else
+        {
+            if (sscanf(line, "%c %d %d %s %lld", &job.flag, &yyyy, &doy, str, &job.time) != 5) continue;
+            char key[MAXCHARS];
+            sprintf(key, "%04d %03d %s", yyyy, doy, str);
+            jobs[key] = job;
+        }
+        n++;
+    }
+    fclose(fp);
+
+    return n;
+} /* end of Load */
+
+/**
+* @brief   : Append - append one record and flush it to the disk
+* @param[I]: flag (JOB_PLANNED, ...)
+* @param[I]: key (key of the job)
+* @param[I]: sync (whether to wait for the disk)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void RunJournal::Append(char flag, const string &key, bool sync)
+{
+    if (!_fp) return;
+
+    job_t &job = _jobs[key];
+    job.flag = flag;
+    job.time = (long long)time(nullptr);
+    fprintf(_fp, "%c %s %lld\n", flag, key.c_str(), job.time);
+    if (sync) Sync();
+} /* end of Append */
+
+/**
+* @brief   : Sync - flush the records appended to the disk
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void RunJournal::Sync()
+{
+    if (!_fp) return;
+
+    fflush(_fp);
+#ifdef _WIN32   /* for Windows */
+    _commit(_fileno(_fp));
+#else           /* for Linux or Mac */
+    fsync(fileno(_fp));
+#endif
+} /* end of Sync */
+
+/**
+* @brief   : Signature - the signature of a configuration file
+* @param[I]: cfgFile (configure file with full path)
+* @param[O]: none
+* @return  : FNV-1a hash of its content in hex, "": not read
+* @note    :
+**/
+string RunJournal::Signature(const char *cfgFile)
+{
+    FILE *fp = fopen(cfgFile, "rb");
+    if (!fp) return "";
+
+    unsigned long long h = 14695981039346656037ULL;
+    int c;
+    while ((c = fgetc(fp)) != EOF)
+    {
+        h ^= (unsigned char)c;
+        h *= 1099511628211ULL;
+    }
+    fclose(fp);
+    char sig[32];
+    sprintf(sig, "%016llx", h);
+
+    return sig;
+} /* end of Signature */
+
+/**
+* @brief   : Open - open the journal next to the log file and compact it
+* @param[I]: fopt (FTP options)
+* @param[I]: cfgFile (configure file with full path)
+* @param[O]: none
+* @return  : true: opened, false: off
+* @note    : off without a log file or in the distributed mode, where the '.done' leases play its part; the
+*            journal of a changed configuration is started anew
+**/
+bool RunJournal::Open(const ftpopt_t *fopt, const char *cfgFile)
+{
+    if (!fopt->journal || fopt->distributed || strlen(fopt->logFil) == 0) return false;
+
+    /* i.e., 'GOOD.log' -> 'GOOD.journal' */
+    string log = fopt->logFil;
+    size_t isep = log.find_last_of("/\\"), idot = log.find_last_of('.');
+    _file = idot != string::npos && (isep == string::npos || idot > isep) ? log.substr(0, idot) : log;
+    _file += JOURNAL_SUFFIX;
+
+    string sig0, sig = Signature(cfgFile);
+    if (sig.empty()) sig = "-";
+    long long trun = 0;
+    bool complete = false;
+    if (Load(_file, _jobs, sig0, trun, complete) > 0 && (complete || sig0 != sig))
+    {
+        /* only a stopped run is resumed, a run after a complete one asks again for the files still missing */
+        if (fopt->fpLog) fprintf(fopt->fpLog, "* INFO(RunJournal): %s, %s is started anew\n", complete ? "the last run "
+            "ran to its end" : "the configuration has changed", _file.c_str());
+        _jobs.clear();
+    }
+
+    /* compacted to one record per job in the order of the days, written to a temporary file and renamed */
+    std::map<string, job_t> jobs(_jobs.begin(), _jobs.end());
+    string tmp = _file + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "w");
+    if (!fp)
+    {
+        cerr << "*** ERROR(RunJournal::Open): failed to open " << tmp << endl;
+
+        return false;
+    }
+    int nstart = 0, nunfin = 0;
+    fprintf(fp, "%c %s %lld\n", JOB_RUN, sig.c_str(), (long long)time(nullptr));
+    for (auto it = jobs.begin(); it != jobs.end(); ++it)
+    {
+        fprintf(fp, "%c %s %lld\n", it->second.flag, it->first.c_str(), it->second.time);
+        if (it->second.flag == JOB_DONE) _nskip++;
+        else if (it->second.flag == JOB_STARTED) nstart++;
+        else if (it->second.flag == JOB_UNFINISHED) nunfin++;
+    }
+    fclose(fp);
+    remove(_file.c_str());  /* 'rename' does not replace a file on Windows */
+    if (rename(tmp.c_str(), _file.c_str()) != 0 || !(_fp = fopen(_file.c_str(), "a")))
+    {
+        cerr << "*** ERROR(RunJournal::Open): failed to write " << _file << endl;
+
+        return false;
+    }
+    if (fopt->fpLog && nstart + nunfin > 0) fprintf(fopt->fpLog, "* INFO(RunJournal): %d jobs stopped in flight and %d "
+        "left unfinished by the previous runs are replayed\n", nstart, nunfin);
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Plan - record the jobs planned for the days and the products, if not known yet
+* @param[I]: days (the days)
+* @param[I]: iprods (the products, i.e., PRI_OBS)
+* @param[O]: none
+* @return  : none
+* @note    : flushed to the disk once
+**/
+void RunJournal::Plan(const std::vector<daydesc_t> &days, const std::vector<int> &iprods)
+{
+    if (!_fp) return;
+
+    for (int i = 0; i < days.size(); i++)
+    {
+        for (int j = 0; j < iprods.size(); j++)
+        {
+            string key = Key(days[i].t, ProdName(iprods[j]));
+            if (_jobs.find(key) == _jobs.end()) Append(JOB_PLANNED, key, false);
+        }
+    }
+    Sync();
+} /* end of Plan */
+
+/**
+* @brief   : Done - whether a job was done
+* @param[I]: ts (the day)
+* @param[I]: iprod (product, i.e., PRI_OBS)
+* @param[O]: none
+* @return  : true: done, false: not, or the journal is off
+* @note    :
+**/
+bool RunJournal::Done(gtime_t ts, int iprod) const
+{
+    if (!_fp) return false;
+
+    auto it = _jobs.find(Key(ts, ProdName(iprod)));
+
+    return it != _jobs.end() && it->second.flag == JOB_DONE;
+} /* end of Done */
+
+/**
+* @brief   : Begin - record the start of a job, before any of its downloads
+* @param[I]: ts (the day)
+* @param[I]: iprod (product, i.e., PRI_OBS)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void RunJournal::Begin(gtime_t ts, int iprod)
+{
+    Append(JOB_STARTED, Key(ts, ProdName(iprod)), true);
+} /* end of Begin */
+
+/**
+* @brief   : End - record the end of a job
+* @param[I]: ts (the day)
+* @param[I]: iprod (product, i.e., PRI_OBS)
+* @param[I]: ok (false: left unfinished by the transient failures, replayed by the next run)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void RunJournal::End(gtime_t ts, int iprod, bool ok)
+{
+    if (!_fp) return;
+
+    Append(ok ? JOB_DONE : JOB_UNFINISHED, Key(ts, ProdName(iprod)), true);
+    if (ok) _ndone++;
+} /* end of End */
+
+/**
+* @brief   : Reopen - record a job done before as unfinished, so that it is run again
+* @param[I]: ts (the day)
+* @param[I]: prod (product in PRODPRI_NAMES, i.e., "nav")
+* @param[O]: none
+* @return  : none
+* @note    : for the jobs of 'retry.list'
+**/
+void RunJournal::Reopen(gtime_t ts, const string &prod)
+{
+    string key = Key(ts, prod);
+    auto it = _jobs.find(key);
+    if (it == _jobs.end() || it->second.flag != JOB_DONE) return;
+    Append(JOB_UNFINISHED, key, true);
+    _nskip--;
+} /* end of Reopen */
+
+/**
+* @brief   : Complete - record the end of the run, so that the next run starts anew
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the next run asks again for the files not published yet or removed locally
+**/
+void RunJournal::Complete()
+{
+    if (!_fp) return;
+
+    fprintf(_fp, "%c %lld\n", JOB_COMPLETE, (long long)time(nullptr));
+    Sync();
+} /* end of Complete */
+
+/**
+* @brief   : Progress - print the progress of a run from its journal
+* @param[I]: file (path of the journal)
+* @param[O]: none
+* @return  : number of the jobs, -1: error
+* @note    : the journal may be written by a running process at the same time
+**/
+int RunJournal::Progress(const char *file)
+{
+    std::unordered_map<string, job_t> jobs;
+    string sig;
+    long long trun = 0;
+    bool complete = false;
+    if (Load(file, jobs, sig, trun, complete) == 0)
+    {
+        cout << "*** ERROR(RunJournal::Progress): no journal in " << file << endl;
+
+        return -1;
+    }
+
+    /* numbers of the jobs planned, started, done and unfinished of each product */
+    std::map<string, std::map<char, int> > counts;
+    std::map<char, int> total;
+    int nrun = 0;
+    long long tlast = trun;
+    string last;
+    for (auto it = jobs.begin(); it != jobs.end(); ++it)
+    {
+        string prod = it->first.substr(it->first.find_last_of(' ') + 1);
+        counts[prod][it->second.flag]++;
+        total[it->second.flag]++;
+        if (it->second.flag != JOB_DONE || it->second.time < trun) continue;
+        nrun++;
+        if (it->second.time >= tlast)
+        {
+            tlast = it->second.time;
+            last = it->first;
+        }
+    }
+    int njob = (int)jobs.size(), ndone = total[JOB_DONE];
+    for (auto it = counts.begin(); it != counts.end(); ++it)
+    {
+        std::map<char, int> &c = it->second;
+        int n = c[JOB_PLANNED] + c[JOB_STARTED] + c[JOB_DONE] + c[JOB_UNFINISHED];
+        printf("%-6s  %5d of %5d done  %5d in flight  %5d unfinished  %5d pending\n", it->first.c_str(), c[JOB_DONE], n,
+            c[JOB_STARTED], c[JOB_UNFINISHED], c[JOB_PLANNED]);
+    }
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d of %d (day, product) jobs done (%.1f%%), %d in flight, %d unfinished, %d pending", ndone, njob,
+        njob > 0 ? 100.0 * ndone / njob : 0.0, total[JOB_STARTED], total[JOB_UNFINISHED], total[JOB_PLANNED]);
+    cout << "*** INFO(RunJournal::Progress): " << buff << endl;
+    if (nrun > 0 && tlast > trun)
+    {
+        /* the rate of the last run */
+        double perJob = (double)(tlast - trun) / nrun;
+        char at[32] = { '\0' };
+        time_t t = (time_t)tlast;
+        strftime(at, sizeof(at), "%Y/%m/%d %H:%M:%S", gmtime(&t));
+        sprintf(buff, "last done: %s at %s, %.1f s per job in the last run, about %.1f h to go", last.c_str(), at, perJob,
+            perJob * (njob - ndone) / 3600.0);
+        cout << "*** INFO(RunJournal::Progress): " << buff << endl;
+    }
+    if (complete) cout << "*** INFO(RunJournal::Progress): the run ran to its end, the next one starts anew" << endl;
+
+    return njob;
+} /* end of Progress */
+
+/**
+* @brief   : Report - report the jobs skipped and done
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void RunJournal::Report(FILE *fpLog) const
+{
+    if (!_fp) return;
+
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d (day, product) jobs done by the previous runs skipped, %d done in this run (%s)", _nskip, _ndone,
+        _file.c_str());
+    cout << "*** INFO(RunJournal::Report): " << buff << endl;
+    if (fpLog) fprintf(fpLog, "* INFO(RunJournal): %s\n", buff);
+} /* end of Report */
@@ -0,0 +1,193 @@
+/*------------------------------------------------------------------------------
+* RunJournal.h : header file of RunJournal.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <unordered_map>
+
+#define JOURNAL_SUFFIX ".journal"        /* suffix of the run journal next to the log file, 'flag yyyy ddd prod time' */
+#define JOB_PLANNED    'P'               /* a job planned, not started yet */
+#define JOB_STARTED    'S'               /* a job started, in flight or stopped by a crash */
+#define JOB_DONE       'D'               /* a job finished */
+#define JOB_UNFINISHED 'U'               /* a job left unfinished by the transient failures */
+#define JOB_RUN        'R'               /* the start of a run, 'R signature time' */
+#define JOB_COMPLETE   'C'               /* the end of a run that was not stopped, 'C time' */
+
+class RunJournal
+{
+private:
+    struct job_t
+    {                                     /* the last record of one (day, product) job */
+        char flag;                        /* JOB_PLANNED, JOB_STARTED, JOB_DONE or JOB_UNFINISHED */
+        long long time;                   /* time of the record (s since 1970-01-01 UTC) */
+    };
+
+    std::unordered_map<string, job_t> _jobs;  /* jobs, key: 'yyyy ddd prod' */
+    string _file;                         /* path of the journal, "": off */
+    FILE *_fp;                            /* the journal opened for appending */
+    int _nskip, _ndone;                   /* numbers of the jobs done by the previous runs (skipped) and done in this run */
+
+    /**
+    * @brief   : Key - the key of a (day, product) job
+    * @param[I]: ts (the day)
+    * @param[I]: prod (product in PRODPRI_NAMES, i.e., "nav")
+    * @param[O]: none
+    * @return  : 'yyyy ddd prod'
+    * @note    :
+    **/
+    static string Key(gtime_t ts, const string &prod);
+
+    /**
+    * @brief   : Load - load a journal
+    * @param[I]: file (path of the journal)
+    * @param[O]: jobs (the jobs, the last record of each one wins)
+    * @param[O]: sig (signature of the configuration of the last run, "": none)
+    * @param[O]: trun (start time of the last run, 0: none)
+    * @param[O]: complete (whether the last run ran to its end)
+    * @return  : number of the records read
+    * @note    : a line cut by a crash is dropped
+    **/
+    static int Load(const string &file, std::unordered_map<string, job_t> &jobs, string &sig, long long &trun,
+        bool &complete);
+
+    /**
+    * @brief   : Append - append one record and flush it to the disk
+    * @param[I]: flag (JOB_PLANNED, ...)
+    * @param[I]: key (key of the job)
+    * @param[I]: sync (whether to wait for the disk)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Append(char flag, const string &key, bool sync);
+
+    /**
+    * @brief   : Sync - flush the records appended to the disk
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Sync();
+
+public:
+    RunJournal()
+    {
+        _fp = nullptr;
+        _nskip = _ndone = 0;
+    }
+    ~RunJournal()
+    {
+        if (_fp) fclose(_fp);
+    }
+
+    /**
+    * @brief   : Signature - the signature of a configuration file
+    * @param[I]: cfgFile (configure file with full path)
+    * @param[O]: none
+    * @return  : FNV-1a hash of its content in hex, "": not read
+    * @note    :
+    **/
+    static string Signature(const char *cfgFile);
+
+    /**
+    * @brief   : Open - open the journal next to the log file and compact it
+    * @param[I]: fopt (FTP options)
+    * @param[I]: cfgFile (configure file with full path)
+    * @param[O]: none
+    * @return  : true: opened, false: off
+    * @note    : off without a log file or in the distributed mode, where the '.done' leases play its part; the
+    *            journal of a run that ran to its end or of a changed configuration is started anew, so only a run
+    *            stopped by a crash or a kill is resumed
+    **/
+    bool Open(const ftpopt_t *fopt, const char *cfgFile);
+
+    /**
+    * @brief   : On - whether the journal is used
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    bool On() const
+    {
+        return _fp != nullptr;
+    }
+
+    /**
+    * @brief   : Plan - record the jobs planned for the days and the products, if not known yet
+    * @param[I]: days (the days)
+    * @param[I]: iprods (the products, i.e., PRI_OBS)
+    * @param[O]: none
+    * @return  : none
+    * @note    : flushed to the disk once
+    **/
+    void Plan(const std::vector<daydesc_t> &days, const std::vector<int> &iprods);
+
+    /**
+    * @brief   : Done - whether a job was done
+    * @param[I]: ts (the day)
+    * @param[I]: iprod (product, i.e., PRI_OBS)
+    * @param[O]: none
+    * @return  : true: done, false: not, or the journal is off
+    * @note    :
+    **/
+    bool Done(gtime_t ts, int iprod) const;
+
+    /**
+    * @brief   : Begin - record the start of a job, before any of its downloads
+    * @param[I]: ts (the day)
+    * @param[I]: iprod (product, i.e., PRI_OBS)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Begin(gtime_t ts, int iprod);
+
+    /**
+    * @brief   : End - record the end of a job
+    * @param[I]: ts (the day)
+    * @param[I]: iprod (product, i.e., PRI_OBS)
+    * @param[I]: ok (false: left unfinished by the transient failures, replayed by the next run)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void End(gtime_t ts, int iprod, bool ok);
+
+    /**
+    * @brief   : Reopen - record a job done before as unfinished, so that it is run again
+    * @param[I]: ts (the day)
+    * @param[I]: prod (product in PRODPRI_NAMES, i.e., "nav")
+    * @param[O]: none
+    * @return  : none
+    * @note    : for the jobs of 'retry.list'
+    **/
+    void Reopen(gtime_t ts, const string &prod);
+
+    /**
+    * @brief   : Complete - record the end of the run, so that the next run starts anew
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the next run asks again for the files not published yet or removed locally
+    **/
+    void Complete();
+
+    /**
+    * @brief   : Progress - print the progress of a run from its journal
+    * @param[I]: file (path of the journal)
+    * @param[O]: none
+    * @return  : number of the jobs, -1: error
+    * @note    : the journal may be written by a running process at the same time
+    **/
+    static int Progress(const char *file);
+
+    /**
+    * @brief   : Report - report the jobs skipped and done
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Report(FILE *fpLog) const;
+};
@@ -0,0 +1,219 @@
+/*------------------------------------------------------------------------------
+* S3Client.cpp : listing and parallel downloading of the objects of an S3 bucket via libcurl
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    Amazon Simple Storage Service API Reference, ListObjectsV2
+*
+* notes   : a public bucket (i.e., the NOAA CORS archive 'noaa-cors-pds') is listed anonymously by ListObjectsV2 with a
+*           prefix, 1000 keys a page, so the files of all the sites of one day are known after a few requests. The
+*           objects are then downloaded by a pool of parallel transfers (HttpPool), whose connections are kept alive
+*           and reused. Any S3-compatible server (i.e., MinIO) can stand in for the bucket
+*           with a path-style endpoint. Without libcurl (GOOD_USE_CURL undefined), the backend is not available and
+*           the callers fall back to 'wget'.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "RetryPolicy.h"
+#include "S3Client.h"
+#ifdef GOOD_USE_CURL
+#include <curl/curl.h>
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+#ifdef GOOD_USE_CURL
+/**
+* @brief   : WriteStr - the callback of libcurl appending the data to a string
+* @param[I]: ptr (data)
+* @param[I]: size (1)
+* @param[I]: nmemb (number of bytes)
+* @param[O]: userdata (string)
+* @return  : number of bytes taken
+* @note    :
+**/
+static size_t WriteStr(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    ((string *)userdata)->append(ptr, size * nmemb);
+
+    return size * nmemb;
+} /* end of WriteStr */
+
+/**
+* @brief   : InitCurl - the global initialization of libcurl, once
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+static void InitCurl()
+{
+    static bool init = false;
+    if (init) return;
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    init = true;
+} /* end of InitCurl */
+#endif
+
+/**
+* @brief   : S3Client - a client of one bucket
+* @param[I]: endpoint (base URL of the bucket)
+* @param[I]: fopt (FTP options, for the number of connections and the limits of the transfers)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+S3Client::S3Client(const string &endpoint, const ftpopt_t *fopt) : _pool(fopt, fopt->s3Conns)
+{
+    _endpoint = endpoint;
+    while (!_endpoint.empty() && _endpoint.back() == '/') _endpoint.pop_back();
+    _connTimeout = fopt->connTimeout;
+    _lowSpeed = (long)fopt->lowSpeed;
+    _lowSpeedWin = fopt->lowSpeedWin;
+} /* end of S3Client */
+
+/**
+* @brief   : Available - whether the S3 backend is built in
+* @param[I]: none
+* @param[O]: none
+* @return  : true: built with libcurl, false: not
+* @note    :
+**/
+bool S3Client::Available()
+{
+#ifdef GOOD_USE_CURL
+    return true;
+#else
+    return false;
+#endif
+} /* end of Available */
+
+/**
+* @brief   : Tag - the text of the next element of a tag in an XML document
+* @param[I]: xml (XML document)
+* @param[I]: tag (tag, i.e., "Key")
+* @param[I/O]: pos (position to search from, moved after the element)
+* @return  : the text, "" if not found (then 'pos' is npos)
+* @note    :
+**/
+string S3Client::Tag(const string &xml, const string &tag, size_t &pos)
+{
+    string open = "<" + tag + ">", close = "</" + tag + ">";
+    size_t ibeg = xml.find(open, pos);
+    size_t iend = ibeg == string::npos ? string::npos : xml.find(close, ibeg);
+    if (iend == string::npos)
+    {
+        pos = string::npos;
+
+        return "";
+    }
+    ibeg += open.size();
+    pos = iend + close.size();
+
+    return xml.substr(ibeg, iend - ibeg);
+} /* end of Tag */
+
+/**
+* @brief   : List - list the objects under a prefix (ListObjectsV2)
+* @param[I]: prefix (key prefix, i.e., 'rinex/2024/032/')
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: objs (objects)
+* @return  : true: ok, false: error
+* @note    : the pages are followed by the continuation token on one kept-alive connection
+**/
+bool S3Client::List(const string &prefix, std::vector<s3obj_t> &objs, FILE *fpLog)
+{
+    objs.clear();
+#ifndef GOOD_USE_CURL
+    cerr << "*** ERROR(S3Client::List): GOOD is built without libcurl, the S3 backend is NOT available!" << endl;
+
+    return false;
+#else
+    InitCurl();
+    CURL *curl = curl_easy_init();
+    if (!curl) return false;
+
+    char *encPrefix = curl_easy_escape(curl, prefix.c_str(), 0);
+    string token, xml;
+    int npage = 0;
+    bool ok = true;
+    while (true)
+    {
+        string url = _endpoint + "/?list-type=2&prefix=" + encPrefix;
+        if (!token.empty())
+        {
+            char *encToken = curl_easy_escape(curl, token.c_str(), 0);
+            url += string("&continuation-token=") + encToken;
+            curl_free(encToken);
+        }
+        xml.clear();
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteStr);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &xml);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        if (_connTimeout > 0) curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, _connTimeout);
+        if (_lowSpeed > 0)
+        {
+            curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, _lowSpeed);
+            curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, _lowSpeedWin);
+        }
+        CURLcode rc = curl_easy_perform(curl);
+        long code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+        if (rc != CURLE_OK || code != 200)
+        {
+            if (fpLog) fprintf(fpLog, "* WARNING(S3Client): listing %s of %s failed (%s, HTTP %ld)\n", prefix.c_str(),
+                _endpoint.c_str(), rc != CURLE_OK ? curl_easy_strerror(rc) : "answered", code);
+            ok = false;
+            break;
+        }
+        npage++;
+
+        size_t pos = 0;
+        while (true)
+        {
+            string content = Tag(xml, "Contents", pos);
+            if (pos == string::npos) break;
+            size_t ipos = 0;
+            s3obj_t obj;
+            obj.key = Tag(content, "Key", ipos);
+            ipos = 0;
+            obj.size = atoll(Tag(content, "Size", ipos).c_str());
+            if (!obj.key.empty()) objs.push_back(obj);
+        }
+        pos = 0;
+        string truncated = Tag(xml, "IsTruncated", pos);
+        pos = 0;
+        token = Tag(xml, "NextContinuationToken", pos);
+        if (truncated != "true" || token.empty()) break;
+    }
+    curl_free(encPrefix);
+    curl_easy_cleanup(curl);
+
+    if (ok && fpLog) fprintf(fpLog, "* INFO(S3Client): %d objects under %s listed in %d pages\n", (int)objs.size(),
+        prefix.c_str(), npage);
+
+    return ok;
+#endif
+} /* end of List */
+
+/**
+* @brief   : GetAll - download objects in parallel
+* @param[I]: keys (keys of the objects)
+* @param[I]: files (local files, one for each key)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: stats (WGET_OK, WGET_PERMANENT or WGET_TRANSIENT of each object)
+* @return  : number of objects downloaded
+* @note    : the transfers are run by the pool of the client, see HttpPool::GetAll
+**/
+int S3Client::GetAll(const std::vector<string> &keys, const std::vector<string> &files, std::vector<int> &stats, FILE *fpLog)
+{
+    std::vector<string> urls(keys.size());
+    for (int i = 0; i < keys.size(); i++) urls[i] = _endpoint + "/" + keys[i];
+
+    return _pool.GetAll(urls, files, stats, fpLog);
+} /* end of GetAll */
@@ -0,0 +1,77 @@
+/*------------------------------------------------------------------------------
+* S3Client.h : header file of S3Client.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include "HttpPool.h"
+
+struct s3obj_t
+{                                         /* one object of a bucket */
+    string key;                           /* key, i.e., 'rinex/2024/032/algo/algo0320.24d.gz' */
+    long long size;                       /* size (bytes) */
+};
+
+class S3Client
+{
+private:
+    string _endpoint;                     /* base URL of the bucket, virtual-hosted ('https://bucket.s3.amazonaws.com') or
+                                             path style ('http://127.0.0.1:9000/bucket') */
+    long _connTimeout;                    /* connect timeout (s), 0: default */
+    long _lowSpeed;                       /* min average speed (B/s) over '_lowSpeedWin', 0: off */
+    long _lowSpeedWin;                    /* window of the average speed (s) */
+    HttpPool _pool;                       /* parallel transfers of the objects, up to 's3Conns' connections */
+
+    /**
+    * @brief   : Tag - the text of the next element of a tag in an XML document
+    * @param[I]: xml (XML document)
+    * @param[I]: tag (tag, i.e., "Key")
+    * @param[I/O]: pos (position to search from, moved after the element)
+    * @return  : the text, "" if not found (then 'pos' is npos)
+    * @note    :
+    **/
+    static string Tag(const string &xml, const string &tag, size_t &pos);
+
+public:
+    /**
+    * @brief   : S3Client - a client of one bucket
+    * @param[I]: endpoint (base URL of the bucket)
+    * @param[I]: fopt (FTP options, for the number of connections and the limits of the transfers)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    S3Client(const string &endpoint, const ftpopt_t *fopt);
+    ~S3Client()
+    {
+
+    }
+
+    /**
+    * @brief   : Available - whether the S3 backend is built in
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: built with libcurl, false: not
+    * @note    :
+    **/
+    static bool Available();
+
+    /**
+    * @brief   : List - list the objects under a prefix (ListObjectsV2)
+    * @param[I]: prefix (key prefix, i.e., 'rinex/2024/032/')
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: objs (objects)
+    * @return  : true: ok, false: error
+    * @note    : the pages are followed by the continuation token on one kept-alive connection
+    **/
+    bool List(const string &prefix, std::vector<s3obj_t> &objs, FILE *fpLog);
+
+    /**
+    * @brief   : GetAll - download objects in parallel
+    * @param[I]: keys (keys of the objects)
+    * @param[I]: files (local files, one for each key)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: stats (WGET_OK, WGET_PERMANENT or WGET_TRANSIENT of each object)
+    * @return  : number of objects downloaded
+    * @note    : the transfers are run by the pool of the client, see HttpPool::GetAll
+    **/
+    int GetAll(const std::vector<string> &keys, const std::vector<string> &files, std::vector<int> &stats, FILE *fpLog);
+};
@@ -0,0 +1,188 @@
+/*------------------------------------------------------------------------------
+* SiteNames.cpp : persistent resolution of the 4-char site names to the RINEX 3 long names
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*    1. IGS, RINEX 3.04 (Appendix A1, the long file names)
+*
+* notes   : 'site.list' has the 4-char site names, while the RINEX 3 file names begin with the 9-char station name
+*           (site, monument/receiver number and ISO country code) and the data source, i.e., 'ABMF00GLP_R', so a file
+*           was asked for by the wildcard 'ABMF*', which costs a listing of the remote directory for each site. The
+*           long names learned from the listings and the files downloaded are kept in 'sitename.list' in the root/main
+*           directory, and a site of a known long name is asked for by the exact URL of its file. A name is learned
+*           again if its file is not there by it, i.e., a new monument number.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "StringUtil.h"
+#include "JobPlan.h"
+#include "SiteNames.h"
+#include <sstream>
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Parse - the site and the long name of a RINEX 3 file
+* @param[I]: file (file name, i.e., 'ABMF00GLP_R_20240320000_01D_30S_MO.crx.gz')
+* @param[O]: site (4-char site name, i.e., 'ABMF')
+* @param[O]: name (9-char name and data source, i.e., 'ABMF00GLP_R')
+* @return  : true: ok, false: not a RINEX 3 long name
+* @note    :
+**/
+bool SiteNames::Parse(const string &file, string &site, string &name)
+{
+    if (file.size() < 24 || file[9] != '_' || file[11] != '_' || !strchr("RSU", file[10])) return false;
+    for (int i = 0; i < 9; i++)
+        if (!isalnum((unsigned char)file[i])) return false;
+    if (!isdigit((unsigned char)file[4]) || !isdigit((unsigned char)file[5])) return false;
+    for (int i = 12; i < 23; i++)
+        if (!isdigit((unsigned char)file[i])) return false;
+
+    site = file.substr(0, 4);
+    name = file.substr(0, 11);
+    for (int i = 0; i < 4; i++) site[i] = (char)toupper((unsigned char)site[i]);
+
+    return true;
+} /* end of Parse */
+
+/**
+* @brief   : Keep - keep the long name of a site
+* @param[I]: site (4-char site name)
+* @param[I]: name (9-char name and data source)
+* @param[I/O]: fp ('sitename.list' opened for appending, opened at the first new name)
+* @return  : true: a new or changed name, false: known
+* @note    :
+**/
+bool SiteNames::Keep(const string &site, const string &name, FILE *&fp)
+{
+    auto it = _names.find(site);
+    if (it != _names.end() && it->second == name) return false;
+
+    _names[site] = name;
+    _nlearn++;
+    if (!fp && !(fp = fopen(_list.c_str(), "a")))
+    {
+        cerr << "*** ERROR(SiteNames::Keep): failed to open " << _list << endl;
+
+        return true;
+    }
+    fprintf(fp, "%s %s\n", site.c_str(), name.c_str());
+
+    return true;
+} /* end of Keep */
+
+/**
+* @brief   : Set - set the long names and load 'sitename.list'
+* @param[I]: fopt (FTP options)
+* @param[I]: mainDir (root/main directory)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void SiteNames::Set(const ftpopt_t *fopt, const char *mainDir)
+{
+    _on = fopt->longName;
+    _list = string(mainDir) + (char)FILEPATHSEP + SITENAME_LIST;
+    _names.clear();
+    if (!_on) return;
+
+    /* the last line of each site wins */
+    FILE *fp = fopen(_list.c_str(), "r");
+    if (!fp) return;
+    char line[MAXCHARS];
+    while (fgets(line, MAXCHARS, fp))
+    {
+        std::istringstream iss(line);
+        string site, name;
+        if (!(iss >> site >> name) || site.size() != 4 || name.size() != 11) continue;
+        _names[site] = name;
+    }
+    fclose(fp);
+} /* end of Set */
+
+/**
+* @brief   : Find - the long name of a site
+* @param[I]: site (4-char site name in upper case)
+* @param[I]: hit (true: counted as a file asked for by its long name)
+* @param[O]: none
+* @return  : 9-char name and data source, i.e., 'ABMF00GLP_R', "" if not known
+* @note    :
+**/
+string SiteNames::Find(const string &site, bool hit)
+{
+    if (!_on) return "";
+
+    auto it = _names.find(site);
+    if (it == _names.end()) return "";
+    if (hit) _nhit++;
+
+    return it->second;
+} /* end of Find */
+
+/**
+* @brief   : Learn - learn the long names from the remote listing and the files of a site in the current directory
+* @param[I]: site (4-char site name in upper case)
+* @param[O]: none
+* @return  : number of the names new or changed
+* @note    : the listing '.listing' left by 'wget' names the other sites of the remote directory as well
+**/
+int SiteNames::Learn(const string &site)
+{
+    if (!_on) return 0;
+
+    FILE *fpList = nullptr;
+    int n = 0;
+    string s, name;
+
+    /* the files of the site downloaded, which win over the listing */
+    std::vector<string> files;
+    StringUtil str;
+    str.GetFilesAll(".", site, files);
+    std::map<string, string> got;
+    for (int i = 0; i < files.size(); i++)
+        if (Parse(files[i], s, name) && s == site) got[s] = name;
+
+    /* remote listing in the format of 'ls -l', the name being the last field */
+    FILE *fp = fopen(LISTING_FILE, "r");
+    if (fp)
+    {
+        char line[MAXCHARS];
+        while (fgets(line, MAXCHARS, fp))
+        {
+            if (line[0] != '-') continue;
+            string file = line;
+            str.TrimSpace4String(file);
+            size_t ipos = file.find_last_of(" \t");
+            if (ipos != string::npos) file = file.substr(ipos + 1);
+            if (Parse(file, s, name) && got.find(s) == got.end() && Keep(s, name, fpList)) n++;
+        }
+        fclose(fp);
+    }
+    for (auto it = got.begin(); it != got.end(); ++it)
+        if (Keep(it->first, it->second, fpList)) n++;
+    if (fpList) fclose(fpList);
+
+    return n;
+} /* end of Learn */
+
+/**
+* @brief   : Report - report the files asked for by their long names and the names learned
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the files of the concurrent jobs are counted in their own processes
+**/
+void SiteNames::Report(FILE *fpLog) const
+{
+    if (_nhit == 0 && _nlearn == 0) return;
+
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d files asked for by the long names of their sites without a listing, %d long names learned", _nhit, _nlearn);
+    cout << "*** INFO(SiteNames::Report): " << buff << endl;
+
+    if (fpLog) fprintf(fpLog, "* INFO(SiteNames): %s\n", buff);
+} /* end of Report */
@@ -0,0 +1,86 @@
+/*------------------------------------------------------------------------------
+* SiteNames.h : header file of SiteNames.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+
+#define SITENAME_LIST  "sitename.list"   /* long names of the sites in the root/main directory, 'site name', i.e.,
+                                            'ABMF ABMF00GLP_R' */
+
+class SiteNames
+{
+private:
+    std::map<string, string> _names;      /* 9-char name and data source, i.e., 'ABMF00GLP_R', key: 4-char site name */
+    bool _on;                             /* (0:off  1:on) */
+    string _list;                         /* path of 'sitename.list' */
+    int _nhit, _nlearn;                   /* numbers of the files asked for by their long names and of the names learned */
+
+    /**
+    * @brief   : Parse - the site and the long name of a RINEX 3 file
+    * @param[I]: file (file name, i.e., 'ABMF00GLP_R_20240320000_01D_30S_MO.crx.gz')
+    * @param[O]: site (4-char site name, i.e., 'ABMF')
+    * @param[O]: name (9-char name and data source, i.e., 'ABMF00GLP_R')
+    * @return  : true: ok, false: not a RINEX 3 long name
+    * @note    :
+    **/
+    static bool Parse(const string &file, string &site, string &name);
+
+    /**
+    * @brief   : Keep - keep the long name of a site
+    * @param[I]: site (4-char site name)
+    * @param[I]: name (9-char name and data source)
+    * @param[I/O]: fp ('sitename.list' opened for appending, opened at the first new name)
+    * @return  : true: a new or changed name, false: known
+    * @note    :
+    **/
+    bool Keep(const string &site, const string &name, FILE *&fp);
+
+public:
+    SiteNames()
+    {
+        _on = false;
+        _nhit = _nlearn = 0;
+    }
+    ~SiteNames()
+    {
+
+    }
+
+    /**
+    * @brief   : Set - set the long names and load 'sitename.list'
+    * @param[I]: fopt (FTP options)
+    * @param[I]: mainDir (root/main directory)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Set(const ftpopt_t *fopt, const char *mainDir);
+
+    /**
+    * @brief   : Find - the long name of a site
+    * @param[I]: site (4-char site name in upper case)
+    * @param[I]: hit (true: counted as a file asked for by its long name)
+    * @param[O]: none
+    * @return  : 9-char name and data source, i.e., 'ABMF00GLP_R', "" if not known
+    * @note    :
+    **/
+    string Find(const string &site, bool hit = true);
+
+    /**
+    * @brief   : Learn - learn the long names from the remote listing and the files of a site in the current directory
+    * @param[I]: site (4-char site name in upper case)
+    * @param[O]: none
+    * @return  : number of the names new or changed
+    * @note    : the listing '.listing' left by 'wget' names the other sites of the remote directory as well
+    **/
+    int Learn(const string &site);
+
+    /**
+    * @brief   : Report - report the files asked for by their long names and the names learned
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Report(FILE *fpLog) const;
+};
@@ -8,10 +8,18 @@
  *
  *
  * history : 2020/09/25 1.0  new (by Feng Zhou)
+ *           2026/10/18      add "Int2Str" for the strings of day descriptors
+ *           2026/10/18      "GetFile" and "GetFilesAll" read the directory directly, without 'files.list' and 'chdir'
  *-----------------------------------------------------------------------------*/
 #include "GOOD.h"
 #include "StringUtil.h"
 #include <cmath>
+#include <sys/stat.h>
+#ifdef _WIN32 /* for Windows */
+#include <io.h>
+#else /* for Linux or Mac */
+#include <dirent.h>
+#endif
 
 /* function definition -------------------------------------------------------*/
 
@@ -105,6 +113,24 @@ string StringUtil::hh2str(int hh)
     return sHh;
 } /* end of hh2str */
 
+/**
+ * @brief   : Int2Str - convert from non-negative integer to zero-padded string with fixed width
+ * @param[I]: val (integer)
+ * @param[I]: n (width)
+ * @param[O]: s (string, n + 1 characters at least)
+ * @return  : none
+ * @note    : no allocation, i.e., Int2Str(32, 3, s) gives "032"
+ **/
+void StringUtil::Int2Str(int val, int n, char *s)
+{
+    s[n] = '\0';
+    for (int i = n - 1; i >= 0; i--)
+    {
+        s[i] = (char)('0' + val % 10);
+        val /= 10;
+    }
+} /* end of Int2Str */
+
 /**
  * @brief     : ToUpper - convert the string from lower case to upper case
  * @param[I/O]: str (string)
@@ -309,120 +335,84 @@ void StringUtil::CutFilePathSep(char *strPath)
 } /* end of CutFilePathSep */
 
 /**
- * @brief   : GetFile - get the full name of a specific file from the current directory
- * @param[I]: dir (the current directory)
- * @param[I]: str (string to match)
- * @param[O]: fileName (the full name of a specific file)
- * @return  : true: found, false: NOT found
- * @note    :
+ * @brief   : ListDir - get the names of the files matching a string in a directory
+ * @param[I]: dir (directory)
+ * @param[I]: str (string to match, in which '?' matches any one character and '*' any characters)
+ * @param[O]: names (file names in ascending order, appended)
+ * @return  : number of names found
+ * @note    : the names are matched by "WildMatch" against '*str*', the same as the shell glob of 'ls *str*', without
+ *            the hidden files and sub-directories, while the current directory is not changed and no temporary file
+ *            is written
  **/
-bool StringUtil::GetFile(string dir, string str, string &fileName)
+static int ListDir(const string &dir, const string &str, vector<string> &names)
 {
-    /* change directory */
-#ifdef _WIN32 /* for Windows */
-    _chdir(dir.c_str());
-#else /* for Linux or Mac */
-    chdir(dir.c_str());
-#endif
-
-    string cmd, fileList = "files.list";
+    size_t n0 = names.size();
+    StringUtil util;
+    string pat = "*" + str + "*";
 #ifdef _WIN32 /* for Windows */
-    cmd = "dir /b | findstr /r \"" + str + "\"" + " > " + fileList;
-
-#else /* for Linux or Mac */
-    cmd = "ls *" + str + "* > " + fileList;
-#endif
-    std::system(cmd.c_str());
-
-    bool isFound = false;
-    if (access(fileList.c_str(), 0) == 0)
+    struct _finddata_t fd;
+    intptr_t h = _findfirst((dir + "\\*").c_str(), &fd);
+    if (h != -1)
     {
-        ifstream filLst(fileList.c_str());
-        if (!filLst.is_open())
+        do
         {
-            cerr << "*** ERROR(StringUtil::GetFile): open files.list = " << fileList << " file failed, please check it" << endl;
-
-            return false;
-        }
-
-        string fil;
-        getline(filLst, fil);
-        TrimSpace4String(fil);
-        if (fil.size() > 0)
+            if ((fd.attrib & _A_SUBDIR) || fd.name[0] == '.' || !util.WildMatch(pat.c_str(), fd.name)) continue;
+            names.push_back(fd.name);
+        } while (_findnext(h, &fd) == 0);
+        _findclose(h);
+    }
+#else /* for Linux or Mac */
+    DIR *dp = opendir(dir.c_str());
+    if (dp)
+    {
+        struct dirent *ep;
+        while ((ep = readdir(dp)) != nullptr)
         {
-            fileName = fil;
-            isFound = true;
+            if (ep->d_name[0] == '.' || !util.WildMatch(pat.c_str(), ep->d_name)) continue;
+            if (ep->d_type == DT_DIR) continue;
+            if (ep->d_type == DT_UNKNOWN)  /* file systems without the type in the entry */
+            {
+                struct stat st;
+                if (stat((dir + "/" + ep->d_name).c_str(), &st) == 0 && S_ISDIR(st.st_mode)) continue;
+            }
+            names.push_back(ep->d_name);
         }
-        else
-            isFound = false;
-
-        /* close 'files.list' */
-        filLst.close();
+        closedir(dp);
     }
-
-    /* delete 'files.list' */
-#ifdef _WIN32 /* for Windows */
-    cmd = "del " + fileList;
-#else /* for Linux or Mac */
-    cmd = "rm -rf " + fileList;
 #endif
-    std::system(cmd.c_str());
+    sort(names.begin() + n0, names.end());
+
+    return (int)(names.size() - n0);
+} /* end of ListDir */
+
+/**
+ * @brief   : GetFile - get the full name of a specific file from a directory
+ * @param[I]: dir (directory)
+ * @param[I]: str (string to match, with the wildcards '?' and '*', i.e., 'COD0MGXFIN_20240320000_01D_???_ORB.SP3')
+ * @param[O]: fileName (the full name of a specific file)
+ * @return  : true: found, false: NOT found
+ * @note    : the first name in ascending order is taken if several files match; reentrant
+ **/
+bool StringUtil::GetFile(string dir, string str, string &fileName)
+{
+    vector<string> names;
+    if (ListDir(dir, str, names) < 1) return false;
+    fileName = names[0];
 
-    return isFound;
+    return true;
 } /* end of GetFile */
 
 /**
- * @brief   : GetFilesAll - get the name list of all the files from the current directory
- * @param[I]: dir (the current directory)
+ * @brief   : GetFilesAll - get the name list of all the files from a directory
+ * @param[I]: dir (directory)
  * @param[I]: suffix (file suffix)
- * @param[O]: files (the name list of all the files)
+ * @param[O]: files (the name list of all the files, appended)
  * @return  : none
- * @note    :
+ * @note    : reentrant
  **/
 void StringUtil::GetFilesAll(string dir, string suffix, vector<string> &files)
 {
-    /* change directory */
-#ifdef _WIN32 /* for Windows */
-    _chdir(dir.c_str());
-#else /* for Linux or Mac */
-    chdir(dir.c_str());
-#endif
-
-    string cmd, fileList = "files.list";
-#ifdef _WIN32 /* for Windows */
-    cmd = "dir /b | find \"" + suffix + "\"" + " > " + fileList;
-#else /* for Linux or Mac */
-    cmd = "ls *" + suffix + "* > " + fileList;
-#endif
-    std::system(cmd.c_str());
-
-    if (access(fileList.c_str(), 0) == 0)
-    {
-        ifstream filLst(fileList.c_str());
-        if (!filLst.is_open())
-        {
-            cerr << "*** ERROR(StringUtil::GetFilesAll): open files.list = " << fileList << " file failed, please check it" << endl;
-
-            return;
-        }
-
-        string fileName;
-        while (getline(filLst, fileName))
-        {
-            files.push_back(fileName);
-        }
-
-        /* close 'files.list' */
-        filLst.close();
-    }
-
-    /* delete 'files.list' */
-#ifdef _WIN32 /* for Windows */
-    cmd = "del " + fileList;
-#else /* for Linux or Mac */
-    cmd = "rm -rf " + fileList;
-#endif
-    std::system(cmd.c_str());
+    ListDir(dir, suffix, files);
 } /* end of GetFilesAll */
 
 /**
@@ -447,4 +437,39 @@ void StringUtil::GetSubStr(string str, string sep, vector<string> &subStrs)
     }
     if (pos1 != str.length())
         subStrs.push_back(str.substr(pos1));
-} /* end of GetSubStr */
\ No newline at end of file
+} /* end of GetSubStr */
+
+/**
+ * @brief   : WildMatch - whether a file name matches a wildcard of 'wget -A'
+ * @param[I]: pat (wildcard with '*' and '?')
+ * @param[I]: name (file name)
+ * @param[O]: none
+ * @return  : true: matched, false: not
+ * @note    :
+ **/
+bool StringUtil::WildMatch(const char *pat, const char *name)
+{
+    const char *star = nullptr, *back = nullptr;
+    while (*name)
+    {
+        if (*pat == '*')
+        {
+            star = pat++;
+            back = name;
+        }
+        else if (*pat == '?' || *pat == *name)
+        {
+            pat++;
+            name++;
+        }
+        else if (star)
+        {
+            pat = star + 1;
+            name = ++back;
+        }
+        else return false;
+    }
+    while (*pat == '*') pat++;
+
+    return *pat == '\0';
+} /* end of WildMatch */
\ No newline at end of file
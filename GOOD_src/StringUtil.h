@@ -72,6 +72,16 @@ public:
     **/
     string hh2str(int hh);
 
+    /**
+    * @brief   : Int2Str - convert from non-negative integer to zero-padded string with fixed width
+    * @param[I]: val (integer)
+    * @param[I]: n (width)
+    * @param[O]: s (string, n + 1 characters at least)
+    * @return  : none
+    * @note    : no allocation, i.e., Int2Str(32, 3, s) gives "032"
+    **/
+    void Int2Str(int val, int n, char *s);
+
     /**
     * @brief     : ToUpper - convert the string from lower case to upper case
     * @param[I/O]: str (string)
@@ -156,22 +166,22 @@ public:
     void CutFilePathSep(char *strPath);
 
     /**
-    * @brief   : GetFile - get the full name of a specific file from the current directory
-    * @param[I]: dir (the current directory)
-    * @param[I]: str (string to match)
+    * @brief   : GetFile - get the full name of a specific file from a directory
+    * @param[I]: dir (directory)
+    * @param[I]: str (string to match, with the wildcards '?' and '*', i.e., 'COD0MGXFIN_20240320000_01D_???_ORB.SP3')
     * @param[O]: fileName (the full name of a specific file)
     * @return  : true: found, false: NOT found
-    * @note    :
+    * @note    : the first name in ascending order is taken if several files match; reentrant
     **/
     bool GetFile(string dir, string str, string &fileName);
 
     /**
-    * @brief   : GetFilesAll - get the name list of all the files from the current directory
-    * @param[I]: dir (the current directory)
+    * @brief   : GetFilesAll - get the name list of all the files from a directory
+    * @param[I]: dir (directory)
     * @param[I]: suffix (file suffix)
-    * @param[O]: files (the name list of all the files)
+    * @param[O]: files (the name list of all the files, appended)
     * @return  : none
-    * @note    :
+    * @note    : reentrant
     **/
     void GetFilesAll(string dir, string suffix, vector<string> &files);
 
@@ -184,4 +194,14 @@ public:
     * @note    :
     **/
     void GetSubStr(string str, string sep, vector<string> &subStrs);
+
+    /**
+    * @brief   : WildMatch - whether a file name matches a wildcard of 'wget -A'
+    * @param[I]: pat (wildcard with '*' and '?')
+    * @param[I]: name (file name)
+    * @param[O]: none
+    * @return  : true: matched, false: not
+    * @note    :
+    **/
+    bool WildMatch(const char *pat, const char *name);
 };
\ No newline at end of file
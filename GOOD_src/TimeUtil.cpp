@@ -9,17 +9,29 @@
  * history : 2020/08/23 1.0  new (by Feng Zhou)
  *           2020/09/12      fix a bug (missing t1 = t0) in TimeAdd (by Yuze Yang and Feng Zhou)
  *           2020/10/25      add VectorXd type for date (by Feng Zhou)
+ *           2026/10/18      add "DayDesc" and "DayDescs" backed by the calendar tables
+ *           2026/10/18      "TimeStr" writes to the buffer of the caller instead of a static one
  *-----------------------------------------------------------------------------*/
 #include "GOOD.h"
 #include "TimeUtil.h"
+#include "StringUtil.h"
 #include <math.h>
 
 /* constants/macros ----------------------------------------------------------*/
 #define MAXLEAPS 64 /* max number of leap seconds table */
+#define CAL_YEAR0  1980   /* first year of the calendar tables */
+#define CAL_NYEAR  120    /* number of years of the calendar tables (1980-2099) */
+#define MJD_JAN1   44239  /* MJD of 1980-01-01 */
+#define MJD_GPST0  44244  /* MJD of the GPS time reference (1980-01-06) */
 
 static const double gpst0[] = {1980, 1, 6, 0, 0, 0}; /* GPS time reference */
 static const double bdst0[] = {2006, 1, 1, 0, 0, 0}; /* BDS time reference */
-static double leaps[MAXLEAPS + 1][7] =
+static const int cumDays[2][13] =
+    {
+        /* days before the first day of each month (common year, leap year) */
+        {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+        {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366}};
+static const double leaps[MAXLEAPS + 1][7] =
     {
         /* leap seconds (y,m,d,h,m,s,UTC-GPST) */
         {2017, 1, 1, 0, 0, 0, -18},
@@ -591,14 +603,120 @@ void TimeUtil::time2str(gtime_t tt, char *s, int n)
  * @brief   : TimeStr - get time string
  * @param[I]: tt (time struct (.mjd and .sod))
  * @param[I]: n (number of decimals)
- * @param[O]: none
- * @return  : time string
- * @note    :
+ * @param[O]: buff (string buffer, 64 characters at least)
+ * @return  : time string, i.e., buff
+ * @note    : reentrant, i.e., printf("%s", tu.TimeStr(tt, 0, buff))
  **/
-char *TimeUtil::TimeStr(gtime_t tt, int n)
+char *TimeUtil::TimeStr(gtime_t tt, int n, char *buff)
 {
-    static char buff[64];
     time2str(tt, buff, n);
 
     return buff;
-} /* end of TimeStr */
\ No newline at end of file
+} /* end of TimeStr */
+
+/**
+ * @brief   : Calendar - the MJD of January 1 of each year in the calendar tables
+ * @param[I]: none
+ * @param[O]: none
+ * @return  : CAL_NYEAR + 1 MJDs
+ * @note    : built at the first call
+ **/
+static const int *Calendar()
+{
+    struct caltab_t
+    {
+        int mjdJan1[CAL_NYEAR + 1];
+
+        caltab_t()
+        {
+            mjdJan1[0] = MJD_JAN1;
+            for (int i = 0; i < CAL_NYEAR; i++)
+            {
+                int year = CAL_YEAR0 + i;
+                bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+                mjdJan1[i + 1] = mjdJan1[i] + (leap ? 366 : 365);
+            }
+        }
+    };
+    static const caltab_t tab;
+
+    return tab.mjdJan1;
+} /* end of Calendar */
+
+/**
+ * @brief   : DayDesc - the conversion from time to day descriptor
+ * @param[I]: tt (time struct (.mjd and .sod))
+ * @param[O]: day (day descriptor)
+ * @return  : none
+ * @note    : looked up in the calendar tables for 1980-2099, otherwise converted by time2yrdoy and time2gpst
+ **/
+void TimeUtil::DayDesc(gtime_t tt, daydesc_t &day)
+{
+    int mjd = tt.mjd + (int)floor(tt.sod / 86400.0);
+    day.t.mjd = mjd;
+    day.t.sod = 0.0;
+
+    const int *mjdJan1 = Calendar();
+    if (mjd >= MJD_GPST0 && mjd < mjdJan1[CAL_NYEAR])
+    {
+        /* the year guessed by the mean length of year is at most one year off */
+        int iy = (mjd - MJD_JAN1) * 4 / 1461;
+        if (iy >= CAL_NYEAR || mjd < mjdJan1[iy]) iy--;
+        else if (mjd >= mjdJan1[iy + 1]) iy++;
+        int leap = mjdJan1[iy + 1] - mjdJan1[iy] == 366 ? 1 : 0;
+        day.yyyy = CAL_YEAR0 + iy;
+        day.doy = mjd - mjdJan1[iy] + 1;
+        for (day.mm = 1; day.doy > cumDays[leap][day.mm]; day.mm++);
+        day.dd = day.doy - cumDays[leap][day.mm - 1];
+        day.wwww = (mjd - MJD_GPST0) / 7;
+        day.dow = (mjd - MJD_GPST0) % 7;
+    }
+    else
+    {
+        time2yrdoy(day.t, &day.yyyy, &day.doy);
+        yrdoy2ymd(day.yyyy, day.doy, &day.mm, &day.dd);
+        day.dow = time2gpst(day.t, &day.wwww, nullptr);
+    }
+    day.yy = yyyy2yy(day.yyyy);
+
+    StringUtil str;
+    str.Int2Str(day.yyyy, 4, day.sYyyy);
+    str.Int2Str(day.yy, 2, day.sYy);
+    str.Int2Str(day.doy, 3, day.sDoy);
+    str.Int2Str(day.mm, 2, day.sMm);
+    str.Int2Str(day.dd, 2, day.sDd);
+    str.Int2Str(day.wwww, 4, day.sWwww);
+    str.Int2Str(day.dow, 1, day.sDow);
+} /* end of DayDesc */
+
+/**
+ * @brief   : DayDescs - the conversion from a span of times to day descriptors
+ * @param[I]: tts (time structs (.mjd and .sod))
+ * @param[I]: n (number of times)
+ * @param[O]: days (n day descriptors)
+ * @return  : none
+ * @note    :
+ **/
+void TimeUtil::DayDescs(const gtime_t *tts, int n, daydesc_t *days)
+{
+    for (int i = 0; i < n; i++) DayDesc(tts[i], days[i]);
+} /* end of DayDescs */
+
+/**
+ * @brief   : DayDescs - the day descriptors of consecutive days
+ * @param[I]: ts (start time)
+ * @param[I]: ndays (number of consecutive days)
+ * @param[O]: days (ndays day descriptors)
+ * @return  : none
+ * @note    :
+ **/
+void TimeUtil::DayDescs(gtime_t ts, int ndays, std::vector<daydesc_t> &days)
+{
+    days.resize(ndays > 0 ? ndays : 0);
+    for (int i = 0; i < ndays; i++)
+    {
+        gtime_t tt = ts;
+        tt.mjd += i;
+        DayDesc(tt, days[i]);
+    }
+} /* end of DayDescs */
@@ -263,9 +263,38 @@ public:
     * @brief   : TimeStr - get time string
     * @param[I]: tt (time struct (.mjd and .sod))
     * @param[I]: n (number of decimals)
-    * @param[O]: none
-    * @return  : time string
+    * @param[O]: buff (string buffer, 64 characters at least)
+    * @return  : time string, i.e., buff
+    * @note    : reentrant, i.e., printf("%s", tu.TimeStr(tt, 0, buff))
+    **/
+    char* TimeStr(gtime_t tt, int n, char *buff);
+
+    /**
+    * @brief   : DayDesc - the conversion from time to day descriptor
+    * @param[I]: tt (time struct (.mjd and .sod))
+    * @param[O]: day (day descriptor)
+    * @return  : none
+    * @note    : looked up in the calendar tables for 1980-2099, otherwise converted by time2yrdoy and time2gpst
+    **/
+    void DayDesc(gtime_t tt, daydesc_t &day);
+
+    /**
+    * @brief   : DayDescs - the conversion from a span of times to day descriptors
+    * @param[I]: tts (time structs (.mjd and .sod))
+    * @param[I]: n (number of times)
+    * @param[O]: days (n day descriptors)
+    * @return  : none
+    * @note    :
+    **/
+    void DayDescs(const gtime_t *tts, int n, daydesc_t *days);
+
+    /**
+    * @brief   : DayDescs - the day descriptors of consecutive days
+    * @param[I]: ts (start time)
+    * @param[I]: ndays (number of consecutive days)
+    * @param[O]: days (ndays day descriptors)
+    * @return  : none
     * @note    :
     **/
-    char* TimeStr(gtime_t tt, int n);
+    void DayDescs(gtime_t ts, int ndays, std::vector<daydesc_t> &days);
 };
\ No newline at end of file
@@ -0,0 +1,236 @@
+/*------------------------------------------------------------------------------
+* Watchdog.cpp : stalled-transfer detection and abort of the 'wget' commands
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : 'wget' may hang for a long time on a dead FTP data channel, which blocks the whole run. So a transfer is
+*           run in its own process group, and the growth of the files in the current directory (where 'wget' writes)
+*           is polled. A transfer whose average speed over the sliding window falls below the limit, or which runs
+*           over the total deadline, is killed and the one file it was writing (the last one grown) is removed, the
+*           files it finished before being kept. It is then a transient failure for "RetryPolicy", which retries it
+*           or passes on to the next analysis center of a fallback chain. The connect timeout is left to 'wget'
+*           itself ('--connect-timeout').
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "Watchdog.h"
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <sys/stat.h>
+#ifndef _WIN32  /* for Linux or Mac */
+#include <dirent.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+/* constants/macros ----------------------------------------------------------*/
+#define WDOG_POLL      0.5               /* polling interval (s) */
+#define WDOG_GRACE     2.0               /* seconds between SIGTERM and SIGKILL */
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Newest - the file last written among the files grown since a snapshot
+* @param[I]: files0 (size of each file at the snapshot)
+* @param[I]: files (size of each file now)
+* @param[O]: none
+* @return  : the file, "": none grown
+* @note    : the log of 'wget' ('.wget_<pid>.log') is not taken
+**/
+static string Newest(const std::map<string, long long> &files0, const std::map<string, long long> &files)
+{
+    string newest;
+#ifndef _WIN32  /* for Linux or Mac */
+    double tnew = -1.0;
+    for (auto it = files.begin(); it != files.end(); ++it)
+    {
+        auto it0 = files0.find(it->first);
+        if (it0 != files0.end() && it0->second == it->second) continue;
+        if (it->first.compare(0, 6, ".wget_") == 0) continue;
+        struct stat st;
+        if (stat(it->first.c_str(), &st) != 0) continue;
+#ifdef __APPLE__
+        double t = st.st_mtimespec.tv_sec + st.st_mtimespec.tv_nsec * 1e-9;
+#else
+        double t = st.st_mtim.tv_sec + st.st_mtim.tv_nsec * 1e-9;
+#endif
+        if (t > tnew)
+        {
+            tnew = t;
+            newest = it->first;
+        }
+    }
+#endif
+
+    return newest;
+} /* end of Newest */
+
+/**
+* @brief   : DirFiles - the sizes of the regular files in the current directory
+* @param[I]: none
+* @param[O]: files (size of each file)
+* @return  : none
+* @note    : the transfers of 'wget' are written in the current directory
+**/
+void Watchdog::DirFiles(std::map<string, long long> &files)
+{
+    files.clear();
+#ifndef _WIN32  /* for Linux or Mac */
+    DIR *dp = opendir(".");
+    if (!dp) return;
+    struct dirent *ep;
+    while ((ep = readdir(dp)) != nullptr)
+    {
+        struct stat st;
+        if (stat(ep->d_name, &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        files[ep->d_name] = (long long)st.st_size;
+    }
+    closedir(dp);
+#endif
+} /* end of DirFiles */
+
+/**
+* @brief   : Set - set the limits of the transfers
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void Watchdog::Set(const ftpopt_t *fopt)
+{
+    _lowSpeed = fopt->lowSpeed > 0.0 ? fopt->lowSpeed : 0.0;
+    _window = fopt->lowSpeedWin > 0 ? fopt->lowSpeedWin : 60;
+    _deadline = fopt->deadline > 0 ? fopt->deadline : 0;
+} /* end of Set */
+
+/**
+* @brief   : Run - run a transfer command under the watchdog
+* @param[I]: cmd (command)
+* @param[I]: host (host of the transfer)
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: event (WDOG_NONE, WDOG_STALLED or WDOG_DEADLINE)
+* @return  : exit status of the command, -1 if aborted
+* @note    : an aborted transfer is killed with its process group, and the one file it was writing is removed
+**/
+int Watchdog::Run(const string &cmd, const string &host, FILE *fpLog, int &event)
+{
+    event = WDOG_NONE;
+#ifdef _WIN32   /* for Windows */
+    return std::system(cmd.c_str());
+#else           /* for Linux or Mac */
+    if (_lowSpeed <= 0.0 && _deadline <= 0)
+    {
+        int ret = std::system(cmd.c_str());
+
+        return (ret != -1 && WIFEXITED(ret)) ? WEXITSTATUS(ret) : -1;
+    }
+
+    std::map<string, long long> files0, files, filesPrev;
+    DirFiles(files0);
+    filesPrev = files0;
+    string active;  /* the file being written, the last one grown */
+    fflush(nullptr);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        int ret = std::system(cmd.c_str());
+
+        return (ret != -1 && WIFEXITED(ret)) ? WEXITSTATUS(ret) : -1;
+    }
+    if (pid == 0)  /* the child, in its own process group so that 'wget' is killed with the shell */
+    {
+        setpgid(0, 0);
+        execl("/bin/sh", "sh", "-c", cmd.c_str(), (char *)nullptr);
+        _exit(127);
+    }
+    setpgid(pid, pid);
+
+    /* the bytes written since the start, sampled over the sliding window */
+    auto now = []() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); };
+    double t0 = now();
+    std::deque<std::pair<double, long long>> samples;
+    samples.push_back(std::make_pair(t0, 0LL));
+    int status = 0;
+    while (true)
+    {
+        if (waitpid(pid, &status, WNOHANG) == pid) return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        std::this_thread::sleep_for(std::chrono::duration<double>(WDOG_POLL));
+
+        double t = now();
+        DirFiles(files);
+        long long bytes = 0;
+        for (auto it = files.begin(); it != files.end(); ++it)
+        {
+            auto it0 = files0.find(it->first);
+            if (it0 == files0.end()) bytes += it->second;
+            else if (it->second > it0->second) bytes += it->second - it0->second;
+        }
+        string grown = Newest(filesPrev, files);
+        if (!grown.empty()) active = grown;
+        filesPrev = files;
+        samples.push_back(std::make_pair(t, bytes));
+        while (samples.size() > 2 && t - samples[1].first >= _window) samples.pop_front();
+
+        double span = t - samples.front().first;
+        if (_deadline > 0 && t - t0 >= _deadline) event = WDOG_DEADLINE;
+        else if (_lowSpeed > 0.0 && span >= _window && (bytes - samples.front().second) / span < _lowSpeed) event = WDOG_STALLED;
+        if (event == WDOG_NONE) continue;
+
+        /* abort the transfer */
+        kill(-pid, SIGTERM);
+        double tk = now();
+        while (waitpid(pid, &status, WNOHANG) != pid)
+        {
+            if (now() - tk > WDOG_GRACE)
+            {
+                kill(-pid, SIGKILL);
+                waitpid(pid, &status, 0);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double>(0.1));
+        }
+        kill(-pid, SIGKILL);  /* the rest of the group, if any */
+
+        /* only the partial file; the files finished before by the same command are kept */
+        DirFiles(files);
+        grown = Newest(filesPrev, files);
+        if (!grown.empty()) active = grown;
+        if (!active.empty()) remove(active.c_str());
+        _nabort[event]++;
+        if (fpLog)
+        {
+            if (event == WDOG_STALLED) fprintf(fpLog, "* WARNING(Watchdog): %s stalled below %.0f B/s over %d s, aborted after %.0f s\n",
+                host.c_str(), _lowSpeed, _window, t - t0);
+            else fprintf(fpLog, "* WARNING(Watchdog): %s over the deadline of %d s, aborted\n", host.c_str(), _deadline);
+        }
+
+        return -1;
+    }
+#endif
+} /* end of Run */
+
+/**
+* @brief   : Report - report the aborted transfers
+* @param[I]: fpLog (log file pointer, nullptr: no log)
+* @param[O]: none
+* @return  : none
+* @note    : the transfers of the concurrent jobs are counted in their own processes and logged one by one
+**/
+void Watchdog::Report(FILE *fpLog) const
+{
+    if (_nabort[WDOG_STALLED] + _nabort[WDOG_DEADLINE] == 0) return;
+
+    char buff[MAXCHARS] = { '\0' };
+    sprintf(buff, "%d transfers aborted, %d stalled and %d over the deadline", _nabort[WDOG_STALLED] + _nabort[WDOG_DEADLINE],
+        _nabort[WDOG_STALLED], _nabort[WDOG_DEADLINE]);
+    cout << "*** INFO(Watchdog::Report): " << buff << endl;
+
+    if (fpLog) fprintf(fpLog, "* INFO(Watchdog): %s\n", buff);
+} /* end of Report */
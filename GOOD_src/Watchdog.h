@@ -0,0 +1,68 @@
+/*------------------------------------------------------------------------------
+* Watchdog.h : header file of Watchdog.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <map>
+
+#define WDOG_NONE      0                 /* the transfer exited by itself */
+#define WDOG_STALLED   1                 /* aborted, below the min average speed over the window */
+#define WDOG_DEADLINE  2                 /* aborted, over the total deadline */
+
+class Watchdog
+{
+private:
+    double _lowSpeed;                     /* min average speed over the window (B/s), 0: off */
+    int _window;                          /* sliding window of the average speed (s) */
+    int _deadline;                        /* total deadline of one transfer (s), 0: off */
+    int _nabort[3];                       /* number of the aborted transfers of each event */
+
+    /**
+    * @brief   : DirFiles - the sizes of the regular files in the current directory
+    * @param[I]: none
+    * @param[O]: files (size of each file)
+    * @return  : none
+    * @note    : the transfers of 'wget' are written in the current directory
+    **/
+    static void DirFiles(std::map<string, long long> &files);
+
+public:
+    Watchdog()
+    {
+        _lowSpeed = 0.0;
+        _window = _deadline = 0;
+        _nabort[0] = _nabort[1] = _nabort[2] = 0;
+    }
+    ~Watchdog()
+    {
+
+    }
+
+    /**
+    * @brief   : Set - set the limits of the transfers
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Set(const ftpopt_t *fopt);
+
+    /**
+    * @brief   : Run - run a transfer command under the watchdog
+    * @param[I]: cmd (command)
+    * @param[I]: host (host of the transfer)
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: event (WDOG_NONE, WDOG_STALLED or WDOG_DEADLINE)
+    * @return  : exit status of the command, -1 if aborted
+    * @note    : an aborted transfer is killed with its process group, and the one file it was writing is removed
+    **/
+    int Run(const string &cmd, const string &host, FILE *fpLog, int &event);
+
+    /**
+    * @brief   : Report - report the aborted transfers
+    * @param[I]: fpLog (log file pointer, nullptr: no log)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the transfers of the concurrent jobs are counted in their own processes and logged one by one
+    **/
+    void Report(FILE *fpLog) const;
+};
@@ -0,0 +1,218 @@
+/*------------------------------------------------------------------------------
+* WorkLease.cpp : lease-based distribution of downloading jobs over several nodes
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader) toolkit
+*
+* References:
+*
+* notes   : the nodes run the same configuration with the same root/main directory and share a work directory,
+*           i.e., on NFS. Each (day, product, site) job is claimed by creating 'dir/yyyyddd/prod_site.lease' with
+*           'O_EXCL', and renamed to '.done' when finished, so a node simply skips the jobs of the others and takes
+*           the unclaimed ones. A lease older than 'leaseSec' is taken over by renaming it first, which only one
+*           node can do. The age is measured against a file just written by the same node, so that the clocks of
+*           the nodes need not agree with each other, only the clock of the file server is used. The leases held
+*           are renewed by a thread every third of 'leaseSec', so that only the lease of a lost node expires. A job
+*           left unfinished or missing some files is released instead of being done, for another node to try.
+*
+* history : 2026/10/18 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "GOOD.h"
+#include "TimeUtil.h"
+#include "WorkLease.h"
+#include <chrono>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32  /* for Windows */
+#include <io.h>
+#include <process.h>
+#include <sys/utime.h>
+#else          /* for Linux or Mac */
+#include <utime.h>
+#endif
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : WorkLease - open the work directory of one day
+* @param[I]: ts (the day)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : nothing is done if the distributed mode is off
+**/
+WorkLease::WorkLease(gtime_t ts, const ftpopt_t *fopt)
+{
+    _stop = false;
+    _leaseSec = fopt->leaseSec > 0 ? fopt->leaseSec : 1800;
+    if (!fopt->distributed || strlen(fopt->leaseDir) == 0) return;
+
+    TimeUtil tu;
+    daydesc_t day;
+    tu.DayDesc(ts, day);
+    char tmpDir[MAXSTRPATH] = { '\0' };
+    sprintf(tmpDir, "%s%c%s%s", fopt->leaseDir, (char)FILEPATHSEP, day.sYyyy, day.sDoy);
+    _dir = tmpDir;
+    if (access(tmpDir, 0) == -1)
+    {
+#ifdef _WIN32   /* for Windows */
+        string cmd = "mkdir " + _dir;
+#else           /* for Linux or Mac */
+        string cmd = "mkdir -p " + _dir;
+#endif
+        std::system(cmd.c_str());
+    }
+
+    char host[MAXCHARS] = { '\0' };
+#ifdef _WIN32   /* for Windows */
+    const char *env = getenv("COMPUTERNAME");
+    if (env) strncpy(host, env, MAXCHARS - 1);
+    sprintf(host + strlen(host), "_%d", (int)_getpid());
+#else           /* for Linux or Mac */
+    gethostname(host, MAXCHARS - 16);
+    sprintf(host + strlen(host), "_%d", (int)getpid());
+#endif
+    _owner = host;
+} /* end of WorkLease */
+
+/**
+* @brief   : ~WorkLease - stop renewing the leases
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the leases still held are left to expire
+**/
+WorkLease::~WorkLease()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+    if (_renewer.joinable()) _renewer.join();
+} /* end of ~WorkLease */
+
+/**
+* @brief   : Create - create a lease file exclusively
+* @param[I]: lease (lease file)
+* @param[O]: none
+* @return  : true: created, false: it exists
+* @note    : 'O_EXCL' is atomic on a local file system and on NFS v3 or later
+**/
+bool WorkLease::Create(const string &lease) const
+{
+    int fd = open(lease.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) return false;
+
+    char buff[MAXCHARS] = { '\0' };
+    int n = sprintf(buff, "%s %ld\n", _owner.c_str(), (long)time(NULL));
+    write(fd, buff, n);
+    close(fd);
+
+    return true;
+} /* end of Create */
+
+/**
+* @brief   : Renew - renew the leases held every third of '_leaseSec', until stopped
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : run by '_renewer'; the modification time set is that of the file server, as the age is measured
+**/
+void WorkLease::Renew()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop)
+    {
+        _cv.wait_for(lock, std::chrono::seconds(_leaseSec / 3 > 1 ? _leaseSec / 3 : 1));
+        if (_stop) break;
+        for (int i = 0; i < _held.size(); i++)
+        {
+            string lease = _held[i] + LEASE_SUFFIX;
+#ifdef _WIN32   /* for Windows */
+            _utime(lease.c_str(), nullptr);
+#else           /* for Linux or Mac */
+            utime(lease.c_str(), nullptr);
+#endif
+        }
+    }
+} /* end of Renew */
+
+/**
+* @brief   : Claim - claim the job of one product and site of the day
+* @param[I]: prod (product, i.e., "obs_ngs_daily", "eop")
+* @param[I]: site (site name, "all": the product as a whole)
+* @param[O]: none
+* @return  : true: claimed (or the distributed mode is off), false: done or leased by another node
+* @note    : an expired lease is taken over, so the job of a lost node is retried; the leases held are renewed
+*            until "Done"
+**/
+bool WorkLease::Claim(const string &prod, const string &site)
+{
+    if (!On()) return true;
+
+    string job = _dir + (char)FILEPATHSEP + prod + "_" + site;
+    string lease = job + LEASE_SUFFIX;
+    if (access((job + DONE_SUFFIX).c_str(), 0) == 0) return false;
+    if (!Create(lease))
+    {
+        /* the age of the lease on the clock of the file server */
+        string clock = _dir + (char)FILEPATHSEP + _owner + ".clock";
+        FILE *fp = fopen(clock.c_str(), "w");
+        if (fp) fclose(fp);
+        struct stat st, st0;
+        bool ok = stat(lease.c_str(), &st) == 0 && stat(clock.c_str(), &st0) == 0;
+        remove(clock.c_str());
+        if (!ok) return false;
+        if ((double)(st0.st_mtime - st.st_mtime) <= _leaseSec) return false;
+
+        /* take over the expired lease; only one node succeeds in renaming it */
+        string stale = lease + "." + _owner;
+        if (rename(lease.c_str(), stale.c_str()) != 0) return false;
+        if (stat(stale.c_str(), &st) == 0 && (double)(st0.st_mtime - st.st_mtime) <= _leaseSec)
+        {
+            /* another node has just taken it over, give it back */
+            rename(stale.c_str(), lease.c_str());
+
+            return false;
+        }
+        remove(stale.c_str());
+        if (access((job + DONE_SUFFIX).c_str(), 0) == 0 || !Create(lease)) return false;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _held.push_back(job);
+    if (!_renewer.joinable()) _renewer = std::thread(&WorkLease::Renew, this);
+
+    return true;
+} /* end of Claim */
+
+/**
+* @brief   : Done - mark all the held jobs as finished, or release them
+* @param[I]: ok (false: left unfinished or missing some files, released so that another node tries it again)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void WorkLease::Done(bool ok)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (int i = 0; i < _held.size(); i++)
+    {
+        string lease = _held[i] + LEASE_SUFFIX, done = _held[i] + DONE_SUFFIX;
+        if (!ok || rename(lease.c_str(), done.c_str()) != 0) remove(lease.c_str());
+    }
+    _held.clear();
+} /* end of Done */
+
+/**
+* @brief   : SiteList - the private 'site.list' of this node in the work directory
+* @param[I]: none
+* @param[O]: none
+* @return  : full path
+* @note    :
+**/
+string WorkLease::SiteList() const
+{
+    return _dir + (char)FILEPATHSEP + _owner + ".list";
+} /* end of SiteList */
@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------------
+* WorkLease.h : header file of WorkLease.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define LEASE_SUFFIX   ".lease"          /* suffix of a claimed job, holding 'owner time' */
+#define DONE_SUFFIX    ".done"           /* suffix of a finished job */
+
+class WorkLease
+{
+private:
+    string _dir;                          /* work directory of the day shared by all the nodes, "": distributed mode off */
+    int _leaseSec;                        /* seconds after which a lease of another node expires */
+    string _owner;                        /* owner of the leases, 'host_pid' */
+    std::vector<string> _held;            /* leases held (without suffix) */
+    std::thread _renewer;                 /* renewing the leases held, so that a job longer than '_leaseSec' is not taken over */
+    std::mutex _mutex;                    /* guarding '_held' and '_stop' */
+    std::condition_variable _cv;          /* waking the renewer up to stop */
+    bool _stop;                           /* whether the renewer stops */
+
+    /**
+    * @brief   : Create - create a lease file exclusively
+    * @param[I]: lease (lease file)
+    * @param[O]: none
+    * @return  : true: created, false: it exists
+    * @note    : 'O_EXCL' is atomic on a local file system and on NFS v3 or later
+    **/
+    bool Create(const string &lease) const;
+
+    /**
+    * @brief   : Renew - renew the leases held every third of '_leaseSec', until stopped
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : run by '_renewer'; the modification time set is that of the file server, as the age is measured
+    **/
+    void Renew();
+
+public:
+    /**
+    * @brief   : WorkLease - open the work directory of one day
+    * @param[I]: ts (the day)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : nothing is done if the distributed mode is off
+    **/
+    WorkLease(gtime_t ts, const ftpopt_t *fopt);
+    ~WorkLease();
+
+    /**
+    * @brief   : On - whether the distributed mode is on
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: on, false: off
+    * @note    :
+    **/
+    bool On() const
+    {
+        return !_dir.empty();
+    }
+
+    /**
+    * @brief   : Claim - claim the job of one product and site of the day
+    * @param[I]: prod (product, i.e., "obs_ngs_daily", "eop")
+    * @param[I]: site (site name, "all": the product as a whole)
+    * @param[O]: none
+    * @return  : true: claimed (or the distributed mode is off), false: done or leased by another node
+    * @note    : an expired lease is taken over, so the job of a lost node is retried; the leases held are renewed
+    *            until "Done"
+    **/
+    bool Claim(const string &prod, const string &site);
+
+    /**
+    * @brief   : Done - mark all the held jobs as finished, or release them
+    * @param[I]: ok (false: left unfinished or missing some files, released so that another node tries it again)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Done(bool ok);
+
+    /**
+    * @brief   : SiteList - the private 'site.list' of this node in the work directory
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : full path
+    * @note    :
+    **/
+    string SiteList() const;
+};
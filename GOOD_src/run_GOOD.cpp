@@ -6,11 +6,114 @@
 #include "GOOD.h"
 #include "StringUtil.h"
 #include "PreProcess.h"
+#include "TimeUtil.h"
+#include "ObsArchive.h"
+#include "MissCache.h"
+#include "RunJournal.h"
 
 
+/**
+* @brief   : DecodeObs - decode the epochs within a time range from a compressed observation file
+* @param[I]: argc, argv ('run_GOOD -decode file.gz [start [end [out]]]', time as 'yyyy/mm/dd,hh:mm:ss' or '-' for open)
+* @param[O]: none
+* @return  : 0:ok, 1:error
+* @note    :
+**/
+static int DecodeObs(int argc, char *argv[])
+{
+    TimeUtil tu;
+    gtime_t tt[2] = { { 0 }, { 0 } };
+    for (int i = 0; i < 2 && i + 3 < argc; i++)
+    {
+        double ep[6] = { 0.0 };
+        if (strcmp(argv[i + 3], "-") == 0) continue;
+        if (sscanf(argv[i + 3], "%lf%*c%lf%*c%lf%*c%lf%*c%lf%*c%lf", ep, ep + 1, ep + 2, ep + 3, ep + 4, ep + 5) < 3)
+        {
+            cout << "*** ERROR: the time " << argv[i + 3] << " should be 'yyyy/mm/dd,hh:mm:ss', please check the command line!" << endl;
+
+            return 1;
+        }
+        tt[i] = tu.ymdhms2time(ep);
+    }
+
+    FILE *fp = argc > 5 ? fopen(argv[5], "w") : stdout;
+    if (!fp)
+    {
+        cout << "*** ERROR: open output file " << argv[5] << " FAILED!" << endl;
+
+        return 1;
+    }
+    bool stat = ObsArchive::Decode(argv[2], tt[0], tt[1], fp);
+    if (fp != stdout) fclose(fp);
+
+    return stat ? 0 : 1;
+} /* end of DecodeObs */
+
+/**
+* @brief   : EstimateCfg - predict the cost of a configuration without downloading
+* @param[I]: argc, argv ('run_GOOD --estimate cfgFile [cfg_txt|cfg_yaml] [npar]')
+* @param[O]: none
+* @return  : 0:ok, 1:error
+* @note    :
+**/
+static int EstimateCfg(int argc, char *argv[])
+{
+    int readCfgMode = readCfgTxt, npar = 1;
+    for (int i = 3; i < argc; i++)
+    {
+        string sArg = argv[i];
+        StringUtil str;
+        str.ToUpper(sArg);
+        if (sArg == "CFG_TXT") readCfgMode = readCfgTxt;
+        else if (sArg == "CFG_YAML") readCfgMode = readCfgYaml;
+        else if ((npar = atoi(argv[i])) < 1)
+        {
+            cout << "*** ERROR: the parallelism " << argv[i] << " should be a positive integer, please check the command line!" << endl;
+
+            return 1;
+        }
+    }
+
+    PreProcess preProc;
+
+    return preProc.Estimate(argv[2], readCfgMode, npar) ? 0 : 1;
+} /* end of EstimateCfg */
+
+/**
+* @brief   : MissCacheCmd - list or forget the remote files known to be missing
+* @param[I]: argc, argv ('run_GOOD -misscache list|purge mainDir [url]', url as a wildcard, i.e., '*abmf*')
+* @param[O]: none
+* @return  : 0:ok, 1:error
+* @note    :
+**/
+static int MissCacheCmd(int argc, char *argv[])
+{
+    string pat = argc > 4 ? argv[4] : "";
+    if (strcmp(argv[2], "list") == 0) return MissCache::List(argv[3], pat) >= 0 ? 0 : 1;
+    if (strcmp(argv[2], "purge") == 0) return MissCache::Purge(argv[3], pat) >= 0 ? 0 : 1;
+    cout << "*** ERROR: the action " << argv[2] << " should be 'list' or 'purge', please check the command line!" << endl;
+
+    return 1;
+} /* end of MissCacheCmd */
+
 /* ppp_run main --------------------------------------------------------------*/
 int main(int argc, char * argv[])
 {
+    /* decode a time range from a compressed observation file, i.e.,
+       'run_GOOD -decode abmf0320.21o.gz 2021/02/01,01:00:00 2021/02/01,02:00:00 abmf0320.21o' */
+    if (argc >= 3 && strcmp(argv[1], "-decode") == 0) return DecodeObs(argc, argv);
+
+    /* predict the files, transfer volume, decoding time and wall time without downloading, i.e.,
+       'run_GOOD --estimate GOOD_cfg.yaml cfg_yaml 4' */
+    if (argc >= 3 && (strcmp(argv[1], "--estimate") == 0 || strcmp(argv[1], "-estimate") == 0)) return EstimateCfg(argc, argv);
+
+    /* list or forget the remote files known to be missing, i.e., 'run_GOOD -misscache purge /data/GNSS "*abmf*"' */
+    if (argc >= 4 && (strcmp(argv[1], "--misscache") == 0 || strcmp(argv[1], "-misscache") == 0)) return MissCacheCmd(argc, argv);
+
+    /* print the progress of a run from its journal next to the log file, i.e., 'run_GOOD -journal /data/log/log.journal' */
+    if (argc >= 3 && (strcmp(argv[1], "--journal") == 0 || strcmp(argv[1], "-journal") == 0))
+        return RunJournal::Progress(argv[2]) >= 0 ? 0 : 1;
+
     int readCfgMode = 0;  /* reading mode for configuration file, TXT or YAML */
 
 #ifdef _WIN32  /* for Windows */